@@ -0,0 +1,476 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    bench_number.c
+    Oracle NUMBER decoder microbenchmark (make bench)
+
+    Times decode_oracle_number and decode_oracle_number_batch against the
+    original byte-by-byte decoder on random NUMBER values, after checking
+    that all three produce the same text.  Not part of the library.
+
+      ./bench_number [values [rounds]]
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+#include <time.h>
+
+#define BENCH_BATCH_ROWS  1024
+
+typedef struct {
+    unsigned char b[22];
+    int len;
+} BENCH_NUMBER;
+
+/*---------------------------------------------------------------------------
+    Original decoder (int_buf / frac_buf digit by digit), kept verbatim as
+    the baseline.
+ ---------------------------------------------------------------------------*/
+static int ref_decode_oracle_number(const unsigned char *buf, int len, char *out, int out_size)
+{
+    int exp_byte;
+    int num_int_pairs;  /* number of base-100 pairs in integer part */
+    int is_negative;
+    int digit;
+    int i, pos;
+    char int_buf[256];  /* integer part digits (exponent can imply up to 63 pairs = 126 chars) */
+    int int_len;
+    char frac_buf[256]; /* fractional part digits */
+    int frac_len;
+    int leading_frac_zeros; /* pairs of "00" before fractional digits */
+
+    if (!buf || !out || out_size < 2) return ODV_ERROR_INVALID_ARG;
+    if (len < 1) { out[0] = '\0'; return ODV_ERROR_INVALID_ARG; }
+
+    /* Oracle NUMBER is at most 22 bytes. Cap to prevent buffer overflow
+       in int_buf[64]/frac_buf[64] which hold base-100 digit pairs. */
+    if (len > 22) len = 22;
+
+    out[0] = '\0';
+    exp_byte = buf[0];
+
+    /*-----------------------------------------------------------------------
+        Zero
+     -----------------------------------------------------------------------*/
+    if (exp_byte == 0x80 || len == 1) {
+        if (out_size < 2) return ODV_ERROR_BUFFER_OVER;
+        out[0] = '0';
+        out[1] = '\0';
+        return ODV_OK;
+    }
+
+    /*-----------------------------------------------------------------------
+        Oracle 12c+ extended precision: exponent 0xFF signals 39+ digit
+        precision with continuation encoding in bytes 1-2.
+        Seen in direct-path exports with extended NUMBER storage.
+     -----------------------------------------------------------------------*/
+    if (exp_byte == 0xFF && len >= 3 && buf[1] == 0xFE) {
+        /* Continuation marker: re-interpret byte 2 as actual exponent,
+           remaining bytes as standard mantissa */
+        exp_byte = buf[2];
+        buf += 2;
+        len -= 2;
+        if (len < 2) {
+            out[0] = '0';
+            out[1] = '\0';
+            return ODV_OK;
+        }
+    }
+
+    int_len = 0;
+    frac_len = 0;
+    leading_frac_zeros = 0;
+
+    /*-----------------------------------------------------------------------
+        Positive number (exponent >= 0xC0)
+     -----------------------------------------------------------------------*/
+    if (exp_byte >= 0xC0) {
+        is_negative = 0;
+        num_int_pairs = exp_byte - 0xC0;
+
+        for (i = 1; i < len; i++) {
+            digit = buf[i] - 1;
+            if (digit < 0) digit = 0;
+            if (digit > 99) digit = 99;
+
+            if (i <= num_int_pairs) {
+                /* Integer part */
+                if (int_len == 0 && digit == 0) {
+                    if (int_len + 2 <= (int)sizeof(int_buf)) {
+                        int_buf[int_len++] = '0';
+                        int_buf[int_len++] = '0';
+                    }
+                } else {
+                    if (int_len == 0 && digit < 10) {
+                        if (int_len + 1 <= (int)sizeof(int_buf))
+                            int_buf[int_len++] = '0' + digit;
+                    } else {
+                        if (int_len + 2 <= (int)sizeof(int_buf)) {
+                            int_buf[int_len++] = '0' + (digit / 10);
+                            int_buf[int_len++] = '0' + (digit % 10);
+                        }
+                    }
+                }
+            } else {
+                /* Fractional part */
+                if (frac_len + 2 <= (int)sizeof(frac_buf)) {
+                    frac_buf[frac_len++] = '0' + (digit / 10);
+                    frac_buf[frac_len++] = '0' + (digit % 10);
+                }
+            }
+        }
+
+        /* Pad missing integer pairs with "00"
+           Oracle omits trailing zero base-100 pairs from the mantissa.
+           e.g. 2700 is stored as exp=0xC2 (2 pairs) with only [28] (=27),
+           the second pair (00) is not stored and must be inferred. */
+        {
+            int pairs_seen = (len - 1 < num_int_pairs) ? len - 1 : num_int_pairs;
+            int missing_pairs = num_int_pairs - pairs_seen;
+            for (i = 0; i < missing_pairs && int_len + 2 <= (int)sizeof(int_buf); i++) {
+                int_buf[int_len++] = '0';
+                int_buf[int_len++] = '0';
+            }
+        }
+
+        /* If no integer digits produced, it's 0 */
+        if (int_len == 0 || num_int_pairs == 0) {
+            int_len = 0;
+            int_buf[int_len++] = '0';
+            /* All mantissa bytes are fractional */
+            frac_len = 0;
+            leading_frac_zeros = 0xC0 - exp_byte;
+            for (i = 1; i < len; i++) {
+                digit = buf[i] - 1;
+                if (digit < 0) digit = 0;
+                if (digit > 99) digit = 99;
+                if (frac_len + 2 <= (int)sizeof(frac_buf)) {
+                    frac_buf[frac_len++] = '0' + (digit / 10);
+                    frac_buf[frac_len++] = '0' + (digit % 10);
+                }
+            }
+        }
+
+    /*-----------------------------------------------------------------------
+        Positive small decimal (0xAE <= exp < 0xC0)
+        Integer part = "0", fractional part has leading zero pairs
+     -----------------------------------------------------------------------*/
+    } else if (exp_byte >= 0x80) {
+        is_negative = 0;
+        int_buf[0] = '0';
+        int_len = 1;
+        leading_frac_zeros = 0xC0 - exp_byte;
+        for (i = 1; i < len; i++) {
+            digit = buf[i] - 1;
+            if (digit < 0) digit = 0;
+            if (digit > 99) digit = 99;
+            if (frac_len + 2 <= (int)sizeof(frac_buf)) {
+                frac_buf[frac_len++] = '0' + (digit / 10);
+                frac_buf[frac_len++] = '0' + (digit % 10);
+            }
+        }
+
+    /*-----------------------------------------------------------------------
+        Negative number (exponent <= 0x3F)
+        Digits are complementary: value = (101 - byte)
+        Terminator: 0x66 (102)
+     -----------------------------------------------------------------------*/
+    } else if (exp_byte < 0x40) {
+        is_negative = 1;
+        num_int_pairs = 0x3F - exp_byte;
+
+        for (i = 1; i < len; i++) {
+            if (buf[i] == 0x66) break;  /* terminator */
+
+            digit = 101 - buf[i];
+            if (digit < 0) digit = 0;
+            if (digit > 99) digit = 99;
+
+            if (i <= num_int_pairs) {
+                /* Integer part */
+                if (int_len == 0 && digit < 10) {
+                    if (int_len + 1 <= (int)sizeof(int_buf))
+                        int_buf[int_len++] = '0' + digit;
+                } else {
+                    if (int_len + 2 <= (int)sizeof(int_buf)) {
+                        int_buf[int_len++] = '0' + (digit / 10);
+                        int_buf[int_len++] = '0' + (digit % 10);
+                    }
+                }
+            } else {
+                /* Fractional part */
+                if (frac_len + 2 <= (int)sizeof(frac_buf)) {
+                    frac_buf[frac_len++] = '0' + (digit / 10);
+                    frac_buf[frac_len++] = '0' + (digit % 10);
+                }
+            }
+        }
+
+        /* Pad missing integer pairs with "00" (same as positive case) */
+        {
+            int data_bytes = 0;
+            for (i = 1; i < len; i++) {
+                if (buf[i] == 0x66) break;
+                data_bytes++;
+            }
+            {
+                int pairs_seen = (data_bytes < num_int_pairs) ? data_bytes : num_int_pairs;
+                int missing_pairs = num_int_pairs - pairs_seen;
+                for (i = 0; i < missing_pairs && int_len + 2 <= (int)sizeof(int_buf); i++) {
+                    int_buf[int_len++] = '0';
+                    int_buf[int_len++] = '0';
+                }
+            }
+        }
+
+        if (int_len == 0 || num_int_pairs == 0) {
+            int_len = 0;
+            int_buf[int_len++] = '0';
+        }
+
+    /*-----------------------------------------------------------------------
+        Negative small decimal (0x40 <= exp < 0x80)
+        Integer part = "0", fractional part complementary
+     -----------------------------------------------------------------------*/
+    } else {
+        /* exp_byte in [0x40..0x7F] */
+        is_negative = 1;
+        int_buf[0] = '0';
+        int_len = 1;
+        leading_frac_zeros = exp_byte - 0x3F;
+        for (i = 1; i < len; i++) {
+            if (buf[i] == 0x66) break;  /* terminator */
+            digit = 101 - buf[i];
+            if (digit < 0) digit = 0;
+            if (digit > 99) digit = 99;
+            if (frac_len + 2 <= (int)sizeof(frac_buf)) {
+                frac_buf[frac_len++] = '0' + (digit / 10);
+                frac_buf[frac_len++] = '0' + (digit % 10);
+            }
+        }
+    }
+
+    /*-----------------------------------------------------------------------
+        Trim trailing zeros from fractional part
+     -----------------------------------------------------------------------*/
+    while (frac_len > 0 && frac_buf[frac_len - 1] == '0') {
+        frac_len--;
+    }
+
+    /*-----------------------------------------------------------------------
+        Build output string
+     -----------------------------------------------------------------------*/
+    pos = 0;
+
+    /* Sign */
+    if (is_negative) {
+        if (pos < out_size - 1) out[pos++] = '-';
+    }
+
+    /* Integer part */
+    for (i = 0; i < int_len && pos < out_size - 1; i++) {
+        out[pos++] = int_buf[i];
+    }
+
+    /* Fractional part */
+    if (frac_len > 0 || leading_frac_zeros > 0) {
+        int total_frac = leading_frac_zeros * 2 + frac_len;
+        /* Only output decimal point if there are meaningful fractional digits */
+        if (total_frac > 0) {
+            if (pos < out_size - 1) out[pos++] = '.';
+
+            /* Leading zero pairs */
+            for (i = 0; i < leading_frac_zeros * 2 && pos < out_size - 1; i++) {
+                out[pos++] = '0';
+            }
+
+            /* Fractional digits */
+            for (i = 0; i < frac_len && pos < out_size - 1; i++) {
+                out[pos++] = frac_buf[i];
+            }
+        }
+    }
+
+    out[pos] = '\0';
+
+    /* Normalize negative zero variants: "-0", "-0.0", "-0.00" etc. → "0"
+       A negative number whose digits all resolved to zero should not
+       carry the sign. Check if the string matches -0[.0*] */
+    if (out[0] == '-' && out[1] == '0') {
+        int all_zero = 1;
+        int k;
+        for (k = 2; k < pos; k++) {
+            if (out[k] != '.' && out[k] != '0') { all_zero = 0; break; }
+        }
+        if (all_zero) {
+            out[0] = '0';
+            out[1] = '\0';
+        }
+    }
+
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Random input
+ ---------------------------------------------------------------------------*/
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t rng(uint32_t n)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)((rng_state >> 32) % n);
+}
+
+/* Encode sign * 0.d[0] d[1] ... d[n-1] * 100^int_pairs */
+static void encode_number(BENCH_NUMBER *v, int neg, int int_pairs,
+                          const int *d, int n)
+{
+    int i;
+
+    v->b[0] = (unsigned char)(neg ? 0x3F - int_pairs : 0xC0 + int_pairs);
+    for (i = 0; i < n; i++)
+        v->b[i + 1] = (unsigned char)(neg ? 101 - d[i] : d[i] + 1);
+    v->len = n + 1;
+    if (neg && n < 20) v->b[v->len++] = 0x66;
+}
+
+/* kind 0: integer IDs, 1: amounts with cents, 2: any precision / scale */
+static void random_number(BENCH_NUMBER *v, int kind)
+{
+    int d[20], n, int_pairs, neg, i;
+
+    switch (kind) {
+    case 0:
+        neg = 0;
+        int_pairs = 1 + (int)rng(5);
+        n = 1 + (int)rng((uint32_t)int_pairs);
+        break;
+    case 1:
+        neg = (rng(5) == 0);
+        int_pairs = 1 + (int)rng(4);
+        n = int_pairs + (int)rng(2);
+        break;
+    default:
+        neg = (int)rng(2);
+        int_pairs = (int)rng(16) - 5;
+        n = 1 + (int)rng(20);
+        break;
+    }
+
+    for (i = 0; i < n; i++) d[i] = (int)rng(100);
+    if (d[0] == 0) d[0] = 1 + (int)rng(99);
+    if (d[n - 1] == 0) d[n - 1] = 1 + (int)rng(99);
+    encode_number(v, neg, int_pairs, d, n);
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*---------------------------------------------------------------------------
+    One input set: verify, then time the three decoders
+ ---------------------------------------------------------------------------*/
+static int bench_set(const char *label, int kind, int count, int rounds)
+{
+    static const unsigned char *bufs[BENCH_BATCH_ROWS];
+    static int lens[BENCH_BATCH_ROWS];
+    static int out_lens[BENCH_BATCH_ROWS];
+    static char batch_out[BENCH_BATCH_ROWS * ODV_NUMBER_STR_LEN];
+    BENCH_NUMBER *vals;
+    char ref[ODV_NUMBER_STR_LEN], cur[ODV_NUMBER_STR_LEN];
+    volatile unsigned sink = 0;
+    double t0, t_ref, t_cur, t_batch, total;
+    int i, r, k, bad = 0;
+
+    vals = (BENCH_NUMBER *)malloc((size_t)count * sizeof(BENCH_NUMBER));
+    if (!vals) return ODV_ERROR_MALLOC;
+    for (i = 0; i < count; i++)
+        random_number(&vals[i], kind == 3 ? (int)rng(3) : kind);
+
+    /* Same text from all three */
+    for (i = 0; i < count; i += BENCH_BATCH_ROWS) {
+        int rows = (count - i < BENCH_BATCH_ROWS) ? count - i : BENCH_BATCH_ROWS;
+        for (k = 0; k < rows; k++) {
+            bufs[k] = vals[i + k].b;
+            lens[k] = vals[i + k].len;
+        }
+        decode_oracle_number_batch(bufs, lens, rows, batch_out,
+                                   ODV_NUMBER_STR_LEN, out_lens);
+        for (k = 0; k < rows; k++) {
+            const char *bt = batch_out + (size_t)k * ODV_NUMBER_STR_LEN;
+            ref_decode_oracle_number(vals[i + k].b, vals[i + k].len, ref, sizeof(ref));
+            decode_oracle_number(vals[i + k].b, vals[i + k].len, cur, sizeof(cur));
+            if (strcmp(ref, cur) != 0 || strcmp(ref, bt) != 0 ||
+                out_lens[k] != (int)strlen(ref)) {
+                if (bad++ < 5)
+                    fprintf(stderr, "%s: mismatch \"%s\" / \"%s\" / \"%s\"\n",
+                            label, ref, cur, bt);
+            }
+        }
+    }
+
+    t0 = now_sec();
+    for (r = 0; r < rounds; r++)
+        for (i = 0; i < count; i++) {
+            ref_decode_oracle_number(vals[i].b, vals[i].len, ref, sizeof(ref));
+            sink += (unsigned char)ref[0];
+        }
+    t_ref = now_sec() - t0;
+
+    t0 = now_sec();
+    for (r = 0; r < rounds; r++)
+        for (i = 0; i < count; i++)
+            sink += (unsigned)decode_oracle_number(vals[i].b, vals[i].len, cur, sizeof(cur));
+    t_cur = now_sec() - t0;
+
+    t0 = now_sec();
+    for (r = 0; r < rounds; r++)
+        for (i = 0; i < count; i += BENCH_BATCH_ROWS) {
+            int rows = (count - i < BENCH_BATCH_ROWS) ? count - i : BENCH_BATCH_ROWS;
+            for (k = 0; k < rows; k++) {
+                bufs[k] = vals[i + k].b;
+                lens[k] = vals[i + k].len;
+            }
+            decode_oracle_number_batch(bufs, lens, rows, batch_out,
+                                       ODV_NUMBER_STR_LEN, out_lens);
+            sink += (unsigned)out_lens[0];
+        }
+    t_batch = now_sec() - t0;
+
+    total = (double)count * rounds / 1e9;
+    printf("%-10s %8.1f %8.1f (x%.2f) %8.1f (x%.2f)%s\n", label,
+           t_ref / total, t_cur / total, t_ref / t_cur,
+           t_batch / total, t_ref / t_batch, bad ? "  MISMATCH" : "");
+
+    free(vals);
+    (void)sink;
+    return bad ? ODV_ERROR : ODV_OK;
+}
+
+int main(int argc, char **argv)
+{
+    int count = (argc > 1) ? atoi(argv[1]) : 1 << 18;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 8;
+    int rc = ODV_OK;
+
+    if (count < 1 || rounds < 1) {
+        fprintf(stderr, "usage: %s [values [rounds]]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%d random values x %d rounds, ns/value\n", count, rounds);
+    printf("%-10s %8s %17s %17s\n", "input", "original", "decode", "batch");
+    if (bench_set("ids", 0, count, rounds) != ODV_OK) rc = ODV_ERROR;
+    if (bench_set("amounts", 1, count, rounds) != ODV_OK) rc = ODV_ERROR;
+    if (bench_set("general", 2, count, rounds) != ODV_OK) rc = ODV_ERROR;
+    if (bench_set("mixed", 3, count, rounds) != ODV_OK) rc = ODV_ERROR;
+    return rc == ODV_OK ? 0 : 1;
+}
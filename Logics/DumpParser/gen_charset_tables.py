@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+    OraDB DUMP Viewer
+
+    gen_charset_tables.py
+    Generates odv_charset_tables.c (code page tables for odv_charset.c)
+
+    Usage:  python3 gen_charset_tables.py > odv_charset_tables.c
+
+    The mappings come from Python's codecs (cp932, euc_jp, gbk, cp1252,
+    iso8859_15), which follow the Microsoft / WHATWG tables used by
+    MultiByteToWideChar for the same code pages.
+
+    Copyright (C) 2026 YANAI Taketo
+"""
+
+import sys
+
+
+def decode(b, enc):
+    try:
+        u = b.decode(enc)
+    except UnicodeDecodeError:
+        return 0
+    if len(u) != 1 or ord(u) > 0xFFFF:
+        return 0
+    return ord(u)
+
+
+def encode(ch, enc):
+    try:
+        return chr(ch).encode(enc)
+    except UnicodeEncodeError:
+        return None
+
+
+out = []
+
+
+def emit(s=''):
+    out.append(s)
+
+
+def emit_u16(name, values, comment):
+    emit('/* %s */' % comment)
+    emit('const unsigned short %s[%d] = {' % (name, len(values)))
+    for i in range(0, len(values), 12):
+        emit('    ' + ', '.join('0x%04X' % v for v in values[i:i + 12]) + ',')
+    emit('};')
+    emit()
+
+
+def emit_u8(name, values, comment):
+    emit('/* %s */' % comment)
+    emit('const unsigned char %s[%d] = {' % (name, len(values)))
+    for i in range(0, len(values), 16):
+        emit('    ' + ', '.join('%d' % v for v in values[i:i + 16]) + ',')
+    emit('};')
+    emit()
+
+
+def emit_reverse(prefix, pairs, code_type, comment):
+    emit('const int %s_enc_count = %d;' % (prefix, len(pairs)))
+    emit()
+    emit_u16(prefix + '_enc_ucs', [u for u, _ in pairs], comment + ': Unicode (sorted)')
+    fmt = '0x%06X' if code_type == 'unsigned int' else '0x%04X'
+    emit('/* %s: code for each entry of %s_enc_ucs */' % (comment, prefix))
+    emit('const %s %s_enc_code[%d] = {' % (code_type, prefix, len(pairs)))
+    for i in range(0, len(pairs), 12):
+        emit('    ' + ', '.join(fmt % c for _, c in pairs[i:i + 12]) + ',')
+    emit('};')
+    emit()
+
+
+def single_high(enc, fill_identity):
+    tbl = []
+    for b in range(0x80, 0x100):
+        u = decode(bytes([b]), enc)
+        if u == 0 and fill_identity:
+            u = b        # undefined: pass through as C1 control (Win32 behaviour)
+        tbl.append(u)
+    return tbl
+
+
+def dbcs_table(enc, leads, trail_lo, trail_hi):
+    """Returns (lead index 0..255 -> row+1, flat rows x trails table)."""
+    lead_idx = [0] * 256
+    rows = []
+    for lead in leads:
+        row = [decode(bytes([lead, t]), enc) for t in range(trail_lo, trail_hi + 1)]
+        if any(row):
+            rows.append(row)
+            lead_idx[lead] = len(rows)
+    return lead_idx, [v for row in rows for v in row]
+
+
+def reverse(enc, chars):
+    """(unicode, preferred multi-byte code) for every character of the
+       table the code page can encode, sorted by unicode."""
+    pairs = []
+    for u in sorted(set(chars)):
+        if u < 0x80:
+            continue
+        e = encode(u, enc)
+        if e is None or len(e) < 2:
+            continue
+        pairs.append((u, int.from_bytes(e, 'big')))
+    return pairs
+
+
+emit('/*****************************************************************************')
+emit('    OraDB DUMP Viewer')
+emit()
+emit('    odv_charset_tables.c')
+emit('    Code page tables for odv_charset.c')
+emit()
+emit('    GENERATED by gen_charset_tables.py -- do not edit.')
+emit()
+emit('    Copyright (C) 2026 YANAI Taketo')
+emit(' *****************************************************************************/')
+emit()
+
+# --- Single-byte code pages (high half only; low half is ASCII) ---
+emit_u16('odv_cp1252_high', single_high('cp1252', True),
+         'Windows-1252 (WE8MSWIN1252): bytes 0x80-0xFF')
+emit_u16('odv_iso8859_15_high', single_high('iso8859_15', True),
+         'ISO-8859-15 (WE8ISO8859P15): bytes 0x80-0xFF')
+
+# --- CP932 (JA16SJIS) ---
+sjis_leads = list(range(0x81, 0xA0)) + list(range(0xE0, 0xFD))
+sjis_single = []
+for b in range(0x80, 0x100):
+    sjis_single.append(0 if b in sjis_leads else decode(bytes([b]), 'cp932'))
+lead, dbcs = dbcs_table('cp932', sjis_leads, 0x40, 0xFC)
+emit_u16('odv_cp932_single', sjis_single,
+         'CP932: single bytes 0x80-0xFF (0 = lead byte or undefined)')
+emit_u8('odv_cp932_lead', lead, 'CP932: lead byte -> row + 1 in odv_cp932_dbcs')
+emit_u16('odv_cp932_dbcs', dbcs, 'CP932: rows x trail bytes 0x40-0xFC')
+emit_reverse('odv_cp932', reverse('cp932', dbcs), 'unsigned short',
+             'CP932 double-byte encoding')
+
+# --- EUC-JP (JA16EUC): JIS X 0208 / JIS X 0212 planes, 94 x 94 ---
+jis0208 = [decode(bytes([l, t]), 'euc_jp') for l in range(0xA1, 0xFF) for t in range(0xA1, 0xFF)]
+jis0212 = [decode(bytes([0x8F, l, t]), 'euc_jp') for l in range(0xA1, 0xFF) for t in range(0xA1, 0xFF)]
+emit_u16('odv_eucjp_0208', jis0208, 'EUC-JP: JIS X 0208 (0xA1-0xFE x 0xA1-0xFE)')
+emit_u16('odv_eucjp_0212', jis0212, 'EUC-JP: JIS X 0212 (0x8F 0xA1-0xFE x 0xA1-0xFE)')
+emit_reverse('odv_eucjp', reverse('euc_jp', jis0208 + jis0212), 'unsigned int',
+             'EUC-JP two/three-byte encoding')
+
+# --- GBK (ZHS16GBK) ---
+lead, dbcs = dbcs_table('gbk', range(0x81, 0xFF), 0x40, 0xFE)
+emit_u8('odv_gbk_lead', lead, 'GBK: lead byte -> row + 1 in odv_gbk_dbcs')
+emit_u16('odv_gbk_dbcs', dbcs, 'GBK: rows x trail bytes 0x40-0xFE')
+emit_reverse('odv_gbk', reverse('gbk', dbcs), 'unsigned short',
+             'GBK double-byte encoding')
+
+sys.stdout.write('\n'.join(out))
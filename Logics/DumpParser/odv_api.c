@@ -37,12 +37,62 @@ static void clear_session(ODV_SESSION *s)
     /* Export option defaults */
     s->date_format = DATE_FMT_SLASH;
     s->custom_date_format[0] = '\0';
+    odv_compile_date_format(&s->date_prog, DATE_FMT_SLASH, NULL);
     s->csv_write_header = 1;
     s->csv_write_types = 0;
     s->csv_delimiter = ',';
     s->sql_create_table = 0;
     s->sql_create_index = 0;
     s->sql_write_comments = 0;
+    s->sql_batch_rows = 1;
+    s->sql_commit_rows = 0;
+    s->parquet_row_group_rows = ODV_PARQUET_ROW_GROUP;
+    s->parquet_compression = PQ_CODEC_SNAPPY;
+    s->parquet_dictionary = 1;
+    s->out_compression = ODV_COMPRESS_NONE;
+    s->out_compression_level = 0;
+    s->out_compression_threads = 0;
+    s->split_max_bytes = 0;
+    s->split_max_rows = 0;
+    s->shard_count = 0;
+    s->shard_keys[0] = '\0';
+    s->tee_count = 0;
+
+    s->checkpoint_interval = ODV_CHECKPOINT_INTERVAL;
+}
+
+/* Switch the row value charset; returns the previous one */
+static int set_out_charset(ODV_SESSION *s, int cs)
+{
+    int prev = s->out_charset;
+    if (cs != prev) {
+        s->out_charset = cs;
+        odv_table_changed(s);   /* Decode plan and names depend on it */
+    }
+    return prev;
+}
+
+/* Run the parser for the detected dump type.  Every parse (list, row
+   delivery, LOB extraction and the exports) goes through here. */
+int odv_run_parse(ODV_SESSION *s, int list_only)
+{
+    s->filter_cs_valid = 0;   /* dump charset is (re)detected by the parser */
+    odv_table_changed(s);
+
+    switch (s->dump_type) {
+    case DUMP_EXPDP:
+        return parse_expdp_dump(s, list_only);
+    case DUMP_EXPDP_COMPRESS:
+        set_error(s, "Compressed EXPDP dumps (COMPRESSION=ALL) are not supported. "
+                     "Please re-export with COMPRESSION=NONE.");
+        return ODV_ERROR_UNSUPPORTED;
+    case DUMP_EXP:
+    case DUMP_EXP_DIRECT:
+        return parse_exp_dump(s, list_only);
+    default:
+        set_error(s, "Unknown or unsupported dump format");
+        return ODV_ERROR_FORMAT;
+    }
 }
 
 /*---------------------------------------------------------------------------
@@ -76,6 +126,16 @@ ODV_API int ODV_CALL odv_destroy_session(ODV_SESSION *session)
 
     free_record(&session->record);
 
+    /* Free catalogs (table list entries own their row checkpoints) */
+    odv_table_list_free(session);
+    odv_table_index_free(session);
+    odv_table_free(&session->table);
+    free_meta_cache(session);
+    odv_free_col_scratch(session);
+    odv_free_decode_plan(session);
+    free(session->ckpt_buf);
+    free(session->constraints_json);
+
     /* Free LOB buffer if allocated */
     if (session->state.lob_buf) {
         free(session->state.lob_buf);
@@ -125,6 +185,14 @@ ODV_API int ODV_CALL odv_set_row_callback(ODV_SESSION *s, ODV_ROW_CALLBACK cb, v
     return ODV_OK;
 }
 
+ODV_API int ODV_CALL odv_set_row_span_callback(ODV_SESSION *s, ODV_ROW_SPAN_CALLBACK cb, void *user_data)
+{
+    if (!s) return ODV_ERROR_INVALID_ARG;
+    s->row_span_cb = cb;
+    s->row_ud = user_data;
+    return ODV_OK;
+}
+
 ODV_API int ODV_CALL odv_set_progress_callback(ODV_SESSION *s, ODV_PROGRESS_CALLBACK cb, void *user_data)
 {
     if (!s) return ODV_ERROR_INVALID_ARG;
@@ -151,6 +219,7 @@ ODV_API int ODV_CALL odv_set_table_filter(ODV_SESSION *s, const char *schema, co
         s->filter_schema[0] = '\0';
         s->filter_table[0] = '\0';
         s->filter_partition[0] = '\0';
+        s->filter_cs_valid = 0;
         return ODV_OK;
     }
 
@@ -163,6 +232,7 @@ ODV_API int ODV_CALL odv_set_table_filter(ODV_SESSION *s, const char *schema, co
     odv_strcpy(s->filter_table, table, ODV_OBJNAME_LEN);
     s->filter_partition[0] = '\0';
     s->filter_active = 1;
+    s->filter_cs_valid = 0;
     s->pass_flg = 0;
 
     return ODV_OK;
@@ -195,6 +265,8 @@ ODV_API int ODV_CALL odv_set_date_format(ODV_SESSION *s, int fmt, const char *cu
     } else {
         s->custom_date_format[0] = '\0';
     }
+    odv_compile_date_format(&s->date_prog, fmt, s->custom_date_format);
+    s->plan.valid = 0;      /* Drop memoized DATE text */
     return ODV_OK;
 }
 
@@ -216,6 +288,55 @@ ODV_API int ODV_CALL odv_set_sql_options(ODV_SESSION *s, int create_table,
     return ODV_OK;
 }
 
+ODV_API int ODV_CALL odv_set_sql_batch(ODV_SESSION *s, int rows_per_statement, int commit_rows)
+{
+    if (!s || rows_per_statement < 0 || commit_rows < 0) return ODV_ERROR_INVALID_ARG;
+    s->sql_batch_rows = rows_per_statement > 1 ? rows_per_statement : 1;
+    s->sql_commit_rows = commit_rows;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_set_parquet_options(ODV_SESSION *s, int row_group_rows, int compression, int dictionary)
+{
+    if (!s || row_group_rows < 0) return ODV_ERROR_INVALID_ARG;
+    if (compression != PQ_CODEC_NONE && compression != PQ_CODEC_SNAPPY) return ODV_ERROR_INVALID_ARG;
+    s->parquet_row_group_rows = row_group_rows > 0 ? row_group_rows : ODV_PARQUET_ROW_GROUP;
+    s->parquet_compression = compression;
+    s->parquet_dictionary = dictionary ? 1 : 0;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_set_output_compression(ODV_SESSION *s, int codec, int level, int threads)
+{
+    if (!s || level < 0 || level > 9 || threads < 0) return ODV_ERROR_INVALID_ARG;
+    if (codec != ODV_COMPRESS_NONE && codec != ODV_COMPRESS_GZIP && codec != ODV_COMPRESS_ZSTD)
+        return ODV_ERROR_INVALID_ARG;
+    s->out_compression = codec;
+    s->out_compression_level = level;
+    s->out_compression_threads = threads;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_set_output_split(ODV_SESSION *s, int64_t max_bytes, int64_t max_rows)
+{
+    if (!s || max_bytes < 0 || max_rows < 0) return ODV_ERROR_INVALID_ARG;
+    s->split_max_bytes = max_bytes;
+    s->split_max_rows = max_rows;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_set_output_shards(ODV_SESSION *s, int shards, const char *key_columns)
+{
+    if (!s || shards < 0 || shards > ODV_MAX_SHARDS) return ODV_ERROR_INVALID_ARG;
+    s->shard_count = shards;
+    if (key_columns) {
+        odv_strcpy(s->shard_keys, key_columns, sizeof(s->shard_keys) - 1);
+    } else {
+        s->shard_keys[0] = '\0';
+    }
+    return ODV_OK;
+}
+
 ODV_API int ODV_CALL odv_set_app_version(ODV_SESSION *s, const char *ver)
 {
     if (!s) return ODV_ERROR_INVALID_ARG;
@@ -264,20 +385,7 @@ ODV_API int ODV_CALL odv_list_tables(ODV_SESSION *s)
     s->table_count = 0;
     s->partition_count = 0;
 
-    switch (s->dump_type) {
-    case DUMP_EXPDP:
-        return parse_expdp_dump(s, 1 /* list_only */);
-    case DUMP_EXPDP_COMPRESS:
-        set_error(s, "Compressed EXPDP dumps (COMPRESSION=ALL) are not supported. "
-                     "Please re-export with COMPRESSION=NONE.");
-        return ODV_ERROR_UNSUPPORTED;
-    case DUMP_EXP:
-    case DUMP_EXP_DIRECT:
-        return parse_exp_dump(s, 1 /* list_only */);
-    default:
-        set_error(s, "Unknown or unsupported dump format");
-        return ODV_ERROR_FORMAT;
-    }
+    return odv_run_parse(s, 1 /* list_only */);
 }
 
 ODV_API int ODV_CALL odv_get_partition_count(ODV_SESSION *s)
@@ -304,23 +412,27 @@ ODV_API int ODV_CALL odv_get_table_entry(ODV_SESSION *s, int index,
 }
 
 /* Build constraints JSON for a table_list entry (EXPDP metadata).
- * Returns pointer to static buffer (overwritten on each call). */
+ * Returns pointer to a session buffer (overwritten on each call). */
 ODV_API const char * ODV_CALL odv_get_table_constraints_json(ODV_SESSION *s, int index)
 {
-    static char json_buf[8192];
     int pos = 0, i;
+    size_t need;
 
-    if (!s || index < 0 || index >= s->table_count) {
-        json_buf[0] = '['; json_buf[1] = ']'; json_buf[2] = '\0';
-        return json_buf;
-    }
+    if (!s || index < 0 || index >= s->table_count) return "[]";
 
     ODV_TABLE_ENTRY *e = &s->table_list[index];
-    if (e->meta_constraint_count == 0) {
-        json_buf[0] = '['; json_buf[1] = ']'; json_buf[2] = '\0';
-        return json_buf;
+    if (e->meta_constraint_count == 0) return "[]";
+
+    /* Worst case per entry: every name character escaped plus the fixed text */
+    need = (size_t)e->meta_constraint_count * (ODV_OBJNAME_LEN * 2 + 64) + 3;
+    if (need > s->constraints_json_alloc) {
+        char *p = (char *)realloc(s->constraints_json, need);
+        if (!p) return "[]";
+        s->constraints_json = p;
+        s->constraints_json_alloc = need;
     }
 
+    char *json_buf = s->constraints_json;
     json_buf[pos++] = '[';
     for (i = 0; i < e->meta_constraint_count; i++) {
         ODV_CONSTRAINT_NAME *mc = &e->meta_constraints[i];
@@ -334,7 +446,7 @@ ODV_API const char * ODV_CALL odv_get_table_constraints_json(ODV_SESSION *s, int
         esc_name[ei] = '\0';
 
         if (i > 0) json_buf[pos++] = ',';
-        int n = snprintf(json_buf + pos, sizeof(json_buf) - pos,
+        int n = snprintf(json_buf + pos, s->constraints_json_alloc - pos,
             "{\"type\":%d,\"name\":\"%s\",\"columns\":[]}", mc->type, esc_name);
         if (n > 0) pos += n;
     }
@@ -357,21 +469,110 @@ ODV_API int ODV_CALL odv_parse_dump(ODV_SESSION *s)
 
     s->cancelled = 0;
     s->total_rows = 0;
+    s->rows_delivered = 0;
+    s->limit_reached = 0;
+    s->limit_active = 1;
 
-    switch (s->dump_type) {
-    case DUMP_EXPDP:
-        return parse_expdp_dump(s, 0 /* full parse */);
-    case DUMP_EXPDP_COMPRESS:
-        set_error(s, "Compressed EXPDP dumps (COMPRESSION=ALL) are not supported. "
-                     "Please re-export with COMPRESSION=NONE.");
-        return ODV_ERROR_UNSUPPORTED;
-    case DUMP_EXP:
-    case DUMP_EXP_DIRECT:
-        return parse_exp_dump(s, 0 /* full parse */);
-    default:
-        set_error(s, "Unknown or unsupported dump format");
-        return ODV_ERROR_FORMAT;
+    rc = odv_run_parse(s, 0 /* full parse */);
+    s->limit_active = 0;
+    if (rc == ODV_ERROR_CANCELLED && s->limit_reached) rc = ODV_OK;
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_seek_row(ODV_SESSION *s, int table_index, int64_t row_no)
+{
+    ODV_TABLE_ENTRY *e;
+    char save_schema[ODV_OBJNAME_LEN + 1];
+    char save_table[ODV_OBJNAME_LEN + 1];
+    char save_partition[ODV_OBJNAME_LEN + 1];
+    int save_active;
+    int64_t save_offset;
+    int lo, hi, rc;
+
+    if (!s || row_no < 0) return ODV_ERROR_INVALID_ARG;
+    if (table_index < 0 || table_index >= s->table_count) {
+        set_error(s, "Table index out of range (call odv_list_tables first)");
+        return ODV_ERROR_INVALID_ARG;
+    }
+    e = &s->table_list[table_index];
+    if (row_no >= e->row_count) return ODV_OK;   /* Nothing to deliver */
+
+    /* Nearest checkpoint at or before row_no (binary search) */
+    memset(&s->seek_ckpt, 0, sizeof(s->seek_ckpt));
+    lo = 0;
+    hi = e->checkpoint_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (e->checkpoints[mid].row_no <= row_no) {
+            s->seek_ckpt = e->checkpoints[mid];
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    /* Select the table (and partition) through the filter/seek settings */
+    odv_strcpy(save_schema, s->filter_schema, ODV_OBJNAME_LEN);
+    odv_strcpy(save_table, s->filter_table, ODV_OBJNAME_LEN);
+    odv_strcpy(save_partition, s->filter_partition, ODV_OBJNAME_LEN);
+    save_active = s->filter_active;
+    save_offset = s->seek_offset;
+
+    odv_set_table_filter(s, e->schema, e->name);
+    if (s->dump_type == DUMP_EXP || s->dump_type == DUMP_EXP_DIRECT)
+        odv_set_partition_filter(s, e->partition);
+    s->seek_offset = e->ddl_offset;
+
+    s->seek_active = 1;
+    s->seek_row = row_no;
+    s->skip_rows = 0;
+    s->keep_table_list = 1;
+    s->cancelled = 0;
+    s->total_rows = 0;
+    s->rows_delivered = 0;
+    s->limit_reached = 0;
+    s->limit_active = 1;
+
+    rc = odv_run_parse(s, 0);
+    if (rc == ODV_ERROR_CANCELLED && s->limit_reached) rc = ODV_OK;
+
+    s->limit_active = 0;
+    s->seek_active = 0;
+    s->skip_rows = 0;
+    s->keep_table_list = 0;
+
+    odv_strcpy(s->filter_schema, save_schema, ODV_OBJNAME_LEN);
+    odv_strcpy(s->filter_table, save_table, ODV_OBJNAME_LEN);
+    odv_strcpy(s->filter_partition, save_partition, ODV_OBJNAME_LEN);
+    s->filter_active = save_active;
+    s->seek_offset = save_offset;
+
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_set_checkpoint_interval(ODV_SESSION *s, int rows)
+{
+    if (!s || rows < 0) return ODV_ERROR_INVALID_ARG;
+    s->checkpoint_interval = rows;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_set_row_limit(ODV_SESSION *s, int64_t max_rows)
+{
+    if (!s || max_rows < 0) return ODV_ERROR_INVALID_ARG;
+    s->row_limit = max_rows;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_set_output_charset(ODV_SESSION *s, int charset)
+{
+    if (!s) return ODV_ERROR_INVALID_ARG;
+    switch (charset) {
+    case ODV_CHARSET_UTF8:    set_out_charset(s, CHARSET_UTF8);    break;
+    case ODV_CHARSET_UTF16LE: set_out_charset(s, CHARSET_UTF16LE); break;
+    default: return ODV_ERROR_INVALID_ARG;
     }
+    return ODV_OK;
 }
 
 ODV_API void ODV_CALL odv_set_csv_delimiter(ODV_SESSION *s, char delimiter)
@@ -381,14 +582,152 @@ ODV_API void ODV_CALL odv_set_csv_delimiter(ODV_SESSION *s, char delimiter)
 
 ODV_API int ODV_CALL odv_export_csv(ODV_SESSION *s, const char *table_name, const char *output_path)
 {
+    int rc, saved_cs;
     if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
-    return write_csv_file(s, table_name, output_path);
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Files are always UTF-8 */
+    rc = write_csv_file(s, table_name, output_path);
+    set_out_charset(s, saved_cs);
+    return rc;
 }
 
 ODV_API int ODV_CALL odv_export_sql(ODV_SESSION *s, const char *table_name, const char *output_path, int dbms_type)
 {
+    int rc, saved_cs;
     if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
-    return write_sql_file(s, table_name, output_path, dbms_type);
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Files are always UTF-8 */
+    rc = write_sql_file(s, table_name, output_path, dbms_type);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_csv_fd(ODV_SESSION *s, const char *table_name, int fd)
+{
+    ODV_OUTBUF out;
+    int rc, saved_cs;
+    if (!s || fd < 0) return ODV_ERROR_INVALID_ARG;
+    rc = odv_out_open_fd(&out, fd);
+    if (rc != ODV_OK) return rc;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);
+    rc = write_csv_sink(s, table_name, &out);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_sql_fd(ODV_SESSION *s, const char *table_name, int fd, int dbms_type)
+{
+    ODV_OUTBUF out;
+    int rc, saved_cs;
+    if (!s || fd < 0) return ODV_ERROR_INVALID_ARG;
+    rc = odv_out_open_fd(&out, fd);
+    if (rc != ODV_OK) return rc;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);
+    rc = write_sql_sink(s, table_name, &out, dbms_type);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_csv_callback(ODV_SESSION *s, const char *table_name,
+                                             ODV_WRITE_CALLBACK cb, void *user_data)
+{
+    ODV_OUTBUF out;
+    int rc, saved_cs;
+    if (!s || !cb) return ODV_ERROR_INVALID_ARG;
+    rc = odv_out_open_callback(&out, cb, user_data);
+    if (rc != ODV_OK) return rc;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);
+    rc = write_csv_sink(s, table_name, &out);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_sql_callback(ODV_SESSION *s, const char *table_name, int dbms_type,
+                                             ODV_WRITE_CALLBACK cb, void *user_data)
+{
+    ODV_OUTBUF out;
+    int rc, saved_cs;
+    if (!s || !cb) return ODV_ERROR_INVALID_ARG;
+    rc = odv_out_open_callback(&out, cb, user_data);
+    if (rc != ODV_OK) return rc;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);
+    rc = write_sql_sink(s, table_name, &out, dbms_type);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_pgcopy(ODV_SESSION *s, const char *table_name, const char *output_path, int binary)
+{
+    int rc, saved_cs;
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Files are always UTF-8 */
+    rc = write_pgcopy_file(s, table_name, output_path, binary);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_parquet(ODV_SESSION *s, const char *table_name, const char *output_path)
+{
+    int rc, saved_cs;
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Parquet strings are UTF-8 */
+    rc = write_parquet_file(s, table_name, output_path);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_xlsx(ODV_SESSION *s, const char *table_name, const char *output_path)
+{
+    int rc, saved_cs;
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Workbook XML is UTF-8 */
+    rc = write_xlsx_file(s, table_name, output_path);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_export_arrow(ODV_SESSION *s, const char *table_name, int batch_rows,
+                                      ODV_ARROW_CALLBACK cb, void *user_data)
+{
+    int rc, saved_cs;
+    if (!s || !cb) return ODV_ERROR_INVALID_ARG;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Arrow strings are UTF-8 */
+    rc = write_arrow_batches(s, table_name, batch_rows, cb, user_data);
+    set_out_charset(s, saved_cs);
+    return rc;
+}
+
+ODV_API int ODV_CALL odv_add_tee_output(ODV_SESSION *s, int format, const char *output_path, int option)
+{
+    ODV_TEE_OUTPUT *o;
+    if (!s || !output_path || !output_path[0]) return ODV_ERROR_INVALID_ARG;
+    if (format != ODV_TEE_CSV && format != ODV_TEE_SQL && format != ODV_TEE_PARQUET &&
+        format != ODV_TEE_XLSX)
+        return ODV_ERROR_INVALID_ARG;
+    if (s->tee_count >= ODV_MAX_TEE) {
+        set_error(s, "Too many tee outputs");
+        return ODV_ERROR_INVALID_ARG;
+    }
+    o = &s->tee_outputs[s->tee_count++];
+    o->format = format;
+    o->option = (format == ODV_TEE_SQL) ? option : 0;
+    odv_strcpy(o->path, output_path, ODV_PATH_LEN - 1);
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_clear_tee_outputs(ODV_SESSION *s)
+{
+    if (!s) return ODV_ERROR_INVALID_ARG;
+    s->tee_count = 0;
+    return ODV_OK;
+}
+
+ODV_API int ODV_CALL odv_export_tee(ODV_SESSION *s, const char *table_name, int threaded)
+{
+    int rc, saved_cs;
+    if (!s) return ODV_ERROR_INVALID_ARG;
+    saved_cs = set_out_charset(s, CHARSET_UTF8);   /* Files are always UTF-8 */
+    rc = write_tee(s, table_name, threaded);
+    set_out_charset(s, saved_cs);
+    return rc;
 }
 
 /*---------------------------------------------------------------------------
@@ -406,7 +745,7 @@ int odv_lob_check_column(ODV_SESSION *s)
         return ODV_OK;
 
     for (i = 0; i < s->table.col_count; i++) {
-        int t = s->table.columns[i].type;
+        int t = s->table.desc[i].type;
         if (t == COL_BLOB || t == COL_CLOB || t == COL_NCLOB) {
             if (odv_stricmp(s->table.columns[i].name, s->lob_column) == 0) {
                 s->lob_column_index = lob_idx;
@@ -542,6 +881,74 @@ void odv_lob_reset_buffer(ODV_SESSION *s)
     s->state.lob_buf_alloc = 0;
 }
 
+/*---------------------------------------------------------------------------
+    Row Checkpoint Helpers
+ ---------------------------------------------------------------------------*/
+
+/* Record a checkpoint at the current record boundary of the table being
+   scanned.  st is the EXPDP parse state (NULL for EXP). */
+int odv_ckpt_add(ODV_SESSION *s, FILE *fp, const ODV_PARSE_STATE *st)
+{
+    ODV_ROW_CHECKPOINT *cp;
+
+    if (s->ckpt_count >= s->ckpt_alloc) {
+        int new_alloc = s->ckpt_alloc ? s->ckpt_alloc * 2 : 64;
+        ODV_ROW_CHECKPOINT *nb = (ODV_ROW_CHECKPOINT *)realloc(
+            s->ckpt_buf, (size_t)new_alloc * sizeof(ODV_ROW_CHECKPOINT));
+        if (!nb) return ODV_ERROR_MALLOC;
+        s->ckpt_buf = nb;
+        s->ckpt_alloc = new_alloc;
+    }
+
+    cp = &s->ckpt_buf[s->ckpt_count++];
+    cp->row_no = s->table.record_count;
+    cp->offset = odv_ftell(fp);
+    cp->seg_remaining     = st ? st->seg_remaining : 0;
+    cp->is_between_record = st ? st->is_between_record : 0;
+    cp->filler_length     = st ? st->filler_length : 0;
+    return ODV_OK;
+}
+
+/* Move the collected checkpoints to a table_list entry */
+void odv_ckpt_attach(ODV_SESSION *s, ODV_TABLE_ENTRY *e)
+{
+    free(e->checkpoints);
+    e->checkpoints = NULL;
+    e->checkpoint_count = 0;
+
+    if (s->ckpt_count > 0) {
+        size_t sz = (size_t)s->ckpt_count * sizeof(ODV_ROW_CHECKPOINT);
+        e->checkpoints = (ODV_ROW_CHECKPOINT *)malloc(sz);
+        if (e->checkpoints) {
+            memcpy(e->checkpoints, s->ckpt_buf, sz);
+            e->checkpoint_count = s->ckpt_count;
+        }
+    }
+    s->ckpt_count = 0;
+}
+
+/* Apply a pending odv_seek_row request at the start of a table's records.
+   Returns 1 if the file was repositioned to a checkpoint, 0 otherwise. */
+int odv_ckpt_resume(ODV_SESSION *s, FILE *fp, ODV_PARSE_STATE *st)
+{
+    const ODV_ROW_CHECKPOINT *cp = &s->seek_ckpt;
+
+    if (!s->seek_active) return 0;
+    s->seek_active = 0;
+    s->skip_rows = s->seek_row - cp->row_no;
+
+    if (cp->offset <= 0) return 0;   /* No checkpoint: parse from table start */
+
+    odv_fseek(fp, cp->offset, SEEK_SET);
+    s->table.record_count = cp->row_no;
+    if (st) {
+        st->seg_remaining     = cp->seg_remaining;
+        st->is_between_record = cp->is_between_record;
+        st->filler_length     = cp->filler_length;
+    }
+    return 1;
+}
+
 /*---------------------------------------------------------------------------
     LOB Extraction API
  ---------------------------------------------------------------------------*/
@@ -555,11 +962,14 @@ ODV_API int ODV_CALL odv_extract_lob(
     const char *extension,
     int64_t data_offset)
 {
-    int rc;
+    int rc, saved_cs;
 
     if (!s || !table || !lob_column || !output_dir)
         return ODV_ERROR_INVALID_ARG;
 
+    /* File names are taken from decoded values: decode to UTF-8 */
+    saved_cs = set_out_charset(s, CHARSET_UTF8);
+
     /* Configure LOB extraction */
     s->lob_extract_mode = 1;
     odv_strcpy(s->lob_column, lob_column, ODV_OBJNAME_LEN);
@@ -593,29 +1003,14 @@ ODV_API int ODV_CALL odv_extract_lob(
     odv_lob_reset_buffer(s);
 
     /* Run the parse (LOB accumulation happens inside parse_*_dump) */
-    switch (s->dump_type) {
-    case DUMP_EXPDP:
-        rc = parse_expdp_dump(s, 0);
-        break;
-    case DUMP_EXPDP_COMPRESS:
-        set_error(s, "Compressed EXPDP dumps are not supported.");
-        rc = ODV_ERROR_UNSUPPORTED;
-        break;
-    case DUMP_EXP:
-    case DUMP_EXP_DIRECT:
-        rc = parse_exp_dump(s, 0);
-        break;
-    default:
-        set_error(s, "Unknown or unsupported dump format");
-        rc = ODV_ERROR_FORMAT;
-        break;
-    }
+    rc = odv_run_parse(s, 0);
 
 cleanup:
     /* Always clean up LOB state regardless of success/failure */
     s->lob_extract_mode = 0;
     s->lob_column_index = -1;
     odv_lob_reset_buffer(s);
+    set_out_charset(s, saved_cs);
 
     return rc;
 }
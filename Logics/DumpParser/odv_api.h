@@ -52,6 +52,12 @@ typedef struct _odv_session ODV_SESSION;
 #define ODV_DUMP_EXP              10
 #define ODV_DUMP_EXP_DIRECT       11
 
+/*---------------------------------------------------------------------------
+    Output Charset Constants (odv_set_output_charset)
+ ---------------------------------------------------------------------------*/
+#define ODV_CHARSET_UTF8           0
+#define ODV_CHARSET_UTF16LE        1
+
 /*---------------------------------------------------------------------------
     Return Codes
  ---------------------------------------------------------------------------*/
@@ -73,6 +79,20 @@ typedef void (ODV_CALL *ODV_ROW_CALLBACK)(
     void *user_data
 );
 
+/* Row data delivery callback with explicit value lengths.
+   col_lengths[i] is the byte length of col_values[i], or -1 for NULL.
+   Values are not copied for delivery: the pointers are only valid until
+   the callback returns. */
+typedef void (ODV_CALL *ODV_ROW_SPAN_CALLBACK)(
+    const char *schema,
+    const char *table,
+    int col_count,
+    const char **col_names,
+    const char **col_values,
+    const int *col_lengths,
+    void *user_data
+);
+
 /* Progress notification callback
    rows_processed: total rows processed so far
    current_table:  name of the table currently being parsed
@@ -85,6 +105,17 @@ typedef void (ODV_CALL *ODV_PROGRESS_CALLBACK)(
     void *user_data
 );
 
+/* Export output callback (odv_export_csv_callback / odv_export_sql_callback)
+   data, len:  the next block of output, up to 1MB (compressed when
+               odv_set_output_compression is set)
+   Returns the number of bytes consumed (1..len; the rest is offered
+   again), or 0 / a negative value to abort the export. */
+typedef int (ODV_CALL *ODV_WRITE_CALLBACK)(
+    const void *data,
+    int len,
+    void *user_data
+);
+
 /* Table discovery callback (called per table during list_tables)
    data_offset: file position of the table DDL, usable with odv_set_data_offset
    for fast seeking on subsequent parse_dump calls. */
@@ -103,6 +134,68 @@ typedef void (ODV_CALL *ODV_TABLE_CALLBACK)(
     void *user_data
 );
 
+/*---------------------------------------------------------------------------
+    Arrow C Data Interface
+    https://arrow.apache.org/docs/format/CDataInterface.html
+    The ABI-stable structs from the specification, so that consumers can
+    take decoded batches (odv_export_arrow) without Arrow headers here.
+ ---------------------------------------------------------------------------*/
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    /* Array type description */
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+
+    /* Release callback */
+    void (*release)(struct ArrowSchema *);
+    /* Opaque producer-specific data */
+    void *private_data;
+};
+
+struct ArrowArray {
+    /* Array data description */
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+
+    /* Release callback */
+    void (*release)(struct ArrowArray *);
+    /* Opaque producer-specific data */
+    void *private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+/* Arrow batch delivery callback (odv_export_arrow)
+   arrow_schema: the table as a struct ("+s") with one nullable child per column
+   batch:        struct array of the next rows of that table
+   Both structs are only valid during the call.  To keep them, move them
+   (copy the struct and set the original's release to NULL, as Arrow
+   importers do); whatever is left unreleased is released on return. */
+typedef void (ODV_CALL *ODV_ARROW_CALLBACK)(
+    const char *schema,
+    const char *table,
+    struct ArrowSchema *arrow_schema,
+    struct ArrowArray *batch,
+    void *user_data
+);
+
 /*---------------------------------------------------------------------------
     Session Lifecycle
  ---------------------------------------------------------------------------*/
@@ -116,6 +209,9 @@ ODV_API int ODV_CALL odv_destroy_session(ODV_SESSION *session);
 
 ODV_API int ODV_CALL odv_set_dump_file(ODV_SESSION *s, const char *path);
 ODV_API int ODV_CALL odv_set_row_callback(ODV_SESSION *s, ODV_ROW_CALLBACK cb, void *user_data);
+/* Set span row callback (used instead of the row callback when set).
+   Pass NULL to go back to the plain row callback. */
+ODV_API int ODV_CALL odv_set_row_span_callback(ODV_SESSION *s, ODV_ROW_SPAN_CALLBACK cb, void *user_data);
 ODV_API int ODV_CALL odv_set_progress_callback(ODV_SESSION *s, ODV_PROGRESS_CALLBACK cb, void *user_data);
 ODV_API int ODV_CALL odv_set_table_callback(ODV_SESSION *s, ODV_TABLE_CALLBACK cb, void *user_data);
 
@@ -147,6 +243,74 @@ ODV_API int ODV_CALL odv_set_csv_options(ODV_SESSION *s, int write_header, int w
 ODV_API int ODV_CALL odv_set_sql_options(ODV_SESSION *s, int create_table,
                                           int create_index, int write_comments);
 
+/* Set SQL export batching.
+   rows_per_statement: rows per INSERT statement (default 1 = one per row).
+                       >1 writes multi-row VALUES lists (PostgreSQL, MySQL,
+                       SQL Server; at most 1000 rows for SQL Server) or
+                       INSERT ALL (Oracle).
+   commit_rows:        wrap the rows in transactions and COMMIT every
+                       commit_rows rows; 0 = no transaction control (default) */
+ODV_API int ODV_CALL odv_set_sql_batch(ODV_SESSION *s, int rows_per_statement, int commit_rows);
+
+/* Set Parquet export options.
+   row_group_rows: rows per row group (0 = default 131072); a row group is
+                   also closed once its buffered values reach 128MB
+   compression:    0 = none, 1 = Snappy (default)
+   dictionary:     1 = dictionary-encode columns whose distinct values
+                   fit in 1MB (default), 0 = PLAIN only */
+ODV_API int ODV_CALL odv_set_parquet_options(ODV_SESSION *s, int row_group_rows, int compression, int dictionary);
+
+/* Set compression of CSV, SQL and PostgreSQL COPY output files.
+   codec:   0 = none (default), 1 = gzip, 2 = zstd.  Every 1MB of output
+            is compressed as an independent gzip member / zstd frame, so
+            the file is one ordinary .gz / .zst stream.
+   level:   1 (fastest) .. 9 (smallest), 0 = codec default (gzip 6, zstd 3)
+   threads: compressing threads, 0 = one per CPU (default), 1 = compress
+            on the exporting thread */
+ODV_API int ODV_CALL odv_set_output_compression(ODV_SESSION *s, int codec, int level, int threads);
+
+/* Split CSV and SQL output into parts.
+   max_bytes: start a new part once the current one holds max_bytes bytes
+              (counted before compression); 0 = no limit (default)
+   max_rows:  start a new part every max_rows rows; 0 = no limit (default)
+   Parts are numbered from 1: "t.csv" -> "t_0001.csv", "t_0002.csv", ...
+   ("t.csv.gz" -> "t_0001.csv.gz").  Every CSV part repeats the header
+   rows, every SQL part starts with its own comment header and closes its
+   statements and transaction.  CREATE TABLE goes to the first part,
+   CREATE INDEX / COMMENT ON to the last part of the first file.  A limit
+   is checked between rows, so a part may end a little past max_bytes. */
+ODV_API int ODV_CALL odv_set_output_split(ODV_SESSION *s, int64_t max_bytes, int64_t max_rows);
+
+/* Hash-shard CSV and SQL output rows over several files.
+   shards:      number of files, 0 or 1 = no sharding (default), max 256.
+                Files are named "t_0001.csv" .. "t_<shards>.csv", or
+                "t_0001_0001.csv" when combined with odv_set_output_split.
+   key_columns: comma-separated column names to hash, so rows with equal
+                keys land in the same file; NULL or "" = the primary key
+                when the dump declares it before the rows, else the
+                whole row */
+ODV_API int ODV_CALL odv_set_output_shards(ODV_SESSION *s, int shards, const char *key_columns);
+
+/* Set row checkpoint interval for odv_seek_row.
+   list_tables records a resume point every `rows` rows of each table.
+   Pass 0 to disable (default: 10000). */
+ODV_API int ODV_CALL odv_set_checkpoint_interval(ODV_SESSION *s, int rows);
+
+/* Set maximum number of rows delivered per parse / seek (0 = unlimited).
+   The parse stops and returns ODV_OK once the limit is reached.
+   Paging setting only: applies to odv_parse_dump and odv_seek_row; the
+   CSV / SQL / Parquet / Arrow / XLSX exports always write every row. */
+ODV_API int ODV_CALL odv_set_row_limit(ODV_SESSION *s, int64_t max_rows);
+
+/* Set the encoding of row values and of the schema/table/column names
+   passed to the row callbacks.
+   charset: ODV_CHARSET_UTF8 (default) or ODV_CHARSET_UTF16LE.
+   UTF-16LE is meant for the span callback: values are length-prefixed
+   (col_lengths in bytes) and not NUL-terminated; names end with two zero
+   bytes.  The table list, table callback, filters, progress callback and
+   CSV/SQL exports stay UTF-8. */
+ODV_API int ODV_CALL odv_set_output_charset(ODV_SESSION *s, int charset);
+
 /* Set application version string (displayed in export comments).
    ver: UTF-8 version string e.g. "1.1.0". Pass NULL to clear. */
 ODV_API int ODV_CALL odv_set_app_version(ODV_SESSION *s, const char *ver);
@@ -176,6 +340,12 @@ ODV_API int ODV_CALL odv_get_table_entry(ODV_SESSION *s, int index,
 /* Parse all data (fires row_callback per row, progress_callback periodically) */
 ODV_API int ODV_CALL odv_parse_dump(ODV_SESSION *s);
 
+/* Deliver rows of one table starting at row_no (0-based).
+   table_index: index as for odv_get_table_entry (list_tables must be called first).
+   Resumes from the nearest row checkpoint instead of re-reading the table
+   from its start. Combine with odv_set_row_limit for paging. */
+ODV_API int ODV_CALL odv_seek_row(ODV_SESSION *s, int table_index, int64_t row_no);
+
 /* Set CSV field delimiter character (default: ',')
    Common values: ',' (comma), '\t' (tab), ';' (semicolon), '|' (pipe) */
 ODV_API void ODV_CALL odv_set_csv_delimiter(ODV_SESSION *s, char delimiter);
@@ -187,6 +357,78 @@ ODV_API int ODV_CALL odv_export_csv(ODV_SESSION *s, const char *table_name, cons
    dbms_type: 0=Oracle, 4=PostgreSQL, 5=MySQL, 6=SQL Server */
 ODV_API int ODV_CALL odv_export_sql(ODV_SESSION *s, const char *table_name, const char *output_path, int dbms_type);
 
+/* Export a table as CSV / SQL INSERTs to an open file descriptor: a pipe
+   into psql, mysql, bcp or a compressor, a socket, or stdout (1).  The
+   descriptor is not closed; flush any stdio buffering on it first.
+   Output goes in 1MB writes; a full pipe blocks the export until the
+   reader catches up (a non-blocking descriptor is polled).  When the
+   reader goes away the export stops and returns -105 (EPIPE); SIGPIPE
+   is not raised.  Output splitting and sharding do not apply.
+   On Windows the descriptor is switched to binary mode. */
+ODV_API int ODV_CALL odv_export_csv_fd(ODV_SESSION *s, const char *table_name, int fd);
+ODV_API int ODV_CALL odv_export_sql_fd(ODV_SESSION *s, const char *table_name, int fd, int dbms_type);
+
+/* Export a table as CSV / SQL INSERTs through a write callback (see
+   ODV_WRITE_CALLBACK), called on the exporting thread. */
+ODV_API int ODV_CALL odv_export_csv_callback(ODV_SESSION *s, const char *table_name,
+                                             ODV_WRITE_CALLBACK cb, void *user_data);
+ODV_API int ODV_CALL odv_export_sql_callback(ODV_SESSION *s, const char *table_name, int dbms_type,
+                                             ODV_WRITE_CALLBACK cb, void *user_data);
+
+/* Export for PostgreSQL COPY (much faster to load than INSERTs)
+   binary: 0 = psql script: CREATE TABLE (odv_set_sql_options) and
+               COPY ... FROM stdin text blocks, one per table
+           1 = PGCOPY binary file of one table, with NUMBER as numeric,
+               DATE/TIMESTAMP as timestamp and RAW/BLOB as bytea, plus
+               "<output_path>.sql" holding the DDL and a \copy command */
+ODV_API int ODV_CALL odv_export_pgcopy(ODV_SESSION *s, const char *table_name, const char *output_path, int binary);
+
+/* Export a table to an Apache Parquet file (one table per file).
+   NUMBER(p,s) becomes INT64 / DECIMAL, NUMBER without precision and FLOAT
+   become DOUBLE, DATE/TIMESTAMP become TIMESTAMP(MICROS), RAW/BLOB become
+   binary and character types (including CLOB) UTF-8 strings.
+   Options: odv_set_parquet_options */
+ODV_API int ODV_CALL odv_export_parquet(ODV_SESSION *s, const char *table_name, const char *output_path);
+
+/* Export to an Excel workbook (.xlsx), streamed with flat memory use.
+   table_name: table to export, or NULL/"" for every table (a sheet each)
+   Each sheet has a bold header row and holds at most 1,048,576 rows;
+   longer tables continue on "NAME (2)", "NAME (3)", ...
+   NUMBER/FLOAT (up to 15 significant digits) and BINARY_FLOAT/DOUBLE
+   become numbers, DATE/TIMESTAMP date cells (1900-03-01 .. 9999-12-31);
+   other values are text as in the CSV output. */
+ODV_API int ODV_CALL odv_export_xlsx(ODV_SESSION *s, const char *table_name, const char *output_path);
+
+/* Deliver decoded rows as Arrow C Data Interface batches (no files).
+   table_name: table to export, or NULL/"" for every table
+   batch_rows: rows per batch (0 = 65536); a batch is also delivered early
+               once its string/binary data reaches 64MB
+   Columns map as in odv_export_parquet (NUMBER(p,0) with p <= 18 as int64,
+   other NUMBER(p,s) as decimal128), plus INTERVAL YEAR TO MONTH as
+   interval[months] and INTERVAL DAY TO SECOND as interval[month_day_nano].
+   Call odv_cancel from the callback to stop early. */
+ODV_API int ODV_CALL odv_export_arrow(ODV_SESSION *s, const char *table_name, int batch_rows,
+                                      ODV_ARROW_CALLBACK cb, void *user_data);
+
+/* Add an output file for odv_export_tee (at most 8).
+   format: 0 = CSV, 1 = SQL INSERTs, 2 = Parquet, 3 = Excel
+   option: SQL dialect (dbms_type as in odv_export_sql), else 0
+   The CSV / SQL / Parquet options and output compression, splitting and
+   sharding of the plain exports apply to each output. */
+ODV_API int ODV_CALL odv_add_tee_output(ODV_SESSION *s, int format, const char *output_path, int option);
+
+/* Remove every output added with odv_add_tee_output */
+ODV_API int ODV_CALL odv_clear_tee_outputs(ODV_SESSION *s);
+
+/* Export a table to every added output in a single parse of the dump.
+   Each file is the same as exporting it on its own.
+   threaded: 1 = one writer thread per output; the parser runs ahead of
+             the slowest writer by up to 8 batches of 1024 rows / 1MB
+   A failing output stops being written while the others go on; the
+   parse stops once every output has failed.  Returns the parse error,
+   else the first output's error. */
+ODV_API int ODV_CALL odv_export_tee(ODV_SESSION *s, const char *table_name, int threaded);
+
 /* Extract LOB column data to individual files.
    schema/table: target table (UTF-8)
    lob_column:   name of the BLOB/CLOB/NCLOB column to extract
@@ -0,0 +1,640 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_arrow.c
+    Arrow C Data Interface batches
+
+    Decodes rows straight into Arrow columnar buffers (validity bitmap,
+    fixed-width values or int32 offsets + data) and hands each batch to
+    the caller as an ArrowSchema / ArrowArray pair.  Buffers are moved,
+    not copied: every batch owns its memory and frees it in its release
+    callbacks, so consumers can import it zero-copy.
+
+    Oracle types map to:
+      NUMBER(p<=18, s<=0)  int64 ("l")
+      NUMBER(p<=38, s)     decimal128 ("d:p,s")
+      NUMBER, FLOAT        float64 ("g")   (no precision / binary precision)
+      BINARY_FLOAT/DOUBLE  float32 / float64
+      DATE, TIMESTAMP      timestamp[us] ("tsu:"), "tsu:UTC" WITH [LOCAL] TIME ZONE
+      INTERVAL YM / DS     interval[months] / interval[month_day_nano]
+      RAW, BLOB, LONG RAW  binary ("z")
+      others (CHAR, CLOB)  utf8 ("u")
+
+    Arrow buffers are native-endian; values are stored as native types.
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+#include "odv_api.h"
+
+#define AR_BATCH_ROWS     65536               /* Default rows per batch */
+#define AR_BATCH_BYTES    (64 * 1024 * 1024)  /* Batch delivered early past this */
+#define AR_INITIAL_ROWS   1024                /* First buffer allocation */
+
+/* How a column's values are produced */
+#define AK_INT64        0
+#define AK_DECIMAL      1
+#define AK_DOUBLE       2
+#define AK_FLOAT        3
+#define AK_TIMESTAMP    4
+#define AK_INTERVAL_YM  5
+#define AK_INTERVAL_DS  6
+#define AK_STRING       7
+#define AK_BINARY       8
+
+typedef struct {
+    int            kind;          /* AK_* */
+    int            width;         /* Value bytes; 0 = offsets + data */
+    int            scale;         /* AK_DECIMAL */
+    char           format[24];    /* Arrow format string */
+    unsigned char *validity;      /* Bitmap, 1 = valid */
+    unsigned char *values;        /* Fixed-width values, or int32 offsets */
+    unsigned char *data;          /* Variable-length bytes */
+    size_t         data_len;
+    size_t         data_cap;
+    int64_t        null_count;
+} AR_COLUMN;
+
+typedef struct {
+    ODV_SESSION       *session;
+    const char        *target_table;
+    ODV_ARROW_CALLBACK cb;
+    void              *cb_ud;
+    int                batch_rows;
+    char               schema[ODV_OBJNAME_LEN + 1];
+    char               table[ODV_OBJNAME_LEN + 1];
+    int                started;
+    int                col_count;
+    AR_COLUMN         *cols;
+    char             **names;
+    int                rows;          /* Rows in the current batch */
+    int                cap;           /* Rows the buffers hold */
+    size_t             var_bytes;     /* Variable-length data in the batch */
+    int64_t            total_rows;
+    int                rc;
+} AR_CONTEXT;
+
+/*---------------------------------------------------------------------------
+    Release callbacks
+
+    Every child owns its buffers (or strings), so a consumer may move
+    children out of a batch and release them separately.  The parent
+    block only holds the child structs and pointer arrays.
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    const void *buffers[3];
+} AR_ARRAY_PRIVATE;
+
+static void ar_release_column_array(struct ArrowArray *a)
+{
+    AR_ARRAY_PRIVATE *p = (AR_ARRAY_PRIVATE *)a->private_data;
+    int i;
+    for (i = 0; i < 3; i++) free((void *)p->buffers[i]);
+    free(p);
+    a->release = NULL;
+}
+
+static void ar_release_struct_array(struct ArrowArray *a)
+{
+    int64_t i;
+    for (i = 0; i < a->n_children; i++) {
+        if (a->children[i]->release) a->children[i]->release(a->children[i]);
+    }
+    free(a->private_data);
+    a->release = NULL;
+}
+
+static void ar_release_column_schema(struct ArrowSchema *sc)
+{
+    free(sc->private_data);     /* format and name */
+    sc->release = NULL;
+}
+
+static void ar_release_struct_schema(struct ArrowSchema *sc)
+{
+    int64_t i;
+    for (i = 0; i < sc->n_children; i++) {
+        if (sc->children[i]->release) sc->children[i]->release(sc->children[i]);
+    }
+    free(sc->private_data);
+    sc->release = NULL;
+}
+
+/*---------------------------------------------------------------------------
+    Column mapping
+ ---------------------------------------------------------------------------*/
+static void ar_map_column(AR_CONTEXT *ctx, int i, AR_COLUMN *c)
+{
+    ODV_SESSION *s = ctx->session;
+    int type = (i < s->table.col_count) ? s->table.desc[i].type : COL_VARCHAR;
+    int raw = (i < s->table.col_count) && s->plan.kernel[i] == KERN_RAW;
+    int prec, scale;
+
+    c->kind = AK_STRING;
+    if (raw) {
+        switch (type) {
+        case COL_NUMBER:
+            if (!odv_number_type(s->table.columns[i].type_str, &prec, &scale)) {
+                c->kind = AK_DOUBLE;
+            } else if (scale == 0 && prec <= 18) {
+                c->kind = AK_INT64;
+            } else {
+                c->kind = AK_DECIMAL;
+                c->scale = scale;
+                snprintf(c->format, sizeof(c->format), "d:%d,%d", prec, scale);
+            }
+            break;
+        case COL_FLOAT:
+        case COL_BIN_DOUBLE:    c->kind = AK_DOUBLE;      break;
+        case COL_BIN_FLOAT:     c->kind = AK_FLOAT;       break;
+        case COL_DATE:
+        case COL_TIMESTAMP:
+        case COL_TIMESTAMP_TZ:
+        case COL_TIMESTAMP_LTZ: c->kind = AK_TIMESTAMP;   break;
+        case COL_INTERVAL_YM:   c->kind = AK_INTERVAL_YM; break;
+        case COL_INTERVAL_DS:   c->kind = AK_INTERVAL_DS; break;
+        default:                break;
+        }
+    }
+    if (type == COL_RAW || type == COL_BLOB || type == COL_LONG_RAW) c->kind = AK_BINARY;
+
+    switch (c->kind) {
+    case AK_INT64:       c->width = 8;  strcpy(c->format, "l");  break;
+    case AK_DECIMAL:     c->width = 16; break;
+    case AK_DOUBLE:      c->width = 8;  strcpy(c->format, "g");  break;
+    case AK_FLOAT:       c->width = 4;  strcpy(c->format, "f");  break;
+    case AK_TIMESTAMP:
+        c->width = 8;
+        strcpy(c->format, (type == COL_TIMESTAMP_TZ || type == COL_TIMESTAMP_LTZ) ? "tsu:UTC" : "tsu:");
+        break;
+    case AK_INTERVAL_YM: c->width = 4;  strcpy(c->format, "tiM"); break;
+    case AK_INTERVAL_DS: c->width = 16; strcpy(c->format, "tin"); break;
+    case AK_BINARY:      c->width = 0;  strcpy(c->format, "z");  break;
+    default:             c->width = 0;  strcpy(c->format, "u");  break;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    Batch buffers
+ ---------------------------------------------------------------------------*/
+
+/* Grows every column to hold at least rows + 1 values */
+static int ar_reserve_rows(AR_CONTEXT *ctx)
+{
+    int cap, i;
+
+    if (ctx->rows < ctx->cap) return ODV_OK;
+    cap = ctx->cap ? ctx->cap * 2 : AR_INITIAL_ROWS;
+    if (cap > ctx->batch_rows) cap = ctx->batch_rows;
+
+    for (i = 0; i < ctx->col_count; i++) {
+        AR_COLUMN *c = &ctx->cols[i];
+        size_t old_bitmap = ((size_t)ctx->cap + 7) / 8, bitmap = ((size_t)cap + 7) / 8;
+        size_t value_bytes = c->width ? (size_t)cap * c->width : ((size_t)cap + 1) * 4;
+        unsigned char *v = (unsigned char *)realloc(c->validity, bitmap);
+        if (!v) return ODV_ERROR_MALLOC;
+        memset(v + old_bitmap, 0, bitmap - old_bitmap);
+        c->validity = v;
+        v = (unsigned char *)realloc(c->values, value_bytes);
+        if (!v) return ODV_ERROR_MALLOC;
+        if (ctx->cap == 0 && !c->width) memset(v, 0, 4);    /* offsets[0] */
+        c->values = v;
+    }
+    ctx->cap = cap;
+    return ODV_OK;
+}
+
+/* Appends n bytes of variable-length data; returns where they go */
+static unsigned char *ar_grow_data(AR_COLUMN *c, size_t n)
+{
+    if (!c->data || c->data_len + n > c->data_cap) {
+        size_t cap = c->data_cap ? c->data_cap : 65536;
+        unsigned char *np;
+        while (cap < c->data_len + n) cap *= 2;
+        np = (unsigned char *)realloc(c->data, cap);
+        if (!np) return NULL;
+        c->data = np;
+        c->data_cap = cap;
+    }
+    c->data_len += n;
+    return c->data + c->data_len - n;
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/*---------------------------------------------------------------------------
+    ar_put_value
+
+    Stores one non-null value of row ctx->rows.  Returns ODV_OK, or an
+    error for a value that is stored as NULL (ODV_ERROR_MALLOC aborts).
+ ---------------------------------------------------------------------------*/
+static int ar_put_value(AR_CONTEXT *ctx, int col, const char *val, int len)
+{
+    AR_COLUMN *c = &ctx->cols[col];
+    const unsigned char *data = (const unsigned char *)val;
+    const ODV_COLDESC *d = &ctx->session->table.desc[col];
+    unsigned char *slot = c->values + (size_t)ctx->rows * c->width;
+    char tmp[ODV_NUMBER_STR_LEN];
+    unsigned char dec[16];
+    int k;
+
+    switch (c->kind) {
+    case AK_INT64: {
+        uint64_t u = 0;
+        int64_t iv;
+        /* Up to 18 digits directly; the rest through the 128-bit path */
+        if (odv_number_to_int64(data, len, &iv) == ODV_OK) {
+            memcpy(slot, &iv, 8);
+            return ODV_OK;
+        }
+        if (odv_number_scaled(data, len, 0, dec) != ODV_OK) return ODV_ERROR_FORMAT;
+        for (k = 8; k < 16; k++)
+            if (dec[k] != ((dec[7] & 0x80) ? 0xFF : 0x00)) return ODV_ERROR_FORMAT;
+        for (k = 7; k >= 0; k--) u = (u << 8) | dec[k];
+        memcpy(slot, &u, 8);
+        return ODV_OK;
+    }
+    case AK_DECIMAL: {
+        uint64_t lo = 0, hi = 0;
+        if (odv_number_scaled(data, len, c->scale, dec) != ODV_OK) return ODV_ERROR_FORMAT;
+        for (k = 7; k >= 0; k--) {
+            lo = (lo << 8) | dec[k];
+            hi = (hi << 8) | dec[k + 8];
+        }
+        memcpy(slot, &lo, 8);       /* Low word first (little-endian targets) */
+        memcpy(slot + 8, &hi, 8);
+        return ODV_OK;
+    }
+    case AK_DOUBLE: {
+        double dv;
+        if (d->type == COL_BIN_DOUBLE) {
+            uint64_t bits;
+            if (len < 8) return ODV_ERROR_FORMAT;
+            bits = oracle_ieee_bits(data, 8);
+            memcpy(&dv, &bits, 8);
+        } else {
+            if (decode_oracle_number(data, len, tmp, sizeof(tmp)) <= 0) return ODV_ERROR_FORMAT;
+            dv = strtod(tmp, NULL);
+        }
+        memcpy(slot, &dv, 8);
+        return ODV_OK;
+    }
+    case AK_FLOAT: {
+        uint32_t bits;
+        if (len < 4) return ODV_ERROR_FORMAT;
+        bits = (uint32_t)oracle_ieee_bits(data, 4);
+        memcpy(slot, &bits, 4);
+        return ODV_OK;
+    }
+    case AK_TIMESTAMP: {
+        int64_t us;
+        if (odv_datetime_to_unix_us(data, len, d->precision, &us) != ODV_OK)
+            return ODV_ERROR_FORMAT;
+        memcpy(slot, &us, 8);
+        return ODV_OK;
+    }
+    case AK_INTERVAL_YM:
+    case AK_INTERVAL_DS: {
+        int32_t months, days;
+        int64_t us, ns;
+        if (odv_interval_parts(data, len, c->kind == AK_INTERVAL_YM, &months, &days, &us) != ODV_OK)
+            return ODV_ERROR_FORMAT;
+        if (c->kind == AK_INTERVAL_YM) {
+            memcpy(slot, &months, 4);
+            return ODV_OK;
+        }
+        ns = us * 1000;
+        memcpy(slot, &months, 4);
+        memcpy(slot + 4, &days, 4);
+        memcpy(slot + 8, &ns, 8);
+        return ODV_OK;
+    }
+    case AK_BINARY:
+        if (ctx->session->plan.kernel[col] != KERN_RAW) {
+            /* Hex preview (BLOB, LONG RAW); placeholders become NULL */
+            unsigned char *out;
+            if (len <= 0 || (len & 1)) return ODV_ERROR_FORMAT;
+            for (k = 0; k < len; k++)
+                if (hex_value(val[k]) < 0) return ODV_ERROR_FORMAT;
+            out = ar_grow_data(c, (size_t)len / 2);
+            if (!out) return ODV_ERROR_MALLOC;
+            for (k = 0; k < len; k += 2)
+                out[k / 2] = (unsigned char)(hex_value(val[k]) << 4 | hex_value(val[k + 1]));
+            break;
+        }
+        /* RAW: the bytes themselves */
+        {
+            unsigned char *out = ar_grow_data(c, (size_t)len);
+            if (!out) return ODV_ERROR_MALLOC;
+            if (len > 0) memcpy(out, val, (size_t)len);
+        }
+        break;
+    default: {
+        unsigned char *out = ar_grow_data(c, (size_t)len);
+        if (!out) return ODV_ERROR_MALLOC;
+        if (len > 0) memcpy(out, val, (size_t)len);
+        break;
+    }
+    }
+
+    if (c->data_len > INT32_MAX) return ODV_ERROR_MALLOC;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    ar_deliver
+
+    Hands the current batch to the callback as a struct array, moving the
+    column buffers into it.  The next row starts a fresh batch.
+ ---------------------------------------------------------------------------*/
+static int ar_deliver(AR_CONTEXT *ctx)
+{
+    struct ArrowSchema root_schema, *child_schemas, **schema_ptrs;
+    struct ArrowArray root_array, *child_arrays, **array_ptrs;
+    int n = ctx->col_count, i;
+
+    if (ctx->rows == 0) return ODV_OK;
+
+    /* Schema: struct of nullable columns */
+    memset(&root_schema, 0, sizeof(root_schema));
+    root_schema.private_data = calloc((size_t)(n > 0 ? n : 1),
+                                      sizeof(struct ArrowSchema) + sizeof(struct ArrowSchema *));
+    if (!root_schema.private_data) return ODV_ERROR_MALLOC;
+    schema_ptrs = (struct ArrowSchema **)root_schema.private_data;
+    child_schemas = (struct ArrowSchema *)(schema_ptrs + (n > 0 ? n : 1));
+    root_schema.format = "+s";
+    root_schema.name = "";
+    root_schema.n_children = n;
+    root_schema.children = schema_ptrs;
+    root_schema.release = ar_release_struct_schema;
+
+    for (i = 0; i < n; i++) {
+        struct ArrowSchema *cs = &child_schemas[i];
+        size_t flen = strlen(ctx->cols[i].format) + 1, nlen = strlen(ctx->names[i]) + 1;
+        char *strs = (char *)malloc(flen + nlen);
+        schema_ptrs[i] = cs;
+        if (!strs) {
+            root_schema.n_children = i;
+            root_schema.release(&root_schema);
+            return ODV_ERROR_MALLOC;
+        }
+        memcpy(strs, ctx->cols[i].format, flen);
+        memcpy(strs + flen, ctx->names[i], nlen);
+        cs->format = strs;
+        cs->name = strs + flen;
+        cs->flags = ARROW_FLAG_NULLABLE;
+        cs->release = ar_release_column_schema;
+        cs->private_data = strs;
+    }
+
+    /* Array: the column buffers move into the children */
+    memset(&root_array, 0, sizeof(root_array));
+    root_array.private_data = calloc(1, (size_t)(n > 0 ? n : 1) *
+                                        (sizeof(struct ArrowArray) + sizeof(struct ArrowArray *))
+                                        + sizeof(const void *));
+    if (!root_array.private_data) {
+        root_schema.release(&root_schema);
+        return ODV_ERROR_MALLOC;
+    }
+    array_ptrs = (struct ArrowArray **)root_array.private_data;
+    child_arrays = (struct ArrowArray *)(array_ptrs + (n > 0 ? n : 1));
+    root_array.length = ctx->rows;
+    root_array.n_buffers = 1;
+    root_array.buffers = (const void **)(child_arrays + (n > 0 ? n : 1));  /* { NULL } */
+    root_array.n_children = n;
+    root_array.children = array_ptrs;
+    root_array.release = ar_release_struct_array;
+
+    for (i = 0; i < n; i++) {
+        AR_COLUMN *c = &ctx->cols[i];
+        struct ArrowArray *ca = &child_arrays[i];
+        AR_ARRAY_PRIVATE *priv = (AR_ARRAY_PRIVATE *)calloc(1, sizeof(AR_ARRAY_PRIVATE));
+        array_ptrs[i] = ca;
+        if (!priv || (!c->width && !c->data && !ar_grow_data(c, 0))) {
+            free(priv);
+            root_array.n_children = i;
+            root_array.release(&root_array);
+            root_schema.release(&root_schema);
+            return ODV_ERROR_MALLOC;
+        }
+        if (c->null_count == 0) {
+            free(c->validity);      /* All valid: no bitmap */
+            c->validity = NULL;
+        }
+        priv->buffers[0] = c->validity;
+        priv->buffers[1] = c->values;
+        priv->buffers[2] = c->width ? NULL : c->data;
+        ca->length = ctx->rows;
+        ca->null_count = c->null_count;
+        ca->n_buffers = c->width ? 2 : 3;
+        ca->buffers = priv->buffers;
+        ca->release = ar_release_column_array;
+        ca->private_data = priv;
+
+        c->validity = NULL;
+        c->values = NULL;
+        if (!c->width) c->data = NULL;
+        c->data_len = 0;
+        c->data_cap = 0;
+        c->null_count = 0;
+    }
+
+    ctx->total_rows += ctx->rows;
+    ctx->rows = 0;
+    ctx->cap = 0;
+    ctx->var_bytes = 0;
+
+    ctx->cb(ctx->schema, ctx->table, &root_schema, &root_array, ctx->cb_ud);
+
+    /* Release whatever the callback did not take */
+    if (root_array.release) root_array.release(&root_array);
+    if (root_schema.release) root_schema.release(&root_schema);
+    return ODV_OK;
+}
+
+static void ar_free_columns(AR_CONTEXT *ctx)
+{
+    int i;
+    for (i = 0; i < ctx->col_count; i++) {
+        free(ctx->cols[i].validity);
+        free(ctx->cols[i].values);
+        free(ctx->cols[i].data);
+    }
+    free(ctx->cols);
+    free(ctx->names);
+    ctx->cols = NULL;
+    ctx->names = NULL;
+    ctx->col_count = 0;
+    ctx->rows = 0;
+    ctx->cap = 0;
+    ctx->var_bytes = 0;
+}
+
+static int ar_setup_columns(AR_CONTEXT *ctx, int col_count, const char **col_names)
+{
+    size_t name_bytes = 0;
+    int slots = col_count > 0 ? col_count : 1;
+    char *p;
+    int i;
+
+    ctx->cols = (AR_COLUMN *)calloc((size_t)slots, sizeof(AR_COLUMN));
+    for (i = 0; i < col_count; i++) name_bytes += strlen(col_names[i]) + 1;
+    ctx->names = (char **)malloc((size_t)slots * sizeof(char *) + name_bytes);
+    if (!ctx->cols || !ctx->names) return ODV_ERROR_MALLOC;
+
+    p = (char *)(ctx->names + slots);
+    for (i = 0; i < col_count; i++) {
+        size_t n = strlen(col_names[i]) + 1;
+        memcpy(p, col_names[i], n);
+        ctx->names[i] = p;
+        p += n;
+        ar_map_column(ctx, i, &ctx->cols[i]);
+    }
+    ctx->col_count = col_count;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Row callback
+ ---------------------------------------------------------------------------*/
+static void ODV_CALL ar_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    const int *col_lengths, void *user_data)
+{
+    AR_CONTEXT *ctx = (AR_CONTEXT *)user_data;
+    int i;
+
+    if (!ctx || ctx->rc != ODV_OK) return;
+    if (!schema) schema = "";
+
+    /* Filter by table name if specified */
+    if (ctx->target_table && ctx->target_table[0] != '\0') {
+        if (strcmp(table, ctx->target_table) != 0) return;
+    }
+
+    /* New table: deliver the last batch of the previous one */
+    if (!ctx->started || strcmp(schema, ctx->schema) != 0 || strcmp(table, ctx->table) != 0 ||
+        col_count != ctx->col_count) {
+        ctx->rc = ar_deliver(ctx);
+        ar_free_columns(ctx);
+        if (ctx->rc == ODV_OK) ctx->rc = ar_setup_columns(ctx, col_count, col_names);
+        ctx->started = 1;
+        odv_strcpy(ctx->schema, schema, ODV_OBJNAME_LEN);
+        odv_strcpy(ctx->table, table, ODV_OBJNAME_LEN);
+    }
+    if (ctx->rc == ODV_OK) ctx->rc = ar_reserve_rows(ctx);
+    if (ctx->rc != ODV_OK) {
+        ctx->session->cancelled = 1;
+        return;
+    }
+
+    for (i = 0; i < col_count; i++) {
+        AR_COLUMN *c = &ctx->cols[i];
+        size_t before = c->data_len;
+        int rc = (col_lengths[i] >= 0) ? ar_put_value(ctx, i, col_values[i], col_lengths[i])
+                                       : ODV_ERROR_FORMAT;
+        if (rc == ODV_ERROR_MALLOC) {
+            ctx->rc = rc;
+            ctx->session->cancelled = 1;
+            return;
+        }
+        if (rc == ODV_OK) {
+            c->validity[ctx->rows >> 3] |= (unsigned char)(1 << (ctx->rows & 7));
+        } else {
+            c->null_count++;
+            c->data_len = before;
+            if (c->width) memset(c->values + (size_t)ctx->rows * c->width, 0, (size_t)c->width);
+        }
+        if (!c->width) {
+            int32_t end = (int32_t)c->data_len;
+            memcpy(c->values + ((size_t)ctx->rows + 1) * 4, &end, 4);
+            ctx->var_bytes += c->data_len - before;
+        }
+    }
+    ctx->rows++;
+
+    if (ctx->rows >= ctx->batch_rows || ctx->var_bytes >= AR_BATCH_BYTES) {
+        ctx->rc = ar_deliver(ctx);
+        if (ctx->rc != ODV_OK) {
+            ctx->session->cancelled = 1;
+            return;
+        }
+    }
+
+    /* Report progress periodically (every 100 rows) */
+    if (ctx->session->progress_cb && ((ctx->total_rows + ctx->rows) % 100) == 0) {
+        ctx->session->progress_cb(ctx->total_rows + ctx->rows, table, ctx->session->progress_ud);
+    }
+}
+
+/*---------------------------------------------------------------------------
+    write_arrow_batches
+
+    Parses the dump and delivers each table's rows (or only table_name's)
+    to cb in Arrow batches of up to batch_rows rows.
+ ---------------------------------------------------------------------------*/
+int write_arrow_batches(ODV_SESSION *s, const char *table_name, int batch_rows,
+                        ODV_ARROW_CALLBACK cb, void *user_data)
+{
+    AR_CONTEXT ctx;
+    ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
+    void *saved_ud;
+    int saved_raw;
+    int rc = ODV_OK;
+
+    if (!s || !cb || batch_rows < 0) return ODV_ERROR_INVALID_ARG;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.session = s;
+    ctx.target_table = table_name;
+    ctx.cb = cb;
+    ctx.cb_ud = user_data;
+    ctx.batch_rows = batch_rows > 0 ? batch_rows : AR_BATCH_ROWS;
+
+    /* Save and replace row callback; keep typed columns as wire bytes */
+    saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
+    saved_ud = s->row_ud;
+    saved_raw = s->raw_values;
+    s->row_cb = NULL;
+    s->row_span_cb = ar_row_callback;
+    s->row_ud = &ctx;
+    s->raw_values = 1;
+    s->plan.valid = 0;
+
+    /* Re-parse dump */
+    s->cancelled = 0;
+    s->total_rows = 0;
+
+    /* Auto-detect dump kind if not done */
+    if (s->dump_type == DUMP_UNKNOWN)
+        rc = detect_dump_kind(s);
+
+    if (rc == ODV_OK) rc = odv_run_parse(s, 0);
+
+    /* Last batch (also after a cancel from the callback) */
+    if (ctx.rc == ODV_OK) ctx.rc = ar_deliver(&ctx);
+    if (ctx.rc != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        odv_strcpy(s->last_error, "Out of memory while building Arrow batches", ODV_MSG_LEN);
+        rc = ctx.rc;
+    }
+    ar_free_columns(&ctx);
+
+    /* Restore original callback and decode mode */
+    s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
+    s->row_ud = saved_ud;
+    s->raw_values = saved_raw;
+    s->plan.valid = 0;
+
+    return rc;
+}
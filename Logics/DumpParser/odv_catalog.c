@@ -0,0 +1,510 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_catalog.c
+    Growable table catalogs (columns, constraints, table list, scratch)
+    and the table list hash index
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+
+/*---------------------------------------------------------------------------
+    Array growth helper
+
+    Grows *arr to hold at least `needed` elements of elem_size bytes,
+    doubling from `initial`.  New elements are zero-filled.
+ ---------------------------------------------------------------------------*/
+static int grow_array(void **arr, int *alloc, int needed, size_t elem_size,
+                      int initial)
+{
+    void *p;
+    int new_alloc;
+
+    if (needed <= *alloc) return ODV_OK;
+
+    new_alloc = *alloc ? *alloc : initial;
+    while (new_alloc < needed) {
+        if (new_alloc > INT_MAX / 2) { new_alloc = needed; break; }
+        new_alloc *= 2;
+    }
+
+    p = realloc(*arr, (size_t)new_alloc * elem_size);
+    if (!p) return ODV_ERROR_MALLOC;
+
+    memset((char *)p + (size_t)*alloc * elem_size, 0,
+           (size_t)(new_alloc - *alloc) * elem_size);
+    *arr = p;
+    *alloc = new_alloc;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Current table (ODV_TABLE)
+ ---------------------------------------------------------------------------*/
+
+/* Clear the table definition for the next CREATE TABLE.
+   Column and constraint storage is kept for reuse. */
+void odv_table_reset(ODV_TABLE *t)
+{
+    ODV_COLDESC *desc = t->desc;
+    ODV_COLUMN *columns = t->columns;
+    ODV_CONSTRAINT *constraints = t->constraints;
+    int col_alloc = t->col_alloc;
+    int constraint_alloc = t->constraint_alloc;
+
+    memset(t, 0, sizeof(ODV_TABLE));
+    t->desc = desc;
+    t->columns = columns;
+    t->col_alloc = col_alloc;
+    t->constraints = constraints;
+    t->constraint_alloc = constraint_alloc;
+}
+
+void odv_table_free(ODV_TABLE *t)
+{
+    free(t->desc);
+    free(t->columns);
+    free(t->constraints);
+    memset(t, 0, sizeof(ODV_TABLE));
+}
+
+/* Return a cleared column slot at idx (metadata; the matching descriptor
+   t->desc[idx] is cleared too), growing storage as needed.
+   Returns NULL if idx exceeds ODV_MAX_COLUMNS or memory is exhausted. */
+ODV_COLUMN *odv_table_column(ODV_TABLE *t, int idx)
+{
+    ODV_COLUMN *col;
+    int desc_alloc = t->col_alloc;
+
+    if (idx < 0 || idx >= ODV_MAX_COLUMNS) return NULL;
+    if (grow_array((void **)&t->desc, &desc_alloc, idx + 1,
+                   sizeof(ODV_COLDESC), 64) != ODV_OK)
+        return NULL;
+    if (grow_array((void **)&t->columns, &t->col_alloc, idx + 1,
+                   sizeof(ODV_COLUMN), 64) != ODV_OK)
+        return NULL;
+
+    memset(&t->desc[idx], 0, sizeof(ODV_COLDESC));
+    col = &t->columns[idx];
+    memset(col, 0, sizeof(ODV_COLUMN));
+    return col;
+}
+
+/* Append a cleared constraint. Returns NULL if memory is exhausted. */
+ODV_CONSTRAINT *odv_table_add_constraint(ODV_TABLE *t)
+{
+    ODV_CONSTRAINT *c;
+
+    if (grow_array((void **)&t->constraints, &t->constraint_alloc,
+                   t->constraint_count + 1, sizeof(ODV_CONSTRAINT), 8) != ODV_OK)
+        return NULL;
+
+    c = &t->constraints[t->constraint_count++];
+    memset(c, 0, sizeof(ODV_CONSTRAINT));
+    return c;
+}
+
+/*---------------------------------------------------------------------------
+    Table list (ODV_TABLE_ENTRY)
+ ---------------------------------------------------------------------------*/
+
+/* Return a cleared entry at s->table_count (the caller increments
+   table_count once the entry is filled in).  Storage owned by a stale
+   entry in that slot is released first. */
+ODV_TABLE_ENTRY *odv_table_list_add(ODV_SESSION *s)
+{
+    ODV_TABLE_ENTRY *e;
+
+    if (grow_array((void **)&s->table_list, &s->table_alloc,
+                   s->table_count + 1, sizeof(ODV_TABLE_ENTRY), 64) != ODV_OK)
+        return NULL;
+
+    e = &s->table_list[s->table_count];
+    free(e->checkpoints);
+    free(e->meta_constraints);
+    memset(e, 0, sizeof(ODV_TABLE_ENTRY));
+    return e;
+}
+
+void odv_table_list_free(ODV_SESSION *s)
+{
+    int i;
+
+    for (i = 0; i < s->table_alloc; i++) {
+        free(s->table_list[i].checkpoints);
+        free(s->table_list[i].meta_constraints);
+    }
+    free(s->table_list);
+    s->table_list = NULL;
+    s->table_alloc = 0;
+    s->table_count = 0;
+}
+
+/* Append a constraint name to a table list entry */
+ODV_CONSTRAINT_NAME *odv_entry_add_constraint_name(ODV_TABLE_ENTRY *e)
+{
+    if (grow_array((void **)&e->meta_constraints, &e->meta_constraint_alloc,
+                   e->meta_constraint_count + 1, sizeof(ODV_CONSTRAINT_NAME),
+                   4) != ODV_OK)
+        return NULL;
+
+    return &e->meta_constraints[e->meta_constraint_count++];
+}
+
+/*---------------------------------------------------------------------------
+    Table list hash index
+
+    Chained hash on (schema, name).  Each bucket chain links the first
+    occurrence of every key; further entries with the same key (partitions
+    of one table) hang off it via occ_next in list order.  The index
+    covers table_list[0, tbl_indexed) and is rebuilt whenever the list
+    was truncated or reset behind its back.
+ ---------------------------------------------------------------------------*/
+
+static uint32_t table_key_hash(const char *schema, const char *name)
+{
+    uint32_t h = 2166136261u;   /* FNV-1a */
+    const unsigned char *p;
+
+    for (p = (const unsigned char *)schema; *p; p++) h = (h ^ *p) * 16777619u;
+    h = (h ^ 0xFF) * 16777619u;   /* separator: "A"."BC" != "AB"."C" */
+    for (p = (const unsigned char *)name; *p; p++) h = (h ^ *p) * 16777619u;
+    return h;
+}
+
+/* First occurrence of (schema, name) in the index, or -1 */
+static int index_lookup(ODV_SESSION *s, uint32_t h, const char *schema,
+                        const char *name)
+{
+    int i;
+
+    if (s->tbl_bucket_count == 0) return -1;
+
+    for (i = s->tbl_buckets[h & (s->tbl_bucket_count - 1)]; i >= 0;
+         i = s->table_list[i].hash_next) {
+        ODV_TABLE_ENTRY *e = &s->table_list[i];
+        if (e->hash == h && strcmp(e->name, name) == 0 &&
+            strcmp(e->schema, schema) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/* Link table_list[idx] into the index; returns its first occurrence or -1 */
+static int index_insert(ODV_SESSION *s, int idx)
+{
+    ODV_TABLE_ENTRY *e = &s->table_list[idx];
+    int first;
+
+    e->hash = table_key_hash(e->schema, e->name);
+    e->hash_next = -1;
+    e->occ_next = -1;
+    e->scan_cursor = idx;
+
+    first = index_lookup(s, e->hash, e->schema, e->name);
+    if (first >= 0) {
+        ODV_TABLE_ENTRY *f = &s->table_list[first];
+        e->occ_index = s->table_list[f->occ_last].occ_index + 1;
+        s->table_list[f->occ_last].occ_next = idx;
+        f->occ_last = idx;
+    } else {
+        int b = (int)(e->hash & (uint32_t)(s->tbl_bucket_count - 1));
+        e->occ_index = 0;
+        e->occ_last = idx;
+        e->hash_next = s->tbl_buckets[b];
+        s->tbl_buckets[b] = idx;
+    }
+    return first;
+}
+
+/* Re-index table_list[0, count) into at least `need` buckets */
+static int index_rebuild(ODV_SESSION *s, int count, int need)
+{
+    int size = s->tbl_bucket_count ? s->tbl_bucket_count : 256;
+    int i;
+
+    while (size < need) size *= 2;
+    if (size != s->tbl_bucket_count) {
+        int *b = (int *)realloc(s->tbl_buckets, (size_t)size * sizeof(int));
+        if (!b) return ODV_ERROR_MALLOC;
+        s->tbl_buckets = b;
+        s->tbl_bucket_count = size;
+    }
+    for (i = 0; i < size; i++) s->tbl_buckets[i] = -1;
+
+    s->tbl_indexed = 0;
+    for (i = 0; i < count; i++) index_insert(s, i);
+    s->tbl_indexed = count;
+    return ODV_OK;
+}
+
+/* Add table_list[idx] (normally s->table_count, before the caller
+   increments it) to the index.  Returns the index of the first entry
+   with the same schema.name, -1 if this is the first occurrence, or
+   ODV_ERROR_MALLOC if the index could not be grown. */
+int odv_table_index_add(ODV_SESSION *s, int idx)
+{
+    int first;
+
+    /* Keep load factor <= 0.5 (entries vs. buckets) */
+    if (idx != s->tbl_indexed || (idx + 1) * 2 > s->tbl_bucket_count) {
+        if (index_rebuild(s, idx, (idx + 1) * 2) != ODV_OK)
+            return ODV_ERROR_MALLOC;
+    }
+    first = index_insert(s, idx);
+    s->tbl_indexed = idx + 1;
+    return first;
+}
+
+/* Bring the index up to table_list[0, table_count) */
+int odv_table_index_sync(ODV_SESSION *s)
+{
+    if (s->tbl_indexed == s->table_count) return ODV_OK;
+    return index_rebuild(s, s->table_count, s->table_count * 2);
+}
+
+/* First table_list entry for schema.name, or -1 */
+int odv_table_index_find(ODV_SESSION *s, const char *schema, const char *name)
+{
+    if (odv_table_index_sync(s) != ODV_OK) return -1;
+    return index_lookup(s, table_key_hash(schema, name), schema, name);
+}
+
+void odv_table_index_free(ODV_SESSION *s)
+{
+    free(s->tbl_buckets);
+    s->tbl_buckets = NULL;
+    s->tbl_bucket_count = 0;
+    s->tbl_indexed = 0;
+}
+
+/*---------------------------------------------------------------------------
+    Table filter
+
+    The filter is stored in UTF-8; it is converted to the dump charset
+    once per parse and compared case-insensitively against the current
+    table.
+ ---------------------------------------------------------------------------*/
+
+static void filter_to_dump_cs(ODV_SESSION *s, const char *src, char *dst)
+{
+    char tmp[ODV_OBJNAME_LEN + 1];
+    int tlen = 0;
+
+    odv_strcpy(dst, src, ODV_OBJNAME_LEN);
+    if (src[0] && s->dump_charset != CHARSET_UTF8 &&
+        s->dump_charset != CHARSET_UNKNOWN) {
+        if (convert_charset(src, (int)strlen(src), CHARSET_UTF8,
+                            tmp, ODV_OBJNAME_LEN, s->dump_charset,
+                            &tlen) == ODV_OK) {
+            tmp[tlen] = '\0';
+            odv_strcpy(dst, tmp, ODV_OBJNAME_LEN);
+        }
+    }
+}
+
+/* Convert the filter names once the dump charset is known */
+void odv_filter_prepare(ODV_SESSION *s)
+{
+    if (s->filter_cs_valid) return;
+    filter_to_dump_cs(s, s->filter_schema, s->filter_schema_cs);
+    filter_to_dump_cs(s, s->filter_table, s->filter_table_cs);
+    s->filter_cs_valid = 1;
+}
+
+/* Returns 1 if s->table matches the table filter (schema optional) */
+int odv_filter_match(ODV_SESSION *s)
+{
+    odv_filter_prepare(s);
+
+    if (s->filter_table[0] &&
+        odv_stricmp(s->table.name, s->filter_table_cs) != 0)
+        return 0;
+    if (s->filter_schema[0] &&
+        odv_stricmp(s->table.schema, s->filter_schema_cs) != 0)
+        return 0;
+    return 1;
+}
+
+/*---------------------------------------------------------------------------
+    Per-column scratch
+ ---------------------------------------------------------------------------*/
+
+/* Size the callback argument arrays for a table with `cols` columns */
+int odv_reserve_col_scratch(ODV_SESSION *s, int cols)
+{
+    int alloc = s->cb_alloc;
+    const char **names, **strs, **defaults;
+    int *ints;
+    char *name_buf;
+
+    if (cols <= alloc && alloc > 0) return ODV_OK;
+
+    alloc = alloc ? alloc : 64;
+    while (alloc < cols) alloc *= 2;
+
+    names    = (const char **)realloc((void *)s->cb_names, alloc * sizeof(char *));
+    if (names) s->cb_names = names;
+    strs     = (const char **)realloc((void *)s->cb_strs, alloc * sizeof(char *));
+    if (strs) s->cb_strs = strs;
+    defaults = (const char **)realloc((void *)s->cb_defaults, alloc * sizeof(char *));
+    if (defaults) s->cb_defaults = defaults;
+    ints     = (int *)realloc(s->cb_ints, alloc * sizeof(int));
+    if (ints) s->cb_ints = ints;
+    name_buf = (char *)realloc(s->cb_name_buf,
+                               (size_t)alloc * (ODV_OBJNAME_LEN * 4 + 1));
+    if (name_buf) s->cb_name_buf = name_buf;
+
+    if (!names || !strs || !defaults || !ints || !name_buf)
+        return ODV_ERROR_MALLOC;
+
+    s->cb_alloc = alloc;
+    return ODV_OK;
+}
+
+void odv_free_col_scratch(ODV_SESSION *s)
+{
+    free((void *)s->cb_names);
+    free((void *)s->cb_strs);
+    free((void *)s->cb_defaults);
+    free(s->cb_ints);
+    free(s->cb_name_buf);
+    s->cb_names = NULL;
+    s->cb_strs = NULL;
+    s->cb_defaults = NULL;
+    s->cb_ints = NULL;
+    s->cb_name_buf = NULL;
+    s->cb_alloc = 0;
+}
+
+/*---------------------------------------------------------------------------
+    Decode plan
+ ---------------------------------------------------------------------------*/
+
+/* s->table was replaced: drop everything derived from it */
+void odv_table_changed(ODV_SESSION *s)
+{
+    s->table_gen++;
+    s->meta_cache.valid = 0;
+    s->plan.valid = 0;
+}
+
+static unsigned char column_kernel(int type, int text_conv, int raw)
+{
+    if (raw) {
+        switch (type) {
+        case COL_NUMBER:
+        case COL_FLOAT:
+        case COL_DATE:
+        case COL_TIMESTAMP:
+        case COL_TIMESTAMP_TZ:
+        case COL_TIMESTAMP_LTZ:
+        case COL_BIN_FLOAT:
+        case COL_BIN_DOUBLE:
+        case COL_INTERVAL_YM:
+        case COL_INTERVAL_DS:
+        case COL_RAW:           return KERN_RAW;
+        default:                break;
+        }
+    }
+    switch (type) {
+    case COL_NUMBER:
+    case COL_FLOAT:         return KERN_NUMBER;
+    case COL_DATE:          return KERN_DATE;
+    case COL_TIMESTAMP:
+    case COL_TIMESTAMP_TZ:
+    case COL_TIMESTAMP_LTZ: return KERN_TIMESTAMP;
+    case COL_BIN_FLOAT:     return KERN_BIN_FLOAT;
+    case COL_BIN_DOUBLE:    return KERN_BIN_DOUBLE;
+    case COL_INTERVAL_YM:   return KERN_INTERVAL_YM;
+    case COL_INTERVAL_DS:   return KERN_INTERVAL_DS;
+    case COL_RAW:
+    case COL_ROWID:         return KERN_HEX;
+    case COL_NCHAR:
+    case COL_NVARCHAR:      return KERN_NTEXT;
+    case COL_BLOB:          return KERN_BLOB;
+    case COL_CLOB:          return KERN_CLOB;
+    case COL_NCLOB:         return KERN_NCLOB;
+    case COL_BFILE:         return KERN_BFILE;
+    case COL_LONG:          return KERN_LONG;
+    case COL_LONG_RAW:      return KERN_LONG_RAW;
+    default:                return text_conv ? KERN_TEXT_CONV : KERN_TEXT;
+    }
+}
+
+/* Return the decode plan for the current table, building it if the table
+   changed since the last call.  Returns NULL if memory is exhausted. */
+const ODV_DECODE_PLAN *odv_decode_plan(ODV_SESSION *s)
+{
+    ODV_DECODE_PLAN *pl = &s->plan;
+    int n = s->table.col_count;
+    int i, rank = 0;
+
+    if (pl->valid && pl->gen == s->table_gen && pl->col_count == n)
+        return pl;
+
+    if (n > pl->alloc || !pl->kernel) {
+        int alloc = pl->alloc ? pl->alloc : 64;
+        unsigned char *k;
+        int *lc, *nc, *lr;
+        ODV_DATE_MEMO *dm;
+        while (alloc < n) alloc *= 2;
+        k  = (unsigned char *)realloc(pl->kernel, (size_t)alloc);
+        if (k) pl->kernel = k;
+        lc = (int *)realloc(pl->lob_cols, (size_t)alloc * sizeof(int));
+        if (lc) pl->lob_cols = lc;
+        nc = (int *)realloc(pl->non_lob_cols, (size_t)alloc * sizeof(int));
+        if (nc) pl->non_lob_cols = nc;
+        lr = (int *)realloc(pl->lob_rank, (size_t)alloc * sizeof(int));
+        if (lr) pl->lob_rank = lr;
+        dm = (ODV_DATE_MEMO *)realloc(pl->date_memo, (size_t)alloc * sizeof(ODV_DATE_MEMO));
+        if (dm) pl->date_memo = dm;
+        if (!k || !lc || !nc || !lr || !dm) return NULL;
+        pl->alloc = alloc;
+    }
+
+    pl->text_src_cs = s->table.dump_charset;
+    pl->text_dst_cs = s->out_charset;
+    pl->wide = (s->out_charset == CHARSET_UTF16LE);
+    if (pl->wide && pl->text_src_cs == CHARSET_UNKNOWN)
+        pl->text_src_cs = CHARSET_UTF8;
+    pl->lob_count = 0;
+    pl->non_lob_count = 0;
+    memset(pl->date_memo, 0, (size_t)n * sizeof(ODV_DATE_MEMO));
+
+    for (i = 0; i < n; i++) {
+        int t = s->table.desc[i].type;
+
+        pl->kernel[i] = column_kernel(t,
+            pl->text_src_cs != pl->text_dst_cs &&
+            pl->text_src_cs != CHARSET_UNKNOWN, s->raw_values);
+
+        /* EXPDP streams these out of line, after the inline columns */
+        if (t == COL_BLOB || t == COL_CLOB || t == COL_NCLOB ||
+            t == COL_LONG || t == COL_LONG_RAW)
+            pl->lob_cols[pl->lob_count++] = i;
+        else
+            pl->non_lob_cols[pl->non_lob_count++] = i;
+
+        /* EXP LOB section order (LONG/LONG RAW stay inline) */
+        pl->lob_rank[i] = rank;
+        if (t == COL_BLOB || t == COL_CLOB || t == COL_NCLOB) rank++;
+    }
+
+    pl->col_count = n;
+    pl->gen = s->table_gen;
+    pl->valid = 1;
+    return pl;
+}
+
+void odv_free_decode_plan(ODV_SESSION *s)
+{
+    free(s->plan.kernel);
+    free(s->plan.lob_cols);
+    free(s->plan.non_lob_cols);
+    free(s->plan.lob_rank);
+    free(s->plan.date_memo);
+    memset(&s->plan, 0, sizeof(s->plan));
+}
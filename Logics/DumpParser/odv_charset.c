@@ -2,44 +2,598 @@
     OraDB DUMP Viewer
 
     odv_charset.c
-    Character set conversion using Win32 MultiByteToWideChar / WideCharToMultiByte
+    Character set conversion (built-in code page tables, no OS dependency)
 
-    Supports: UTF-8, Shift_JIS (CP932), EUC-JP (CP20932), UTF-16LE, US-ASCII
+    Supports: UTF-8, UTF-16LE/BE, Shift_JIS (CP932), EUC-JP, GBK (CP936),
+              Windows-1252, ISO-8859-1, ISO-8859-15, US-ASCII
+
+    Every conversion decodes the source to Unicode one character at a
+    time and encodes it straight into the destination buffer; runs of
+    ASCII bytes are detected 16 bytes at a time and copied without any
+    table lookup.  AL16UTF16 (UTF-16BE) to UTF-8 / UTF-16LE, the bulk of
+    NCHAR and CLOB traffic, has dedicated vectorized kernels, as does the
+    hex text of RAW and BLOB data.
 
     Copyright (C) 2026 YANAI Taketo
  *****************************************************************************/
 
 #include "odv_types.h"
 
-#ifdef WINDOWS
-#include <windows.h>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+  #include <emmintrin.h>
+  #define ODV_ASCII_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  #include <arm_neon.h>
+  #define ODV_ASCII_NEON
 #endif
 
+/* Code page tables (odv_charset_tables.c, generated by gen_charset_tables.py) */
+extern const unsigned short odv_cp1252_high[128];
+extern const unsigned short odv_iso8859_15_high[128];
+extern const unsigned short odv_cp932_single[128];
+extern const unsigned char  odv_cp932_lead[256];
+extern const unsigned short odv_cp932_dbcs[];
+extern const int            odv_cp932_enc_count;
+extern const unsigned short odv_cp932_enc_ucs[];
+extern const unsigned short odv_cp932_enc_code[];
+extern const unsigned short odv_eucjp_0208[94 * 94];
+extern const unsigned short odv_eucjp_0212[94 * 94];
+extern const int            odv_eucjp_enc_count;
+extern const unsigned short odv_eucjp_enc_ucs[];
+extern const unsigned int   odv_eucjp_enc_code[];
+extern const unsigned char  odv_gbk_lead[256];
+extern const unsigned short odv_gbk_dbcs[];
+extern const int            odv_gbk_enc_count;
+extern const unsigned short odv_gbk_enc_ucs[];
+extern const unsigned short odv_gbk_enc_code[];
+
+#define SJIS_TRAIL_LO   0x40
+#define SJIS_TRAIL_HI   0xFC
+#define GBK_TRAIL_LO    0x40
+#define GBK_TRAIL_HI    0xFE
+
+#define UCS_REPLACEMENT 0xFFFD
+
+/*---------------------------------------------------------------------------
+    ASCII run detection
+ ---------------------------------------------------------------------------*/
+
+/* Length of the leading run of bytes < 0x80 */
+static int ascii_run(const unsigned char *p, int n)
+{
+    int i = 0;
+
+#if defined(ODV_ASCII_SSE2)
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        if (_mm_movemask_epi8(v) != 0) break;
+    }
+#elif defined(ODV_ASCII_NEON)
+    for (; i + 16 <= n; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(p + i)) >= 0x80) break;
+    }
+#endif
+    /* 8 bytes at a time, then the tail */
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        if (w & 0x8080808080808080ULL) break;
+    }
+    while (i < n && p[i] < 0x80) i++;
+    return i;
+}
+
+static int is_ascii_compatible(int cs)
+{
+    return cs != CHARSET_UTF16LE && cs != CHARSET_UTF16BE;
+}
+
+/*---------------------------------------------------------------------------
+    Decoders: one character from src[*pos], advancing *pos
+ ---------------------------------------------------------------------------*/
+
+static unsigned int decode_utf8(const unsigned char *s, int n, int *pos)
+{
+    int i = *pos;
+    unsigned int c = s[i];
+    unsigned int cp;
+    int need, k;
+
+    if (c < 0x80) { *pos = i + 1; return c; }
+    if (c >= 0xC2 && c <= 0xDF)      { need = 1; cp = c & 0x1F; }
+    else if (c >= 0xE0 && c <= 0xEF) { need = 2; cp = c & 0x0F; }
+    else if (c >= 0xF0 && c <= 0xF4) { need = 3; cp = c & 0x07; }
+    else { *pos = i + 1; return UCS_REPLACEMENT; }
+
+    if (i + need >= n) { *pos = i + 1; return UCS_REPLACEMENT; }
+    for (k = 1; k <= need; k++) {
+        unsigned int t = s[i + k];
+        if ((t & 0xC0) != 0x80) { *pos = i + 1; return UCS_REPLACEMENT; }
+        cp = (cp << 6) | (t & 0x3F);
+    }
+    /* Reject overlongs, surrogates and > U+10FFFF */
+    if ((need == 2 && cp < 0x800) || (need == 3 && cp < 0x10000) ||
+        (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+        *pos = i + 1;
+        return UCS_REPLACEMENT;
+    }
+    *pos = i + need + 1;
+    return cp;
+}
+
+/* n is even (convert_charset drops a trailing odd byte) */
+static unsigned int decode_utf16(const unsigned char *s, int n, int *pos, int big_endian)
+{
+    int i = *pos;
+    unsigned int u, u2;
+
+    u = big_endian ? ((unsigned int)s[i] << 8 | s[i + 1])
+                   : ((unsigned int)s[i + 1] << 8 | s[i]);
+    *pos = i + 2;
+    if (u < 0xD800 || u > 0xDFFF) return u;
+    if (u >= 0xDC00 || i + 3 >= n) return UCS_REPLACEMENT;
+
+    u2 = big_endian ? ((unsigned int)s[i + 2] << 8 | s[i + 3])
+                    : ((unsigned int)s[i + 3] << 8 | s[i + 2]);
+    if (u2 < 0xDC00 || u2 > 0xDFFF) return UCS_REPLACEMENT;
+    *pos = i + 4;
+    return 0x10000 + ((u - 0xD800) << 10) + (u2 - 0xDC00);
+}
+
+static unsigned int decode_cp932(const unsigned char *s, int n, int *pos)
+{
+    int i = *pos;
+    unsigned int c = s[i];
+    int row;
+
+    *pos = i + 1;
+    if (c < 0x80) return c;
+
+    row = odv_cp932_lead[c];
+    if (row) {
+        if (i + 1 < n && s[i + 1] >= SJIS_TRAIL_LO && s[i + 1] <= SJIS_TRAIL_HI) {
+            unsigned int u = odv_cp932_dbcs[(row - 1) * (SJIS_TRAIL_HI - SJIS_TRAIL_LO + 1)
+                                            + (s[i + 1] - SJIS_TRAIL_LO)];
+            *pos = i + 2;
+            return u ? u : UCS_REPLACEMENT;
+        }
+        return UCS_REPLACEMENT;
+    }
+    return odv_cp932_single[c - 0x80] ? odv_cp932_single[c - 0x80] : UCS_REPLACEMENT;
+}
+
+static unsigned int decode_eucjp(const unsigned char *s, int n, int *pos)
+{
+    int i = *pos;
+    unsigned int c = s[i];
+
+    *pos = i + 1;
+    if (c < 0x80) return c;
+
+    if (c == 0x8E) {                            /* JIS X 0201 katakana */
+        if (i + 1 < n && s[i + 1] >= 0xA1 && s[i + 1] <= 0xDF) {
+            *pos = i + 2;
+            return 0xFF61 + (s[i + 1] - 0xA1);
+        }
+        return UCS_REPLACEMENT;
+    }
+    if (c == 0x8F) {                            /* JIS X 0212 */
+        if (i + 2 < n && s[i + 1] >= 0xA1 && s[i + 1] <= 0xFE &&
+            s[i + 2] >= 0xA1 && s[i + 2] <= 0xFE) {
+            unsigned int u = odv_eucjp_0212[(s[i + 1] - 0xA1) * 94 + (s[i + 2] - 0xA1)];
+            *pos = i + 3;
+            return u ? u : UCS_REPLACEMENT;
+        }
+        return UCS_REPLACEMENT;
+    }
+    if (c >= 0xA1 && c <= 0xFE && i + 1 < n &&  /* JIS X 0208 */
+        s[i + 1] >= 0xA1 && s[i + 1] <= 0xFE) {
+        unsigned int u = odv_eucjp_0208[(c - 0xA1) * 94 + (s[i + 1] - 0xA1)];
+        *pos = i + 2;
+        return u ? u : UCS_REPLACEMENT;
+    }
+    return UCS_REPLACEMENT;
+}
+
+static unsigned int decode_gbk(const unsigned char *s, int n, int *pos)
+{
+    int i = *pos;
+    unsigned int c = s[i];
+    int row;
+
+    *pos = i + 1;
+    if (c < 0x80) return c;
+    if (c == 0x80) return 0x20AC;               /* CP936 euro sign */
+
+    row = odv_gbk_lead[c];
+    if (row && i + 1 < n && s[i + 1] >= GBK_TRAIL_LO && s[i + 1] <= GBK_TRAIL_HI) {
+        unsigned int u = odv_gbk_dbcs[(row - 1) * (GBK_TRAIL_HI - GBK_TRAIL_LO + 1)
+                                      + (s[i + 1] - GBK_TRAIL_LO)];
+        *pos = i + 2;
+        return u ? u : UCS_REPLACEMENT;
+    }
+    return UCS_REPLACEMENT;
+}
+
+static unsigned int decode_char(int cs, const unsigned char *s, int n, int *pos)
+{
+    unsigned int c;
+
+    switch (cs) {
+    case CHARSET_UTF16LE:   return decode_utf16(s, n, pos, 0);
+    case CHARSET_UTF16BE:   return decode_utf16(s, n, pos, 1);
+    case CHARSET_SJIS:      return decode_cp932(s, n, pos);
+    case CHARSET_EUC:       return decode_eucjp(s, n, pos);
+    case CHARSET_GBK:       return decode_gbk(s, n, pos);
+    case CHARSET_WIN1252:
+    case CHARSET_ISO8859P15:
+    case CHARSET_US8:
+    case CHARSET_US7:
+        c = s[(*pos)++];
+        if (c < 0x80) return c;
+        if (cs == CHARSET_WIN1252)    return odv_cp1252_high[c - 0x80];
+        if (cs == CHARSET_ISO8859P15) return odv_iso8859_15_high[c - 0x80];
+        return c;   /* ISO-8859-1; 8-bit data in US7ASCII dumps is read as Latin-1 */
+    case CHARSET_UTF8:
+    default:
+        return decode_utf8(s, n, pos);
+    }
+}
+
 /*---------------------------------------------------------------------------
-    Map internal charset constant to Windows code page
+    Encoders: one character into dst[*pos], bounded by cap.
+    Return 0 if the character does not fit.
  ---------------------------------------------------------------------------*/
-static unsigned int charset_to_codepage(int cs)
+
+/* Reverse lookup: index of cp in a sorted *_enc_ucs table, or -1 */
+static int find_ucs(const unsigned short *ucs, int count, unsigned int cp)
 {
+    int lo = 0, hi = count - 1;
+
+    if (cp > 0xFFFF) return -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (ucs[mid] == cp) return mid;
+        if (ucs[mid] < cp) lo = mid + 1; else hi = mid - 1;
+    }
+    return -1;
+}
+
+static int put_bytes(unsigned char *d, int cap, int *pos, unsigned int code, int nbytes)
+{
+    if (*pos + nbytes > cap) return 0;
+    while (nbytes-- > 0) d[(*pos)++] = (unsigned char)(code >> (nbytes * 8));
+    return 1;
+}
+
+/* Multi-byte code (1-3 bytes, big-endian in `code`) */
+static int put_mb(unsigned char *d, int cap, int *pos, unsigned int code)
+{
+    return put_bytes(d, cap, pos, code, code > 0xFFFF ? 3 : code > 0xFF ? 2 : 1);
+}
+
+static int encode_char(int cs, unsigned int cp, unsigned char *d, int cap, int *pos)
+{
+    unsigned int code = 0;
+    int k;
+
     switch (cs) {
-    case CHARSET_UTF8:      return 65001;  /* CP_UTF8 */
-    case CHARSET_SJIS:      return 932;    /* CP932 (Shift_JIS) */
-    case CHARSET_EUC:       return 20932;  /* EUC-JP */
-    case CHARSET_US7:       return 20127;  /* US-ASCII */
-    case CHARSET_US8:       return 28591;  /* ISO-8859-1 (WE8ISO8859P1) */
-    case CHARSET_WIN1252:   return 1252;   /* Windows-1252 (WE8MSWIN1252) */
-    case CHARSET_ISO8859P15:return 28605;  /* ISO-8859-15 (WE8ISO8859P15) */
-    case CHARSET_GBK:       return 936;    /* GBK (ZHS16GBK) */
-    case CHARSET_UTF16LE:   return 1200;   /* UTF-16LE (special) */
-    case CHARSET_UTF16BE:   return 1201;   /* UTF-16BE (special) */
-    default:                return 65001;  /* Default to UTF-8 */
+    case CHARSET_UTF16LE:
+    case CHARSET_UTF16BE: {
+        int be = (cs == CHARSET_UTF16BE);
+        if (cp >= 0x10000) {
+            unsigned int v = cp - 0x10000;
+            unsigned int hi = 0xD800 + (v >> 10), lo = 0xDC00 + (v & 0x3FF);
+            if (*pos + 4 > cap) return 0;
+            d[(*pos)++] = (unsigned char)(be ? hi >> 8 : hi);
+            d[(*pos)++] = (unsigned char)(be ? hi : hi >> 8);
+            d[(*pos)++] = (unsigned char)(be ? lo >> 8 : lo);
+            d[(*pos)++] = (unsigned char)(be ? lo : lo >> 8);
+            return 1;
+        }
+        if (*pos + 2 > cap) return 0;
+        d[(*pos)++] = (unsigned char)(be ? cp >> 8 : cp);
+        d[(*pos)++] = (unsigned char)(be ? cp : cp >> 8);
+        return 1;
     }
+
+    case CHARSET_SJIS:
+        if (cp < 0x80) return put_bytes(d, cap, pos, cp, 1);
+        k = find_ucs(odv_cp932_enc_ucs, odv_cp932_enc_count, cp);
+        if (k >= 0) code = odv_cp932_enc_code[k];
+        for (k = 0; !code && k < 128; k++)
+            if (odv_cp932_single[k] == cp) code = 0x80 + (unsigned int)k;
+        return put_mb(d, cap, pos, code ? code : '?');
+
+    case CHARSET_EUC:
+        if (cp < 0x80) return put_bytes(d, cap, pos, cp, 1);
+        if (cp >= 0xFF61 && cp <= 0xFF9F)
+            return put_bytes(d, cap, pos, 0x8EA1 + (cp - 0xFF61), 2);
+        k = find_ucs(odv_eucjp_enc_ucs, odv_eucjp_enc_count, cp);
+        if (k >= 0) code = odv_eucjp_enc_code[k];
+        return put_mb(d, cap, pos, code ? code : '?');
+
+    case CHARSET_GBK:
+        if (cp < 0x80) return put_bytes(d, cap, pos, cp, 1);
+        if (cp == 0x20AC) return put_bytes(d, cap, pos, 0x80, 1);
+        k = find_ucs(odv_gbk_enc_ucs, odv_gbk_enc_count, cp);
+        if (k >= 0) code = odv_gbk_enc_code[k];
+        return put_mb(d, cap, pos, code ? code : '?');
+
+    case CHARSET_WIN1252:
+    case CHARSET_ISO8859P15: {
+        const unsigned short *high = (cs == CHARSET_WIN1252)
+                                   ? odv_cp1252_high : odv_iso8859_15_high;
+        if (cp < 0x80) return put_bytes(d, cap, pos, cp, 1);
+        for (k = 0; k < 128; k++)
+            if (high[k] == cp) return put_bytes(d, cap, pos, 0x80 + (unsigned int)k, 1);
+        return put_bytes(d, cap, pos, '?', 1);
+    }
+
+    case CHARSET_US8:
+        return put_bytes(d, cap, pos, cp < 0x100 ? cp : '?', 1);
+
+    case CHARSET_US7:
+        return put_bytes(d, cap, pos, cp < 0x80 ? cp : '?', 1);
+
+    case CHARSET_UTF8:
+    default:
+        if (cp < 0x80)    return put_bytes(d, cap, pos, cp, 1);
+        if (cp < 0x800)   return put_bytes(d, cap, pos,
+                                           ((0xC0 | (cp >> 6)) << 8) | (0x80 | (cp & 0x3F)), 2);
+        if (cp < 0x10000) return put_bytes(d, cap, pos,
+                                           ((0xE0 | (cp >> 12)) << 16) |
+                                           ((0x80 | ((cp >> 6) & 0x3F)) << 8) |
+                                           (0x80 | (cp & 0x3F)), 3);
+        if (*pos + 4 > cap) return 0;
+        d[(*pos)++] = (unsigned char)(0xF0 | (cp >> 18));
+        d[(*pos)++] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+        d[(*pos)++] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+        d[(*pos)++] = (unsigned char)(0x80 | (cp & 0x3F));
+        return 1;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    UTF-16BE transcoders (AL16UTF16 NCHAR / CLOB / NCLOB data)
+
+    Both stop before a character that does not fit in dst_cap and return
+    the number of bytes written; *consumed (optional) receives the number
+    of source bytes used.  Unpaired surrogates become U+FFFD.  No NUL is
+    appended.
+
+    odv_utf16be_to_utf8 never writes more than 1.5x the source bytes it
+    has consumed, so dst may be the same buffer as src provided src starts
+    at least src_len / 2 bytes after dst.  odv_utf16be_to_utf16le may
+    convert in place (dst == src).
+ ---------------------------------------------------------------------------*/
+
+#define UTF16BE_UNIT(p) ((unsigned int)(p)[0] << 8 | (unsigned int)(p)[1])
+
+int odv_utf16be_to_utf8(const unsigned char *src, int src_len,
+                        unsigned char *dst, int dst_cap, int *consumed)
+{
+    int i = 0, o = 0;
+
+    src_len &= ~1;
+    while (i < src_len) {
+        /* Eight ASCII units at a time: keep the low byte of each unit */
+#if defined(ODV_ASCII_SSE2)
+        const __m128i ascii_mask = _mm_set1_epi16((short)0x80FF);
+        for (; i + 16 <= src_len && o + 8 <= dst_cap; i += 16, o += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i z = _mm_cmpeq_epi16(_mm_and_si128(v, ascii_mask), _mm_setzero_si128());
+            if (_mm_movemask_epi8(z) != 0xFFFF) break;
+            v = _mm_srli_epi16(v, 8);
+            _mm_storel_epi64((__m128i *)(dst + o), _mm_packus_epi16(v, v));
+        }
+#elif defined(ODV_ASCII_NEON)
+        for (; i + 16 <= src_len && o + 8 <= dst_cap; i += 16, o += 8) {
+            uint16x8_t w = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(src + i)));
+            if (vmaxvq_u16(w) >= 0x80) break;
+            vst1_u8(dst + o, vmovn_u16(w));
+        }
+#endif
+        /* Scalar until the next ASCII unit */
+        while (i < src_len) {
+            unsigned int u = UTF16BE_UNIT(src + i);
+
+            if (u < 0x80) {
+                if (o + 1 > dst_cap) goto done;
+                dst[o++] = (unsigned char)u;
+                i += 2;
+                break;
+            }
+            if (u < 0x800) {
+                if (o + 2 > dst_cap) goto done;
+                dst[o++] = (unsigned char)(0xC0 | (u >> 6));
+                dst[o++] = (unsigned char)(0x80 | (u & 0x3F));
+                i += 2;
+                continue;
+            }
+            if (u >= 0xD800 && u <= 0xDFFF) {
+                unsigned int u2 = (i + 4 <= src_len) ? UTF16BE_UNIT(src + i + 2) : 0;
+                if (u < 0xDC00 && u2 >= 0xDC00 && u2 <= 0xDFFF) {
+                    unsigned int cp = 0x10000 + ((u - 0xD800) << 10) + (u2 - 0xDC00);
+                    if (o + 4 > dst_cap) goto done;
+                    dst[o++] = (unsigned char)(0xF0 | (cp >> 18));
+                    dst[o++] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+                    dst[o++] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+                    dst[o++] = (unsigned char)(0x80 | (cp & 0x3F));
+                    i += 4;
+                    continue;
+                }
+                u = UCS_REPLACEMENT;
+            }
+            if (o + 3 > dst_cap) goto done;
+            dst[o++] = (unsigned char)(0xE0 | (u >> 12));
+            dst[o++] = (unsigned char)(0x80 | ((u >> 6) & 0x3F));
+            dst[o++] = (unsigned char)(0x80 | (u & 0x3F));
+            i += 2;
+        }
+    }
+
+done:
+    if (consumed) *consumed = i;
+    return o;
+}
+
+int odv_utf16be_to_utf16le(const unsigned char *src, int src_len,
+                           unsigned char *dst, int dst_cap, int *consumed)
+{
+    int i = 0, lim;
+
+    src_len &= ~1;
+    lim = (src_len < (dst_cap & ~1)) ? src_len : (dst_cap & ~1);
+
+    while (i < lim) {
+        /* Eight units at a time when none of them is a surrogate */
+#if defined(ODV_ASCII_SSE2)
+        const __m128i sur_mask = _mm_set1_epi16((short)0xF800);
+        const __m128i sur_val  = _mm_set1_epi16((short)0xD800);
+        for (; i + 16 <= lim; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, sur_mask), sur_val)))
+                break;
+            _mm_storeu_si128((__m128i *)(dst + i), v);
+        }
+#elif defined(ODV_ASCII_NEON)
+        for (; i + 16 <= lim; i += 16) {
+            uint8x16_t v = vrev16q_u8(vld1q_u8(src + i));
+            uint16x8_t w = vreinterpretq_u16_u8(v);
+            if (vmaxvq_u16(vceqq_u16(vandq_u16(w, vdupq_n_u16(0xF800)),
+                                     vdupq_n_u16(0xD800))))
+                break;
+            vst1q_u8(dst + i, v);
+        }
+#endif
+        /* Scalar until the next block boundary */
+        {
+            int stop = (i + 16 <= lim) ? i + 16 : lim;
+            while (i < stop) {
+                unsigned int u = UTF16BE_UNIT(src + i);
+                if (u >= 0xD800 && u <= 0xDFFF) {
+                    unsigned int u2 = (i + 4 <= src_len) ? UTF16BE_UNIT(src + i + 2) : 0;
+                    if (u < 0xDC00 && u2 >= 0xDC00 && u2 <= 0xDFFF) {
+                        if (i + 4 > lim) goto done;
+                        dst[i]     = (unsigned char)u;
+                        dst[i + 1] = (unsigned char)(u >> 8);
+                        dst[i + 2] = (unsigned char)u2;
+                        dst[i + 3] = (unsigned char)(u2 >> 8);
+                        i += 4;
+                        continue;
+                    }
+                    u = UCS_REPLACEMENT;
+                }
+                dst[i]     = (unsigned char)u;
+                dst[i + 1] = (unsigned char)(u >> 8);
+                i += 2;
+            }
+        }
+    }
+
+done:
+    if (consumed) *consumed = i;
+    return i;
+}
+
+/*---------------------------------------------------------------------------
+    odv_hex_encode
+
+    Upper-case hex text of n bytes (RAW / ROWID values, BLOB previews):
+    2n bytes, or 4n with wide = 1 (UTF-16LE).  No NUL is appended.
+
+    Bytes are encoded from the end, so dst may be src itself or start
+    anywhere after it (decoding a RAW value in place).
+    Returns the number of bytes written.
+ ---------------------------------------------------------------------------*/
+int odv_hex_encode(const unsigned char *src, int n, char *dst, int wide)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    unsigned char *d = (unsigned char *)dst;
+    int w = wide ? 2 : 1;
+    int i = n;
+
+    if (n <= 0) return 0;
+
+    /* Tail that does not fill a 16-byte block */
+    while (i & 15) {
+        unsigned char b = src[--i];
+        unsigned char *o = d + i * 2 * w;
+        o[0] = (unsigned char)hex[b >> 4];
+        o[w] = (unsigned char)hex[b & 0x0F];
+        if (wide) { o[1] = 0; o[3] = 0; }
+    }
+
+    /* 16 bytes -> 32 digits per step */
+    while (i > 0) {
+        i -= 16;
+#if defined(ODV_ASCII_SSE2)
+        {
+            const __m128i nib  = _mm_set1_epi8(0x0F);
+            const __m128i nine = _mm_set1_epi8(9);
+            const __m128i zero = _mm_set1_epi8('0');
+            const __m128i gap  = _mm_set1_epi8('A' - '0' - 10);
+            __m128i v  = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nib);
+            __m128i lo = _mm_and_si128(v, nib);
+            __m128i a, b;
+
+            hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), gap));
+            lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), gap));
+            a = _mm_unpacklo_epi8(hi, lo);
+            b = _mm_unpackhi_epi8(hi, lo);
+            if (wide) {
+                __m128i z = _mm_setzero_si128();
+                _mm_storeu_si128((__m128i *)(d + i * 4),      _mm_unpacklo_epi8(a, z));
+                _mm_storeu_si128((__m128i *)(d + i * 4 + 16), _mm_unpackhi_epi8(a, z));
+                _mm_storeu_si128((__m128i *)(d + i * 4 + 32), _mm_unpacklo_epi8(b, z));
+                _mm_storeu_si128((__m128i *)(d + i * 4 + 48), _mm_unpackhi_epi8(b, z));
+            } else {
+                _mm_storeu_si128((__m128i *)(d + i * 2),      a);
+                _mm_storeu_si128((__m128i *)(d + i * 2 + 16), b);
+            }
+        }
+#elif defined(ODV_ASCII_NEON)
+        {
+            const uint8x16_t tbl = vld1q_u8((const uint8_t *)hex);
+            uint8x16_t v = vld1q_u8(src + i);
+            uint8x16x2_t z = vzipq_u8(vqtbl1q_u8(tbl, vshrq_n_u8(v, 4)),
+                                      vqtbl1q_u8(tbl, vandq_u8(v, vdupq_n_u8(0x0F))));
+            if (wide) {
+                uint8x16x2_t lo, hi;
+                lo.val[0] = z.val[0]; lo.val[1] = vdupq_n_u8(0);
+                hi.val[0] = z.val[1]; hi.val[1] = vdupq_n_u8(0);
+                vst2q_u8(d + i * 4, lo);
+                vst2q_u8(d + i * 4 + 32, hi);
+            } else {
+                vst1q_u8(d + i * 2, z.val[0]);
+                vst1q_u8(d + i * 2 + 16, z.val[1]);
+            }
+        }
+#else
+        {
+            int j;
+            for (j = 15; j >= 0; j--) {
+                unsigned char b = src[i + j];
+                unsigned char *o = d + (i + j) * 2 * w;
+                o[0] = (unsigned char)hex[b >> 4];
+                o[w] = (unsigned char)hex[b & 0x0F];
+                if (wide) { o[1] = 0; o[3] = 0; }
+            }
+        }
+#endif
+    }
+    return n * 2 * w;
 }
 
 /*---------------------------------------------------------------------------
     convert_charset
 
     Converts string from src_cs encoding to dst_cs encoding.
-    Goes through UTF-16 as intermediate (Windows API).
+    Output that does not fit in dst_size is truncated at a character
+    boundary.  The result is NUL-terminated (two NUL bytes for UTF-16).
 
     Returns ODV_OK on success.
     *out_len receives the number of bytes written (excluding NUL).
@@ -47,10 +601,11 @@ static unsigned int charset_to_codepage(int cs)
 int convert_charset(const char *src, int src_len, int src_cs,
                     char *dst, int dst_size, int dst_cs, int *out_len)
 {
-#ifdef WINDOWS
-    UINT src_cp, dst_cp;
-    int wlen, result;
-    wchar_t *wbuf;
+    const unsigned char *s = (const unsigned char *)src;
+    unsigned char *d = (unsigned char *)dst;
+    int wide = (dst_cs == CHARSET_UTF16LE || dst_cs == CHARSET_UTF16BE);
+    int cap, i = 0, o = 0;
+    int ascii_src;
 
     if (!src || !dst || dst_size <= 0) return ODV_ERROR_INVALID_ARG;
 
@@ -59,96 +614,58 @@ int convert_charset(const char *src, int src_len, int src_cs,
         int copy_len = (src_len < dst_size - 1) ? src_len : dst_size - 1;
         if (copy_len > 0) memcpy(dst, src, copy_len);
         dst[copy_len] = '\0';
+        if (wide && copy_len + 1 < dst_size) dst[copy_len + 1] = '\0';
         if (out_len) *out_len = copy_len;
         return ODV_OK;
     }
 
-    src_cp = charset_to_codepage(src_cs);
-    dst_cp = charset_to_codepage(dst_cs);
+    cap = dst_size - (wide ? 2 : 1);
+    if (cap < 0) cap = 0;
 
-    /* Special: src is UTF-16LE */
-    if (src_cs == CHARSET_UTF16LE) {
-        result = WideCharToMultiByte(dst_cp, 0,
-                    (const wchar_t *)src, src_len / 2,
-                    dst, dst_size - 1, NULL, NULL);
-        if (result <= 0) { dst[0] = '\0'; if (out_len) *out_len = 0; return ODV_ERROR; }
-        dst[result] = '\0';
-        if (out_len) *out_len = result;
+    /* AL16UTF16 to the usual output charsets: dedicated kernels */
+    if (src_cs == CHARSET_UTF16BE &&
+        (dst_cs == CHARSET_UTF8 || dst_cs == CHARSET_UTF16LE)) {
+        o = (dst_cs == CHARSET_UTF8)
+            ? odv_utf16be_to_utf8(s, src_len, d, cap, NULL)
+            : odv_utf16be_to_utf16le(s, src_len, d, cap, NULL);
+        d[o] = '\0';
+        if (wide) d[o + 1] = '\0';
+        if (out_len) *out_len = o;
         return ODV_OK;
     }
+    ascii_src = is_ascii_compatible(src_cs);
+    if (!ascii_src) src_len &= ~1;
 
-    /* Special: dst is UTF-16LE */
-    if (dst_cs == CHARSET_UTF16LE) {
-        result = MultiByteToWideChar(src_cp, 0, src, src_len,
-                    (wchar_t *)dst, (dst_size - 2) / 2);
-        if (result <= 0) { dst[0] = dst[1] = '\0'; if (out_len) *out_len = 0; return ODV_ERROR; }
-        ((wchar_t *)dst)[result] = L'\0';
-        if (out_len) *out_len = result * 2;
-        return ODV_OK;
-    }
+    while (i < src_len) {
+        unsigned int cp;
 
-    /* Special: src is UTF-16BE — byte-swap to UTF-16LE, then convert */
-    if (src_cs == CHARSET_UTF16BE) {
-        int i, wlen_be = src_len / 2;
-        wchar_t *wbuf_be;
-        if (wlen_be <= 0) { dst[0] = '\0'; if (out_len) *out_len = 0; return ODV_OK; }
-        wbuf_be = (wchar_t *)malloc((wlen_be + 1) * sizeof(wchar_t));
-        if (!wbuf_be) return ODV_ERROR_MALLOC;
-        for (i = 0; i < wlen_be; i++) {
-            unsigned char hi = (unsigned char)src[i * 2];
-            unsigned char lo = (unsigned char)src[i * 2 + 1];
-            wbuf_be[i] = (wchar_t)((hi << 8) | lo);
+        /* ASCII fast path: no table lookups for runs of bytes < 0x80 */
+        if (ascii_src && s[i] < 0x80) {
+            int run = ascii_run(s + i, src_len - i);
+            if (!wide) {
+                if (run > cap - o) run = cap - o;
+                memcpy(d + o, s + i, run);
+                o += run;
+            } else {
+                int k;
+                if (run > (cap - o) / 2) run = (cap - o) / 2;
+                for (k = 0; k < run; k++) {
+                    d[o + k * 2]     = (dst_cs == CHARSET_UTF16LE) ? s[i + k] : 0;
+                    d[o + k * 2 + 1] = (dst_cs == CHARSET_UTF16LE) ? 0 : s[i + k];
+                }
+                o += run * 2;
+            }
+            i += run;
+            if (o >= cap || run == 0) break;
+            continue;
         }
-        wbuf_be[wlen_be] = L'\0';
-        result = WideCharToMultiByte(dst_cp, 0, wbuf_be, wlen_be,
-                    dst, dst_size - 1, NULL, NULL);
-        free(wbuf_be);
-        if (result <= 0) { dst[0] = '\0'; if (out_len) *out_len = 0; return ODV_ERROR; }
-        dst[result] = '\0';
-        if (out_len) *out_len = result;
-        return ODV_OK;
-    }
 
-    /* General: src -> UTF-16 -> dst */
-    wlen = MultiByteToWideChar(src_cp, 0, src, src_len, NULL, 0);
-    if (wlen <= 0) {
-        int copy_len = (src_len < dst_size - 1) ? src_len : dst_size - 1;
-        memcpy(dst, src, copy_len);
-        dst[copy_len] = '\0';
-        if (out_len) *out_len = copy_len;
-        return ODV_OK;
+        cp = decode_char(src_cs, s, src_len, &i);
+        if (!encode_char(dst_cs, cp, d, cap, &o)) break;
     }
 
-    wbuf = (wchar_t *)malloc((wlen + 1) * sizeof(wchar_t));
-    if (!wbuf) return ODV_ERROR_MALLOC;
-
-    MultiByteToWideChar(src_cp, 0, src, src_len, wbuf, wlen);
-    wbuf[wlen] = L'\0';
-
-    result = WideCharToMultiByte(dst_cp, 0, wbuf, wlen,
-                dst, dst_size - 1, NULL, NULL);
-    free(wbuf);
-
-    if (result <= 0) {
-        int copy_len = (src_len < dst_size - 1) ? src_len : dst_size - 1;
-        memcpy(dst, src, copy_len);
-        dst[copy_len] = '\0';
-        if (out_len) *out_len = copy_len;
-        return ODV_OK;
-    }
-
-    dst[result] = '\0';
-    if (out_len) *out_len = result;
+    d[o] = '\0';
+    if (wide) d[o + 1] = '\0';
+    if (out_len) *out_len = o;
     return ODV_OK;
-
-#else
-    /* Non-Windows: simple copy (assume UTF-8) */
-    int copy_len;
-    if (!src || !dst) return ODV_ERROR_INVALID_ARG;
-    copy_len = (src_len < dst_size - 1) ? src_len : dst_size - 1;
-    memcpy(dst, src, copy_len);
-    dst[copy_len] = '\0';
-    if (out_len) *out_len = copy_len;
-    return ODV_OK;
-#endif
 }
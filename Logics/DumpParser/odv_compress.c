@@ -0,0 +1,631 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_compress.c
+    Parallel block compression of export output
+
+    A compressed ODV_OUTBUF hands every full buffer (ODV_OUTBUF_SIZE
+    bytes) to a pool of threads as an independent block: a gzip member
+    (odv_deflate.c) or a Zstandard frame (odv_zstd.c).  Concatenated
+    members / frames are a valid stream for gzip, zcat, zstd and the
+    zlib / zstd libraries.  Blocks are written in submission order; the
+    exporting thread writes whatever has finished each time it submits,
+    and waits only when every slot is still in flight.
+
+    Also holds what the two codecs share: the hash-chain LZ77 match
+    finder and length-limited Huffman code construction.
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+#include "odv_thread.h"
+
+#ifndef WINDOWS
+  #include <unistd.h>
+#endif
+
+int odv_cpu_count(void)
+{
+#ifdef WINDOWS
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+int odv_highbit32(uint32_t v)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(v);
+#elif defined(_MSC_VER)
+    unsigned long r;
+    _BitScanReverse(&r, v);
+    return (int)r;
+#else
+    int r = 0;
+    while (v >>= 1) r++;
+    return r;
+#endif
+}
+
+/*---------------------------------------------------------------------------
+    LZ77 match finder
+
+    Hash chains over 4-byte prefixes; the chain length, lazy evaluation
+    and "good enough" length come from the level (1 fastest .. 9 best).
+    The parse is a list of sequences whose last entry holds only the
+    trailing literals.
+ ---------------------------------------------------------------------------*/
+#define LZ_HASH_BITS   16
+#define LZ_MIN_MATCH   4
+
+static const struct { int chain; int lazy; int nice; } lz_levels[10] = {
+    {    0, 0,   0 },
+    {    4, 0,  16 },       /* 1 */
+    {    8, 0,  32 },
+    {   16, 0,  64 },
+    {   16, 1,  64 },
+    {   32, 1, 128 },
+    {   64, 1, 128 },       /* 6 */
+    {  128, 1, 258 },
+    {  512, 1, 258 },
+    { 2048, 1, 258 }        /* 9 */
+};
+
+static uint32_t lz_read32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+#define LZ_HASH(p) ((lz_read32(p) * 2654435761u) >> (32 - LZ_HASH_BITS))
+
+static int lz_extend(const unsigned char *a, const unsigned char *b, const unsigned char *end)
+{
+    const unsigned char *start = b;
+    uint64_t x, y;
+
+    while (b + 8 <= end) {
+        memcpy(&x, a, 8);
+        memcpy(&y, b, 8);
+        if (x != y) break;
+        a += 8;
+        b += 8;
+    }
+    while (b < end && *a == *b) {
+        a++;
+        b++;
+    }
+    return (int)(b - start);
+}
+
+/* Longest match for src[pos..], searching earlier positions only */
+static int lz_find(const ODV_LZ *lz, const unsigned char *src, int n, int pos,
+                   int chain, int nice, int max_dist, int max_len, int *offset)
+{
+    const unsigned char *cur = src + pos;
+    int32_t cand = lz->head[LZ_HASH(cur)];
+    int limit = ODV_MIN(max_len, n - pos);
+    int best = LZ_MIN_MATCH - 1;
+    uint32_t first = lz_read32(cur);
+
+    while (cand >= 0 && pos - cand <= max_dist && chain-- > 0) {
+        const unsigned char *m = src + cand;
+        if (m[best] == cur[best] && lz_read32(m) == first) {
+            int len = lz_extend(m, cur, cur + limit);
+            if (len > best) {
+                best = len;
+                *offset = pos - cand;
+                if (len >= nice || len >= limit) break;
+            }
+        }
+        cand = lz->prev[cand];
+    }
+    return best;
+}
+
+static void lz_insert(ODV_LZ *lz, const unsigned char *src, int pos)
+{
+    uint32_t h = LZ_HASH(src + pos);
+    lz->prev[pos] = lz->head[h];
+    lz->head[h] = pos;
+}
+
+/*---------------------------------------------------------------------------
+    odv_lz_parse
+
+    Parses src[0..n) into lz->seqs.  Matches are LZ_MIN_MATCH..max_len
+    bytes long and at most max_dist back.
+    Returns the number of sequences (>= 1), or ODV_ERROR_MALLOC.
+ ---------------------------------------------------------------------------*/
+int odv_lz_parse(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                 int max_dist, int max_len)
+{
+    int chain, lazy, nice, pos, anchor, ins, limit, nseq = 0;
+
+    if (level < 1) level = 1;
+    if (level > 9) level = 9;
+    chain = lz_levels[level].chain;
+    lazy = lz_levels[level].lazy;
+    nice = ODV_MIN(lz_levels[level].nice, max_len);
+
+    if (!lz->head) {
+        lz->head = (int32_t *)malloc(sizeof(int32_t) << LZ_HASH_BITS);
+        if (!lz->head) return ODV_ERROR_MALLOC;
+    }
+    if (n > lz->prev_cap) {
+        int32_t *p = (int32_t *)realloc(lz->prev, sizeof(int32_t) * (size_t)n);
+        if (!p) return ODV_ERROR_MALLOC;
+        lz->prev = p;
+        lz->prev_cap = n;
+    }
+    if (n / LZ_MIN_MATCH + 1 > lz->seq_cap) {
+        int cap = n / LZ_MIN_MATCH + 1;
+        ODV_LZ_SEQ *p = (ODV_LZ_SEQ *)realloc(lz->seqs, sizeof(ODV_LZ_SEQ) * (size_t)cap);
+        if (!p) return ODV_ERROR_MALLOC;
+        lz->seqs = p;
+        lz->seq_cap = cap;
+    }
+    memset(lz->head, 0xFF, sizeof(int32_t) << LZ_HASH_BITS);
+
+    pos = anchor = ins = 0;
+    limit = n - LZ_MIN_MATCH;       /* Last position with a full hash prefix */
+    while (pos <= limit) {
+        int len, off = 0;
+
+        len = lz_find(lz, src, n, pos, chain, nice, max_dist, max_len, &off);
+        lz_insert(lz, src, pos);
+        ins = pos + 1;
+        if (len < LZ_MIN_MATCH) {
+            pos++;
+            continue;
+        }
+
+        /* Lazy evaluation: prefer a longer match starting one byte later */
+        while (lazy && len < nice && pos + 1 <= limit) {
+            int off2 = 0;
+            int len2 = lz_find(lz, src, n, pos + 1, chain, nice, max_dist, max_len, &off2);
+            lz_insert(lz, src, pos + 1);
+            ins = pos + 2;
+            if (len2 <= len) break;
+            pos++;
+            len = len2;
+            off = off2;
+        }
+
+        lz->seqs[nseq].lit_len = (uint32_t)(pos - anchor);
+        lz->seqs[nseq].match_len = (uint32_t)len;
+        lz->seqs[nseq].offset = (uint32_t)off;
+        nseq++;
+
+        pos += len;
+        for (; ins < pos && ins <= limit; ins++)
+            lz_insert(lz, src, ins);
+        anchor = pos;
+    }
+
+    lz->seqs[nseq].lit_len = (uint32_t)(n - anchor);
+    lz->seqs[nseq].match_len = 0;
+    lz->seqs[nseq].offset = 0;
+    return nseq + 1;
+}
+
+/* Codec working memory of at least size bytes, kept across blocks */
+void *odv_lz_scratch(ODV_LZ *lz, size_t size)
+{
+    if (size > lz->scratch_cap) {
+        unsigned char *p = (unsigned char *)realloc(lz->scratch, size);
+        if (!p) return NULL;
+        lz->scratch = p;
+        lz->scratch_cap = size;
+    }
+    return lz->scratch;
+}
+
+void odv_lz_free(ODV_LZ *lz)
+{
+    free(lz->head);
+    free(lz->prev);
+    free(lz->seqs);
+    free(lz->scratch);
+    memset(lz, 0, sizeof(*lz));
+}
+
+/*---------------------------------------------------------------------------
+    odv_huffman_lengths
+
+    Code lengths of a complete prefix code for freq[0..n), n <= 288,
+    none longer than max_bits.  Symbols with a zero frequency get 0; a
+    lone symbol gets length 1.  Lengths come from the in-place
+    minimum-redundancy algorithm (Moffat & Katajainen); overlong codes
+    are folded to max_bits and the Kraft sum restored by lengthening
+    the shortest codes that can take it.
+ ---------------------------------------------------------------------------*/
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void min_redundancy(uint32_t *a, int n)
+{
+    int root, leaf, next, avail, used, depth;
+
+    a[0] += a[1];
+    root = 0;
+    leaf = 2;
+    for (next = 1; next < n - 1; next++) {
+        if (leaf >= n || a[root] < a[leaf]) {
+            a[next] = a[root];
+            a[root++] = (uint32_t)next;
+        } else {
+            a[next] = a[leaf++];
+        }
+        if (leaf >= n || (root < next && a[root] < a[leaf])) {
+            a[next] += a[root];
+            a[root++] = (uint32_t)next;
+        } else {
+            a[next] += a[leaf++];
+        }
+    }
+
+    a[n - 2] = 0;
+    for (next = n - 3; next >= 0; next--) a[next] = a[a[next]] + 1;
+
+    avail = 1;
+    used = depth = 0;
+    root = n - 2;
+    next = n - 1;
+    while (avail > 0) {
+        while (root >= 0 && (int)a[root] == depth) {
+            used++;
+            root--;
+        }
+        while (avail > used) {
+            a[next--] = (uint32_t)depth;
+            avail--;
+        }
+        avail = 2 * used;
+        depth++;
+        used = 0;
+    }
+}
+
+void odv_huffman_lengths(const uint32_t *freq, int n, int max_bits, unsigned char *len)
+{
+    uint64_t key[288];
+    uint32_t a[288];
+    int count[33];
+    uint32_t total;
+    int i, j, k, m = 0;
+
+    memset(len, 0, (size_t)n);
+    for (i = 0; i < n; i++)
+        if (freq[i]) key[m++] = ((uint64_t)freq[i] << 16) | (uint64_t)i;
+    if (m == 0) return;
+    if (m == 1) {
+        len[key[0] & 0xFFFF] = 1;
+        return;
+    }
+
+    qsort(key, (size_t)m, sizeof(key[0]), cmp_u64);
+    for (i = 0; i < m; i++) a[i] = (uint32_t)(key[i] >> 16);
+    min_redundancy(a, m);
+
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < m; i++) count[ODV_MIN((int)a[i], 32)]++;
+    for (i = max_bits + 1; i <= 32; i++) {
+        count[max_bits] += count[i];
+        count[i] = 0;
+    }
+    total = 0;
+    for (i = 1; i <= max_bits; i++) total += (uint32_t)count[i] << (max_bits - i);
+    while (total != (1u << max_bits)) {
+        count[max_bits]--;
+        for (i = max_bits - 1; i > 0; i--) {
+            if (count[i]) {
+                count[i]--;
+                count[i + 1] += 2;
+                break;
+            }
+        }
+        total--;
+    }
+
+    /* Rarest symbols (front of the sorted list) take the longest codes */
+    k = 0;
+    for (i = max_bits; i >= 1; i--)
+        for (j = count[i]; j > 0; j--)
+            len[key[k++] & 0xFFFF] = (unsigned char)i;
+}
+
+/*---------------------------------------------------------------------------
+    Block pipeline
+
+    jobs[] is a ring indexed by block sequence number.  Block k sits in
+    slot k % njobs from submission until it is written, so the exporting
+    thread may refill a slot once every older block has been written.
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    unsigned char *in;              /* Swapped with the ODV_OUTBUF buffer */
+    int            in_len;
+    unsigned char *out;
+    int            out_len;
+    int            out_cap;
+    int            rc;
+    int            done;
+} ZC_JOB;
+
+struct ODV_ZSTREAM {
+    int        codec;               /* ODV_COMPRESS_* */
+    int        level;
+    int        nthreads;            /* Worker threads, 0 = compress inline */
+    ZC_JOB    *jobs;
+    int        njobs;
+    int64_t    submitted;           /* Blocks handed over */
+    int64_t    taken;               /* Blocks picked up by a worker */
+    int64_t    written;             /* Blocks written to the file */
+    int        stop;
+    ODV_MUTEX  lock;
+    ODV_COND   work_cv;             /* Workers: a block was submitted / stop */
+    ODV_COND   done_cv;             /* Exporting thread: a block finished */
+    ODV_THREAD *threads;
+    int        started;
+    ODV_LZ     lz;                  /* Inline compression */
+};
+
+/* Worst-case block output: stored / raw blocks plus framing */
+static int zc_bound(int n)
+{
+    return n + n / 16 + 1024;
+}
+
+static int zc_compress(const ODV_ZSTREAM *z, ODV_LZ *lz, ZC_JOB *job, const unsigned char *src, int n)
+{
+    int len;
+
+    if (!job->out) {
+        job->out_cap = zc_bound(ODV_OUTBUF_SIZE);
+        job->out = (unsigned char *)malloc((size_t)job->out_cap);
+        if (!job->out) return ODV_ERROR_MALLOC;
+    }
+    if (z->codec == ODV_COMPRESS_ZSTD)
+        len = odv_zstd_frame(lz, src, n, z->level, job->out, job->out_cap);
+    else
+        len = odv_gzip_member(lz, src, n, z->level, job->out, job->out_cap);
+    if (len < 0) return len;
+    job->out_len = len;
+    return ODV_OK;
+}
+
+static ODV_THREAD_FUNC(zc_worker)
+{
+    ODV_ZSTREAM *z = (ODV_ZSTREAM *)arg;
+    ODV_LZ lz;
+
+    memset(&lz, 0, sizeof(lz));
+    odv_lock(&z->lock);
+    for (;;) {
+        ZC_JOB *job;
+        int rc;
+
+        while (!z->stop && z->taken == z->submitted)
+            odv_wait(&z->work_cv, &z->lock);
+        if (z->taken == z->submitted) break;
+        job = &z->jobs[z->taken++ % z->njobs];
+        odv_unlock(&z->lock);
+
+        rc = zc_compress(z, &lz, job, job->in, job->in_len);
+
+        odv_lock(&z->lock);
+        job->rc = rc;
+        job->done = 1;
+        odv_signal(&z->done_cv);
+    }
+    odv_unlock(&z->lock);
+    odv_lz_free(&lz);
+    return 0;
+}
+
+static void zc_write(ODV_OUTBUF *o, ZC_JOB *job)
+{
+    if (o->error != ODV_OK) return;
+    if (job->rc != ODV_OK)
+        o->error = job->rc;
+    else
+        o->error = odv_out_send(o, job->out, job->out_len);
+}
+
+/* Writes the oldest unwritten block.  Returns 0 if it is not finished
+   and wait is 0. */
+static int zc_write_next(ODV_OUTBUF *o, int wait)
+{
+    ODV_ZSTREAM *z = o->z;
+    ZC_JOB *job = &z->jobs[z->written % z->njobs];
+
+    odv_lock(&z->lock);
+    while (!job->done) {
+        if (!wait) {
+            odv_unlock(&z->lock);
+            return 0;
+        }
+        odv_wait(&z->done_cv, &z->lock);
+    }
+    odv_unlock(&z->lock);
+
+    zc_write(o, job);
+    z->written++;
+    return 1;
+}
+
+static void zc_free(ODV_ZSTREAM *z)
+{
+    int i;
+
+    if (z->started > 0) {
+        odv_lock(&z->lock);
+        z->stop = 1;
+        odv_broadcast(&z->work_cv);
+        odv_unlock(&z->lock);
+        for (i = 0; i < z->started; i++) {
+            odv_thread_join(z->threads[i]);
+        }
+    }
+    if (z->nthreads > 0) {
+        odv_cond_free(&z->work_cv);
+        odv_cond_free(&z->done_cv);
+        odv_mutex_free(&z->lock);
+    }
+    if (z->jobs) {
+        for (i = 0; i < z->njobs; i++) {
+            free(z->jobs[i].in);
+            free(z->jobs[i].out);
+        }
+    }
+    free(z->jobs);
+    free(z->threads);
+    odv_lz_free(&z->lz);
+    free(z);
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_compress
+
+    Turns an open ODV_OUTBUF into a compressed stream.
+    codec:   ODV_COMPRESS_* (NONE leaves the output as is)
+    level:   1 (fastest) .. 9 (smallest), 0 = 6 for gzip, 3 for zstd
+    threads: compressing threads, 0 = one per CPU, 1 = none (the caller
+             compresses each block itself)
+ ---------------------------------------------------------------------------*/
+int odv_out_compress(ODV_OUTBUF *o, int codec, int level, int threads)
+{
+    ODV_ZSTREAM *z;
+    int i;
+
+    if (!o || !o->buf) return ODV_ERROR_INVALID_ARG;
+    if (codec == ODV_COMPRESS_NONE) return ODV_OK;
+    if (codec != ODV_COMPRESS_GZIP && codec != ODV_COMPRESS_ZSTD) return ODV_ERROR_INVALID_ARG;
+
+    z = (ODV_ZSTREAM *)calloc(1, sizeof(ODV_ZSTREAM));
+    if (!z) return ODV_ERROR_MALLOC;
+    z->codec = codec;
+    z->level = (level > 0) ? ODV_MIN(level, 9) : (codec == ODV_COMPRESS_GZIP ? 6 : 3);
+    if (threads <= 0) threads = odv_cpu_count();
+    threads = ODV_MIN(threads, ODV_COMPRESS_MAX_THREADS);
+    z->nthreads = (threads > 1) ? threads : 0;
+    z->njobs = (z->nthreads > 0) ? 2 * z->nthreads : 1;
+
+    z->jobs = (ZC_JOB *)calloc((size_t)z->njobs, sizeof(ZC_JOB));
+    if (!z->jobs) {
+        zc_free(z);
+        return ODV_ERROR_MALLOC;
+    }
+    if (z->nthreads == 0) {
+        o->z = z;
+        return ODV_OK;
+    }
+
+    odv_mutex_init(&z->lock);
+    odv_cond_init(&z->work_cv);
+    odv_cond_init(&z->done_cv);
+    for (i = 0; i < z->njobs; i++) {
+        z->jobs[i].in = (unsigned char *)malloc(ODV_OUTBUF_SIZE);
+        if (!z->jobs[i].in) {
+            zc_free(z);
+            return ODV_ERROR_MALLOC;
+        }
+    }
+    z->threads = (ODV_THREAD *)calloc((size_t)z->nthreads, sizeof(ODV_THREAD));
+    if (!z->threads) {
+        zc_free(z);
+        return ODV_ERROR_MALLOC;
+    }
+    for (i = 0; i < z->nthreads; i++) {
+        if (!odv_thread_start(&z->threads[i], zc_worker, z)) break;
+        z->started++;
+    }
+    if (z->started == 0) {
+        zc_free(z);
+        return ODV_ERROR;
+    }
+
+    o->z = z;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    odv_z_flush
+
+    Compresses the buffered bytes as one block (odv_out_flush).
+ ---------------------------------------------------------------------------*/
+int odv_z_flush(ODV_OUTBUF *o)
+{
+    ODV_ZSTREAM *z = o->z;
+    ZC_JOB *job;
+    unsigned char *p;
+
+    if (o->error != ODV_OK) {
+        o->len = 0;
+        return o->error;
+    }
+
+    if (z->nthreads == 0) {
+        job = &z->jobs[0];
+        job->rc = zc_compress(z, &z->lz, job, (const unsigned char *)o->buf, o->len);
+        zc_write(o, job);
+        z->submitted++;
+        z->written++;
+        o->len = 0;
+        return o->error;
+    }
+
+    /* Wait for the slot of the block submitted njobs blocks ago */
+    while (z->submitted - z->written >= z->njobs)
+        zc_write_next(o, 1);
+
+    job = &z->jobs[z->submitted % z->njobs];
+    p = job->in;
+    job->in = (unsigned char *)o->buf;
+    job->in_len = o->len;
+    job->done = 0;
+    o->buf = (char *)p;
+    o->len = 0;
+
+    odv_lock(&z->lock);
+    z->submitted++;
+    odv_signal(&z->work_cv);
+    odv_unlock(&z->lock);
+
+    while (z->written < z->submitted && zc_write_next(o, 0))
+        ;
+    return o->error;
+}
+
+/*---------------------------------------------------------------------------
+    odv_z_close
+
+    Compresses the rest, writes every pending block and stops the
+    threads (odv_out_close).  An empty output still gets one (empty)
+    member / frame so that the file is a valid stream.
+ ---------------------------------------------------------------------------*/
+int odv_z_close(ODV_OUTBUF *o)
+{
+    ODV_ZSTREAM *z = o->z;
+
+    if (o->len > 0 || z->submitted == 0)
+        odv_z_flush(o);
+    if (z->nthreads > 0) {
+        while (z->written < z->submitted)
+            zc_write_next(o, 1);
+    }
+    zc_free(z);
+    o->z = NULL;
+    return o->error;
+}
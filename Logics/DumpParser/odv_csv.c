@@ -13,164 +13,195 @@
  *****************************************************************************/
 
 #include "odv_types.h"
-#include <stdio.h>
-
-/*---------------------------------------------------------------------------
-    csv_needs_escape
-
-    Returns 1 if the value contains characters requiring CSV escaping.
- ---------------------------------------------------------------------------*/
-static int csv_needs_escape(const char *val, char delimiter)
-{
-    while (*val) {
-        if (*val == delimiter || *val == '"' || *val == '\n' || *val == '\r')
-            return 1;
-        val++;
-    }
-    return 0;
-}
 
 /*---------------------------------------------------------------------------
     csv_write_escaped
 
-    Writes a value to the file, wrapping in double-quotes and escaping
-    embedded double-quotes (by doubling them) when necessary.
+    Writes a value, wrapping it in double-quotes and doubling embedded
+    double-quotes when it contains the delimiter, '"', CR or LF.
+    Runs without a quote are copied as one block.
  ---------------------------------------------------------------------------*/
-static void csv_write_escaped(FILE *fp, const char *val, char delimiter)
+static void csv_write_escaped(ODV_OUTBUF *out, const char *val, int len, char delimiter)
 {
-    if (!csv_needs_escape(val, delimiter)) {
-        fputs(val, fp);
+    int pos = odv_csv_special(val, len, delimiter);
+    const char *q;
+
+    if (pos == len) {
+        odv_out_write(out, val, len);
         return;
     }
 
-    fputc('"', fp);
-    while (*val) {
-        if (*val == '"') {
-            fputc('"', fp);
-            fputc('"', fp);
-        } else {
-            fputc(*val, fp);
-        }
-        val++;
+    odv_out_putc(out, '"');
+    odv_out_write(out, val, pos);
+    val += pos;
+    len -= pos;
+    while ((q = (const char *)memchr(val, '"', len)) != NULL) {
+        int run = (int)(q - val) + 1;
+        odv_out_write(out, val, run);
+        odv_out_putc(out, '"');
+        val += run;
+        len -= run;
     }
-    fputc('"', fp);
+    odv_out_write(out, val, len);
+    odv_out_putc(out, '"');
 }
 
 /*---------------------------------------------------------------------------
     CSV export context (used as row callback user_data)
  ---------------------------------------------------------------------------*/
 typedef struct {
-    FILE *fp;
+    ODV_SPLIT split;            /* Output parts / shards */
     int64_t row_count;
     const char *target_table;   /* NULL = export all tables */
     const char *target_schema;
-    int header_written;
     ODV_SESSION *session;       /* For accessing column type info */
     int write_header;           /* 1=output column name header row */
     int write_types;            /* 1=output column type row after header */
     char delimiter;             /* Field delimiter character (default ',') */
+    int progress;               /* 1=report rows to progress_cb */
 } CSV_CONTEXT;
 
 /*---------------------------------------------------------------------------
-    csv_row_callback
+    csv_put_row
 
-    Called for each row during dump parsing.
-    Writes the row to the CSV file.
+    Writes one row to the CSV file.
+    Returns ODV_OK, or the error the output has failed with (disk full,
+    closed pipe).
  ---------------------------------------------------------------------------*/
-static void ODV_CALL csv_row_callback(
-    const char *schema, const char *table,
-    int col_count, const char **col_names, const char **col_values,
-    void *user_data)
+static int csv_put_row(CSV_CONTEXT *ctx, const char *schema, const char *table,
+                       int col_count, const char **col_names, const char **col_values,
+                       const int *col_lengths)
 {
-    CSV_CONTEXT *ctx = (CSV_CONTEXT *)user_data;
-    int i;
-
-    if (!ctx || !ctx->fp) return;
+    ODV_OUTBUF *out;
+    int i, k;
 
     /* Filter by table name if specified */
     if (ctx->target_table && ctx->target_table[0] != '\0') {
-        if (strcmp(table, ctx->target_table) != 0) return;
+        if (strcmp(table, ctx->target_table) != 0) return ODV_OK;
     }
 
-    /* Write header row on first data row */
-    if (!ctx->header_written) {
-        ctx->header_written = 1;
+    k = odv_split_pick(&ctx->split, schema, table, col_count, col_names, col_values, col_lengths);
+    if (odv_split_due(&ctx->split, k)) odv_split_rotate(&ctx->split, k);
+    out = &ctx->split.files[k];
+    if (out->error != ODV_OK) return out->error;
+
+    /* Write header row on the first data row of every part */
+    if (ctx->split.fresh[k]) {
+        ctx->split.fresh[k] = 0;
 
         if (ctx->write_header) {
             for (i = 0; i < col_count; i++) {
-                if (i > 0) fputc(ctx->delimiter, ctx->fp);
-                csv_write_escaped(ctx->fp, col_names[i], ctx->delimiter);
+                if (i > 0) odv_out_putc(out, ctx->delimiter);
+                csv_write_escaped(out, col_names[i], (int)strlen(col_names[i]),
+                                  ctx->delimiter);
             }
-            fputc('\n', ctx->fp);
+            odv_out_putc(out, '\n');
         }
 
         /* Write column type row if requested */
         if (ctx->write_types && ctx->session) {
             for (i = 0; i < col_count; i++) {
-                if (i > 0) fputc(ctx->delimiter, ctx->fp);
+                if (i > 0) odv_out_putc(out, ctx->delimiter);
                 if (i < ctx->session->table.col_count &&
                     ctx->session->table.columns[i].type_str[0]) {
-                    csv_write_escaped(ctx->fp, ctx->session->table.columns[i].type_str,
-                                      ctx->delimiter);
+                    const char *t = ctx->session->table.columns[i].type_str;
+                    csv_write_escaped(out, t, (int)strlen(t), ctx->delimiter);
                 }
             }
-            fputc('\n', ctx->fp);
+            odv_out_putc(out, '\n');
         }
     }
 
     /* Write data row */
     for (i = 0; i < col_count; i++) {
-        if (i > 0) fputc(ctx->delimiter, ctx->fp);
-        if (col_values[i] && col_values[i][0] != '\0') {
-            csv_write_escaped(ctx->fp, col_values[i], ctx->delimiter);
+        if (i > 0) odv_out_putc(out, ctx->delimiter);
+        if (col_lengths[i] > 0) {
+            csv_write_escaped(out, col_values[i], col_lengths[i], ctx->delimiter);
         }
     }
-    fputc('\n', ctx->fp);
+    odv_out_putc(out, '\n');
 
+    ctx->split.rows[k]++;
     ctx->row_count++;
 
     /* Report progress periodically (every 100 rows) */
-    if (ctx->session && ctx->session->progress_cb && (ctx->row_count % 100) == 0) {
+    if (ctx->progress && ctx->session->progress_cb && (ctx->row_count % 100) == 0) {
         ctx->session->progress_cb(ctx->row_count, table, ctx->session->progress_ud);
     }
+    return ODV_OK;
 }
 
 /*---------------------------------------------------------------------------
-    write_csv_file
+    csv_row_callback
 
-    Exports a table (or all tables) from the dump to a CSV file.
-    Re-parses the dump using the row callback to stream data to the file.
+    Called for each row during dump parsing.
  ---------------------------------------------------------------------------*/
-int write_csv_file(ODV_SESSION *s, const char *table_name, const char *output_path)
+static void ODV_CALL csv_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    const int *col_lengths, void *user_data)
 {
-    CSV_CONTEXT ctx;
-    ODV_ROW_CALLBACK saved_cb;
-    void *saved_ud;
-    int rc;
+    CSV_CONTEXT *ctx = (CSV_CONTEXT *)user_data;
 
-    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+    if (!ctx || !ctx->split.files) return;
+
+    /* Stop parsing once the output cannot take more */
+    if (csv_put_row(ctx, schema, table, col_count, col_names, col_values,
+                    col_lengths) != ODV_OK)
+        ctx->session->cancelled = 1;
+}
+
+static void csv_init_context(CSV_CONTEXT *ctx, ODV_SESSION *s, const char *table_name)
+{
+    ctx->row_count = 0;
+    ctx->target_table = table_name;
+    ctx->target_schema = NULL;
+    ctx->session = s;
+    ctx->write_header = s->csv_write_header;
+    ctx->write_types = s->csv_write_types;
+    ctx->delimiter = s->csv_delimiter ? s->csv_delimiter : ',';
+    ctx->progress = 1;
+}
 
-    /* Open output file (UTF-8, no BOM) */
-    ctx.fp = fopen(output_path, "wb");
-    if (!ctx.fp) {
-        odv_strcpy(s->last_error, "Cannot create CSV output file", ODV_MSG_LEN);
-        return ODV_ERROR_FOPEN;
+/* Closes the output; rc is the parse result.  Returns the export result. */
+static int csv_finish(ODV_SESSION *s, CSV_CONTEXT *ctx, int rc)
+{
+    int close_rc = odv_split_close(&ctx->split);
+
+    if (close_rc != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        if (close_rc == ODV_ERROR_EPIPE) {
+            odv_strcpy(s->last_error, "CSV output closed by the reader", ODV_MSG_LEN);
+            rc = ODV_ERROR_EPIPE;
+        } else {
+            odv_strcpy(s->last_error, "Cannot write CSV output file", ODV_MSG_LEN);
+            rc = ODV_ERROR_FWRITE;
+        }
     }
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    export_csv
+
+    Re-parses the dump using the row callback to stream data to the open
+    ctx->split, then closes it.
+ ---------------------------------------------------------------------------*/
+static int export_csv(ODV_SESSION *s, const char *table_name, CSV_CONTEXT *ctx)
+{
+    ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
+    void *saved_ud;
+    int rc;
 
-    ctx.row_count = 0;
-    ctx.target_table = table_name;
-    ctx.target_schema = NULL;
-    ctx.header_written = 0;
-    ctx.session = s;
-    ctx.write_header = s->csv_write_header;
-    ctx.write_types = s->csv_write_types;
-    ctx.delimiter = s->csv_delimiter ? s->csv_delimiter : ',';
+    csv_init_context(ctx, s, table_name);
 
     /* Save and replace row callback */
     saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
     saved_ud = s->row_ud;
-    s->row_cb = csv_row_callback;
-    s->row_ud = &ctx;
+    s->row_cb = NULL;
+    s->row_span_cb = csv_row_callback;
+    s->row_ud = ctx;
 
     /* Re-parse dump to stream rows */
     s->cancelled = 0;
@@ -180,35 +211,116 @@ int write_csv_file(ODV_SESSION *s, const char *table_name, const char *output_pa
     if (s->dump_type == DUMP_UNKNOWN) {
         rc = detect_dump_kind(s);
         if (rc != ODV_OK) {
-            fclose(ctx.fp);
+            odv_split_close(&ctx->split);
             s->row_cb = saved_cb;
+            s->row_span_cb = saved_span_cb;
             s->row_ud = saved_ud;
             return rc;
         }
     }
 
-    switch (s->dump_type) {
-    case DUMP_EXPDP:
-        rc = parse_expdp_dump(s, 0);
-        break;
-    case DUMP_EXPDP_COMPRESS:
-        odv_strcpy(s->last_error, "Compressed EXPDP dumps are not supported", ODV_MSG_LEN);
-        rc = ODV_ERROR_UNSUPPORTED;
-        break;
-    case DUMP_EXP:
-    case DUMP_EXP_DIRECT:
-        rc = parse_exp_dump(s, 0);
-        break;
-    default:
-        rc = ODV_ERROR_FORMAT;
-        break;
-    }
+    rc = odv_run_parse(s, 0);
 
-    fclose(ctx.fp);
+    /* A failed write cancels the parse (see csv_row_callback) */
+    rc = csv_finish(s, ctx, rc);
 
     /* Restore original callback */
     s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
     s->row_ud = saved_ud;
 
     return rc;
 }
+
+/*---------------------------------------------------------------------------
+    write_csv_file
+
+    Exports a table (or all tables) from the dump to a CSV file, or to
+    its parts / shards (odv_set_output_split, odv_set_output_shards).
+ ---------------------------------------------------------------------------*/
+int write_csv_file(ODV_SESSION *s, const char *table_name, const char *output_path)
+{
+    CSV_CONTEXT ctx;
+    int rc;
+
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+
+    /* Open output file(s) (UTF-8, no BOM) */
+    rc = odv_split_open(&ctx.split, s, output_path);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, (rc == ODV_ERROR_FOPEN) ? "Cannot create CSV output file"
+                                                          : "Cannot start output compression",
+                   ODV_MSG_LEN);
+        return rc;
+    }
+    return export_csv(s, table_name, &ctx);
+}
+
+/*---------------------------------------------------------------------------
+    write_csv_sink
+
+    Exports to an opened descriptor / callback sink, which it closes.
+ ---------------------------------------------------------------------------*/
+int write_csv_sink(ODV_SESSION *s, const char *table_name, ODV_OUTBUF *out)
+{
+    CSV_CONTEXT ctx;
+    int rc;
+
+    if (!s || !out) return ODV_ERROR_INVALID_ARG;
+
+    rc = odv_split_attach(&ctx.split, s, out);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, "Cannot start output compression", ODV_MSG_LEN);
+        return rc;
+    }
+    return export_csv(s, table_name, &ctx);
+}
+
+/*---------------------------------------------------------------------------
+    csv_tee_open
+
+    Opens a CSV output of a tee export (odv_tee.c).
+ ---------------------------------------------------------------------------*/
+static int csv_sink_row(void *sink_ctx, const char *schema, const char *table,
+                        int col_count, const char **col_names, const char **col_values,
+                        const int *col_lengths)
+{
+    return csv_put_row((CSV_CONTEXT *)sink_ctx, schema, table, col_count, col_names,
+                       col_values, col_lengths);
+}
+
+static int csv_sink_close(void *sink_ctx, int rc)
+{
+    CSV_CONTEXT *ctx = (CSV_CONTEXT *)sink_ctx;
+
+    rc = csv_finish(ctx->session, ctx, rc);
+    free(ctx);
+    return rc;
+}
+
+int csv_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                 ODV_TEE_SINK *sink)
+{
+    CSV_CONTEXT *ctx;
+    int rc;
+
+    ctx = (CSV_CONTEXT *)malloc(sizeof(CSV_CONTEXT));
+    if (!ctx) return ODV_ERROR_MALLOC;
+
+    rc = odv_split_open(&ctx->split, s, output_path);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, (rc == ODV_ERROR_FOPEN) ? "Cannot create CSV output file"
+                                                          : "Cannot start output compression",
+                   ODV_MSG_LEN);
+        free(ctx);
+        return rc;
+    }
+    csv_init_context(ctx, s, table_name);
+    ctx->progress = 0;          /* Reported by the tee */
+
+    sink->ctx = ctx;
+    sink->raw = 0;
+    sink->row = csv_sink_row;
+    sink->close = csv_sink_close;
+    return ODV_OK;
+}
@@ -27,110 +27,279 @@
 #include <stdio.h>
 #include <string.h>
 
+/* "00" "01" ... "99" */
+static const char digit_pairs[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+/* Decoded DATE fields */
+typedef struct {
+    int yyyy, mm, dd, hh, mi, ss;
+} DATE_FIELDS;
+
+static void date_fields(const unsigned char *buf, DATE_FIELDS *f)
+{
+    /* Decode year: century and year are both offset by 100 */
+    if (buf[0] >= 100) {
+        f->yyyy = ((int)buf[0] - 100) * 100 + ((int)buf[1] - 100);
+    } else {
+        /* Negative year (BC dates) */
+        f->yyyy = -((100 - (int)buf[0]) * 100 + ((int)buf[1] - 100));
+    }
+
+    f->mm = buf[2];
+    f->dd = buf[3];
+    f->hh = buf[4] - 1;
+    f->mi = buf[5] - 1;
+    f->ss = buf[6] - 1;
+
+    /* Validate */
+    if (f->mm < 1 || f->mm > 12) f->mm = 1;
+    if (f->dd < 1 || f->dd > 31) f->dd = 1;
+    if (f->hh < 0 || f->hh > 23) f->hh = 0;
+    if (f->mi < 0 || f->mi > 59) f->mi = 0;
+    if (f->ss < 0 || f->ss > 59) f->ss = 0;
+}
+
+/* "%04d" without snprintf for the usual 0-9999 */
+static int put_year(char *p, int yyyy)
+{
+    char tmp[16];
+    int n;
+
+    if (yyyy >= 0 && yyyy <= 9999) {
+        memcpy(p, digit_pairs + (yyyy / 100) * 2, 2);
+        memcpy(p + 2, digit_pairs + (yyyy % 100) * 2, 2);
+        return 4;
+    }
+    n = snprintf(tmp, sizeof(tmp), "%04d", yyyy);
+    memcpy(p, tmp, n);
+    return n;
+}
+
 /*---------------------------------------------------------------------------
-    decode_oracle_date
+    odv_compile_date_format
 
-    Decodes 7-byte Oracle DATE to string.
+    Turns a DATE_FMT_* mode into a list of fixed-width emitters, once,
+    instead of matching tokens for every value.
 
     fmt: DATE_FMT_SLASH   => "YYYY/MM/DD HH:MI:SS"
          DATE_FMT_COMPACT => "YYYYMMDD"
          DATE_FMT_FULL    => "YYYYMMDDHHMMSS"
- ---------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------
-    format_date_custom
-
-    Formats date components using a custom format string.
-    Tokens: YYYY, MM, DD, HH24, MI, SS
+         DATE_FMT_CUSTOM  => custom_fmt
+    Custom tokens: YYYY, MM, DD, HH24, MI, SS.
     All other characters are output literally.
  ---------------------------------------------------------------------------*/
-static int format_date_custom(const char *fmt_str, int yyyy, int mm, int dd,
-                               int hh, int mi, int ss, char *out, int out_size)
+void odv_compile_date_format(ODV_DATE_PROG *prog, int fmt, const char *custom_fmt)
 {
-    const char *p = fmt_str;
-    int pos = 0;
-
-    while (*p && pos < out_size - 1) {
-        if (strncmp(p, "YYYY", 4) == 0) {
-            pos += snprintf(out + pos, out_size - pos, "%04d", yyyy);
-            p += 4;
-        } else if (strncmp(p, "MM", 2) == 0) {
-            pos += snprintf(out + pos, out_size - pos, "%02d", mm);
-            p += 2;
-        } else if (strncmp(p, "DD", 2) == 0) {
-            pos += snprintf(out + pos, out_size - pos, "%02d", dd);
-            p += 2;
-        } else if (strncmp(p, "HH24", 4) == 0) {
-            pos += snprintf(out + pos, out_size - pos, "%02d", hh);
-            p += 4;
-        } else if (strncmp(p, "MI", 2) == 0) {
-            pos += snprintf(out + pos, out_size - pos, "%02d", mi);
-            p += 2;
-        } else if (strncmp(p, "SS", 2) == 0) {
-            pos += snprintf(out + pos, out_size - pos, "%02d", ss);
-            p += 2;
-        } else {
-            out[pos++] = *p++;
+    const char *p;
+    int lit_len = 0, i;
+
+    memset(prog, 0, sizeof(*prog));
+
+    switch (fmt) {
+    case DATE_FMT_COMPACT:
+        p = "YYYYMMDD";
+        prog->min_out = 9;
+        break;
+    case DATE_FMT_FULL:
+        p = "YYYYMMDDHH24MISS";
+        prog->frac = 1;
+        prog->min_out = 15;
+        break;
+    case DATE_FMT_CUSTOM:
+        if (custom_fmt && custom_fmt[0]) {
+            p = custom_fmt;
+            prog->custom = 1;
+            break;
+        }
+        /* Fall through to default if no custom format */
+        /* fall through */
+    default:
+        p = "YYYY/MM/DD HH24:MI:SS";
+        prog->frac = 1;
+        prog->min_out = 20;
+        break;
+    }
+
+    while (*p && prog->count < (int)(sizeof(prog->ops) / sizeof(prog->ops[0]))) {
+        ODV_DATE_OP *op = &prog->ops[prog->count];
+
+        if (strncmp(p, "YYYY", 4) == 0)      { op->op = DOP_YYYY; p += 4; }
+        else if (strncmp(p, "MM", 2) == 0)   { op->op = DOP_MM;   p += 2; }
+        else if (strncmp(p, "DD", 2) == 0)   { op->op = DOP_DD;   p += 2; }
+        else if (strncmp(p, "HH24", 4) == 0) { op->op = DOP_HH24; p += 4; }
+        else if (strncmp(p, "MI", 2) == 0)   { op->op = DOP_MI;   p += 2; }
+        else if (strncmp(p, "SS", 2) == 0)   { op->op = DOP_SS;   p += 2; }
+        else {
+            if (lit_len >= (int)sizeof(prog->lit)) break;
+            /* Extend the previous literal run */
+            if (prog->count > 0 && op[-1].op == DOP_LIT) {
+                op[-1].len++;
+                prog->lit[lit_len++] = *p++;
+                continue;
+            }
+            op->op = DOP_LIT;
+            op->off = (unsigned short)lit_len;
+            op->len = 1;
+            prog->lit[lit_len++] = *p++;
+        }
+        prog->count++;
+    }
+
+    for (i = 0; i < prog->count; i++) {
+        switch (prog->ops[i].op) {
+        case DOP_LIT:  prog->max_len += prog->ops[i].len; break;
+        case DOP_YYYY: prog->max_len += 6; break;   /* -10155 .. 15655 */
+        default:       prog->max_len += 2; break;
         }
     }
-    out[pos] = '\0';
-    return ODV_OK;
 }
 
-int decode_oracle_date(const unsigned char *buf, int len, char *out, int out_size, int fmt, const char *custom_fmt)
+/* Runs prog; out must hold prog->max_len + 1 bytes.
+   Returns the text length. */
+static int run_date_prog(const ODV_DATE_PROG *prog, const DATE_FIELDS *f, char *out)
 {
-    int yyyy, mm, dd, hh, mi, ss;
+    char *p = out;
+    int i;
+
+    for (i = 0; i < prog->count; i++) {
+        const ODV_DATE_OP *op = &prog->ops[i];
+        switch (op->op) {
+        case DOP_LIT:  memcpy(p, prog->lit + op->off, op->len); p += op->len; break;
+        case DOP_YYYY: p += put_year(p, f->yyyy); break;
+        case DOP_MM:   memcpy(p, digit_pairs + f->mm * 2, 2); p += 2; break;
+        case DOP_DD:   memcpy(p, digit_pairs + f->dd * 2, 2); p += 2; break;
+        case DOP_HH24: memcpy(p, digit_pairs + f->hh * 2, 2); p += 2; break;
+        case DOP_MI:   memcpy(p, digit_pairs + f->mi * 2, 2); p += 2; break;
+        case DOP_SS:   memcpy(p, digit_pairs + f->ss * 2, 2); p += 2; break;
+        }
+    }
+    *p = '\0';
+    return (int)(p - out);
+}
 
-    if (!buf || !out || out_size < 2) return ODV_ERROR_INVALID_ARG;
+/* run_date_prog into a buffer of any size (truncated) */
+static int format_date(const ODV_DATE_PROG *prog, const DATE_FIELDS *f,
+                       char *out, int out_size)
+{
+    char tmp[ODV_DATE_PROG_TEXT_LEN];
+    int n;
+
+    if (out_size > prog->max_len) return run_date_prog(prog, f, out);
+
+    n = run_date_prog(prog, f, tmp);
+    if (n > out_size - 1) n = out_size - 1;
+    memcpy(out, tmp, n);
+    out[n] = '\0';
+    return n;
+}
+
+/*---------------------------------------------------------------------------
+    decode_oracle_date
+
+    Decodes 7-byte Oracle DATE to string using a compiled format
+    (odv_compile_date_format).
+    Returns the text length, or a negative ODV_ERROR_* code.
+ ---------------------------------------------------------------------------*/
+int decode_oracle_date(const unsigned char *buf, int len, char *out, int out_size, const ODV_DATE_PROG *prog)
+{
+    DATE_FIELDS f;
+
+    if (!buf || !out || !prog || out_size < 2) return ODV_ERROR_INVALID_ARG;
     if (len < 7) {
         out[0] = '\0';
         return ODV_ERROR_INVALID_ARG;
     }
 
-    /* Decode year: century and year are both offset by 100 */
-    if (buf[0] >= 100) {
-        yyyy = ((int)buf[0] - 100) * 100 + ((int)buf[1] - 100);
-    } else {
-        /* Negative year (BC dates) */
-        yyyy = -((100 - (int)buf[0]) * 100 + ((int)buf[1] - 100));
+    if (out_size < prog->min_out) return ODV_ERROR_BUFFER_OVER;
+    date_fields(buf, &f);
+    return format_date(prog, &f, out, out_size);
+}
+
+/*---------------------------------------------------------------------------
+    decode_oracle_date_memo
+
+    decode_oracle_date through the per-column memo of the decode plan:
+    DATE columns repeat heavily, so the last raw value and its text are
+    kept and reused when the next row carries the same 7 bytes.
+
+    *text receives the text (valid until the next call for the column).
+    Returns the text length, or -1 if the value is not a DATE.
+ ---------------------------------------------------------------------------*/
+int decode_oracle_date_memo(ODV_SESSION *s, int col, const unsigned char *buf, int len, const char **text)
+{
+    ODV_DATE_MEMO *m;
+    DATE_FIELDS f;
+    int n;
+
+    if (len < 7 || !s->plan.date_memo || col < 0 || col >= s->plan.col_count)
+        return -1;
+
+    m = &s->plan.date_memo[col];
+    if (m->len == 0 || memcmp(m->raw, buf, 7) != 0) {
+        if (s->date_prog.max_len >= ODV_DATE_MEMO_LEN) return -1;
+        date_fields(buf, &f);
+        n = run_date_prog(&s->date_prog, &f, m->text);
+        if (n == 0) return -1;
+        memcpy(m->raw, buf, 7);
+        m->len = (unsigned char)n;
     }
+    *text = m->text;
+    return m->len;
+}
 
-    mm = buf[2];
-    dd = buf[3];
-    hh = buf[4] - 1;
-    mi = buf[5] - 1;
-    ss = buf[6] - 1;
+/*---------------------------------------------------------------------------
+    odv_datetime_to_unix_us
 
-    /* Validate */
-    if (mm < 1 || mm > 12) mm = 1;
-    if (dd < 1 || dd > 31) dd = 1;
-    if (hh < 0 || hh > 23) hh = 0;
-    if (mi < 0 || mi > 59) mi = 0;
-    if (ss < 0 || ss > 59) ss = 0;
+    DATE / TIMESTAMP as microseconds since 1970-01-01 00:00:00 (proleptic
+    Gregorian), for typed encoders.  Fractional seconds are cut to
+    ts_precision digits as decode_oracle_timestamp prints them, then
+    rounded to the nearest microsecond.
+    Returns ODV_OK, or ODV_ERROR_FORMAT if len < 7.
+ ---------------------------------------------------------------------------*/
+int odv_datetime_to_unix_us(const unsigned char *buf, int len, int ts_precision, int64_t *us)
+{
+    static const unsigned int cut[10] = {
+        1000000000u, 100000000u, 10000000u, 1000000u, 100000u, 10000u, 1000u, 100u, 10u, 1u
+    };
+    DATE_FIELDS f;
+    int64_t y, era, yoe, doy, doe, days;
+    unsigned int nano = 0;
 
-    switch (fmt) {
-    case DATE_FMT_SLASH:
-        if (out_size < 20) return ODV_ERROR_BUFFER_OVER;
-        snprintf(out, out_size, "%04d/%02d/%02d %02d:%02d:%02d", yyyy, mm, dd, hh, mi, ss);
-        break;
-    case DATE_FMT_COMPACT:
-        if (out_size < 9) return ODV_ERROR_BUFFER_OVER;
-        snprintf(out, out_size, "%04d%02d%02d", yyyy, mm, dd);
-        break;
-    case DATE_FMT_FULL:
-        if (out_size < 15) return ODV_ERROR_BUFFER_OVER;
-        snprintf(out, out_size, "%04d%02d%02d%02d%02d%02d", yyyy, mm, dd, hh, mi, ss);
-        break;
-    case DATE_FMT_CUSTOM:
-        if (custom_fmt && custom_fmt[0]) {
-            return format_date_custom(custom_fmt, yyyy, mm, dd, hh, mi, ss, out, out_size);
-        }
-        /* Fall through to default if no custom format */
-    default:
-        if (out_size < 20) return ODV_ERROR_BUFFER_OVER;
-        snprintf(out, out_size, "%04d/%02d/%02d %02d:%02d:%02d", yyyy, mm, dd, hh, mi, ss);
-        break;
+    if (!buf || !us) return ODV_ERROR_INVALID_ARG;
+    if (len < 7) return ODV_ERROR_FORMAT;
+
+    date_fields(buf, &f);
+    if (len >= 11) {
+        nano = ((unsigned int)buf[7] << 24) | ((unsigned int)buf[8] << 16) |
+               ((unsigned int)buf[9] << 8)  |  (unsigned int)buf[10];
+        if (nano > 999999999u) nano = 999999999u;
+        if (ts_precision < 0) ts_precision = 6;
+        if (ts_precision > 9) ts_precision = 9;
+        nano -= nano % cut[ts_precision];
     }
 
+    /* Days from civil (1 BC is year 0) */
+    y = (f.yyyy < 0) ? f.yyyy + 1 : f.yyyy;
+    if (f.mm <= 2) y--;
+    era = (y >= 0 ? y : y - 399) / 400;
+    yoe = y - era * 400;
+    doy = (153 * (f.mm + (f.mm > 2 ? -3 : 9)) + 2) / 5 + f.dd - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    days = era * 146097 + doe - 719468;
+
+    *us = ((days * 24 + f.hh) * 60 + f.mi) * 60 + f.ss;
+    *us = *us * 1000000 + (nano + 500) / 1000;
     return ODV_OK;
 }
 
@@ -145,13 +314,17 @@ int decode_oracle_date(const unsigned char *buf, int len, char *out, int out_siz
       negative => use Oracle default (6)
 
     Output: "YYYY/MM/DD HH:MI:SS.FFFFFF" (for precision=6)
+    Returns the text length, or a negative ODV_ERROR_* code.
  ---------------------------------------------------------------------------*/
-int decode_oracle_timestamp(const unsigned char *buf, int len, char *out, int out_size, int fmt, const char *custom_fmt, int ts_precision)
+int decode_oracle_timestamp(const unsigned char *buf, int len, char *out, int out_size, const ODV_DATE_PROG *prog, int ts_precision)
 {
-    int yyyy, mm, dd, hh, mi, ss;
+    DATE_FIELDS f;
     unsigned int nano = 0;
+    char tmp[ODV_DATE_PROG_TEXT_LEN + 12];
+    char *dst, *p;
+    int i, n;
 
-    if (!buf || !out || out_size < 2) return ODV_ERROR_INVALID_ARG;
+    if (!buf || !out || !prog || out_size < 2) return ODV_ERROR_INVALID_ARG;
     if (len < 7) {
         out[0] = '\0';
         return ODV_ERROR_INVALID_ARG;
@@ -161,24 +334,15 @@ int decode_oracle_timestamp(const unsigned char *buf, int len, char *out, int ou
     if (ts_precision < 0) ts_precision = 6;
     if (ts_precision > 9) ts_precision = 9;
 
-    /* Decode date portion (same as DATE) */
-    if (buf[0] >= 100) {
-        yyyy = ((int)buf[0] - 100) * 100 + ((int)buf[1] - 100);
-    } else {
-        yyyy = -((100 - (int)buf[0]) * 100 + ((int)buf[1] - 100));
-    }
+    /* TIMESTAMP(0): no fractional seconds, same as DATE */
+    if (ts_precision == 0) return decode_oracle_date(buf, 7, out, out_size, prog);
 
-    mm = buf[2];
-    dd = buf[3];
-    hh = buf[4] - 1;
-    mi = buf[5] - 1;
-    ss = buf[6] - 1;
+    /* Custom format ignores nanoseconds */
+    if (prog->custom) return decode_oracle_date(buf, 7, out, out_size, prog);
+    if (out_size < 30) return ODV_ERROR_BUFFER_OVER;
+    if (!prog->frac) return decode_oracle_date(buf, 7, out, out_size, prog);
 
-    if (mm < 1 || mm > 12) mm = 1;
-    if (dd < 1 || dd > 31) dd = 1;
-    if (hh < 0 || hh > 23) hh = 0;
-    if (mi < 0 || mi > 59) mi = 0;
-    if (ss < 0 || ss > 59) ss = 0;
+    date_fields(buf, &f);
 
     /* Extract nanoseconds from bytes 7-10 (big-endian 32-bit) */
     if (len >= 11) {
@@ -188,96 +352,349 @@ int decode_oracle_timestamp(const unsigned char *buf, int len, char *out, int ou
              |  (unsigned int)buf[10];
     }
 
-    /* Custom format: delegate to format_date_custom (ignores nanoseconds) */
-    if (fmt == DATE_FMT_CUSTOM && custom_fmt && custom_fmt[0]) {
-        return format_date_custom(custom_fmt, yyyy, mm, dd, hh, mi, ss, out, out_size);
-    }
-
-    /* Format output based on column precision */
-    if (ts_precision > 0) {
+    /* Date, then "%09u" truncated to the column precision */
+    dst = (out_size > prog->max_len + 10) ? out : tmp;
+    p = dst + run_date_prog(prog, &f, dst);
+    *p++ = '.';
+    if (nano > 999999999u) {
         char nano_str[16];
-
-        if (out_size < 30) return ODV_ERROR_BUFFER_OVER;
-
-        /* Format nanoseconds and truncate to requested precision */
-        snprintf(nano_str, sizeof(nano_str), "%09u", nano);
-        nano_str[ts_precision] = '\0';
-
-        switch (fmt) {
-        case DATE_FMT_SLASH:
-        default:
-            snprintf(out, out_size, "%04d/%02d/%02d %02d:%02d:%02d.%s",
-                     yyyy, mm, dd, hh, mi, ss, nano_str);
-            break;
-        case DATE_FMT_COMPACT:
-            snprintf(out, out_size, "%04d%02d%02d", yyyy, mm, dd);
-            break;
-        case DATE_FMT_FULL:
-            snprintf(out, out_size, "%04d%02d%02d%02d%02d%02d.%s",
-                     yyyy, mm, dd, hh, mi, ss, nano_str);
-            break;
-        }
+        snprintf(nano_str, sizeof(nano_str), "%010u", nano);
+        memcpy(p, nano_str, ts_precision);
     } else {
-        /* TIMESTAMP(0): no fractional seconds, same as DATE */
-        return decode_oracle_date(buf, 7, out, out_size, fmt, custom_fmt);
+        for (i = 8; i >= 0; i--) {
+            if (i < ts_precision) p[i] = (char)('0' + nano % 10);
+            nano /= 10;
+        }
     }
-
-    return ODV_OK;
+    p += ts_precision;
+    *p = '\0';
+    n = (int)(p - dst);
+
+    if (dst == tmp) {
+        if (n > out_size - 1) n = out_size - 1;
+        memcpy(out, tmp, n);
+        out[n] = '\0';
+    }
+    return n;
 }
 
 /*---------------------------------------------------------------------------
-    decode_binary_float
+    Shortest round-trip formatting (Grisu2)
 
-    Decodes 4-byte Oracle BINARY_FLOAT.
-    Oracle stores floats in a modified IEEE 754 format:
-      - If high bit set (byte[0] >= 0x80): subtract 0x80 from byte[0]
-      - If high bit clear (byte[0] < 0x80): XOR all bytes with 0xFF
-      - Stored big-endian, needs reversal for little-endian platforms
+    BINARY_FLOAT / BINARY_DOUBLE are printed with the fewest digits that
+    read back (strtof / strtod) to the same bits, e.g. 0.1f as "0.1"
+    rather than "0.1000000015".  Pure integer arithmetic: no locale, no
+    allocation.  Layout follows %g (plain notation for exponents -4 up to
+    the type's precision, otherwise d.ddde+XX).
+
+    Reference: F. Loitsch, "Printing Floating-Point Numbers Quickly and
+    Accurately with Integers", PLDI 2010.
  ---------------------------------------------------------------------------*/
-int decode_binary_float(const unsigned char *buf, char *out, int out_size)
+
+/* f * 2^e */
+typedef struct {
+    uint64_t f;
+    int      e;
+} DIYFP;
+
+/* Normalized 10^k, k = -300, -292, ..., 324 */
+static const struct {
+    uint64_t f;
+    int      e;
+    int      k;
+} cached_pow10[] = {
+    { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+    { 0xBE5691EF416BD60CULL, -1007, -284 },
+    { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+    { 0xD3515C2831559A83ULL,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+    { 0xEA9C227723EE8BCBULL,  -901, -252 },
+    { 0xAECC49914078536DULL,  -874, -244 },
+    { 0x823C12795DB6CE57ULL,  -847, -236 },
+    { 0xC21094364DFB5637ULL,  -821, -228 },
+    { 0x9096EA6F3848984FULL,  -794, -220 },
+    { 0xD77485CB25823AC7ULL,  -768, -212 },
+    { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+    { 0xEF340A98172AACE5ULL,  -715, -196 },
+    { 0xB23867FB2A35B28EULL,  -688, -188 },
+    { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+    { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+    { 0x936B9FCEBB25C996ULL,  -608, -164 },
+    { 0xDBAC6C247D62A584ULL,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+    { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+    { 0x87625F056C7C4A8BULL,  -475, -124 },
+    { 0xC9BCFF6034C13053ULL,  -449, -116 },
+    { 0x964E858C91BA2655ULL,  -422, -108 },
+    { 0xDFF9772470297EBDULL,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+    { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+    { 0xB94470938FA89BCFULL,  -316,  -76 },
+    { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+    { 0xCDB02555653131B6ULL,  -263,  -60 },
+    { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+    { 0xAA242499697392D3ULL,  -183,  -36 },
+    { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+    { 0xBCE5086492111AEBULL,  -130,  -20 },
+    { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+    { 0xD1B71758E219652CULL,   -77,   -4 },
+    { 0x9C40000000000000ULL,   -50,    4 },
+    { 0xE8D4A51000000000ULL,   -24,   12 },
+    { 0xAD78EBC5AC620000ULL,     3,   20 },
+    { 0x813F3978F8940984ULL,    30,   28 },
+    { 0xC097CE7BC90715B3ULL,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+    { 0xD5D238A4ABE98068ULL,   109,   52 },
+    { 0x9F4F2726179A2245ULL,   136,   60 },
+    { 0xED63A231D4C4FB27ULL,   162,   68 },
+    { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+    { 0x83C7088E1AAB65DBULL,   216,   84 },
+    { 0xC45D1DF942711D9AULL,   242,   92 },
+    { 0x924D692CA61BE758ULL,   269,  100 },
+    { 0xDA01EE641A708DEAULL,   295,  108 },
+    { 0xA26DA3999AEF774AULL,   322,  116 },
+    { 0xF209787BB47D6B85ULL,   348,  124 },
+    { 0xB454E4A179DD1877ULL,   375,  132 },
+    { 0x865B86925B9BC5C2ULL,   402,  140 },
+    { 0xC83553C5C8965D3DULL,   428,  148 },
+    { 0x952AB45CFA97A0B3ULL,   455,  156 },
+    { 0xDE469FBD99A05FE3ULL,   481,  164 },
+    { 0xA59BC234DB398C25ULL,   508,  172 },
+    { 0xF6C69A72A3989F5CULL,   534,  180 },
+    { 0xB7DCBF5354E9BECEULL,   561,  188 },
+    { 0x88FCF317F22241E2ULL,   588,  196 },
+    { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+    { 0x98165AF37B2153DFULL,   641,  212 },
+    { 0xE2A0B5DC971F303AULL,   667,  220 },
+    { 0xA8D9D1535CE3B396ULL,   694,  228 },
+    { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+    { 0xBB764C4CA7A44410ULL,   747,  244 },
+    { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+    { 0xD01FEF10A657842CULL,   800,  260 },
+    { 0x9B10A4E5E9913129ULL,   827,  268 },
+    { 0xE7109BFBA19C0C9DULL,   853,  276 },
+    { 0xAC2820D9623BF429ULL,   880,  284 },
+    { 0x80444B5E7AA7CF85ULL,   907,  292 },
+    { 0xBF21E44003ACDD2DULL,   933,  300 },
+    { 0x8E679C2F5E44FF8FULL,   960,  308 },
+    { 0xD433179D9C8CB841ULL,   986,  316 },
+    { 0x9E19DB92B4E31BA9ULL,  1013,  324 },
+};
+
+static DIYFP diy(uint64_t f, int e)
 {
-    unsigned char tmp[4];
-    float fval;
+    DIYFP r;
+    r.f = f;
+    r.e = e;
+    return r;
+}
 
-    if (!buf || !out || out_size < 2) return ODV_ERROR_INVALID_ARG;
+/* Upper 64 bits of the 128-bit product, rounded */
+static DIYFP diy_mul(DIYFP x, DIYFP y)
+{
+    uint64_t a = x.f >> 32, b = x.f & 0xFFFFFFFFu;
+    uint64_t c = y.f >> 32, d = y.f & 0xFFFFFFFFu;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t mid = (bd >> 32) + (ad & 0xFFFFFFFFu) + (bc & 0xFFFFFFFFu) + (1u << 31);
 
-    /* Copy and transform */
-    memcpy(tmp, buf, 4);
+    return diy(ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64);
+}
 
-    if (tmp[0] >= 0x80) {
-        tmp[0] -= 0x80;
-    } else {
-        tmp[0] ^= 0xFF;
-        tmp[1] ^= 0xFF;
-        tmp[2] ^= 0xFF;
-        tmp[3] ^= 0xFF;
+static DIYFP diy_normalize(DIYFP x)
+{
+    while (!(x.f & 0x8000000000000000ULL)) {
+        x.f <<= 1;
+        x.e--;
     }
+    return x;
+}
 
-    /* Reverse byte order: big-endian to little-endian */
-    {
-        unsigned char t;
-        t = tmp[0]; tmp[0] = tmp[3]; tmp[3] = t;
-        t = tmp[1]; tmp[1] = tmp[2]; tmp[2] = t;
+/*
+ * Decimal digits of the shortest representation of the IEEE value with
+ * mantissa field `frac`, exponent field `bexp` (both unsigned, sign
+ * already stripped) and `mant_bits` stored mantissa bits (23 or 52).
+ * Writes up to 17 digits; value = digits * 10^*dec_exp.  Returns the
+ * digit count.
+ */
+static int grisu2(uint64_t frac, int bexp, int mant_bits, int bias,
+                  char *digits, int *dec_exp)
+{
+    uint64_t hidden = (uint64_t)1 << mant_bits;
+    DIYFP v, m_plus, m_minus, c, w, w_plus, w_minus, one;
+    uint64_t delta, dist, p2, rest, ten;
+    uint32_t p1, pow10;
+    int k, idx, n, len = 0, m = 0;
+
+    /* Value and the midpoints to its neighbours */
+    if (bexp == 0) v = diy(frac, 1 - bias - mant_bits);
+    else v = diy(frac + hidden, bexp - bias - mant_bits);
+
+    m_plus = diy_normalize(diy(2 * v.f + 1, v.e - 1));
+    if (frac == 0 && bexp > 1) m_minus = diy(4 * v.f - 1, v.e - 2);
+    else m_minus = diy(2 * v.f - 1, v.e - 1);
+    m_minus.f <<= m_minus.e - m_plus.e;
+    m_minus.e = m_plus.e;
+    v = diy_normalize(v);
+
+    /* Scale by a cached 10^-k so the product's exponent is in [-60, -32] */
+    k = -60 - m_plus.e - 1;
+    k = (k * 78913) / (1 << 18) + (k > 0);
+    idx = (300 + k + 7) / 8;
+    c = diy(cached_pow10[idx].f, cached_pow10[idx].e);
+    *dec_exp = -cached_pow10[idx].k;
+
+    w = diy_mul(v, c);
+    w_plus = diy_mul(m_plus, c);
+    w_minus = diy_mul(m_minus, c);
+    w_plus.f--;
+    w_minus.f++;
+
+    one = diy((uint64_t)1 << -w_plus.e, w_plus.e);
+    delta = w_plus.f - w_minus.f;
+    dist = w_plus.f - w.f;
+    p1 = (uint32_t)(w_plus.f >> -one.e);
+    p2 = w_plus.f & (one.f - 1);
+
+    /* Integral digits */
+    for (n = 10, pow10 = 1000000000; n > 1 && p1 < pow10; n--) pow10 /= 10;
+    while (n > 0) {
+        digits[len++] = (char)('0' + p1 / pow10);
+        p1 %= pow10;
+        n--;
+        rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta) {
+            *dec_exp += n;
+            ten = (uint64_t)pow10 << -one.e;
+            goto round;
+        }
+        pow10 /= 10;
     }
 
-    memcpy(&fval, tmp, sizeof(float));
+    /* Fractional digits */
+    for (;;) {
+        p2 *= 10;
+        digits[len++] = (char)('0' + (p2 >> -one.e));
+        p2 &= one.f - 1;
+        m++;
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) break;
+    }
+    *dec_exp -= m;
+    rest = p2;
+    ten = one.f;
+
+round:
+    /* Step the last digit towards w while staying inside the boundaries */
+    while (rest < dist && delta - rest >= ten &&
+           (rest + ten < dist || dist - rest > rest + ten - dist)) {
+        digits[len - 1]--;
+        rest += ten;
+    }
+    return len;
+}
 
-    /* Format and trim trailing zeros */
-    if (out_size < 32) return ODV_ERROR_BUFFER_OVER;
+/*
+ * IEEE bits -> text.  max_x is the first decimal exponent printed in
+ * scientific form (10 for BINARY_FLOAT, 17 for BINARY_DOUBLE, as the
+ * %.10g / %.17g this replaces).
+ */
+static int format_ieee(uint64_t bits, int mant_bits, int exp_bits, int max_x,
+                       char *out)
+{
+    int bias = (1 << (exp_bits - 1)) - 1;
+    int bexp = (int)(bits >> mant_bits) & ((1 << exp_bits) - 1);
+    uint64_t frac = bits & (((uint64_t)1 << mant_bits) - 1);
+    int neg = (int)(bits >> (mant_bits + exp_bits)) & 1;
+    char digits[20];
+    char *p = out;
+    int len, k, x, i;
+
+    if (bexp == (1 << exp_bits) - 1) {
+        if (frac) { memcpy(out, "NaN", 4); return 3; }
+        memcpy(out, neg ? "-Inf" : "Inf", neg ? 5 : 4);
+        return neg ? 4 : 3;
+    }
+    if (neg) *p++ = '-';
+    if (bexp == 0 && frac == 0) {
+        *p++ = '0';
+        *p = '\0';
+        return (int)(p - out);
+    }
+
+    len = grisu2(frac, bexp, mant_bits, bias, digits, &k);
+    x = len + k - 1;    /* Exponent of the leading digit */
 
-    /* IEEE 754 special values */
-    if (fval != fval) {
-        /* NaN: use uppercase representation */
-        odv_strcpy(out, "NaN", out_size - 1);
-    } else if (fval > 3.402823e+38f) {
-        odv_strcpy(out, "Inf", out_size - 1);
-    } else if (fval < -3.402823e+38f) {
-        odv_strcpy(out, "-Inf", out_size - 1);
+    if (x < -4 || x >= max_x) {
+        /* d.ddde+XX */
+        *p++ = digits[0];
+        if (len > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, len - 1);
+            p += len - 1;
+        }
+        *p++ = 'e';
+        *p++ = (x < 0) ? '-' : '+';
+        if (x < 0) x = -x;
+        if (x >= 100) *p++ = (char)('0' + x / 100);
+        *p++ = (char)('0' + x / 10 % 10);
+        *p++ = (char)('0' + x % 10);
+    } else if (k >= 0) {
+        /* 1200 */
+        memcpy(p, digits, len);
+        p += len;
+        for (i = 0; i < k; i++) *p++ = '0';
+    } else if (x >= 0) {
+        /* 12.34 */
+        memcpy(p, digits, x + 1);
+        p += x + 1;
+        *p++ = '.';
+        memcpy(p, digits + x + 1, len - x - 1);
+        p += len - x - 1;
     } else {
-        snprintf(out, out_size, "%.10g", (double)fval);
+        /* 0.001234 */
+        *p++ = '0';
+        *p++ = '.';
+        for (i = -1; i > x; i--) *p++ = '0';
+        memcpy(p, digits, len);
+        p += len;
     }
+    *p = '\0';
+    return (int)(p - out);
+}
 
-    return ODV_OK;
+/*
+ * Oracle BINARY_FLOAT / BINARY_DOUBLE bytes -> IEEE 754 bits.
+ * Oracle stores the value big-endian with a modified sign:
+ *   - If high bit set (byte[0] >= 0x80): subtract 0x80 from byte[0]
+ *   - If high bit clear (byte[0] < 0x80): XOR all bytes with 0xFF
+ */
+uint64_t oracle_ieee_bits(const unsigned char *buf, int nbytes)
+{
+    uint64_t bits = 0;
+    int i;
+
+    for (i = 0; i < nbytes; i++) bits = (bits << 8) | buf[i];
+    if (buf[0] >= 0x80) bits ^= (uint64_t)0x80 << ((nbytes - 1) * 8);
+    else bits = ~bits & (nbytes == 8 ? ~(uint64_t)0 : 0xFFFFFFFFu);
+    return bits;
+}
+
+/*---------------------------------------------------------------------------
+    decode_binary_float
+
+    Decodes 4-byte Oracle BINARY_FLOAT (shortest round-trip text).
+    out_size must be at least 32. Returns the text length.
+ ---------------------------------------------------------------------------*/
+int decode_binary_float(const unsigned char *buf, char *out, int out_size)
+{
+    if (!buf || !out || out_size < 2) return ODV_ERROR_INVALID_ARG;
+    if (out_size < 32) return ODV_ERROR_BUFFER_OVER;
+
+    return format_ieee(oracle_ieee_bits(buf, 4), 23, 8, 10, out);
 }
 
 /*---------------------------------------------------------------------------
@@ -288,53 +705,10 @@ int decode_binary_float(const unsigned char *buf, char *out, int out_size)
  ---------------------------------------------------------------------------*/
 int decode_binary_double(const unsigned char *buf, char *out, int out_size)
 {
-    unsigned char tmp[8];
-    double dval;
-
     if (!buf || !out || out_size < 2) return ODV_ERROR_INVALID_ARG;
-
-    /* Copy and transform */
-    memcpy(tmp, buf, 8);
-
-    if (tmp[0] >= 0x80) {
-        tmp[0] -= 0x80;
-    } else {
-        tmp[0] ^= 0xFF;
-        tmp[1] ^= 0xFF;
-        tmp[2] ^= 0xFF;
-        tmp[3] ^= 0xFF;
-        tmp[4] ^= 0xFF;
-        tmp[5] ^= 0xFF;
-        tmp[6] ^= 0xFF;
-        tmp[7] ^= 0xFF;
-    }
-
-    /* Reverse byte order: big-endian to little-endian */
-    {
-        unsigned char t;
-        t = tmp[0]; tmp[0] = tmp[7]; tmp[7] = t;
-        t = tmp[1]; tmp[1] = tmp[6]; tmp[6] = t;
-        t = tmp[2]; tmp[2] = tmp[5]; tmp[5] = t;
-        t = tmp[3]; tmp[3] = tmp[4]; tmp[4] = t;
-    }
-
-    memcpy(&dval, tmp, sizeof(double));
-
-    /* Format and trim trailing zeros */
     if (out_size < 32) return ODV_ERROR_BUFFER_OVER;
 
-    /* IEEE 754 special values */
-    if (dval != dval) {
-        odv_strcpy(out, "NaN", out_size - 1);
-    } else if (dval > 1.7976931348623157e+308) {
-        odv_strcpy(out, "Inf", out_size - 1);
-    } else if (dval < -1.7976931348623157e+308) {
-        odv_strcpy(out, "-Inf", out_size - 1);
-    } else {
-        snprintf(out, out_size, "%.17g", dval);
-    }
-
-    return ODV_OK;
+    return format_ieee(oracle_ieee_bits(buf, 8), 52, 11, 17, out);
 }
 
 /*---------------------------------------------------------------------------
@@ -345,12 +719,14 @@ int decode_binary_double(const unsigned char *buf, char *out, int out_size)
       Byte  4  : Month (excess-60)
 
     Output: "+YY-MM" or "-YY-MM"
+    Returns the text length, or a negative ODV_ERROR_* code.
  ---------------------------------------------------------------------------*/
 int decode_interval_ym(const unsigned char *buf, int len, char *out, int out_size)
 {
     int32_t year;
     int month;
     const char *sign;
+    int n;
 
     if (!buf || !out || out_size < 16) return ODV_ERROR_INVALID_ARG;
     if (len < 5) { out[0] = '\0'; return ODV_ERROR_FORMAT; }
@@ -368,7 +744,40 @@ int decode_interval_ym(const unsigned char *buf, int len, char *out, int out_siz
         sign = "+";
     }
 
-    snprintf(out, out_size, "%s%d-%d", sign, year, month);
+    n = snprintf(out, out_size, "%s%d-%d", sign, year, month);
+    return (n < out_size) ? n : out_size - 1;
+}
+
+/*---------------------------------------------------------------------------
+    odv_interval_parts
+
+    INTERVAL YEAR TO MONTH (ym = 1) or DAY TO SECOND (ym = 0) as signed
+    months / days / microseconds, for typed encoders.
+    Returns ODV_OK, or ODV_ERROR_FORMAT if the value is too short.
+ ---------------------------------------------------------------------------*/
+int odv_interval_parts(const unsigned char *buf, int len, int ym,
+                       int32_t *months, int32_t *days, int64_t *us)
+{
+    int32_t lead, frac;
+
+    if (!buf || !months || !days || !us) return ODV_ERROR_INVALID_ARG;
+    if (len < (ym ? 5 : 11)) return ODV_ERROR_FORMAT;
+
+    lead = (int32_t)((((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+                     ((uint32_t)buf[2] << 8) | (uint32_t)buf[3]) - 0x80000000u);
+    if (ym) {
+        *months = (int32_t)((int64_t)lead * 12 + ((int)buf[4] - 60));
+        *days = 0;
+        *us = 0;
+        return ODV_OK;
+    }
+
+    frac = (int32_t)((((uint32_t)buf[7] << 24) | ((uint32_t)buf[8] << 16) |
+                     ((uint32_t)buf[9] << 8) | (uint32_t)buf[10]) - 0x80000000u);
+    *months = 0;
+    *days = lead;
+    *us = ((int64_t)((int)buf[4] - 60) * 3600 + ((int)buf[5] - 60) * 60 + ((int)buf[6] - 60))
+          * 1000000 + (frac + (frac < 0 ? -500 : 500)) / 1000;
     return ODV_OK;
 }
 
@@ -383,6 +792,7 @@ int decode_interval_ym(const unsigned char *buf, int len, char *out, int out_siz
       Bytes 7-10: Frac second (big-endian, excess-0x80000000, in nanoseconds)
 
     Output: "+DD HH:MI:SS.FFFFFFFFF" or "-DD HH:MI:SS.FFFFFFFFF"
+    Returns the text length, or a negative ODV_ERROR_* code.
  ---------------------------------------------------------------------------*/
 int decode_interval_ds(const unsigned char *buf, int len, char *out, int out_size)
 {
@@ -390,6 +800,7 @@ int decode_interval_ds(const unsigned char *buf, int len, char *out, int out_siz
     int hour, minute, second;
     int32_t frac;
     const char *sign;
+    int n;
 
     if (!buf || !out || out_size < 40) return ODV_ERROR_INVALID_ARG;
     if (len < 11) { out[0] = '\0'; return ODV_ERROR_FORMAT; }
@@ -415,19 +826,18 @@ int decode_interval_ds(const unsigned char *buf, int len, char *out, int out_siz
     }
 
     if (frac > 0) {
-        snprintf(out, out_size, "%s%d %02d:%02d:%02d.%09d",
-                 sign, day, hour, minute, second, frac);
+        n = snprintf(out, out_size, "%s%d %02d:%02d:%02d.%09d",
+                     sign, day, hour, minute, second, frac);
+        if (n >= out_size) n = out_size - 1;
         /* Trim trailing zeros from fractional part */
-        {
-            int p = (int)strlen(out);
-            while (p > 0 && out[p - 1] == '0') p--;
-            if (p > 0 && out[p - 1] == '.') p--;
-            out[p] = '\0';
-        }
+        while (n > 0 && out[n - 1] == '0') n--;
+        if (n > 0 && out[n - 1] == '.') n--;
+        out[n] = '\0';
     } else {
-        snprintf(out, out_size, "%s%d %02d:%02d:%02d",
-                 sign, day, hour, minute, second);
+        n = snprintf(out, out_size, "%s%d %02d:%02d:%02d",
+                     sign, day, hour, minute, second);
+        if (n >= out_size) n = out_size - 1;
     }
 
-    return ODV_OK;
+    return n;
 }
@@ -0,0 +1,482 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_deflate.c
+    DEFLATE (RFC 1951) encoder and gzip (RFC 1952) members
+
+    Each call compresses one self-contained block: the LZ77 parse from
+    odv_lz_parse (32 KB window, matches of 4..258 bytes) is cut into
+    DEFLATE blocks of DF_BLOCK_TOKENS symbols, and every block is written
+    with whichever of dynamic Huffman, fixed Huffman or stored coding
+    is smallest.  Used by the compressed export output (odv_compress.c).
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+
+#define DF_WINDOW         32768
+#define DF_MAX_MATCH      258
+#define DF_BLOCK_TOKENS   32768
+#define DF_STORED_MAX     65535
+#define DF_TOKEN_MATCH    0x80000000u   /* | (length - 3) << 15 | (distance - 1) */
+
+#define DF_LITLEN_CODES   286
+#define DF_DIST_CODES     30
+#define DF_CLEN_CODES     19
+
+/*---------------------------------------------------------------------------
+    CRC-32 (ISO-HDLC, reflected polynomial 0xEDB88320)
+ ---------------------------------------------------------------------------*/
+static const uint32_t crc_table[256] = {
+    0x00000000u, 0x77073096u, 0xEE0E612Cu, 0x990951BAu, 0x076DC419u, 0x706AF48Fu,
+    0xE963A535u, 0x9E6495A3u, 0x0EDB8832u, 0x79DCB8A4u, 0xE0D5E91Eu, 0x97D2D988u,
+    0x09B64C2Bu, 0x7EB17CBDu, 0xE7B82D07u, 0x90BF1D91u, 0x1DB71064u, 0x6AB020F2u,
+    0xF3B97148u, 0x84BE41DEu, 0x1ADAD47Du, 0x6DDDE4EBu, 0xF4D4B551u, 0x83D385C7u,
+    0x136C9856u, 0x646BA8C0u, 0xFD62F97Au, 0x8A65C9ECu, 0x14015C4Fu, 0x63066CD9u,
+    0xFA0F3D63u, 0x8D080DF5u, 0x3B6E20C8u, 0x4C69105Eu, 0xD56041E4u, 0xA2677172u,
+    0x3C03E4D1u, 0x4B04D447u, 0xD20D85FDu, 0xA50AB56Bu, 0x35B5A8FAu, 0x42B2986Cu,
+    0xDBBBC9D6u, 0xACBCF940u, 0x32D86CE3u, 0x45DF5C75u, 0xDCD60DCFu, 0xABD13D59u,
+    0x26D930ACu, 0x51DE003Au, 0xC8D75180u, 0xBFD06116u, 0x21B4F4B5u, 0x56B3C423u,
+    0xCFBA9599u, 0xB8BDA50Fu, 0x2802B89Eu, 0x5F058808u, 0xC60CD9B2u, 0xB10BE924u,
+    0x2F6F7C87u, 0x58684C11u, 0xC1611DABu, 0xB6662D3Du, 0x76DC4190u, 0x01DB7106u,
+    0x98D220BCu, 0xEFD5102Au, 0x71B18589u, 0x06B6B51Fu, 0x9FBFE4A5u, 0xE8B8D433u,
+    0x7807C9A2u, 0x0F00F934u, 0x9609A88Eu, 0xE10E9818u, 0x7F6A0DBBu, 0x086D3D2Du,
+    0x91646C97u, 0xE6635C01u, 0x6B6B51F4u, 0x1C6C6162u, 0x856530D8u, 0xF262004Eu,
+    0x6C0695EDu, 0x1B01A57Bu, 0x8208F4C1u, 0xF50FC457u, 0x65B0D9C6u, 0x12B7E950u,
+    0x8BBEB8EAu, 0xFCB9887Cu, 0x62DD1DDFu, 0x15DA2D49u, 0x8CD37CF3u, 0xFBD44C65u,
+    0x4DB26158u, 0x3AB551CEu, 0xA3BC0074u, 0xD4BB30E2u, 0x4ADFA541u, 0x3DD895D7u,
+    0xA4D1C46Du, 0xD3D6F4FBu, 0x4369E96Au, 0x346ED9FCu, 0xAD678846u, 0xDA60B8D0u,
+    0x44042D73u, 0x33031DE5u, 0xAA0A4C5Fu, 0xDD0D7CC9u, 0x5005713Cu, 0x270241AAu,
+    0xBE0B1010u, 0xC90C2086u, 0x5768B525u, 0x206F85B3u, 0xB966D409u, 0xCE61E49Fu,
+    0x5EDEF90Eu, 0x29D9C998u, 0xB0D09822u, 0xC7D7A8B4u, 0x59B33D17u, 0x2EB40D81u,
+    0xB7BD5C3Bu, 0xC0BA6CADu, 0xEDB88320u, 0x9ABFB3B6u, 0x03B6E20Cu, 0x74B1D29Au,
+    0xEAD54739u, 0x9DD277AFu, 0x04DB2615u, 0x73DC1683u, 0xE3630B12u, 0x94643B84u,
+    0x0D6D6A3Eu, 0x7A6A5AA8u, 0xE40ECF0Bu, 0x9309FF9Du, 0x0A00AE27u, 0x7D079EB1u,
+    0xF00F9344u, 0x8708A3D2u, 0x1E01F268u, 0x6906C2FEu, 0xF762575Du, 0x806567CBu,
+    0x196C3671u, 0x6E6B06E7u, 0xFED41B76u, 0x89D32BE0u, 0x10DA7A5Au, 0x67DD4ACCu,
+    0xF9B9DF6Fu, 0x8EBEEFF9u, 0x17B7BE43u, 0x60B08ED5u, 0xD6D6A3E8u, 0xA1D1937Eu,
+    0x38D8C2C4u, 0x4FDFF252u, 0xD1BB67F1u, 0xA6BC5767u, 0x3FB506DDu, 0x48B2364Bu,
+    0xD80D2BDAu, 0xAF0A1B4Cu, 0x36034AF6u, 0x41047A60u, 0xDF60EFC3u, 0xA867DF55u,
+    0x316E8EEFu, 0x4669BE79u, 0xCB61B38Cu, 0xBC66831Au, 0x256FD2A0u, 0x5268E236u,
+    0xCC0C7795u, 0xBB0B4703u, 0x220216B9u, 0x5505262Fu, 0xC5BA3BBEu, 0xB2BD0B28u,
+    0x2BB45A92u, 0x5CB36A04u, 0xC2D7FFA7u, 0xB5D0CF31u, 0x2CD99E8Bu, 0x5BDEAE1Du,
+    0x9B64C2B0u, 0xEC63F226u, 0x756AA39Cu, 0x026D930Au, 0x9C0906A9u, 0xEB0E363Fu,
+    0x72076785u, 0x05005713u, 0x95BF4A82u, 0xE2B87A14u, 0x7BB12BAEu, 0x0CB61B38u,
+    0x92D28E9Bu, 0xE5D5BE0Du, 0x7CDCEFB7u, 0x0BDBDF21u, 0x86D3D2D4u, 0xF1D4E242u,
+    0x68DDB3F8u, 0x1FDA836Eu, 0x81BE16CDu, 0xF6B9265Bu, 0x6FB077E1u, 0x18B74777u,
+    0x88085AE6u, 0xFF0F6A70u, 0x66063BCAu, 0x11010B5Cu, 0x8F659EFFu, 0xF862AE69u,
+    0x616BFFD3u, 0x166CCF45u, 0xA00AE278u, 0xD70DD2EEu, 0x4E048354u, 0x3903B3C2u,
+    0xA7672661u, 0xD06016F7u, 0x4969474Du, 0x3E6E77DBu, 0xAED16A4Au, 0xD9D65ADCu,
+    0x40DF0B66u, 0x37D83BF0u, 0xA9BCAE53u, 0xDEBB9EC5u, 0x47B2CF7Fu, 0x30B5FFE9u,
+    0xBDBDF21Cu, 0xCABAC28Au, 0x53B39330u, 0x24B4A3A6u, 0xBAD03605u, 0xCDD70693u,
+    0x54DE5729u, 0x23D967BFu, 0xB3667A2Eu, 0xC4614AB8u, 0x5D681B02u, 0x2A6F2B94u,
+    0xB40BBE37u, 0xC30C8EA1u, 0x5A05DF1Bu, 0x2D02EF8Du
+};
+
+uint32_t odv_crc32(uint32_t crc, const void *p, size_t n)
+{
+    const unsigned char *s = (const unsigned char *)p;
+
+    crc = ~crc;
+    while (n--) crc = crc_table[(crc ^ *s++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/*---------------------------------------------------------------------------
+    Bit output (LSB first)
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    unsigned char *p;
+    unsigned char *end;
+    uint64_t       acc;
+    int            bits;
+    int            overflow;
+} DF_BITS;
+
+static void df_put(DF_BITS *b, uint32_t v, int n)
+{
+    b->acc |= (uint64_t)v << b->bits;
+    b->bits += n;
+    if (b->bits >= 32) {
+        if (b->end - b->p >= 4) {
+            b->p[0] = (unsigned char)b->acc;
+            b->p[1] = (unsigned char)(b->acc >> 8);
+            b->p[2] = (unsigned char)(b->acc >> 16);
+            b->p[3] = (unsigned char)(b->acc >> 24);
+            b->p += 4;
+        } else {
+            b->overflow = 1;
+        }
+        b->acc >>= 32;
+        b->bits -= 32;
+    }
+}
+
+/* Pads with zero bits to a byte boundary and writes the pending bytes */
+static void df_align(DF_BITS *b)
+{
+    for (; b->bits > 0; b->bits -= 8) {
+        if (b->p < b->end) *b->p++ = (unsigned char)b->acc;
+        else b->overflow = 1;
+        b->acc >>= 8;
+    }
+    b->acc = 0;
+    b->bits = 0;
+}
+
+/*---------------------------------------------------------------------------
+    Symbols
+ ---------------------------------------------------------------------------*/
+
+/* Match length 3..258 -> length symbol 257..285 and its extra bits */
+static int df_length_code(int len, int *ebits, int *extra)
+{
+    int l = len - 3, e;
+
+    if (l < 8 || l == 255) {
+        *ebits = *extra = 0;
+        return (l < 8) ? 257 + l : 285;
+    }
+    e = odv_highbit32((uint32_t)l) - 2;
+    *ebits = e;
+    *extra = l - ((4 + ((l >> e) & 3)) << e);
+    return 261 + 4 * e + ((l >> e) & 3);
+}
+
+/* Distance 1..32768 -> distance symbol 0..29 and its extra bits */
+static int df_dist_code(int dist, int *ebits, int *extra)
+{
+    int x = dist - 1, e;
+
+    if (x < 4) {
+        *ebits = *extra = 0;
+        return x;
+    }
+    e = odv_highbit32((uint32_t)x) - 1;
+    *ebits = e;
+    *extra = x - ((2 + ((x >> e) & 1)) << e);
+    return 2 * e + 2 + ((x >> e) & 1);
+}
+
+static int df_length_extra_bits(int sym)
+{
+    int k = sym - 257;
+    return (k < 8 || k == 28) ? 0 : (k - 4) / 4;
+}
+
+static int df_dist_extra_bits(int sym)
+{
+    return (sym < 4) ? 0 : (sym - 2) / 2;
+}
+
+/* Canonical codes for the lengths, bit-reversed for LSB-first output */
+static void df_codes(const unsigned char *len, int n, uint16_t *code)
+{
+    int count[16], next[16];
+    int i, k, c = 0;
+
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < n; i++) count[len[i]]++;
+    count[0] = 0;
+    for (i = 1; i < 16; i++) {
+        c = (c + count[i - 1]) << 1;
+        next[i] = c;
+    }
+    for (i = 0; i < n; i++) {
+        uint32_t v, r = 0;
+        if (!len[i]) continue;
+        v = (uint32_t)next[len[i]]++;
+        for (k = 0; k < len[i]; k++) {
+            r = (r << 1) | (v & 1);
+            v >>= 1;
+        }
+        code[i] = (uint16_t)r;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    df_write_block
+
+    Writes one DEFLATE block holding tok[0..ntok), which decode to
+    raw[0..raw_len), using the cheapest of the three block types.
+ ---------------------------------------------------------------------------*/
+static const unsigned char clen_order[DF_CLEN_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+static void df_emit(DF_BITS *b, const uint32_t *tok, int ntok,
+                    const unsigned char *llen, const uint16_t *lcode,
+                    const unsigned char *dlen, const uint16_t *dcode)
+{
+    int i, sym, eb, ex;
+
+    for (i = 0; i < ntok; i++) {
+        uint32_t t = tok[i];
+        if (!(t & DF_TOKEN_MATCH)) {
+            df_put(b, lcode[t], llen[t]);
+            continue;
+        }
+        sym = df_length_code((int)((t >> 15) & 0xFF) + 3, &eb, &ex);
+        df_put(b, lcode[sym], llen[sym]);
+        if (eb) df_put(b, (uint32_t)ex, eb);
+        sym = df_dist_code((int)(t & 0x7FFF) + 1, &eb, &ex);
+        df_put(b, dcode[sym], dlen[sym]);
+        if (eb) df_put(b, (uint32_t)ex, eb);
+    }
+    df_put(b, lcode[256], llen[256]);
+}
+
+/* Bits of the symbols with the given code lengths, extra bits included */
+static uint64_t df_data_bits(const uint32_t *lfreq, const unsigned char *llen,
+                             const uint32_t *dfreq, const unsigned char *dlen)
+{
+    uint64_t bits = 0;
+    int i;
+
+    for (i = 0; i < 256; i++) bits += (uint64_t)lfreq[i] * llen[i];
+    bits += llen[256];
+    for (i = 257; i < DF_LITLEN_CODES; i++)
+        bits += (uint64_t)lfreq[i] * (uint64_t)(llen[i] + df_length_extra_bits(i));
+    for (i = 0; i < DF_DIST_CODES; i++)
+        bits += (uint64_t)dfreq[i] * (uint64_t)(dlen[i] + df_dist_extra_bits(i));
+    return bits;
+}
+
+static void df_write_stored(DF_BITS *b, const unsigned char *raw, int raw_len, int final)
+{
+    int off = 0;
+
+    do {
+        int k = ODV_MIN(raw_len - off, DF_STORED_MAX);
+        df_put(b, (final && off + k == raw_len) ? 1 : 0, 1);
+        df_put(b, 0, 2);
+        df_align(b);
+        if (b->end - b->p < 4 + k) {
+            b->overflow = 1;
+            return;
+        }
+        b->p[0] = (unsigned char)k;
+        b->p[1] = (unsigned char)(k >> 8);
+        b->p[2] = (unsigned char)~k;
+        b->p[3] = (unsigned char)(~k >> 8);
+        memcpy(b->p + 4, raw + off, (size_t)k);
+        b->p += 4 + k;
+        off += k;
+    } while (off < raw_len);
+}
+
+static void df_write_block(DF_BITS *b, const uint32_t *tok, int ntok,
+                           const unsigned char *raw, int raw_len, int final)
+{
+    uint32_t lfreq[DF_LITLEN_CODES], dfreq[DF_DIST_CODES], cfreq[DF_CLEN_CODES];
+    unsigned char llen[288], dlen[DF_DIST_CODES], clen[DF_CLEN_CODES];
+    unsigned char fixed_llen[288], fixed_dlen[DF_DIST_CODES];
+    uint16_t lcode[288], dcode[DF_DIST_CODES], ccode[DF_CLEN_CODES];
+    unsigned char lens[DF_LITLEN_CODES + DF_DIST_CODES];
+    unsigned char rle[DF_LITLEN_CODES + DF_DIST_CODES], rle_extra[DF_LITLEN_CODES + DF_DIST_CODES];
+    int nrle = 0, hlit, hdist, hclen, nlens, i, eb, ex;
+    uint64_t dyn_bits, fixed_bits, stored_bits;
+
+    memset(lfreq, 0, sizeof(lfreq));
+    memset(dfreq, 0, sizeof(dfreq));
+    for (i = 0; i < ntok; i++) {
+        uint32_t t = tok[i];
+        if (!(t & DF_TOKEN_MATCH)) {
+            lfreq[t]++;
+        } else {
+            lfreq[df_length_code((int)((t >> 15) & 0xFF) + 3, &eb, &ex)]++;
+            dfreq[df_dist_code((int)(t & 0x7FFF) + 1, &eb, &ex)]++;
+        }
+    }
+    lfreq[256] = 1;
+
+    /* Dynamic codes; a block without matches still needs one distance code */
+    odv_huffman_lengths(lfreq, DF_LITLEN_CODES, 15, llen);
+    odv_huffman_lengths(dfreq, DF_DIST_CODES, 15, dlen);
+    for (i = 0; i < DF_DIST_CODES && !dlen[i]; i++)
+        ;
+    if (i == DF_DIST_CODES) dlen[0] = 1;
+
+    for (hlit = DF_LITLEN_CODES; hlit > 257 && !llen[hlit - 1]; hlit--)
+        ;
+    for (hdist = DF_DIST_CODES; hdist > 1 && !dlen[hdist - 1]; hdist--)
+        ;
+    memcpy(lens, llen, (size_t)hlit);
+    memcpy(lens + hlit, dlen, (size_t)hdist);
+    nlens = hlit + hdist;
+
+    /* Code length sequence: 16 repeats the previous length 3-6 times,
+       17 / 18 give runs of 3-10 / 11-138 zeros */
+    memset(cfreq, 0, sizeof(cfreq));
+    for (i = 0; i < nlens; ) {
+        int cur = lens[i], run = 1;
+        while (i + run < nlens && lens[i + run] == cur) run++;
+        i += run;
+        if (cur == 0) {
+            while (run >= 11) {
+                int r = ODV_MIN(run, 138);
+                rle[nrle] = 18; rle_extra[nrle++] = (unsigned char)(r - 11);
+                run -= r;
+            }
+            if (run >= 3) {
+                rle[nrle] = 17; rle_extra[nrle++] = (unsigned char)(run - 3);
+                run = 0;
+            }
+        } else {
+            rle[nrle] = (unsigned char)cur; rle_extra[nrle++] = 0;
+            run--;
+            while (run >= 3) {
+                int r = ODV_MIN(run, 6);
+                rle[nrle] = 16; rle_extra[nrle++] = (unsigned char)(r - 3);
+                run -= r;
+            }
+        }
+        while (run-- > 0) {
+            rle[nrle] = (unsigned char)cur; rle_extra[nrle++] = 0;
+        }
+    }
+    for (i = 0; i < nrle; i++) cfreq[rle[i]]++;
+    odv_huffman_lengths(cfreq, DF_CLEN_CODES, 7, clen);
+    for (hclen = DF_CLEN_CODES; hclen > 4 && !clen[clen_order[hclen - 1]]; hclen--)
+        ;
+
+    dyn_bits = 3 + 14 + 3 * (uint64_t)hclen + df_data_bits(lfreq, llen, dfreq, dlen);
+    for (i = 0; i < nrle; i++)
+        dyn_bits += clen[rle[i]] + (rle[i] == 16 ? 2 : rle[i] == 17 ? 3 : rle[i] == 18 ? 7 : 0);
+
+    /* Fixed codes */
+    for (i = 0; i < 288; i++)
+        fixed_llen[i] = (unsigned char)(i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8);
+    memset(fixed_dlen, 5, sizeof(fixed_dlen));
+    fixed_bits = 3 + df_data_bits(lfreq, fixed_llen, dfreq, fixed_dlen);
+
+    stored_bits = 8 * (uint64_t)raw_len + 40 * (uint64_t)(raw_len / DF_STORED_MAX + 1) + 7;
+
+    if (stored_bits <= dyn_bits && stored_bits <= fixed_bits) {
+        df_write_stored(b, raw, raw_len, final);
+    } else if (fixed_bits <= dyn_bits) {
+        df_put(b, final ? 1 : 0, 1);
+        df_put(b, 1, 2);
+        df_codes(fixed_llen, 288, lcode);
+        df_codes(fixed_dlen, DF_DIST_CODES, dcode);
+        df_emit(b, tok, ntok, fixed_llen, lcode, fixed_dlen, dcode);
+    } else {
+        df_put(b, final ? 1 : 0, 1);
+        df_put(b, 2, 2);
+        df_put(b, (uint32_t)(hlit - 257), 5);
+        df_put(b, (uint32_t)(hdist - 1), 5);
+        df_put(b, (uint32_t)(hclen - 4), 4);
+        for (i = 0; i < hclen; i++) df_put(b, clen[clen_order[i]], 3);
+        df_codes(clen, DF_CLEN_CODES, ccode);
+        for (i = 0; i < nrle; i++) {
+            int sym = rle[i];
+            df_put(b, ccode[sym], clen[sym]);
+            if (sym == 16) df_put(b, rle_extra[i], 2);
+            else if (sym == 17) df_put(b, rle_extra[i], 3);
+            else if (sym == 18) df_put(b, rle_extra[i], 7);
+        }
+        df_codes(llen, DF_LITLEN_CODES, lcode);
+        df_codes(dlen, DF_DIST_CODES, dcode);
+        df_emit(b, tok, ntok, llen, lcode, dlen, dcode);
+    }
+}
+
+/*---------------------------------------------------------------------------
+    odv_deflate_chunk
+
+    Compresses src[0..n) as one piece of a raw DEFLATE stream.  With
+    final set the last block ends the stream; otherwise an empty stored
+    block byte-aligns the output (a sync flush) so the next chunk can be
+    appended.  Matches do not reach back into earlier chunks.
+    level: 1 (fastest) .. 9 (smallest).
+    Returns the compressed size, or ODV_ERROR_MALLOC / ODV_ERROR_BUFFER_OVER.
+ ---------------------------------------------------------------------------*/
+int odv_deflate_chunk(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                      int final, unsigned char *dst, int cap)
+{
+    DF_BITS b;
+    uint32_t *tok;
+    uint32_t lit_done = 0;
+    int nseq, i = 0, pos = 0;
+
+    nseq = odv_lz_parse(lz, src, n, level, DF_WINDOW, DF_MAX_MATCH);
+    if (nseq < 0) return nseq;
+    tok = (uint32_t *)odv_lz_scratch(lz, sizeof(uint32_t) * DF_BLOCK_TOKENS);
+    if (!tok) return ODV_ERROR_MALLOC;
+
+    memset(&b, 0, sizeof(b));
+    b.p = dst;
+    b.end = dst + cap;
+
+    do {
+        int start = pos, ntok = 0;
+
+        while (i < nseq && ntok < DF_BLOCK_TOKENS) {
+            const ODV_LZ_SEQ *q = &lz->seqs[i];
+            while (lit_done < q->lit_len && ntok < DF_BLOCK_TOKENS) {
+                tok[ntok++] = src[pos++];
+                lit_done++;
+            }
+            if (lit_done < q->lit_len) break;
+            if (q->match_len) {
+                if (ntok == DF_BLOCK_TOKENS) break;
+                tok[ntok++] = DF_TOKEN_MATCH | ((q->match_len - 3) << 15) | (q->offset - 1);
+                pos += (int)q->match_len;
+            }
+            i++;
+            lit_done = 0;
+        }
+        df_write_block(&b, tok, ntok, src + start, pos - start, final && i >= nseq);
+    } while (i < nseq && !b.overflow);
+
+    if (!final) df_write_stored(&b, src, 0, 0);
+    df_align(&b);
+    if (b.overflow) return ODV_ERROR_BUFFER_OVER;
+    return (int)(b.p - dst);
+}
+
+/*---------------------------------------------------------------------------
+    odv_deflate
+
+    Compresses src[0..n) into a complete raw DEFLATE stream (last block
+    marked final).  level: 1 (fastest) .. 9 (smallest).
+    Returns the compressed size, or ODV_ERROR_MALLOC / ODV_ERROR_BUFFER_OVER.
+ ---------------------------------------------------------------------------*/
+int odv_deflate(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                unsigned char *dst, int cap)
+{
+    return odv_deflate_chunk(lz, src, n, level, 1, dst, cap);
+}
+
+/*---------------------------------------------------------------------------
+    odv_gzip_member
+
+    One gzip member: 10-byte header (no name, no time stamp), the
+    DEFLATE stream, CRC-32 and the input size.
+ ---------------------------------------------------------------------------*/
+int odv_gzip_member(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                    unsigned char *dst, int cap)
+{
+    static const unsigned char header[10] = { 0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF };
+    uint32_t crc;
+    unsigned char *p;
+    int len;
+
+    if (cap < 18) return ODV_ERROR_BUFFER_OVER;
+    memcpy(dst, header, sizeof(header));
+    len = odv_deflate(lz, src, n, level, dst + 10, cap - 18);
+    if (len < 0) return len;
+
+    crc = odv_crc32(0, src, (size_t)n);
+    p = dst + 10 + len;
+    p[0] = (unsigned char)crc;
+    p[1] = (unsigned char)(crc >> 8);
+    p[2] = (unsigned char)(crc >> 16);
+    p[3] = (unsigned char)(crc >> 24);
+    p[4] = (unsigned char)n;
+    p[5] = (unsigned char)(n >> 8);
+    p[6] = (unsigned char)(n >> 16);
+    p[7] = (unsigned char)(n >> 24);
+    return len + 18;
+}
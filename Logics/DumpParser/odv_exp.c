@@ -27,7 +27,8 @@
  ---------------------------------------------------------------------------*/
 static int parse_exp_header(ODV_SESSION *s, FILE *fp);
 static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only);
-static int parse_column_type(const char *type_str, ODV_COLUMN *col);
+static int parse_column_type(const char *type_str, ODV_COLUMN *col,
+                             ODV_COLDESC *d);
 static void trim_right(char *str);
 
 /*---------------------------------------------------------------------------
@@ -259,19 +260,19 @@ static const char *parse_constraint_columns(const char *p, ODV_CONSTRAINT *c, in
 /*---------------------------------------------------------------------------
     add_constraint
 
-    Adds a constraint to the current table if there's room.
-    Returns pointer to the new constraint, or NULL if full.
+    Adds a constraint to the current table.
+    Returns pointer to the new constraint, or NULL if out of memory.
  ---------------------------------------------------------------------------*/
 static ODV_CONSTRAINT *add_constraint(ODV_SESSION *s, int type)
 {
     /* If a constraint with the same name already exists, upgrade it
        (e.g., CREATE UNIQUE INDEX → ALTER TABLE ADD PRIMARY KEY) */
     /* For PK/UNIQUE: check if name matches an existing UNIQUE and upgrade to PK */
-    if (s->table.constraint_count >= ODV_MAX_CONSTRAINTS) return NULL;
-    ODV_CONSTRAINT *c = &s->table.constraints[s->table.constraint_count];
-    memset(c, 0, sizeof(ODV_CONSTRAINT));
+    ODV_CONSTRAINT *c;
+    odv_tee_sync(s);        /* Tee writers read the constraint list */
+    c = odv_table_add_constraint(&s->table);
+    if (!c) return NULL;
     c->type = type;
-    s->table.constraint_count++;
     return c;
 }
 
@@ -506,7 +507,8 @@ static int parse_create_table(ODV_SESSION *s, const char *ddl)
     }
 
     /* Store table info */
-    memset(&s->table, 0, sizeof(ODV_TABLE));
+    odv_tee_sync(s);
+    odv_table_reset(&s->table);
     odv_strcpy(s->table.schema, schema, ODV_OBJNAME_LEN);
     odv_strcpy(s->table.name, table_name, ODV_OBJNAME_LEN);
     s->table.dump_charset = s->dump_charset;
@@ -639,10 +641,10 @@ static int parse_create_table(ODV_SESSION *s, const char *ddl)
 
         /* Store column */
         if (col_name[0] != '\0' && type_str[0] != '\0') {
-            ODV_COLUMN *col = &s->table.columns[col_count];
-            memset(col, 0, sizeof(ODV_COLUMN));
+            ODV_COLUMN *col = odv_table_column(&s->table, col_count);
+            if (!col) break;
             odv_strcpy(col->name, col_name, ODV_OBJNAME_LEN);
-            parse_column_type(type_str, col);
+            parse_column_type(type_str, col, &s->table.desc[col_count]);
             col->not_null = not_null_flag;
             odv_strcpy(col->default_val, default_str, 255);
             col_count++;
@@ -657,7 +659,7 @@ static int parse_create_table(ODV_SESSION *s, const char *ddl)
     {
         int i;
         for (i = 0; i < col_count; i++) {
-            int t = s->table.columns[i].type;
+            int t = s->table.desc[i].type;
             if (t == COL_BLOB || t == COL_CLOB || t == COL_NCLOB ||
                 t == COL_BFILE || t == COL_USER_DEFINE) {
                 s->table.lob_col_count++;
@@ -671,9 +673,11 @@ static int parse_create_table(ODV_SESSION *s, const char *ddl)
 /*---------------------------------------------------------------------------
     parse_column_type
 
-    Parses a type string like "VARCHAR2(100)" into ODV_COLUMN fields.
+    Parses a type string like "VARCHAR2(100)" into the column's type
+    string (col) and decode descriptor (d).
  ---------------------------------------------------------------------------*/
-static int parse_column_type(const char *type_str, ODV_COLUMN *col)
+static int parse_column_type(const char *type_str, ODV_COLUMN *col,
+                             ODV_COLDESC *d)
 {
     char upper[256];
     int i;
@@ -690,53 +694,53 @@ static int parse_column_type(const char *type_str, ODV_COLUMN *col)
 
     /* Match type and extract parameters */
     if (starts_with_ci(upper, "VARCHAR2") || starts_with_ci(upper, "VARCHAR")) {
-        col->type = COL_VARCHAR;
+        d->type = COL_VARCHAR;
     } else if (starts_with_ci(upper, "NVARCHAR2") || starts_with_ci(upper, "NVARCHAR")) {
-        col->type = COL_NVARCHAR;
+        d->type = COL_NVARCHAR;
     } else if (starts_with_ci(upper, "NCHAR")) {
-        col->type = COL_NCHAR;
+        d->type = COL_NCHAR;
     } else if (starts_with_ci(upper, "CHAR")) {
-        col->type = COL_CHAR;
+        d->type = COL_CHAR;
     } else if (starts_with_ci(upper, "NUMBER")) {
-        col->type = COL_NUMBER;
+        d->type = COL_NUMBER;
     } else if (starts_with_ci(upper, "FLOAT")) {
-        col->type = COL_FLOAT;
+        d->type = COL_FLOAT;
     } else if (starts_with_ci(upper, "BINARY_FLOAT")) {
-        col->type = COL_BIN_FLOAT;
+        d->type = COL_BIN_FLOAT;
     } else if (starts_with_ci(upper, "BINARY_DOUBLE")) {
-        col->type = COL_BIN_DOUBLE;
+        d->type = COL_BIN_DOUBLE;
     } else if (starts_with_ci(upper, "TIMESTAMP") && strstr(upper, "LOCAL")) {
-        col->type = COL_TIMESTAMP_LTZ;
+        d->type = COL_TIMESTAMP_LTZ;
     } else if (starts_with_ci(upper, "TIMESTAMP") && strstr(upper, "TIME ZONE")) {
-        col->type = COL_TIMESTAMP_TZ;
+        d->type = COL_TIMESTAMP_TZ;
     } else if (starts_with_ci(upper, "TIMESTAMP")) {
-        col->type = COL_TIMESTAMP;
+        d->type = COL_TIMESTAMP;
     } else if (starts_with_ci(upper, "DATE")) {
-        col->type = COL_DATE;
+        d->type = COL_DATE;
     } else if (starts_with_ci(upper, "INTERVAL") && strstr(upper, "YEAR")) {
-        col->type = COL_INTERVAL_YM;
+        d->type = COL_INTERVAL_YM;
     } else if (starts_with_ci(upper, "INTERVAL") && strstr(upper, "DAY")) {
-        col->type = COL_INTERVAL_DS;
+        d->type = COL_INTERVAL_DS;
     } else if (starts_with_ci(upper, "LONG RAW")) {
-        col->type = COL_LONG_RAW;
+        d->type = COL_LONG_RAW;
     } else if (starts_with_ci(upper, "LONG")) {
-        col->type = COL_LONG;
+        d->type = COL_LONG;
     } else if (starts_with_ci(upper, "RAW")) {
-        col->type = COL_RAW;
+        d->type = COL_RAW;
     } else if (starts_with_ci(upper, "BLOB")) {
-        col->type = COL_BLOB;
+        d->type = COL_BLOB;
     } else if (starts_with_ci(upper, "NCLOB")) {
-        col->type = COL_NCLOB;
+        d->type = COL_NCLOB;
     } else if (starts_with_ci(upper, "CLOB")) {
-        col->type = COL_CLOB;
+        d->type = COL_CLOB;
     } else if (starts_with_ci(upper, "BFILE")) {
-        col->type = COL_BFILE;
+        d->type = COL_BFILE;
     } else if (starts_with_ci(upper, "XMLTYPE")) {
-        col->type = COL_XMLTYPE;
+        d->type = COL_XMLTYPE;
     } else if (starts_with_ci(upper, "ROWID") || starts_with_ci(upper, "UROWID")) {
-        col->type = COL_ROWID;
+        d->type = COL_ROWID;
     } else {
-        col->type = COL_VARCHAR;  /* default fallback */
+        d->type = COL_VARCHAR;  /* default fallback */
     }
 
     /* Extract length/precision/scale from parentheses */
@@ -746,42 +750,42 @@ static int parse_column_type(const char *type_str, ODV_COLUMN *col)
         if (p) {
             has_parens = 1;
             p++;
-            col->length = atoi(p);
+            d->length = atoi(p);
 
             /* For NUMBER(p,s) */
             p = strchr(p, ',');
             if (p) {
                 p++;
-                col->scale = atoi(p);
-                col->precision = col->length;
+                d->scale = atoi(p);
+                d->precision = d->length;
             }
         }
 
         /* For TIMESTAMP types, parenthesized value is fractional seconds precision */
-        switch (col->type) {
+        switch (d->type) {
         case COL_TIMESTAMP:
         case COL_TIMESTAMP_TZ:
         case COL_TIMESTAMP_LTZ:
             if (has_parens) {
-                col->precision = col->length;
-                col->length = 0; /* Reset to get default byte length below */
+                d->precision = d->length;
+                d->length = 0; /* Reset to get default byte length below */
             } else {
-                col->precision = 6; /* Oracle default */
+                d->precision = 6; /* Oracle default */
             }
             break;
         }
     }
 
     /* Default lengths for types without explicit size */
-    if (col->length == 0) {
-        switch (col->type) {
-        case COL_DATE:          col->length = 7; break;
-        case COL_TIMESTAMP:     col->length = 11; break;
-        case COL_TIMESTAMP_TZ:  col->length = 13; break;
-        case COL_TIMESTAMP_LTZ: col->length = 11; break;
-        case COL_BIN_FLOAT:     col->length = 4; break;
-        case COL_BIN_DOUBLE:    col->length = 8; break;
-        case COL_ROWID:         col->length = 18; break;
+    if (d->length == 0) {
+        switch (d->type) {
+        case COL_DATE:          d->length = 7; break;
+        case COL_TIMESTAMP:     d->length = 11; break;
+        case COL_TIMESTAMP_TZ:  d->length = 13; break;
+        case COL_TIMESTAMP_LTZ: d->length = 11; break;
+        case COL_BIN_FLOAT:     d->length = 4; break;
+        case COL_BIN_DOUBLE:    d->length = 8; break;
+        case COL_ROWID:         d->length = 18; break;
         default: break;
         }
     }
@@ -793,6 +797,7 @@ static int parse_column_type(const char *type_str, ODV_COLUMN *col)
     notify_exp_table
 
     Notifies via table callback and adds to table list.
+    Returns ODV_ERROR_MALLOC if the table list or its index cannot grow.
  ---------------------------------------------------------------------------*/
 static void conv_name(const char *src, int src_cs, int dst_cs,
                       char *dst, int dst_size)
@@ -808,49 +813,38 @@ static void conv_name(const char *src, int src_cs, int dst_cs,
     odv_strcpy(dst, src, dst_size - 1);
 }
 
-static void notify_exp_table(ODV_SESSION *s, int64_t row_count)
+static int notify_exp_table(ODV_SESSION *s, int64_t row_count)
 {
-    const char *col_names[ODV_MAX_COLUMNS];
-    const char *col_types[ODV_MAX_COLUMNS];
-    int col_not_nulls[ODV_MAX_COLUMNS];
-    const char *col_defaults[ODV_MAX_COLUMNS];
     char conv_schema[ODV_OBJNAME_LEN * 4 + 1];
     char conv_name_buf[ODV_OBJNAME_LEN * 4 + 1];
-    char conv_col_names[ODV_MAX_COLUMNS][ODV_OBJNAME_LEN * 4 + 1];
-    int i;
+    ODV_TABLE_ENTRY *e;
+    int i, k;
 
-    /* Convert names to output charset */
-    conv_name(s->table.schema, s->dump_charset, s->out_charset,
+    /* Convert names to UTF-8 (table list and table callback) */
+    conv_name(s->table.schema, s->dump_charset, CHARSET_UTF8,
               conv_schema, sizeof(conv_schema));
-    conv_name(s->table.name, s->dump_charset, s->out_charset,
+    conv_name(s->table.name, s->dump_charset, CHARSET_UTF8,
               conv_name_buf, sizeof(conv_name_buf));
 
-    if (s->table_count < ODV_MAX_TABLES) {
-        ODV_TABLE_ENTRY *e = &s->table_list[s->table_count];
+    if (!s->keep_table_list) {
+        if ((e = odv_table_list_add(s)) == NULL) return ODV_ERROR_MALLOC;
         odv_strcpy(e->schema, conv_schema, ODV_OBJNAME_LEN);
         odv_strcpy(e->name, conv_name_buf, ODV_OBJNAME_LEN);
         e->col_count = s->table.col_count;
         e->row_count = row_count;
+        e->ddl_offset = s->table.ddl_offset;
+        odv_ckpt_attach(s, e);
+        k = odv_table_index_add(s, s->table_count);
+        if (k == ODV_ERROR_MALLOC) return ODV_ERROR_MALLOC;
 
         /* Set partition info from EXP PARTITION marker */
         if (s->table.is_partition && s->table.partition[0]) {
             odv_strcpy(e->partition, s->table.partition, ODV_OBJNAME_LEN);
             /* Detect partition type: first occurrence = PARTITION_TABLE,
                subsequent = PARTITION (same as EXPDP logic) */
-            {
-                int k, found_prev = 0;
-                for (k = 0; k < s->table_count; k++) {
-                    if (strcmp(s->table_list[k].schema, e->schema) == 0 &&
-                        strcmp(s->table_list[k].name, e->name) == 0) {
-                        found_prev = 1;
-                        if (s->table_list[k].type == TABLE_TYPE_TABLE) {
-                            s->table_list[k].type = TABLE_TYPE_PARTITION_TABLE;
-                        }
-                        break;
-                    }
-                }
-                e->type = found_prev ? TABLE_TYPE_PARTITION : TABLE_TYPE_PARTITION_TABLE;
-            }
+            if (k >= 0 && s->table_list[k].type == TABLE_TYPE_TABLE)
+                s->table_list[k].type = TABLE_TYPE_PARTITION_TABLE;
+            e->type = (k >= 0) ? TABLE_TYPE_PARTITION : TABLE_TYPE_PARTITION_TABLE;
         } else {
             e->type = TABLE_TYPE_TABLE;
             e->partition[0] = '\0';
@@ -860,25 +854,27 @@ static void notify_exp_table(ODV_SESSION *s, int64_t row_count)
         s->table_count++;
     }
 
-    if (s->table_cb) {
+    if (s->table_cb && odv_reserve_col_scratch(s, s->table.col_count) == ODV_OK) {
+        const int name_len = ODV_OBJNAME_LEN * 4 + 1;
         char *cjson;
-        for (i = 0; i < s->table.col_count && i < ODV_MAX_COLUMNS; i++) {
-            conv_name(s->table.columns[i].name, s->dump_charset, s->out_charset,
-                      conv_col_names[i], sizeof(conv_col_names[i]));
-            col_names[i] = conv_col_names[i];
-            col_types[i] = s->table.columns[i].type_str;
-            col_not_nulls[i] = s->table.columns[i].not_null;
-            col_defaults[i] = s->table.columns[i].default_val;
+        for (i = 0; i < s->table.col_count; i++) {
+            char *conv_col = s->cb_name_buf + (size_t)i * name_len;
+            conv_name(s->table.columns[i].name, s->dump_charset, CHARSET_UTF8,
+                      conv_col, name_len);
+            s->cb_names[i] = conv_col;
+            s->cb_strs[i] = s->table.columns[i].type_str;
+            s->cb_ints[i] = s->table.columns[i].not_null;
+            s->cb_defaults[i] = s->table.columns[i].default_val;
         }
         cjson = serialize_constraints_json(s);
         s->table_cb(
             conv_schema,
             conv_name_buf,
             s->table.col_count,
-            col_names,
-            col_types,
-            col_not_nulls,
-            col_defaults,
+            s->cb_names,
+            s->cb_strs,
+            s->cb_ints,
+            s->cb_defaults,
             s->table.constraint_count,
             cjson ? cjson : "[]",
             row_count,
@@ -887,264 +883,333 @@ static void notify_exp_table(ODV_SESSION *s, int64_t row_count)
         );
         if (cjson) free(cjson);
     }
+    return ODV_OK;
 }
 
 /*---------------------------------------------------------------------------
-    decode_exp_column
+    EXP column decode kernels (indexed by KERN_*, see odv_decode_plan)
 
-    Decodes a single EXP column value from binary data.
-    Stores result as string in the record value.
+    Decode a single EXP column value from binary data and store the
+    result as a string in the record value.
  ---------------------------------------------------------------------------*/
-static int decode_exp_column(ODV_SESSION *s, int col_idx,
-                             const unsigned char *data, int data_len)
+typedef int (*EXP_KERNEL)(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                          const unsigned char *data, int data_len);
+
+/* Decoders write straight into the value buffer (value_text_buf) and
+   return the text length; a failed decode leaves the value NULL. */
+static int xk_number(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                     const unsigned char *data, int data_len)
 {
-    ODV_COLUMN *col;
-    ODV_VALUE *val;
-    char tmp[1024];
-    int rc;
+    char *out = value_text_buf(val, ODV_NUMBER_STR_LEN);
+    (void)s; (void)col_idx;
+    commit_value_text(val, out ? decode_oracle_number(data, data_len, out,
+                                                      ODV_NUMBER_STR_LEN) : -1);
+    return ODV_OK;
+}
 
-    if (col_idx >= s->table.col_count) return ODV_OK;
+static int xk_date(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                   const unsigned char *data, int data_len)
+{
+    const char *text;
+    int cap = s->date_prog.max_len + 32;
+    int n = decode_oracle_date_memo(s, col_idx, data, data_len, &text);
+    char *out;
+    if (n >= 0) {
+        set_value_string(val, text, n);
+        return ODV_OK;
+    }
+    out = value_text_buf(val, cap);
+    commit_value_text(val, out ? decode_oracle_date(data, data_len, out, cap,
+                                                    &s->date_prog) : -1);
+    return ODV_OK;
+}
 
-    col = &s->table.columns[col_idx];
-    val = &s->record.values[col_idx];
+static int xk_timestamp(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                        const unsigned char *data, int data_len)
+{
+    int cap = s->date_prog.max_len + 32;
+    char *out = value_text_buf(val, cap);
+    commit_value_text(val, out ? decode_oracle_timestamp(data, data_len, out, cap,
+                                                         &s->date_prog,
+                                                         s->table.desc[col_idx].precision) : -1);
+    return ODV_OK;
+}
 
-    switch (col->type) {
-    case COL_NUMBER:
-    case COL_FLOAT:
-        rc = decode_oracle_number(data, data_len, tmp, sizeof(tmp));
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_bin_float(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                        const unsigned char *data, int data_len)
+{
+    char *out = value_text_buf(val, 32);
+    (void)s; (void)col_idx; (void)data_len;
+    commit_value_text(val, out ? decode_binary_float(data, out, 32) : -1);
+    return ODV_OK;
+}
 
-    case COL_DATE:
-        rc = decode_oracle_date(data, data_len, tmp, sizeof(tmp), s->date_format, s->custom_date_format);
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_bin_double(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                         const unsigned char *data, int data_len)
+{
+    char *out = value_text_buf(val, 32);
+    (void)s; (void)col_idx; (void)data_len;
+    commit_value_text(val, out ? decode_binary_double(data, out, 32) : -1);
+    return ODV_OK;
+}
 
-    case COL_TIMESTAMP:
-    case COL_TIMESTAMP_TZ:
-    case COL_TIMESTAMP_LTZ:
-        rc = decode_oracle_timestamp(data, data_len, tmp, sizeof(tmp), s->date_format, s->custom_date_format, col->precision);
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_interval_ym(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                          const unsigned char *data, int data_len)
+{
+    char *out = value_text_buf(val, 40);
+    (void)s; (void)col_idx;
+    commit_value_text(val, out ? decode_interval_ym(data, data_len, out, 40) : -1);
+    return ODV_OK;
+}
 
-    case COL_BIN_FLOAT:
-        rc = decode_binary_float(data, tmp, sizeof(tmp));
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_interval_ds(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                          const unsigned char *data, int data_len)
+{
+    char *out = value_text_buf(val, 40);
+    (void)s; (void)col_idx;
+    commit_value_text(val, out ? decode_interval_ds(data, data_len, out, 40) : -1);
+    return ODV_OK;
+}
 
-    case COL_BIN_DOUBLE:
-        rc = decode_binary_double(data, tmp, sizeof(tmp));
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_hex(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                  const unsigned char *data, int data_len)
+{
+    /* Hex output: "0x" + hex bytes */
+    (void)s; (void)col_idx;
+    set_value_hex(val, "0x", data, data_len);
+    return ODV_OK;
+}
 
-    case COL_INTERVAL_YM:
-        rc = decode_interval_ym(data, data_len, tmp, sizeof(tmp));
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_placeholder(ODV_VALUE *val, const char *ph)
+{
+    set_value_string(val, ph, (int)strlen(ph));
+    return ODV_OK;
+}
 
-    case COL_INTERVAL_DS:
-        rc = decode_interval_ds(data, data_len, tmp, sizeof(tmp));
-        if (rc == ODV_OK) {
-            set_value_string(val, tmp, (int)strlen(tmp));
-        } else {
-            set_value_null(val);
-        }
-        break;
+static int xk_blob(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                   const unsigned char *data, int data_len)
+{
+    /* The 'data' here is the BLOB locator (~100 byte structure) read in
+       the regular column phase. The actual BLOB content lives in the LOB
+       section that follows the row's regular columns and is consumed by
+       parse_exp_records()'s LOB section reader. Just set a placeholder;
+       do NOT accumulate the locator into the LOB extract buffer. */
+    (void)s; (void)col_idx; (void)data; (void)data_len;
+    return xk_placeholder(val, "%BLOB%");
+}
 
-    case COL_RAW:
-    case COL_ROWID: {
-        /* Hex output: "0x" + hex bytes */
-        int needed = data_len * 2 + 3;
-        rc = ensure_value_buf(val, needed);
-        if (rc == ODV_OK) {
-            int j, pos = 0;
-            val->data[pos++] = '0';
-            val->data[pos++] = 'x';
-            for (j = 0; j < data_len; j++) {
-                static const char hex[] = "0123456789ABCDEF";
-                val->data[pos++] = hex[(data[j] >> 4) & 0x0F];
-                val->data[pos++] = hex[data[j] & 0x0F];
-            }
-            val->data[pos] = '\0';
-            val->data_len = pos;
-            val->is_null = 0;
-        }
-        break;
-    }
+static int xk_clob(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                   const unsigned char *data, int data_len)
+{
+    /* CLOB locator — actual content read from the LOB section. */
+    (void)s; (void)col_idx; (void)data; (void)data_len;
+    return xk_placeholder(val, "%CLOB%");
+}
 
-    case COL_BLOB: {
-        /* The 'data' here is the BLOB locator (~100 byte structure) read in
-           the regular column phase. The actual BLOB content lives in the LOB
-           section that follows the row's regular columns and is consumed by
-           parse_exp_records()'s LOB section reader. Just set a placeholder;
-           do NOT accumulate the locator into the LOB extract buffer. */
-        const char *ph = "%BLOB%";
-        set_value_string(val, ph, (int)strlen(ph));
-        break;
-    }
+static int xk_nclob(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                    const unsigned char *data, int data_len)
+{
+    /* NCLOB locator — actual content read from the LOB section. */
+    (void)s; (void)col_idx; (void)data; (void)data_len;
+    return xk_placeholder(val, "%NCLOB%");
+}
 
-    case COL_LONG_RAW: {
-        /* LONG RAW is inline length-prefixed (NOT a LOB section column).
-           Existing LOB-extract accumulation behavior is preserved. */
-        if (s->lob_extract_mode && s->lob_column_index >= 0) {
-            int li, lob_idx = 0;
-            for (li = 0; li < col_idx; li++) {
-                int ct = s->table.columns[li].type;
-                if (ct == COL_BLOB || ct == COL_CLOB || ct == COL_NCLOB)
-                    lob_idx++;
-            }
-            if (lob_idx < s->table.lob_col_count)
-                odv_lob_accumulate(s, lob_idx, data, data_len);
-        }
-        {
-            const char *ph = "%BLOB%";
-            set_value_string(val, ph, (int)strlen(ph));
-        }
-        break;
-    }
+static int xk_bfile(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                    const unsigned char *data, int data_len)
+{
+    (void)s; (void)col_idx; (void)data; (void)data_len;
+    return xk_placeholder(val, "%BFILE%");
+}
 
-    case COL_CLOB: {
-        /* CLOB locator — actual content read from the LOB section. */
-        const char *ph = "%CLOB%";
-        set_value_string(val, ph, (int)strlen(ph));
-        break;
+/* LONG / LONG RAW are inline length-prefixed (NOT LOB section columns).
+   Existing LOB-extract accumulation behavior is preserved. */
+static void xk_long_extract(ODV_SESSION *s, int col_idx,
+                            const unsigned char *data, int data_len)
+{
+    if (s->lob_extract_mode && s->lob_column_index >= 0) {
+        int lob_idx = s->plan.lob_rank[col_idx];
+        if (lob_idx < s->table.lob_col_count)
+            odv_lob_accumulate(s, lob_idx, data, data_len);
     }
+}
 
-    case COL_LONG: {
-        /* LONG is inline length-prefixed (NOT a LOB section column). */
-        if (s->lob_extract_mode && s->lob_column_index >= 0) {
-            int li, lob_idx = 0;
-            for (li = 0; li < col_idx; li++) {
-                int ct = s->table.columns[li].type;
-                if (ct == COL_BLOB || ct == COL_CLOB || ct == COL_NCLOB)
-                    lob_idx++;
-            }
-            if (lob_idx < s->table.lob_col_count)
-                odv_lob_accumulate(s, lob_idx, data, data_len);
-        }
-        if (s->table.dump_charset != s->out_charset &&
-            s->table.dump_charset != CHARSET_UNKNOWN) {
-            int out_len = 0;
-            rc = ensure_value_buf(val, data_len * 4 + 1);
-            if (rc == ODV_OK) {
-                rc = convert_charset((const char *)data, data_len,
-                                     s->table.dump_charset,
-                                     (char *)val->data, val->buf_size,
-                                     s->out_charset, &out_len);
-                if (rc == ODV_OK) {
-                    val->data[out_len] = '\0';
-                    val->data_len = out_len;
-                    val->is_null = 0;
-                } else {
-                    set_value_string(val, (const char *)data, data_len);
-                }
-            }
-        } else {
-            set_value_string(val, (const char *)data, data_len);
-        }
-        break;
-    }
+static int xk_long_raw(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                       const unsigned char *data, int data_len)
+{
+    xk_long_extract(s, col_idx, data, data_len);
+    return xk_placeholder(val, "%BLOB%");
+}
 
-    case COL_NCLOB: {
-        /* NCLOB locator — actual content read from the LOB section. */
-        const char *ph = "%NCLOB%";
-        set_value_string(val, ph, (int)strlen(ph));
-        break;
-    }
+/* CHAR/VARCHAR2 (and unknown types) already in the output charset */
+static int xk_text(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                   const unsigned char *data, int data_len)
+{
+    set_value_string(val, (const char *)data, data_len);
 
-    case COL_BFILE: {
-        const char *ph = "%BFILE%";
-        set_value_string(val, ph, (int)strlen(ph));
-        break;
+    /* Trim trailing spaces for CHAR types */
+    if (s->table.desc[col_idx].type == COL_CHAR &&
+        val->data && val->data_len > 0) {
+        while (val->data_len > 0 && val->data[val->data_len - 1] == ' ') {
+            val->data_len--;
+        }
+        val->data[val->data_len] = '\0';
     }
+    return ODV_OK;
+}
 
-    case COL_NCHAR:
-    case COL_NVARCHAR: {
-        /* EXP stores NCHAR/NVARCHAR2 data in national charset (AL16UTF16 = UTF-16BE).
-           Convert UTF-16BE → UTF-8 for display. */
-        char conv_buf[ODV_VARCHAR_LEN];
-        int conv_len = 0;
-        if (data_len > 0 &&
-            convert_charset((const char *)data, data_len,
-                            CHARSET_UTF16BE,
-                            conv_buf, sizeof(conv_buf),
-                            CHARSET_UTF8, &conv_len) == ODV_OK) {
-            set_value_string(val, conv_buf, conv_len);
-            /* Trim trailing spaces for NCHAR */
-            if (col->type == COL_NCHAR && val->data && val->data_len > 0) {
-                while (val->data_len > 0 && val->data[val->data_len - 1] == ' ') {
-                    val->data_len--;
-                }
-                val->data[val->data_len] = '\0';
-            }
+/* Convert dump charset -> output charset into the value buffer */
+static void xk_convert(ODV_SESSION *s, ODV_VALUE *val,
+                       const unsigned char *data, int data_len)
+{
+    int out_len = 0;
+    int rc = ensure_value_buf(val, data_len * 4 + 1);
+    if (rc == ODV_OK) {
+        rc = convert_charset((const char *)data, data_len,
+                             s->plan.text_src_cs,
+                             (char *)val->data, val->buf_size,
+                             s->plan.text_dst_cs, &out_len);
+        if (rc == ODV_OK) {
+            val->data[out_len] = '\0';
+            val->data_len = out_len;
+            val->is_null = 0;
         } else {
-            /* Fallback: copy raw */
             set_value_string(val, (const char *)data, data_len);
         }
-        break;
     }
+}
 
-    default:
-        /* String types: CHAR, VARCHAR, etc. */
-        if (s->table.dump_charset != s->out_charset &&
-            s->table.dump_charset != CHARSET_UNKNOWN) {
-            int out_len = 0;
-            rc = ensure_value_buf(val, data_len * 4 + 1);
-            if (rc == ODV_OK) {
-                rc = convert_charset((const char *)data, data_len,
-                                     s->table.dump_charset,
-                                     (char *)val->data, val->buf_size,
-                                     s->out_charset, &out_len);
-                if (rc == ODV_OK) {
-                    val->data[out_len] = '\0';
-                    val->data_len = out_len;
-                    val->is_null = 0;
-                } else {
-                    set_value_string(val, (const char *)data, data_len);
-                }
-            }
-        } else {
-            set_value_string(val, (const char *)data, data_len);
-        }
+static int xk_text_conv(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                        const unsigned char *data, int data_len)
+{
+    xk_convert(s, val, data, data_len);
 
-        /* Trim trailing spaces for CHAR types */
-        if ((col->type == COL_CHAR || col->type == COL_NCHAR) &&
-            val->data && val->data_len > 0) {
-            while (val->data_len > 0 && val->data[val->data_len - 1] == ' ') {
-                val->data_len--;
-            }
-            val->data[val->data_len] = '\0';
-        }
-        break;
+    /* Trim trailing spaces for CHAR types */
+    if (s->table.desc[col_idx].type == COL_CHAR)
+        trim_value_spaces(val, s->plan.wide);
+    return ODV_OK;
+}
+
+static int xk_long(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                   const unsigned char *data, int data_len)
+{
+    xk_long_extract(s, col_idx, data, data_len);
+    if (s->plan.text_src_cs != s->plan.text_dst_cs &&
+        s->plan.text_src_cs != CHARSET_UNKNOWN) {
+        xk_convert(s, val, data, data_len);
+    } else {
+        set_value_string(val, (const char *)data, data_len);
     }
+    return ODV_OK;
+}
+
+static int xk_ntext(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                    const unsigned char *data, int data_len)
+{
+    /* EXP stores NCHAR/NVARCHAR2 data in national charset (AL16UTF16 = UTF-16BE).
+       Transcode straight into the value buffer: UTF-8 is at most 1.5x,
+       UTF-16LE is the same length. */
+    int n = data_len & ~1;
+    int cap = s->plan.wide ? n : n / 2 * 3;
+    if (n <= 0) {
+        set_value_string(val, "", 0);
+    } else if (ensure_value_buf(val, cap + 2) == ODV_OK) {
+        val->data_len = s->plan.wide
+            ? odv_utf16be_to_utf16le(data, n, val->data, cap, NULL)
+            : odv_utf16be_to_utf8(data, n, val->data, cap, NULL);
+        val->data[val->data_len] = '\0';
+        val->data[val->data_len + 1] = '\0';
+        val->is_null = 0;
+        /* Trim trailing spaces for NCHAR */
+        if (s->table.desc[col_idx].type == COL_NCHAR)
+            trim_value_spaces(val, s->plan.wide);
+    } else {
+        /* Fallback: copy raw */
+        set_value_string(val, (const char *)data, data_len);
+    }
+    return ODV_OK;
+}
 
+/* Oracle wire bytes, for typed exporters (s->raw_values) */
+static int xk_raw(ODV_SESSION *s, int col_idx, ODV_VALUE *val,
+                  const unsigned char *data, int data_len)
+{
+    (void)s; (void)col_idx;
+    set_value_string(val, (const char *)data, data_len);
     return ODV_OK;
 }
 
+/* ASCII-only kernels: numeric/date/hex plus the LOB placeholders */
+#define EXP_ASCII_KERNELS (KERN_ASCII_MASK | (1u << KERN_BLOB) | (1u << KERN_CLOB) | \
+                           (1u << KERN_NCLOB) | (1u << KERN_BFILE) | (1u << KERN_LONG_RAW))
+
+static const EXP_KERNEL exp_kernels[KERN_COUNT] = {
+    xk_text,            /* KERN_TEXT */
+    xk_text_conv,       /* KERN_TEXT_CONV */
+    xk_ntext,           /* KERN_NTEXT */
+    xk_number,          /* KERN_NUMBER */
+    xk_date,            /* KERN_DATE */
+    xk_timestamp,       /* KERN_TIMESTAMP */
+    xk_bin_float,       /* KERN_BIN_FLOAT */
+    xk_bin_double,      /* KERN_BIN_DOUBLE */
+    xk_interval_ym,     /* KERN_INTERVAL_YM */
+    xk_interval_ds,     /* KERN_INTERVAL_DS */
+    xk_hex,             /* KERN_HEX */
+    xk_blob,            /* KERN_BLOB */
+    xk_clob,            /* KERN_CLOB */
+    xk_nclob,           /* KERN_NCLOB */
+    xk_bfile,           /* KERN_BFILE */
+    xk_long,            /* KERN_LONG */
+    xk_long_raw,        /* KERN_LONG_RAW */
+    xk_raw              /* KERN_RAW */
+};
+
+/* Decode one column through the table's decode plan */
+static int decode_exp_column(ODV_SESSION *s, int col_idx,
+                             const unsigned char *data, int data_len)
+{
+    int k, rc;
+
+    if (col_idx >= s->table.col_count) return ODV_OK;
+
+    k = s->plan.kernel[col_idx];
+    rc = exp_kernels[k](s, col_idx, &s->record.values[col_idx], data, data_len);
+    if (s->plan.wide && (EXP_ASCII_KERNELS >> k & 1))
+        widen_value_ascii(&s->record.values[col_idx]);
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    Verbatim columns
+
+    CHAR/VARCHAR2 columns whose dump charset already matches the output
+    charset need no decoding: their bytes are read straight into the row
+    arena instead of going through col_buf and decode_exp_column.
+ ---------------------------------------------------------------------------*/
+static int is_verbatim_column(ODV_SESSION *s, int col_idx)
+{
+    int t;
+
+    if (col_idx >= s->table.col_count) return 0;
+    if (s->plan.kernel[col_idx] != KERN_TEXT) return 0;
+    t = s->table.desc[col_idx].type;
+    return t == COL_CHAR || t == COL_VARCHAR;
+}
+
+static void finish_verbatim_value(ODV_SESSION *s, int col_idx, int len)
+{
+    ODV_VALUE *val = &s->record.values[col_idx];
+
+    val->data_len = len;
+    val->is_null = 0;
+
+    /* Trim trailing spaces for CHAR */
+    if (s->table.desc[col_idx].type == COL_CHAR) {
+        while (val->data_len > 0 && val->data[val->data_len - 1] == ' ')
+            val->data_len--;
+    }
+    val->data[val->data_len] = '\0';
+}
+
 /*---------------------------------------------------------------------------
     is_lob_type
 
@@ -1275,25 +1340,25 @@ static int parse_exp_records(ODV_SESSION *s, FILE *fp, int64_t data_start,
     int non_null_lob_count = 0;
     int col_idx = 0;
     int col_len;
+    int verbatim;
     int rc = ODV_OK;
     int64_t row_count = 0;
+    int64_t next_ckpt;
 
-    /* Seek to data start */
+    /* Seek to data start (or to the nearest checkpoint for odv_seek_row) */
     odv_fseek(fp, data_start, SEEK_SET);
+    odv_ckpt_resume(s, fp, NULL);
+
+    /* Row checkpoints are collected on the first (counting) scan only */
+    s->ckpt_count = 0;
+    next_ckpt = s->checkpoint_interval;
 
     /* Ensure record can hold all columns */
-    if (s->table.col_count > s->record.max_columns) {
-        /* grow_record is static in odv_record.c, use realloc approach */
-        ODV_VALUE *new_vals;
-        int new_max = s->table.col_count + 64;
-        new_vals = (ODV_VALUE *)realloc(s->record.values,
-                                        new_max * sizeof(ODV_VALUE));
-        if (!new_vals) return ODV_ERROR_MALLOC;
-        memset(new_vals + s->record.max_columns, 0,
-               (new_max - s->record.max_columns) * sizeof(ODV_VALUE));
-        s->record.values = new_vals;
-        s->record.max_columns = new_max;
-    }
+    rc = grow_record(&s->record, s->table.col_count);
+    if (rc != ODV_OK) return rc;
+
+    /* Per-column decode kernels for this table */
+    if (!odv_decode_plan(s)) return ODV_ERROR_MALLOC;
 
     /* In LOB extraction mode, validate the target column exists */
     if (s->lob_extract_mode) {
@@ -1320,6 +1385,14 @@ static int parse_exp_records(ODV_SESSION *s, FILE *fp, int64_t data_start,
 
 
     while (!s->cancelled) {
+        /* Record boundary: take a row checkpoint every K rows */
+        if (list_only && col_idx == 0 && next_ckpt > 0
+            && s->table.record_count >= next_ckpt) {
+            rc = odv_ckpt_add(s, fp, NULL);
+            if (rc != ODV_OK) goto rec_done;
+            next_ckpt = s->table.record_count + s->checkpoint_interval;
+        }
+
         /* Read 2-byte length prefix */
         if (fread(len_buf, 1, 2, fp) != 2) {
             break; /* EOF */
@@ -1455,7 +1528,7 @@ static int parse_exp_records(ODV_SESSION *s, FILE *fp, int64_t data_start,
 
         /* Type-specific length validation (ref: check_column_length) */
         if (col_idx < s->table.col_count) {
-            int ctype = s->table.columns[col_idx].type;
+            int ctype = s->table.desc[col_idx].type;
             int bad = 0;
             switch (ctype) {
             case COL_NUMBER: case COL_FLOAT:
@@ -1500,19 +1573,31 @@ static int parse_exp_records(ODV_SESSION *s, FILE *fp, int64_t data_start,
             break;
         }
 
-        /* Ensure buffer is large enough */
-        if (col_len > col_buf_size) {
-            unsigned char *new_buf = (unsigned char *)realloc(col_buf, col_len + 1);
-            if (!new_buf) { rc = ODV_ERROR_MALLOC; break; }
-            col_buf = new_buf;
-            col_buf_size = col_len + 1;
-        }
+        verbatim = col_len > 0 && is_verbatim_column(s, col_idx);
 
-        /* Read column data */
-        if (col_len > 0) {
-            if ((int)fread(col_buf, 1, col_len, fp) != col_len) {
+        if (verbatim) {
+            /* Read straight into the row arena (no decode needed) */
+            ODV_VALUE *val = &s->record.values[col_idx];
+            rc = ensure_value_buf(val, col_len + 1);
+            if (rc != ODV_OK) break;
+            if ((int)fread(val->data, 1, col_len, fp) != col_len) {
                 break; /* Truncated */
             }
+        } else {
+            /* Ensure buffer is large enough */
+            if (col_len > col_buf_size) {
+                unsigned char *new_buf = (unsigned char *)realloc(col_buf, col_len + 1);
+                if (!new_buf) { rc = ODV_ERROR_MALLOC; break; }
+                col_buf = new_buf;
+                col_buf_size = col_len + 1;
+            }
+
+            /* Read column data */
+            if (col_len > 0) {
+                if ((int)fread(col_buf, 1, col_len, fp) != col_len) {
+                    break; /* Truncated */
+                }
+            }
         }
 
         /* Track non-NULL LOB locators so the LOB section reader can match
@@ -1520,13 +1605,15 @@ static int parse_exp_records(ODV_SESSION *s, FILE *fp, int64_t data_start,
            here but the actual LOB content is delivered later. */
         if (col_idx < s->table.col_count
             && non_null_lob_cols
-            && is_lob_type(s->table.columns[col_idx].type)
+            && is_lob_type(s->table.desc[col_idx].type)
             && non_null_lob_count < s->table.lob_col_count) {
             non_null_lob_cols[non_null_lob_count++] = col_idx;
         }
 
         /* Decode and store */
-        if (col_idx < s->table.col_count) {
+        if (verbatim) {
+            finish_verbatim_value(s, col_idx, col_len);
+        } else if (col_idx < s->table.col_count) {
             decode_exp_column(s, col_idx, col_buf, col_len);
         }
         col_idx++;
@@ -1629,19 +1716,8 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
 
         /* Pre-set current_schema from filter (we skipped past CONNECT) */
         if (s->filter_schema[0]) {
-            char tmp[ODV_OBJNAME_LEN + 1];
-            int tlen = 0;
-            if (s->dump_charset != s->out_charset &&
-                s->dump_charset != CHARSET_UNKNOWN) {
-                if (convert_charset(s->filter_schema, (int)strlen(s->filter_schema),
-                                    s->out_charset, tmp, ODV_OBJNAME_LEN,
-                                    s->dump_charset, &tlen) == ODV_OK) {
-                    tmp[tlen] = '\0';
-                    odv_strcpy(current_schema, tmp, ODV_OBJNAME_LEN);
-                }
-            } else {
-                odv_strcpy(current_schema, s->filter_schema, ODV_OBJNAME_LEN);
-            }
+            odv_filter_prepare(s);
+            odv_strcpy(current_schema, s->filter_schema_cs, ODV_OBJNAME_LEN);
         }
     } else {
         /* Normal: start from beginning of file */
@@ -1793,8 +1869,9 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
                          after[5] == '"' || after[5] == '\0')) {
                         /* Notify previous pending table (with accumulated constraints) */
                         if (pending_table && s->table.name[0] != '\0') {
-                            notify_exp_table(s, pending_row_count);
                             pending_table = 0;
+                            rc = notify_exp_table(s, pending_row_count);
+                            if (rc != ODV_OK) goto done;
                             pending_row_count = 0;
                         }
                         if (parse_create_table(s, word)) {
@@ -1807,52 +1884,12 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
                                 odv_strcpy(s->table.schema, current_schema,
                                            ODV_OBJNAME_LEN);
                             s->table.record_count = 0;
-                            invalidate_meta_cache();
+                            odv_table_changed(s);
                             pending_table = 1;
 
                             /* Table filter check */
                             if (s->filter_active) {
-                                int match = 1;
-                                if (s->filter_table[0]) {
-                                    char ft[ODV_OBJNAME_LEN + 1];
-                                    int ft_len;
-                                    odv_strcpy(ft, s->filter_table, ODV_OBJNAME_LEN);
-                                    ft_len = (int)strlen(ft);
-                                    /* Reverse-convert: UTF-8 -> dump charset */
-                                    if (s->dump_charset != s->out_charset &&
-                                        s->dump_charset != CHARSET_UNKNOWN) {
-                                        char tmp[ODV_OBJNAME_LEN + 1];
-                                        int tlen = 0;
-                                        int cvt_rc = convert_charset(ft, ft_len, s->out_charset,
-                                                            tmp, ODV_OBJNAME_LEN, s->dump_charset,
-                                                            &tlen);
-                                        if (cvt_rc == ODV_OK) {
-                                            tmp[tlen] = '\0';
-                                            odv_strcpy(ft, tmp, ODV_OBJNAME_LEN);
-                                        }
-                                    }
-                                    if (odv_stricmp(s->table.name, ft) != 0)
-                                        match = 0;
-                                }
-                                if (match && s->filter_schema[0]) {
-                                    char fs[ODV_OBJNAME_LEN + 1];
-                                    int fs_len;
-                                    odv_strcpy(fs, s->filter_schema, ODV_OBJNAME_LEN);
-                                    fs_len = (int)strlen(fs);
-                                    if (s->dump_charset != s->out_charset &&
-                                        s->dump_charset != CHARSET_UNKNOWN) {
-                                        char tmp[ODV_OBJNAME_LEN + 1];
-                                        int tlen = 0;
-                                        if (convert_charset(fs, fs_len, s->out_charset,
-                                                            tmp, ODV_OBJNAME_LEN, s->dump_charset,
-                                                            &tlen) == ODV_OK) {
-                                            tmp[tlen] = '\0';
-                                            odv_strcpy(fs, tmp, ODV_OBJNAME_LEN);
-                                        }
-                                    }
-                                    if (odv_stricmp(s->table.schema, fs) != 0)
-                                        match = 0;
-                                }
+                                int match = odv_filter_match(s);
                                 s->pass_flg = match ? 0 : 1;
                                 /* Early exit: target table already processed,
                                    now a different table appeared → done */
@@ -2177,7 +2214,8 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
                         } else {
                             /* Subsequent partition: notify the previous partition,
                              * then start a new partition entry with same table structure */
-                            notify_exp_table(s, pending_row_count > 0 ? pending_row_count : s->table.record_count);
+                            rc = notify_exp_table(s, pending_row_count > 0 ? pending_row_count : s->table.record_count);
+                            if (rc != ODV_OK) { pending_table = 0; goto done; }
                             pending_row_count = 0;
                             s->table.record_count = 0;
                             odv_strcpy(s->table.partition, part_name, ODV_OBJNAME_LEN);
@@ -2354,7 +2392,7 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
                 is_char_type = 0;
                 if (meta_col_count <= 0 || meta_col_count > ODV_MAX_COLUMNS) {
                     s->table.name[0] = '\0';
-                    if (s->table_count > 0) s->table_count--;
+                    if (!s->keep_table_list && s->table_count > 0) s->table_count--;
                     step = 2;
                     wlen = 0;
                 } else {
@@ -2369,7 +2407,7 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
                 switch (c) {
                 case 0x3A: /* XMLTYPE — unsupported */
                     s->table.name[0] = '\0';
-                    if (s->table_count > 0) s->table_count--;
+                    if (!s->keep_table_list && s->table_count > 0) s->table_count--;
                     step = 2;
                     wlen = 0;
                     goto meta_done;
@@ -2586,10 +2624,15 @@ static int parse_exp_ddl_and_data(ODV_SESSION *s, FILE *fp, int list_only)
 done:
     /* Notify last pending table if not yet notified (with constraints) */
     if (pending_table && s->table.name[0] != '\0') {
-        notify_exp_table(s, pending_row_count > 0 ? pending_row_count : s->table.record_count);
+        int nrc = notify_exp_table(s, pending_row_count > 0 ? pending_row_count : s->table.record_count);
+        if (nrc != ODV_OK) rc = nrc;
     }
 
     free(word);
+    if (rc == ODV_ERROR_MALLOC) {
+        odv_strcpy(s->last_error, "Out of memory building the table list", ODV_MSG_LEN);
+        return rc;
+    }
     if (s->cancelled) return ODV_ERROR_CANCELLED;
     return rc;
 }
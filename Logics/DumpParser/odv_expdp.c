@@ -46,6 +46,7 @@ typedef struct {
     ODV_SESSION *session;
     int  in_col_list;       /* inside <COL_LIST_ITEM> */
     int  col_idx;           /* current column being defined */
+    int  col_ok;            /* 1=column slot col_idx is available */
     char cur_schema[ODV_OBJNAME_LEN + 1];
     char cur_table[ODV_OBJNAME_LEN + 1];
     int  property;
@@ -108,9 +109,7 @@ static void ddl_xml_callback(const char *tag, const char *value,
             if (!dc->in_col_list) {
                 /* Opening: prepare next column slot */
                 dc->in_col_list = 1;
-                if (dc->col_idx < ODV_MAX_COLUMNS) {
-                    memset(&s->table.columns[dc->col_idx], 0, sizeof(ODV_COLUMN));
-                }
+                dc->col_ok = (odv_table_column(&s->table, dc->col_idx) != NULL);
                 return;
             }
             /* Closing: fall through to column finalization at bottom */
@@ -130,8 +129,9 @@ static void ddl_xml_callback(const char *tag, const char *value,
     else if (strcmp(tag, "PROPERTY") == 0 && !dc->in_col_list) {
         dc->property = atoi(value);
     }
-    else if (dc->in_col_list && dc->col_idx < ODV_MAX_COLUMNS) {
-        ODV_COLUMN *col = &s->table.columns[dc->col_idx];
+    else if (dc->in_col_list && dc->col_ok) {
+        ODV_COLUMN  *col = &s->table.columns[dc->col_idx];
+        ODV_COLDESC *d   = &s->table.desc[dc->col_idx];
 
         if (strcmp(tag, "COL_NAME") == 0 || strcmp(tag, "NAME") == 0) {
             /* Skip Oracle system-generated internal columns:
@@ -141,29 +141,29 @@ static void ddl_xml_callback(const char *tag, const char *value,
                  value[strlen(value) - 1] == '$') ||
                 strncmp(value, "SYS_IME_", 8) == 0) {
                 /* Mark to skip */
-                col->type = -1;
+                d->type = -1;
             } else {
                 odv_strcpy(col->name, value, ODV_OBJNAME_LEN);
             }
         }
         else if (strcmp(tag, "TYPE_NUM") == 0) {
             /* Don't overwrite -1 marker for system-generated columns */
-            if (col->type != -1) {
+            if (d->type != -1) {
                 int tn = atoi(value);
-                col->type = type_num_to_col_type(tn, col->length, col->flags);
+                d->type = type_num_to_col_type(tn, d->length, col->flags);
             }
         }
         else if (strcmp(tag, "LENGTH") == 0) {
-            col->length = atoi(value);
+            d->length = atoi(value);
         }
         else if (strcmp(tag, "PRECISION_NUM") == 0) {
-            col->precision = atoi(value);
+            d->precision = atoi(value);
         }
         else if (strcmp(tag, "SCALE") == 0) {
-            col->scale = atoi(value);
+            d->scale = atoi(value);
         }
         else if (strcmp(tag, "CHARSET") == 0 || strcmp(tag, "CHARSETID") == 0) {
-            col->charset = atoi(value);
+            d->charset = atoi(value);
         }
         else if (strcmp(tag, "FLAGS") == 0) {
             col->flags = atoi(value);
@@ -179,42 +179,43 @@ static void ddl_xml_callback(const char *tag, const char *value,
     /* End of column definition */
     if (strcmp(tag, "COL_LIST_ITEM") == 0 && dc->in_col_list) {
         dc->in_col_list = 0;
-        if (dc->col_idx < ODV_MAX_COLUMNS) {
-            ODV_COLUMN *col = &s->table.columns[dc->col_idx];
+        if (dc->col_ok) {
+            ODV_COLUMN  *col = &s->table.columns[dc->col_idx];
+            ODV_COLDESC *d   = &s->table.desc[dc->col_idx];
             /* Only count non-system columns */
-            if (col->type != -1 && col->name[0] != '\0') {
+            if (d->type != -1 && col->name[0] != '\0') {
                 /* CHARSETID 2000 = AL16UTF16 (national charset, UTF-16BE).
                  * Upgrade VARCHAR2→NVARCHAR2 and CHAR→NCHAR accordingly. */
-                if (col->charset == 2000) {
-                    if (col->type == COL_VARCHAR) col->type = COL_NVARCHAR;
-                    else if (col->type == COL_CHAR)    col->type = COL_NCHAR;
+                if (d->charset == 2000) {
+                    if (d->type == COL_VARCHAR) d->type = COL_NVARCHAR;
+                    else if (d->type == COL_CHAR)    d->type = COL_NCHAR;
                 }
                 /* Build type string */
-                switch (col->type) {
+                switch (d->type) {
                 case COL_NVARCHAR:
                     /* length is in bytes (2 bytes/char in UTF-16) */
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "NVARCHAR2(%d)", col->length / 2);
+                             "NVARCHAR2(%d)", d->length / 2);
                     break;
                 case COL_NCHAR:
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "NCHAR(%d)", col->length / 2);
+                             "NCHAR(%d)", d->length / 2);
                     break;
                 case COL_VARCHAR:
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "VARCHAR2(%d)", col->length);
+                             "VARCHAR2(%d)", d->length);
                     break;
                 case COL_CHAR:
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "CHAR(%d)", col->length);
+                             "CHAR(%d)", d->length);
                     break;
                 case COL_NUMBER:
-                    if (col->precision > 0 && col->scale != 0)
+                    if (d->precision > 0 && d->scale != 0)
                         snprintf(col->type_str, sizeof(col->type_str),
-                                 "NUMBER(%d,%d)", col->precision, col->scale);
-                    else if (col->precision > 0)
+                                 "NUMBER(%d,%d)", d->precision, d->scale);
+                    else if (d->precision > 0)
                         snprintf(col->type_str, sizeof(col->type_str),
-                                 "NUMBER(%d)", col->precision);
+                                 "NUMBER(%d)", d->precision);
                     else
                         snprintf(col->type_str, sizeof(col->type_str), "NUMBER");
                     break;
@@ -222,19 +223,19 @@ static void ddl_xml_callback(const char *tag, const char *value,
                     snprintf(col->type_str, sizeof(col->type_str), "DATE");
                     break;
                 case COL_TIMESTAMP:
-                    if (col->precision <= 0) col->precision = 6; /* Oracle default */
+                    if (d->precision <= 0) d->precision = 6; /* Oracle default */
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "TIMESTAMP(%d)", col->precision);
+                             "TIMESTAMP(%d)", d->precision);
                     break;
                 case COL_TIMESTAMP_TZ:
-                    if (col->precision <= 0) col->precision = 6;
+                    if (d->precision <= 0) d->precision = 6;
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "TIMESTAMP(%d) WITH TIME ZONE", col->precision);
+                             "TIMESTAMP(%d) WITH TIME ZONE", d->precision);
                     break;
                 case COL_TIMESTAMP_LTZ:
-                    if (col->precision <= 0) col->precision = 6;
+                    if (d->precision <= 0) d->precision = 6;
                     snprintf(col->type_str, sizeof(col->type_str),
-                             "TIMESTAMP(%d) WITH LOCAL TIME ZONE", col->precision);
+                             "TIMESTAMP(%d) WITH LOCAL TIME ZONE", d->precision);
                     break;
                 case COL_BLOB:
                     snprintf(col->type_str, sizeof(col->type_str), "BLOB");
@@ -243,7 +244,7 @@ static void ddl_xml_callback(const char *tag, const char *value,
                     snprintf(col->type_str, sizeof(col->type_str), "CLOB");
                     break;
                 case COL_RAW:
-                    snprintf(col->type_str, sizeof(col->type_str), "RAW(%d)", col->length);
+                    snprintf(col->type_str, sizeof(col->type_str), "RAW(%d)", d->length);
                     break;
                 case COL_INTERVAL_YM:
                     snprintf(col->type_str, sizeof(col->type_str),
@@ -281,14 +282,14 @@ static void ddl_xml_callback(const char *tag, const char *value,
                     snprintf(col->type_str, sizeof(col->type_str), "USER_DEFINED");
                     break;
                 default:
-                    snprintf(col->type_str, sizeof(col->type_str), "VARCHAR2(%d)", col->length);
+                    snprintf(col->type_str, sizeof(col->type_str), "VARCHAR2(%d)", d->length);
                     break;
                 }
 
                 /* Count LOB columns */
-                if (col->type == COL_BLOB || col->type == COL_CLOB ||
-                    col->type == COL_NCLOB || col->type == COL_LONG_RAW ||
-                    col->type == COL_BFILE || col->type == COL_USER_DEFINE) {
+                if (d->type == COL_BLOB || d->type == COL_CLOB ||
+                    d->type == COL_NCLOB || d->type == COL_LONG_RAW ||
+                    d->type == COL_BFILE || d->type == COL_USER_DEFINE) {
                     s->table.lob_col_count++;
                 }
 
@@ -373,44 +374,45 @@ static void convert_name(const char *src, int src_cs, int dst_cs,
     odv_strcpy(dst, src, dst_size - 1);
 }
 
-static void notify_table(ODV_SESSION *s, int64_t row_count)
+/* Fire the table callback and add the table to table_list.
+   Returns ODV_ERROR_MALLOC if the table list or its index cannot grow. */
+static int notify_table(ODV_SESSION *s, int64_t row_count)
 {
     char conv_schema[ODV_OBJNAME_LEN * 4 + 1];
     char conv_name[ODV_OBJNAME_LEN * 4 + 1];
-    char conv_col_names_buf[ODV_MAX_COLUMNS][ODV_OBJNAME_LEN * 4 + 1];
 
-    /* Convert schema/table/column names to output charset */
-    convert_name(s->table.schema, s->dump_charset, s->out_charset,
+    /* Convert schema/table/column names to UTF-8 */
+    convert_name(s->table.schema, s->dump_charset, CHARSET_UTF8,
                  conv_schema, sizeof(conv_schema));
-    convert_name(s->table.name, s->dump_charset, s->out_charset,
+    convert_name(s->table.name, s->dump_charset, CHARSET_UTF8,
                  conv_name, sizeof(conv_name));
 
-    if (s->table_cb && s->table.name[0] != '\0') {
-        const char *col_names[ODV_MAX_COLUMNS];
-        const char *col_types[ODV_MAX_COLUMNS];
-        int col_not_nulls[ODV_MAX_COLUMNS];
-        const char *col_defaults[ODV_MAX_COLUMNS];
+    if (s->table_cb && s->table.name[0] != '\0'
+        && odv_reserve_col_scratch(s, s->table.col_count) == ODV_OK) {
+        const int name_len = ODV_OBJNAME_LEN * 4 + 1;
         int i;
 
-        for (i = 0; i < s->table.col_count && i < ODV_MAX_COLUMNS; i++) {
-            convert_name(s->table.columns[i].name, s->dump_charset, s->out_charset,
-                         conv_col_names_buf[i], sizeof(conv_col_names_buf[i]));
-            col_names[i] = conv_col_names_buf[i];
-            col_types[i] = s->table.columns[i].type_str;
-            col_not_nulls[i] = s->table.columns[i].not_null;
-            col_defaults[i] = s->table.columns[i].default_val;
+        for (i = 0; i < s->table.col_count; i++) {
+            char *conv_col = s->cb_name_buf + (size_t)i * name_len;
+            convert_name(s->table.columns[i].name, s->dump_charset, CHARSET_UTF8,
+                         conv_col, name_len);
+            s->cb_names[i] = conv_col;
+            s->cb_strs[i] = s->table.columns[i].type_str;
+            s->cb_ints[i] = s->table.columns[i].not_null;
+            s->cb_defaults[i] = s->table.columns[i].default_val;
         }
 
         s->table_cb(conv_schema, conv_name,
-                     s->table.col_count, col_names, col_types,
-                     col_not_nulls, col_defaults,
+                     s->table.col_count, s->cb_names, s->cb_strs,
+                     s->cb_ints, s->cb_defaults,
                      0, "[]",
                      row_count, s->table.ddl_offset, s->table_ud);
     }
 
     /* Add to internal table list (store converted names) */
-    if (s->table_count < ODV_MAX_TABLES && s->table.name[0] != '\0') {
-        ODV_TABLE_ENTRY *e = &s->table_list[s->table_count];
+    if (!s->keep_table_list && s->table.name[0] != '\0') {
+        ODV_TABLE_ENTRY *e = odv_table_list_add(s);
+        if (!e) return ODV_ERROR_MALLOC;
         odv_strcpy(e->schema, conv_schema, ODV_OBJNAME_LEN);
         odv_strcpy(e->name, conv_name, ODV_OBJNAME_LEN);
         e->partition[0] = '\0';
@@ -418,197 +420,273 @@ static void notify_table(ODV_SESSION *s, int64_t row_count)
         e->type = TABLE_TYPE_TABLE;
         e->col_count = s->table.col_count;
         e->row_count = row_count;
-        e->meta_constraint_count = 0;
+        e->ddl_offset = s->table.ddl_offset;
+        odv_ckpt_attach(s, e);
 
         /* Detect partitioned tables: if the same schema.table already appeared
            in the table list, this is another partition of that table.
            Mark duplicates as TABLE_TYPE_PARTITION and mark the first occurrence
            retroactively as TABLE_TYPE_PARTITION_TABLE. */
         {
-            int k;
-            for (k = 0; k < s->table_count; k++) {
-                if (strcmp(s->table_list[k].schema, e->schema) == 0 &&
-                    strcmp(s->table_list[k].name, e->name) == 0) {
-                    /* Found a previous occurrence — this table is partitioned */
-                    e->type = TABLE_TYPE_PARTITION;
-
-                    /* Retroactively mark the first occurrence as PARTITION_TABLE
-                       (only if it hasn't been marked yet) */
-                    if (s->table_list[k].type == TABLE_TYPE_TABLE) {
-                        s->table_list[k].type = TABLE_TYPE_PARTITION_TABLE;
-                    }
-                    break;
-                }
+            int k = odv_table_index_add(s, s->table_count);
+            if (k == ODV_ERROR_MALLOC) return ODV_ERROR_MALLOC;
+            if (k >= 0) {
+                e->type = TABLE_TYPE_PARTITION;
+                if (s->table_list[k].type == TABLE_TYPE_TABLE)
+                    s->table_list[k].type = TABLE_TYPE_PARTITION_TABLE;
             }
         }
 
         s->table_count++;
     }
+    return ODV_OK;
 }
 
 /*---------------------------------------------------------------------------
-    Decode a completed column value (type-specific conversion)
+    Column decode kernels (indexed by KERN_*, see odv_decode_plan)
 
     Called after all bytes of a column have been accumulated in v->data.
-    Converts raw Oracle wire format to display string.
+    Convert raw Oracle wire format to display string.
  ---------------------------------------------------------------------------*/
-static void decode_column_value(ODV_SESSION *s, int col_idx)
+typedef void (*EXPDP_KERNEL)(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col);
+
+/* Numeric and datetime kernels decode straight into v->data, so the raw
+   bytes (22 at most for these types) are copied off the span first. */
+#define EXPDP_RAW_MAX 32
+
+static int take_raw(const ODV_VALUE *v, unsigned char *raw)
 {
-    ODV_VALUE  *v;
-    ODV_COLUMN *col;
-    char decode_buf[ODV_VARCHAR_LEN + 4];
+    int n = (v->data && v->data_len > 0) ? v->data_len : 0;
+    if (n > EXPDP_RAW_MAX) n = EXPDP_RAW_MAX;
+    memset(raw, 0, EXPDP_RAW_MAX);
+    if (n) memcpy(raw, v->data, n);
+    return n;
+}
 
-    if (col_idx >= s->table.col_count) return;
+static void kern_number(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    int len = take_raw(v, raw);
+    char *out = value_text_buf(v, ODV_NUMBER_STR_LEN);
+    (void)s; (void)col;
+    commit_value_text(v, out ? decode_oracle_number(raw, len, out, ODV_NUMBER_STR_LEN) : -1);
+}
 
-    v   = &s->record.values[col_idx];
-    col = &s->table.columns[col_idx];
-    v->type    = col->type;
-    v->is_null = 0;
+static void kern_date(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    const char *text;
+    int cap = s->date_prog.max_len + 32;
+    int len = take_raw(v, raw);
+    int n = decode_oracle_date_memo(s, (int)(col - s->table.desc), raw, len, &text);
+    char *out = value_text_buf(v, n >= 0 ? n + 1 : cap);
+    if (out && n >= 0) {
+        memcpy(out, text, n);
+        commit_value_text(v, n);
+        return;
+    }
+    commit_value_text(v, out ? decode_oracle_date(raw, len, out, cap, &s->date_prog) : -1);
+}
 
-    switch (col->type) {
-    case COL_NUMBER:
-    case COL_FLOAT:
-        decode_oracle_number(v->data, v->data_len,
-                             decode_buf, sizeof(decode_buf));
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_DATE:
-        decode_oracle_date(v->data, v->data_len,
-                           decode_buf, sizeof(decode_buf),
-                           s->date_format, s->custom_date_format);
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_TIMESTAMP:
-    case COL_TIMESTAMP_TZ:
-    case COL_TIMESTAMP_LTZ:
-        decode_oracle_timestamp(v->data, v->data_len,
-                                decode_buf, sizeof(decode_buf),
-                                s->date_format, s->custom_date_format,
-                                col->precision);
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_BIN_FLOAT:
-        decode_binary_float(v->data, decode_buf, sizeof(decode_buf));
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_BIN_DOUBLE:
-        decode_binary_double(v->data, decode_buf, sizeof(decode_buf));
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_INTERVAL_YM:
-        decode_interval_ym(v->data, v->data_len,
-                           decode_buf, sizeof(decode_buf));
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_INTERVAL_DS:
-        decode_interval_ds(v->data, v->data_len,
-                           decode_buf, sizeof(decode_buf));
-        set_value_string(v, decode_buf, (int)strlen(decode_buf));
-        v->type = col->type;
-        break;
-
-    case COL_RAW:
-    case COL_ROWID: {
-        int hi;
-        char hex_buf[ODV_VARCHAR_LEN];
-        int hlen = 0;
-        for (hi = 0; hi < v->data_len && hlen < (int)sizeof(hex_buf) - 3; hi++) {
-            snprintf(hex_buf + hlen, 3, "%02X", v->data[hi]);
-            hlen += 2;
-        }
-        hex_buf[hlen] = '\0';
-        set_value_string(v, hex_buf, hlen);
-        v->type = col->type;
-        break;
+static void kern_timestamp(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    int cap = s->date_prog.max_len + 32;
+    int len = take_raw(v, raw);
+    char *out = value_text_buf(v, cap);
+    commit_value_text(v, out ? decode_oracle_timestamp(raw, len, out, cap, &s->date_prog,
+                                                       col->precision) : -1);
+}
+
+static void kern_bin_float(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    char *out;
+    (void)s; (void)col;
+    take_raw(v, raw);
+    out = value_text_buf(v, 32);
+    commit_value_text(v, out ? decode_binary_float(raw, out, 32) : -1);
+}
+
+static void kern_bin_double(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    char *out;
+    (void)s; (void)col;
+    take_raw(v, raw);
+    out = value_text_buf(v, 32);
+    commit_value_text(v, out ? decode_binary_double(raw, out, 32) : -1);
+}
+
+static void kern_interval_ym(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    int len = take_raw(v, raw);
+    char *out = value_text_buf(v, 40);
+    (void)s; (void)col;
+    commit_value_text(v, out ? decode_interval_ym(raw, len, out, 40) : -1);
+}
+
+static void kern_interval_ds(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    unsigned char raw[EXPDP_RAW_MAX];
+    int len = take_raw(v, raw);
+    char *out = value_text_buf(v, 40);
+    (void)s; (void)col;
+    commit_value_text(v, out ? decode_interval_ds(raw, len, out, 40) : -1);
+}
+
+static void kern_hex(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    (void)s; (void)col;
+    if (v->data_len <= 0) {
+        set_value_string(v, "", 0);
+        return;
     }
+    set_value_hex(v, NULL, v->data, v->data_len);
+}
 
-    case COL_NCHAR:
-    case COL_NVARCHAR: {
-        char conv_buf[ODV_VARCHAR_LEN];
-        int conv_len = 0;
-        if (v->data && v->data_len > 0 &&
-            convert_charset((const char *)v->data, v->data_len,
-                            CHARSET_UTF16BE,
-                            conv_buf, sizeof(conv_buf),
-                            CHARSET_UTF8, &conv_len) == ODV_OK) {
-            set_value_string(v, conv_buf, conv_len);
-        } else if (v->data && v->data_len < v->buf_size) {
-            v->data[v->data_len] = '\0';
-        }
-        v->type = col->type;
-        break;
+/* NCHAR/NVARCHAR2 (AL16UTF16): transcoded in place.  For UTF-8 output the
+   raw units are moved up by half their length first so the output (at
+   most 1.5x) never overtakes the unread input; UTF-16LE is a byte swap. */
+static void kern_ntext(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    int n, gap;
+    (void)col;
+    if (!v->data || v->data_len <= 0) {
+        if (v->data && v->data_len < v->buf_size) v->data[v->data_len] = '\0';
+        return;
     }
+    n = v->data_len & ~1;
+    gap = s->plan.wide ? 0 : n / 2;
+    if (ensure_value_buf(v, gap + n + 2) != ODV_OK) {
+        if (v->data && v->data_len < v->buf_size) v->data[v->data_len] = '\0';
+        return;
+    }
+    if (s->plan.wide) {
+        v->data_len = odv_utf16be_to_utf16le(v->data, n, v->data, n, NULL);
+        v->data[v->data_len + 1] = '\0';
+    } else {
+        memmove(v->data + gap, v->data, n);
+        v->data_len = odv_utf16be_to_utf8(v->data + gap, n, v->data, gap + n, NULL);
+    }
+    v->data[v->data_len] = '\0';
+}
+
+/* CHAR/VARCHAR2 already in the output charset */
+static void kern_text(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    (void)s; (void)col;
+    if (v->data && v->data_len < v->buf_size) v->data[v->data_len] = '\0';
+}
 
-    case COL_CHAR:
-    case COL_VARCHAR:
-    default:
+/* Converted in the value's own span: the source bytes are parked past the
+   worst-case output (3 bytes per input byte) and converted back down. */
+static void kern_text_conv(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    int n, cap, conv_len = 0;
+    (void)col;
+    if (!v->data || v->data_len <= 0) {
         if (v->data && v->data_len < v->buf_size) v->data[v->data_len] = '\0';
-        if (s->dump_charset != s->out_charset &&
-            s->dump_charset != CHARSET_UNKNOWN) {
-            char conv_buf[ODV_VARCHAR_LEN];
-            int conv_len = 0;
-            if (convert_charset((const char *)v->data, v->data_len,
-                                s->dump_charset,
-                                conv_buf, sizeof(conv_buf),
-                                s->out_charset, &conv_len) == ODV_OK) {
-                set_value_string(v, conv_buf, conv_len);
-            }
-        }
-        v->type = col->type;
-        break;
+        return;
+    }
+    n = v->data_len;
+    if (n > (INT_MAX - 2) / 4) return;
+    cap = n * 3 + 2;
+    if (ensure_value_buf(v, cap + n) != ODV_OK) {
+        if (v->data_len < v->buf_size) v->data[v->data_len] = '\0';
+        return;
+    }
+    memmove(v->data + cap, v->data, n);
+    if (convert_charset((const char *)v->data + cap, n,
+                        s->plan.text_src_cs,
+                        (char *)v->data, cap,
+                        s->plan.text_dst_cs, &conv_len) == ODV_OK) {
+        commit_value_text(v, conv_len);
+    } else {
+        memmove(v->data, v->data + cap, n);
+        v->data[n] = '\0';
     }
 }
 
+/* LOB-family types seen inline are treated as text */
+static void kern_text_any(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    if (s->plan.text_src_cs != s->plan.text_dst_cs &&
+        s->plan.text_src_cs != CHARSET_UNKNOWN)
+        kern_text_conv(s, v, col);
+    else
+        kern_text(s, v, col);
+}
+
+/* Oracle wire bytes are left in the value for typed exporters */
+static void kern_raw(ODV_SESSION *s, ODV_VALUE *v, const ODV_COLDESC *col)
+{
+    (void)s; (void)v; (void)col;
+}
+
+static const EXPDP_KERNEL expdp_kernels[KERN_COUNT] = {
+    kern_text,          /* KERN_TEXT */
+    kern_text_conv,     /* KERN_TEXT_CONV */
+    kern_ntext,         /* KERN_NTEXT */
+    kern_number,        /* KERN_NUMBER */
+    kern_date,          /* KERN_DATE */
+    kern_timestamp,     /* KERN_TIMESTAMP */
+    kern_bin_float,     /* KERN_BIN_FLOAT */
+    kern_bin_double,    /* KERN_BIN_DOUBLE */
+    kern_interval_ym,   /* KERN_INTERVAL_YM */
+    kern_interval_ds,   /* KERN_INTERVAL_DS */
+    kern_hex,           /* KERN_HEX */
+    kern_text_any,      /* KERN_BLOB */
+    kern_text_any,      /* KERN_CLOB */
+    kern_text_any,      /* KERN_NCLOB */
+    kern_text_any,      /* KERN_BFILE */
+    kern_text_any,      /* KERN_LONG */
+    kern_text_any,      /* KERN_LONG_RAW */
+    kern_raw            /* KERN_RAW */
+};
+
+/* Decode a completed column value through the table's decode plan */
+static void decode_column_value(ODV_SESSION *s, int col_idx)
+{
+    ODV_VALUE         *v;
+    const ODV_COLDESC *col;
+
+    if (col_idx >= s->table.col_count) return;
+
+    v   = &s->record.values[col_idx];
+    col = &s->table.desc[col_idx];
+    v->is_null = 0;
+
+    expdp_kernels[s->plan.kernel[col_idx]](s, v, col);
+    if (s->plan.wide && (KERN_ASCII_MASK >> s->plan.kernel[col_idx] & 1))
+        widen_value_ascii(v);
+    v->type = col->type;
+}
+
 /*---------------------------------------------------------------------------
     Accumulate LOB preview data for GUI display.
 
     For BLOB: hex-encode into the column value (max ODV_LOB_PREVIEW_LEN/2 bytes)
     For CLOB: copy text into the column value (max ODV_LOB_PREVIEW_LEN bytes)
     Only accumulates if the LOB column is within the table's column range.
+    With UTF-16LE output every limit is doubled (two bytes per unit).
  ---------------------------------------------------------------------------*/
 static void accumulate_lob_preview(ODV_SESSION *s, int lob_col_idx,
                                    const unsigned char *data, int len)
 {
     int abs_col;    /* Absolute column index in the table */
-    int non_lob_cols;
-    int i, lob_i;
     ODV_VALUE *v;
     int col_type;
+    int cw = s->plan.wide ? 2 : 1;  /* Output bytes per ASCII character */
 
     if (!data || len <= 0) return;
 
-    non_lob_cols = s->table.col_count - s->table.lob_col_count;
-    if (non_lob_cols < 0) non_lob_cols = 0;
-
-    /* Find the absolute column index for this LOB column */
-    abs_col = -1;
-    lob_i = 0;
-    for (i = 0; i < s->table.col_count; i++) {
-        int t = s->table.columns[i].type;
-        if (t == COL_BLOB || t == COL_CLOB || t == COL_NCLOB ||
-            t == COL_LONG || t == COL_LONG_RAW) {
-            if (lob_i == lob_col_idx) {
-                abs_col = i;
-                break;
-            }
-            lob_i++;
-        }
-    }
-    if (abs_col < 0 || abs_col >= s->table.col_count) return;
+    /* Absolute column index for this LOB column */
+    if (lob_col_idx < 0 || lob_col_idx >= s->plan.lob_count) return;
+    abs_col = s->plan.lob_cols[lob_col_idx];
 
-    col_type = s->table.columns[abs_col].type;
+    col_type = s->table.desc[abs_col].type;
     v = &s->record.values[abs_col];
     v->type = col_type;
     v->is_null = 0;
@@ -616,46 +694,54 @@ static void accumulate_lob_preview(ODV_SESSION *s, int lob_col_idx,
     if (col_type == COL_BLOB || col_type == COL_LONG_RAW) {
         /* BLOB: hex-encode (each source byte → 2 hex chars) */
         int max_src = ODV_LOB_PREVIEW_LEN / 2;  /* max source bytes */
-        int already = v->data_len / 2;           /* source bytes already encoded */
+        int already = v->data_len / (2 * cw);    /* source bytes already encoded */
         int avail = max_src - already;
         int to_encode = (len < avail) ? len : avail;
-        int hi;
+        unsigned char *d;
 
         if (to_encode <= 0) return;
-        ensure_value_buf(v, v->data_len + to_encode * 2 + 1);
+        ensure_value_buf(v, v->data_len + to_encode * 2 * cw + cw);
         if (!v->data) return;
 
-        for (hi = 0; hi < to_encode; hi++) {
-            snprintf((char *)v->data + v->data_len, 3, "%02X", data[hi]);
-            v->data_len += 2;
-        }
-        v->data[v->data_len] = '\0';
+        d = v->data + v->data_len;
+        d += odv_hex_encode(data, to_encode, (char *)d, cw == 2);
+        v->data_len = (int)(d - v->data);
+        d[0] = '\0';
+        if (cw == 2) d[1] = '\0';
     } else if (col_type == COL_CLOB || col_type == COL_NCLOB) {
         /* CLOB/NCLOB: Oracle EXPDP stores LOB data in AL16UTF16 (UTF-16BE).
-         * Convert to UTF-8 for display. */
-        int max_bytes = ODV_LOB_PREVIEW_LEN;
+         * Transcode to the output charset for display. */
+        int max_bytes = ODV_LOB_PREVIEW_LEN * cw;
         int avail = max_bytes - v->data_len;
-        char conv_buf[ODV_LOB_PREVIEW_LEN + 4];
-        int conv_len = 0;
         int src_len = (len < avail * 2) ? len : avail * 2; /* UTF-16 is ~2x */
 
-        if (avail <= 0 || src_len <= 0) return;
-
-        /* Ensure even byte count for UTF-16 */
-        src_len &= ~1;
-        if (src_len <= 0) return;
-
-        if (convert_charset((const char *)data, src_len,
-                            CHARSET_UTF16BE,
-                            conv_buf, sizeof(conv_buf),
-                            CHARSET_UTF8, &conv_len) == ODV_OK && conv_len > 0) {
-            int to_copy = (conv_len < avail) ? conv_len : avail;
-            ensure_value_buf(v, v->data_len + to_copy + 1);
-            if (!v->data) return;
-            memcpy(v->data + v->data_len, conv_buf, to_copy);
-            v->data_len += to_copy;
-            v->data[v->data_len] = '\0';
+        if (avail <= 0 || src_len < 2) return;
+        ensure_value_buf(v, v->data_len + avail + cw);
+        if (!v->data) return;
+
+        if (cw == 2) {
+            v->data_len += odv_utf16be_to_utf16le(data, src_len,
+                                                  v->data + v->data_len, avail, NULL);
+            v->data[v->data_len + 1] = '\0';
+        } else {
+            v->data_len += odv_utf16be_to_utf8(data, src_len,
+                                               v->data + v->data_len, avail, NULL);
         }
+        v->data[v->data_len] = '\0';
+    } else if (cw == 2) {
+        /* LONG (UTF-16LE output): convert from the dump charset */
+        int avail = ODV_LOB_PREVIEW_LEN * 2 - v->data_len;
+        int to_conv = (len < avail / 2) ? len : avail / 2;
+        int out_len = 0;
+
+        if (to_conv <= 0) return;
+        ensure_value_buf(v, v->data_len + avail + 2);
+        if (!v->data) return;
+
+        if (convert_charset((const char *)data, to_conv, s->plan.text_src_cs,
+                            (char *)v->data + v->data_len, avail + 2,
+                            CHARSET_UTF16LE, &out_len) == ODV_OK)
+            v->data_len += out_len;
     } else {
         /* LONG: copy text directly (stored in DB charset) */
         int max_bytes = ODV_LOB_PREVIEW_LEN;
@@ -707,6 +793,7 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
     int chunk_size = 0;
     int record_count = 0;
     int progress_counter = 0;
+    int64_t next_ckpt;
     int rc;
 
     non_lob_cols = s->table.col_count - s->table.lob_col_count;
@@ -731,19 +818,14 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
     st->filler_length    = 2;
     st->seg_remaining    = -1;
 
-    /* Build non-LOB column → absolute column index mapping.
-     * In EXPDP LOB records, column data is packed without LOB columns.
-     * For tables with no LOBs, this is a trivial identity mapping. */
+    /* Decode plan: kernels per column and the non-LOB column → absolute
+     * column index mapping.  In EXPDP LOB records, column data is packed
+     * without LOB columns; for tables with no LOBs the map is the identity. */
     {
-        int mi, mc = 0;
-        for (mi = 0; mi < s->table.col_count && mc < ODV_MAX_COLUMNS; mi++) {
-            int t = s->table.columns[mi].type;
-            if (t != COL_BLOB && t != COL_CLOB && t != COL_NCLOB &&
-                t != COL_LONG && t != COL_LONG_RAW) {
-                st->non_lob_map[mc++] = mi;
-            }
-        }
-        st->non_lob_count = mc;
+        const ODV_DECODE_PLAN *pl = odv_decode_plan(s);
+        if (!pl) return ODV_ERROR_MALLOC;
+        st->non_lob_map   = pl->non_lob_cols;
+        st->non_lob_count = pl->non_lob_count;
     }
 
     /* In LOB extraction mode, validate the target column exists */
@@ -753,13 +835,26 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
     }
 
     /* Ensure record has enough columns */
-    if (s->record.max_columns < s->table.col_count) {
-        free_record(&s->record);
-        rc = init_record(&s->record, s->table.col_count + 16);
-        if (rc != ODV_OK) return rc;
-    }
+    rc = grow_record(&s->record, s->table.col_count);
+    if (rc != ODV_OK) return rc;
+
+    /* odv_seek_row: jump to the nearest row checkpoint */
+    if (odv_ckpt_resume(s, fp, st))
+        *address = odv_ftell(fp);
+
+    /* Row checkpoints are collected on the first (counting) scan only */
+    s->ckpt_count = 0;
+    next_ckpt = s->checkpoint_interval;
 
     while (!s->cancelled) {
+        /* Record boundary: take a row checkpoint every K rows */
+        if (list_only && st->step == 1 && next_ckpt > 0
+            && s->table.record_count >= next_ckpt) {
+            rc = odv_ckpt_add(s, fp, st);
+            if (rc != ODV_OK) return rc;
+            next_ckpt = s->table.record_count + s->checkpoint_interval;
+        }
+
         /* Segment boundary check: Oracle omits trailing NULL columns.
          * When a 3c-segment is exhausted while we are still reading
          * normal columns, treat unread columns as NULL and deliver. */
@@ -772,10 +867,14 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
                 st->col_idx++;
             }
             s->record.col_count = s->table.col_count;
-            if (!list_only && !st->is_lob_record) {
-                rc = deliver_row(s);
-                if (rc != ODV_OK) return rc;
-                odv_report_progress(s, fp);
+            if (!st->is_lob_record) {
+                /* Counted on the list scan too: row checkpoints and
+                   odv_seek_row rely on the same numbering */
+                if (!list_only) {
+                    rc = deliver_row(s);
+                    if (rc != ODV_OK) return rc;
+                    odv_report_progress(s, fp);
+                }
                 record_count++;
                 s->table.record_count++;
             }
@@ -924,7 +1023,7 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
                     if (ac < s->table.col_count) {
                         set_value_null(&s->record.values[ac]);
                         s->record.values[ac].type =
-                            s->table.columns[ac].type;
+                            s->table.desc[ac].type;
                     }
                     st->col_idx++;
                 } else if (b == 0xfe) {
@@ -936,7 +1035,7 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
                     if (ac < s->table.col_count) {
                         set_value_string(&s->record.values[ac], "", 0);
                         s->record.values[ac].type =
-                            s->table.columns[ac].type;
+                            s->table.desc[ac].type;
                     }
                     st->col_idx++;
                 } else {
@@ -1018,8 +1117,34 @@ static int parse_expdp_records(ODV_SESSION *s, FILE *fp, int64_t *address,
                     if (v->data && v->data_len < v->buf_size - 1) {
                         v->data[v->data_len++] = b;
                     }
+                    st->col_remaining--;
+
+                    /* Bulk-read the rest of the column straight into the
+                       value.  Stop short of the next block offset 2 so the
+                       "<?xml" overrun check above still sees that byte. */
+                    if (st->col_remaining > 0 && v->data) {
+                        int n = st->col_remaining;
+                        int space = v->buf_size - 1 - v->data_len;
+                        int to_mark = (int)((ODV_DUMP_BLOCK_LEN + 2
+                                             - *address % ODV_DUMP_BLOCK_LEN)
+                                            % ODV_DUMP_BLOCK_LEN);
+                        if (n > space) n = space;
+                        if (n > to_mark) n = to_mark;
+                        if (n > 0) {
+                            int got = (int)fread(v->data + v->data_len, 1, n, fp);
+                            v->data_len += got;
+                            *address += got;
+                            st->col_remaining -= got;
+                            progress_counter += got;
+                            if (st->seg_remaining > 0) {
+                                st->seg_remaining -= got;
+                                if (st->seg_remaining < 0) st->seg_remaining = 0;
+                            }
+                        }
+                    }
+                } else {
+                    st->col_remaining--;
                 }
-                st->col_remaining--;
                 if (st->col_remaining <= 0) {
                     /* Column complete — decode */
                     decode_column_value(s, ac);
@@ -1403,7 +1528,7 @@ int parse_expdp_dump(ODV_SESSION *s, int list_only)
         return ODV_ERROR_MALLOC;
     }
 
-    s->table_count = 0;
+    if (!s->keep_table_list) s->table_count = 0;
     s->total_rows = 0;
 
     /* Fast seek: if seek_offset is set (from previous list_tables),
@@ -1470,10 +1595,11 @@ int parse_expdp_dump(ODV_SESSION *s, int list_only)
                 dc.session = s;
 
                 /* Reset table for new definition */
-                memset(&s->table, 0, sizeof(ODV_TABLE));
+                odv_tee_sync(s);
+                odv_table_reset(&s->table);
                 s->table.dump_charset = s->dump_charset;
                 s->table.os_charset = s->out_charset;
-                invalidate_meta_cache();
+                odv_table_changed(s);
 
                 parse_xml_ddl(ddl_buf, end_pos, ddl_xml_callback, &dc);
 
@@ -1490,46 +1616,7 @@ int parse_expdp_dump(ODV_SESSION *s, int list_only)
 
                     /* Table filter check */
                     if (s->filter_active) {
-                        int match = 1;
-                        if (s->filter_table[0]) {
-                            char ft[ODV_OBJNAME_LEN + 1];
-                            int ft_len = 0;
-                            odv_strcpy(ft, s->filter_table, ODV_OBJNAME_LEN);
-                            ft_len = (int)strlen(ft);
-                            /* Reverse-convert filter name: UTF-8 → dump charset */
-                            if (s->dump_charset != s->out_charset &&
-                                s->dump_charset != CHARSET_UNKNOWN) {
-                                char tmp[ODV_OBJNAME_LEN + 1];
-                                int tlen = 0;
-                                if (convert_charset(ft, ft_len, s->out_charset,
-                                                    tmp, ODV_OBJNAME_LEN, s->dump_charset,
-                                                    &tlen) == ODV_OK) {
-                                    tmp[tlen] = '\0';
-                                    odv_strcpy(ft, tmp, ODV_OBJNAME_LEN);
-                                }
-                            }
-                            if (odv_stricmp(s->table.name, ft) != 0)
-                                match = 0;
-                        }
-                        if (match && s->filter_schema[0]) {
-                            char fs[ODV_OBJNAME_LEN + 1];
-                            int fs_len = 0;
-                            odv_strcpy(fs, s->filter_schema, ODV_OBJNAME_LEN);
-                            fs_len = (int)strlen(fs);
-                            if (s->dump_charset != s->out_charset &&
-                                s->dump_charset != CHARSET_UNKNOWN) {
-                                char tmp[ODV_OBJNAME_LEN + 1];
-                                int tlen = 0;
-                                if (convert_charset(fs, fs_len, s->out_charset,
-                                                    tmp, ODV_OBJNAME_LEN, s->dump_charset,
-                                                    &tlen) == ODV_OK) {
-                                    tmp[tlen] = '\0';
-                                    odv_strcpy(fs, tmp, ODV_OBJNAME_LEN);
-                                }
-                            }
-                            if (odv_stricmp(s->table.schema, fs) != 0)
-                                match = 0;
-                        }
+                        int match = odv_filter_match(s);
                         s->pass_flg = match ? 0 : 1;
 
                         /* Early exit: target table already processed,
@@ -1545,16 +1632,18 @@ int parse_expdp_dump(ODV_SESSION *s, int list_only)
 
                     if (list_only && s->filter_active && s->pass_flg) {
                         /* Filtered out in list_only: skip records entirely */
-                        notify_table(s, 0);
+                        if (notify_table(s, 0) != ODV_OK) goto expdp_nomem;
                     } else if (list_only && !s->filter_active) {
                         /* list_only without filter: count rows */
                         rc = parse_expdp_records(s, fp, &address, list_only);
-                        notify_table(s, s->table.record_count);
+                        if (notify_table(s, s->table.record_count) != ODV_OK)
+                            goto expdp_nomem;
                         if (rc != ODV_OK && rc != ODV_ERROR_CANCELLED) { /* non-fatal */ }
                     } else if (!s->filter_active || !s->pass_flg) {
                         /* Full parse (no filter or filter matched) */
                         rc = parse_expdp_records(s, fp, &address, list_only);
-                        notify_table(s, s->table.record_count);
+                        if (notify_table(s, s->table.record_count) != ODV_OK)
+                            goto expdp_nomem;
                         if (rc != ODV_OK && rc != ODV_ERROR_CANCELLED) { /* non-fatal */ }
 
                         /* When seek_offset was used, we parsed exactly one partition's
@@ -1566,7 +1655,7 @@ int parse_expdp_dump(ODV_SESSION *s, int list_only)
                         }
                     } else {
                         /* Filtered out in full parse: skip records */
-                        notify_table(s, 0);
+                        if (notify_table(s, 0) != ODV_OK) goto expdp_nomem;
                     }
                 }
 
@@ -1607,33 +1696,20 @@ expdp_done:
      * [len]SCHEMA [ff][02][c1][02][ff][ff][ff][len]PARTITION_NAME[ff]
      * For non-partitioned tables, PARTITION_NAME is absent (just [ff]s). */
     if (list_only && s->table_count > 0) {
-        /* Build per-table occurrence counters for partition matching.
-         * part_occ[i] = which occurrence (0-based) of this schema.table
-         * in the table_list (e.g., 4 partitions → occ 0,1,2,3). */
-        int part_occ[ODV_MAX_TABLES];
-        {
-            int ti;
-            for (ti = 0; ti < s->table_count; ti++) {
-                part_occ[ti] = 0;
-                int k;
-                for (k = 0; k < ti; k++) {
-                    if (strcmp(s->table_list[k].schema, s->table_list[ti].schema) == 0 &&
-                        strcmp(s->table_list[k].name, s->table_list[ti].name) == 0) {
-                        part_occ[ti]++;
-                    }
-                }
-            }
-        }
+        /* The n-th TABLE_DATA record of a schema.table in the master table
+         * belongs to the n-th table_list entry with that key (entries are
+         * chained per key by the catalog index).  Rewind each key's cursor
+         * to its first occurrence. */
+        int ti;
+        if (odv_table_index_sync(s) != ODV_OK) goto expdp_nomem;
+        for (ti = 0; ti < s->table_count; ti++)
+            s->table_list[ti].scan_cursor = ti;
 
         /* Scan file for SCHEMA_EXPORT/TABLE/TABLE_DATA entries.
          * Simple approach: search byte-by-byte, then seek+read the structure. */
         {
             static const char path_marker[] = "SCHEMA_EXPORT/TABLE/TABLE_DATA";
             static const int path_len = 30;
-            /* Track per-table occurrence in master table */
-            char scan_keys[ODV_MAX_TABLES][ODV_OBJNAME_LEN * 2 + 2];
-            int scan_count = 0;
-
             /* Use the already-parsed file — re-open for scanning */
             FILE *sfp = fopen(s->dump_path, "rb");
             if (sfp) {
@@ -1694,33 +1770,20 @@ expdp_done:
 
                         /* Convert charset for matching */
                         char ct[260], cs2[260];
-                        convert_name(tn, s->dump_charset, s->out_charset, ct, sizeof(ct));
-                        convert_name(sn, s->dump_charset, s->out_charset, cs2, sizeof(cs2));
-
-                        /* Count occurrence */
-                        int occ = 0;
-                        {
-                            char key[260];
-                            snprintf(key, sizeof(key), "%s.%s", cs2, ct);
-                            int pi;
-                            for (pi = 0; pi < scan_count; pi++) {
-                                if (strcmp(scan_keys[pi], key) == 0) occ++;
-                            }
-                            if (scan_count < ODV_MAX_TABLES)
-                                odv_strcpy(scan_keys[scan_count++], key, 259);
-                        }
-
-                        /* Assign partition name to matching table_list entry */
-                        if (pn[0]) {
-                            int ti;
-                            for (ti = 0; ti < s->table_count; ti++) {
-                                if (strcmp(s->table_list[ti].schema, cs2) == 0 &&
-                                    strcmp(s->table_list[ti].name, ct) == 0 &&
-                                    part_occ[ti] == occ) {
-                                    odv_strcpy(s->table_list[ti].partition, pn,
+                        convert_name(tn, s->dump_charset, CHARSET_UTF8, ct, sizeof(ct));
+                        convert_name(sn, s->dump_charset, CHARSET_UTF8, cs2, sizeof(cs2));
+
+                        /* Advance this key's cursor; assign the partition
+                         * name to the entry it pointed at */
+                        int first = odv_table_index_find(s, cs2, ct);
+                        if (first >= 0) {
+                            ODV_TABLE_ENTRY *f = &s->table_list[first];
+                            int cur = f->scan_cursor;
+                            if (cur >= 0) {
+                                f->scan_cursor = s->table_list[cur].occ_next;
+                                if (pn[0])
+                                    odv_strcpy(s->table_list[cur].partition, pn,
                                                ODV_OBJNAME_LEN);
-                                    break;
-                                }
                             }
                         }
                     }
@@ -1802,25 +1865,19 @@ expdp_done:
 
                         /* Convert charset */
                         char ct[260], cs2[260], cc[260];
-                        convert_name(tn, s->dump_charset, s->out_charset, ct, sizeof(ct));
-                        convert_name(sn, s->dump_charset, s->out_charset, cs2, sizeof(cs2));
-                        convert_name(cn, s->dump_charset, s->out_charset, cc, sizeof(cc));
+                        convert_name(tn, s->dump_charset, CHARSET_UTF8, ct, sizeof(ct));
+                        convert_name(sn, s->dump_charset, CHARSET_UTF8, cs2, sizeof(cs2));
+                        convert_name(cn, s->dump_charset, CHARSET_UTF8, cc, sizeof(cc));
 
                         /* Find matching table in table_list (first occurrence for
                          * partitioned tables) and add constraint name. */
-                        int ti;
-                        for (ti = 0; ti < s->table_count; ti++) {
-                            if (strcmp(s->table_list[ti].schema, cs2) == 0 &&
-                                strcmp(s->table_list[ti].name, ct) == 0) {
-                                ODV_TABLE_ENTRY *te = &s->table_list[ti];
-                                if (te->meta_constraint_count < ODV_MAX_META_CONSTRAINTS) {
-                                    ODV_CONSTRAINT_NAME *mc =
-                                        &te->meta_constraints[te->meta_constraint_count];
-                                    odv_strcpy(mc->name, cc, ODV_OBJNAME_LEN);
-                                    mc->type = mtype;
-                                    te->meta_constraint_count++;
-                                }
-                                break;
+                        int ti = odv_table_index_find(s, cs2, ct);
+                        if (ti >= 0) {
+                            ODV_CONSTRAINT_NAME *mc =
+                                odv_entry_add_constraint_name(&s->table_list[ti]);
+                            if (mc) {
+                                odv_strcpy(mc->name, cc, ODV_OBJNAME_LEN);
+                                mc->type = mtype;
                             }
                         }
                     }
@@ -1835,4 +1892,10 @@ expdp_done:
 
     if (s->cancelled) return ODV_ERROR_CANCELLED;
     return ODV_OK;
+
+expdp_nomem:
+    free(ddl_buf);
+    fclose(fp);
+    odv_strcpy(s->last_error, "Out of memory building the table list", ODV_MSG_LEN);
+    return ODV_ERROR_MALLOC;
 }
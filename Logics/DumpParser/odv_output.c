@@ -0,0 +1,692 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_output.c
+    Buffered export output
+
+    Exporters format rows into a large private buffer that goes to the
+    file in ODV_OUTBUF_SIZE blocks, instead of a stdio call per field or
+    character.  The stream itself is unbuffered, so each block is a single
+    write to the OS.  Instead of a file, the sink can be a descriptor
+    (pipe, socket, stdout) or a write callback.  With compression on (odv_compress.c) every block
+    becomes one gzip member / zstd frame instead.  ODV_SPLIT spreads an
+    export over size / row-count rotated parts and hash-sharded files.
+    Also holds the vectorized scan that finds the bytes a CSV field has
+    to be quoted for.
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE               /* F_SETPIPE_SZ */
+#endif
+
+#include "odv_types.h"
+#include <stdarg.h>
+#include <errno.h>
+
+#ifdef WINDOWS
+  #include <io.h>
+  #include <fcntl.h>
+#else
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <pthread.h>
+  #include <signal.h>
+  #include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+  #include <emmintrin.h>
+  #define ODV_SCAN_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  #include <arm_neon.h>
+  #define ODV_SCAN_NEON
+#endif
+
+/*---------------------------------------------------------------------------
+    odv_out_open
+
+    Creates (truncates) the output file and allocates the buffer.
+ ---------------------------------------------------------------------------*/
+int odv_out_open(ODV_OUTBUF *o, const char *path)
+{
+    if (!o || !path) return ODV_ERROR_INVALID_ARG;
+
+    memset(o, 0, sizeof(*o));
+    o->fd = -1;
+    o->buf = (char *)malloc(ODV_OUTBUF_SIZE);
+    if (!o->buf) return ODV_ERROR_MALLOC;
+    o->cap = ODV_OUTBUF_SIZE;
+
+    o->fp = fopen(path, "wb");
+    if (!o->fp) {
+        free(o->buf);
+        o->buf = NULL;
+        return ODV_ERROR_FOPEN;
+    }
+    setvbuf(o->fp, NULL, _IONBF, 0);
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_open_fd
+
+    Output to an open descriptor, which the caller keeps and closes.
+    A pipe is widened to hold a whole block where the OS allows, so the
+    reader is woken once per block rather than every 64KB.
+ ---------------------------------------------------------------------------*/
+int odv_out_open_fd(ODV_OUTBUF *o, int fd)
+{
+    if (!o || fd < 0) return ODV_ERROR_INVALID_ARG;
+
+    memset(o, 0, sizeof(*o));
+    o->fd = fd;
+    o->buf = (char *)malloc(ODV_OUTBUF_SIZE);
+    if (!o->buf) return ODV_ERROR_MALLOC;
+    o->cap = ODV_OUTBUF_SIZE;
+
+#ifdef WINDOWS
+    _setmode(fd, _O_BINARY);        /* No LF -> CRLF translation on stdout */
+#elif defined(F_SETPIPE_SZ)
+    {
+        int size = fcntl(fd, F_GETPIPE_SZ);
+        if (size > 0 && size < ODV_OUTBUF_SIZE) fcntl(fd, F_SETPIPE_SZ, ODV_OUTBUF_SIZE);
+    }
+#endif
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_open_callback
+
+    Output to a write callback, called with one block at a time.
+ ---------------------------------------------------------------------------*/
+int odv_out_open_callback(ODV_OUTBUF *o, ODV_WRITE_CALLBACK cb, void *user_data)
+{
+    if (!o || !cb) return ODV_ERROR_INVALID_ARG;
+
+    memset(o, 0, sizeof(*o));
+    o->fd = -1;
+    o->write_cb = cb;
+    o->write_ud = user_data;
+    o->buf = (char *)malloc(ODV_OUTBUF_SIZE);
+    if (!o->buf) return ODV_ERROR_MALLOC;
+    o->cap = ODV_OUTBUF_SIZE;
+    return ODV_OK;
+}
+
+/* Writes all n bytes to a descriptor, resuming after partial writes and
+   signals.  A non-blocking descriptor is waited on until the reader has
+   drained it. */
+#ifdef WINDOWS
+static int fd_write(int fd, const char *p, int n)
+{
+    while (n > 0) {
+        int w = _write(fd, p, (unsigned int)n);
+        if (w <= 0) return (errno == EPIPE) ? ODV_ERROR_EPIPE : ODV_ERROR_FWRITE;
+        p += w;
+        n -= w;
+    }
+    return ODV_OK;
+}
+#else
+static int fd_write(int fd, const char *p, int n)
+{
+    sigset_t pipe_set, old_set, pending;
+    int was_pending, rc = ODV_OK;
+
+    /* A reader that goes away must fail the export with EPIPE instead of
+       killing the host with SIGPIPE: hold the signal back on this thread
+       and take the one the failed write raised */
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+    sigpending(&pending);
+    was_pending = sigismember(&pending, SIGPIPE);
+
+    while (n > 0) {
+        ssize_t w = write(fd, p, (size_t)n);
+        if (w > 0) {
+            p += w;
+            n -= (int)w;
+        } else if (w < 0 && errno == EINTR) {
+            continue;
+        } else if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+                rc = ODV_ERROR_FWRITE;
+                break;
+            }
+        } else {
+            rc = (w < 0 && errno == EPIPE) ? ODV_ERROR_EPIPE : ODV_ERROR_FWRITE;
+            break;
+        }
+    }
+
+    if (rc == ODV_ERROR_EPIPE && !was_pending) {
+        sigpending(&pending);
+        if (sigismember(&pending, SIGPIPE)) {
+            int sig;
+            sigwait(&pipe_set, &sig);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &old_set, NULL);
+    return rc;
+}
+#endif
+
+/*---------------------------------------------------------------------------
+    odv_out_send
+
+    Passes n bytes to the sink as they are (no buffering, no compression).
+    Returns ODV_OK, ODV_ERROR_EPIPE or ODV_ERROR_FWRITE.
+ ---------------------------------------------------------------------------*/
+int odv_out_send(ODV_OUTBUF *o, const void *p, int n)
+{
+    const char *s = (const char *)p;
+
+    if (o->write_cb) {
+        while (n > 0) {
+            int w = o->write_cb(s, n, o->write_ud);
+            if (w <= 0 || w > n) return ODV_ERROR_FWRITE;
+            s += w;
+            n -= w;
+        }
+        return ODV_OK;
+    }
+    if (o->fd >= 0) return fd_write(o->fd, s, n);
+    return (fwrite(p, 1, (size_t)n, o->fp) == (size_t)n) ? ODV_OK : ODV_ERROR_FWRITE;
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_flush
+
+    Writes the buffered bytes.  A failure is kept in o->error and later
+    output is discarded.
+ ---------------------------------------------------------------------------*/
+int odv_out_flush(ODV_OUTBUF *o)
+{
+    o->flushed += o->len;
+    if (o->z) return (o->len > 0) ? odv_z_flush(o) : o->error;
+    if (o->len > 0 && o->error == ODV_OK)
+        o->error = odv_out_send(o, o->buf, o->len);
+    o->len = 0;
+    return o->error;
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_write
+
+    Appends n bytes.  Blocks larger than the buffer bypass it, unless the
+    output is compressed (blocks are then cut at the buffer size).
+ ---------------------------------------------------------------------------*/
+void odv_out_write(ODV_OUTBUF *o, const void *p, int n)
+{
+    if (n <= 0) return;
+    if (o->z) {
+        const char *s = (const char *)p;
+        while (n > 0) {
+            int k = ODV_MIN(n, o->cap - o->len);
+            memcpy(o->buf + o->len, s, k);
+            o->len += k;
+            s += k;
+            n -= k;
+            if (o->len == o->cap) odv_out_flush(o);
+        }
+        return;
+    }
+    if (n <= o->cap - o->len) {
+        memcpy(o->buf + o->len, p, n);
+        o->len += n;
+        return;
+    }
+    odv_out_flush(o);
+    if (n < o->cap) {
+        memcpy(o->buf, p, n);
+        o->len = n;
+    } else {
+        o->flushed += n;
+        if (o->error == ODV_OK) o->error = odv_out_send(o, p, n);
+    }
+}
+
+void odv_out_puts(ODV_OUTBUF *o, const char *str)
+{
+    odv_out_write(o, str, (int)strlen(str));
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_printf
+
+    Formatted append.  Formats straight into the buffer when it fits.
+ ---------------------------------------------------------------------------*/
+void odv_out_printf(ODV_OUTBUF *o, const char *fmt, ...)
+{
+    va_list ap;
+    char *tmp;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(o->buf + o->len, (size_t)(o->cap - o->len), fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if (n < o->cap - o->len) {
+        o->len += n;
+        return;
+    }
+
+    tmp = (char *)malloc((size_t)n + 1);
+    if (!tmp) {
+        o->error = ODV_ERROR_MALLOC;
+        return;
+    }
+    va_start(ap, fmt);
+    vsnprintf(tmp, (size_t)n + 1, fmt, ap);
+    va_end(ap);
+    odv_out_write(o, tmp, n);
+    free(tmp);
+}
+
+/*---------------------------------------------------------------------------
+    odv_out_close
+
+    Flushes (finishing the compressed stream), closes the file and frees
+    the buffer.  A descriptor sink stays open.
+    Returns ODV_OK, or the error of the first failed write.
+ ---------------------------------------------------------------------------*/
+int odv_out_close(ODV_OUTBUF *o)
+{
+    int rc;
+
+    if (!o || !o->buf) return ODV_ERROR_INVALID_ARG;
+    rc = o->z ? odv_z_close(o) : odv_out_flush(o);
+    if (o->fp && fclose(o->fp) != 0 && rc == ODV_OK) rc = ODV_ERROR_FWRITE;
+    free(o->buf);
+    o->buf = NULL;
+    o->fp = NULL;
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    Split / sharded output
+
+    Without rotation or sharding the single part is the output path
+    itself.  Otherwise parts are named
+        <name>_<shard>_<part><ext>   rotation and sharding
+        <name>_<shard><ext>          sharding only
+        <name>_<part><ext>           rotation only
+    with 4-digit numbers from 0001.  <ext> is the last extension, or the
+    last two when that is .gz / .zst ("t.csv.gz" -> "t_0001.csv.gz").
+ ---------------------------------------------------------------------------*/
+static void split_name(const ODV_SPLIT *sp, int k, char *name, size_t size)
+{
+    const char *path = sp->path, *base = sp->path, *ext, *p;
+    char suffix[24];
+    int n = 0;
+
+    for (p = path; *p; p++)
+        if (*p == '/' || *p == '\\') base = p + 1;
+    ext = strrchr(base, '.');
+    if (ext && ext > base && (strcmp(ext, ".gz") == 0 || strcmp(ext, ".zst") == 0)) {
+        for (p = ext - 1; p > base && *p != '.'; p--)
+            ;
+        if (p > base) ext = p;
+    }
+    if (!ext || ext == base) ext = path + strlen(path);
+
+    suffix[0] = '\0';
+    if (sp->shards > 1) n = snprintf(suffix, sizeof(suffix), "_%04d", k + 1);
+    if (sp->numbered) snprintf(suffix + n, sizeof(suffix) - (size_t)n, "_%04d", sp->part[k]);
+    snprintf(name, size, "%.*s%s%s", (int)(ext - path), path, suffix, ext);
+}
+
+static int split_open_part(ODV_SPLIT *sp, int k, ODV_OUTBUF *o)
+{
+    char name[ODV_PATH_LEN + 32];
+    int rc;
+
+    if (sp->shards > 1 || sp->numbered) split_name(sp, k, name, sizeof(name));
+    else odv_strcpy(name, sp->path, ODV_PATH_LEN - 1);
+
+    rc = odv_out_open(o, name);
+    if (rc != ODV_OK) return rc;
+    rc = odv_out_compress(o, sp->codec, sp->level, sp->threads);
+    if (rc != ODV_OK) odv_out_close(o);
+    return rc;
+}
+
+static void split_free(ODV_SPLIT *sp)
+{
+    free(sp->files);
+    free(sp->part);
+    free(sp->rows);
+    free(sp->fresh);
+    free(sp->key);
+    sp->files = NULL;
+    sp->part = NULL;
+    sp->rows = NULL;
+    sp->fresh = NULL;
+    sp->key = NULL;
+}
+
+/*---------------------------------------------------------------------------
+    odv_split_open
+
+    Opens the first part of every shard, with the session's rotation,
+    sharding and compression options.
+    Returns ODV_OK, ODV_ERROR_FOPEN or a compression setup error.
+ ---------------------------------------------------------------------------*/
+int odv_split_open(ODV_SPLIT *sp, ODV_SESSION *s, const char *path)
+{
+    int k, rc, threads;
+
+    if (!sp || !s || !path) return ODV_ERROR_INVALID_ARG;
+
+    memset(sp, 0, sizeof(*sp));
+    sp->session = s;
+    sp->shards = (s->shard_count > 1) ? s->shard_count : 1;
+    sp->max_bytes = s->split_max_bytes;
+    sp->max_rows = s->split_max_rows;
+    sp->numbered = (sp->max_bytes > 0 || sp->max_rows > 0);
+    sp->codec = s->out_compression;
+    sp->level = s->out_compression_level;
+    odv_strcpy(sp->path, path, ODV_PATH_LEN - 1);
+
+    /* Shards share the CPUs; two workers at least keep each shard's
+       compression off the exporting thread */
+    threads = s->out_compression_threads;
+    if (sp->shards > 1 && sp->codec != ODV_COMPRESS_NONE) {
+        if (threads <= 0) threads = odv_cpu_count();
+        if (threads > 1) threads = ODV_MAX(2, (threads + sp->shards - 1) / sp->shards);
+    }
+    sp->threads = threads;
+
+    sp->files = (ODV_OUTBUF *)calloc((size_t)sp->shards, sizeof(ODV_OUTBUF));
+    sp->part = (int *)calloc((size_t)sp->shards, sizeof(int));
+    sp->rows = (int64_t *)calloc((size_t)sp->shards, sizeof(int64_t));
+    sp->fresh = (unsigned char *)calloc((size_t)sp->shards, 1);
+    if (!sp->files || !sp->part || !sp->rows || !sp->fresh) {
+        split_free(sp);
+        return ODV_ERROR_MALLOC;
+    }
+
+    for (k = 0; k < sp->shards; k++) {
+        sp->part[k] = 1;
+        sp->fresh[k] = 1;
+        rc = split_open_part(sp, k, &sp->files[k]);
+        if (rc != ODV_OK) {
+            while (--k >= 0) odv_out_close(&sp->files[k]);
+            split_free(sp);
+            return rc;
+        }
+    }
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    odv_split_attach
+
+    Single-part output to an already opened sink (descriptor / callback);
+    rotation and sharding do not apply to a stream.  The split owns o
+    from here on, also when compression cannot be started.
+ ---------------------------------------------------------------------------*/
+int odv_split_attach(ODV_SPLIT *sp, ODV_SESSION *s, ODV_OUTBUF *o)
+{
+    int rc;
+
+    if (!sp || !s || !o || !o->buf) return ODV_ERROR_INVALID_ARG;
+
+    memset(sp, 0, sizeof(*sp));
+    sp->session = s;
+    sp->shards = 1;
+    sp->codec = s->out_compression;
+    sp->level = s->out_compression_level;
+    sp->threads = s->out_compression_threads;
+
+    rc = odv_out_compress(o, sp->codec, sp->level, sp->threads);
+    if (rc != ODV_OK) {
+        odv_out_close(o);
+        return rc;
+    }
+
+    sp->files = (ODV_OUTBUF *)calloc(1, sizeof(ODV_OUTBUF));
+    sp->part = (int *)calloc(1, sizeof(int));
+    sp->rows = (int64_t *)calloc(1, sizeof(int64_t));
+    sp->fresh = (unsigned char *)calloc(1, 1);
+    if (!sp->files || !sp->part || !sp->rows || !sp->fresh) {
+        split_free(sp);
+        odv_out_close(o);
+        return ODV_ERROR_MALLOC;
+    }
+    sp->files[0] = *o;
+    sp->part[0] = 1;
+    sp->fresh[0] = 1;
+    return ODV_OK;
+}
+
+static void split_add_key(ODV_SPLIT *sp, const char *name, int col_count, const char **col_names)
+{
+    int i;
+
+    for (i = 0; i < col_count && sp->key_count < sp->key_alloc; i++) {
+        if (strcmp(col_names[i], name) == 0) {
+            sp->key[sp->key_count++] = i;
+            return;
+        }
+    }
+}
+
+/* Key columns of a new table: the session's shard_keys names, else the
+   primary key.  Names that match no column are skipped. */
+static void split_resolve_key(ODV_SPLIT *sp, const char *schema, const char *table,
+                              int col_count, const char **col_names)
+{
+    const char *p = sp->session->shard_keys;
+    const ODV_TABLE *t = &sp->session->table;
+    int i, j;
+
+    odv_strcpy(sp->key_schema, schema ? schema : "", ODV_OBJNAME_LEN);
+    odv_strcpy(sp->key_table, table ? table : "", ODV_OBJNAME_LEN);
+    sp->key_valid = 1;
+    sp->key_count = 0;
+
+    if (col_count > sp->key_alloc) {
+        int *k = (int *)realloc(sp->key, sizeof(int) * (size_t)col_count);
+        if (!k) return;
+        sp->key = k;
+        sp->key_alloc = col_count;
+    }
+
+    if (*p) {
+        while (*p) {
+            char name[ODV_OBJNAME_LEN + 1];
+            int n = 0;
+            while (*p == ' ' || *p == ',') p++;
+            while (*p && *p != ',') {
+                if (n < ODV_OBJNAME_LEN) name[n++] = *p;
+                p++;
+            }
+            while (n > 0 && name[n - 1] == ' ') n--;
+            name[n] = '\0';
+            if (n > 0) split_add_key(sp, name, col_count, col_names);
+        }
+        return;
+    }
+
+    for (i = 0; i < t->constraint_count; i++) {
+        const ODV_CONSTRAINT *c = &t->constraints[i];
+        if (c->type != CONSTRAINT_PK) continue;
+        for (j = 0; j < c->col_count; j++)
+            split_add_key(sp, c->columns[j], col_count, col_names);
+        break;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    odv_split_pick
+
+    Returns the shard of a row: a hash (FNV-1a, then a 64-bit mix) of the
+    key column values, or of the whole row when the table has no usable
+    key, modulo the shard count.
+    col_lengths may be NULL for NUL-terminated values.
+ ---------------------------------------------------------------------------*/
+int odv_split_pick(ODV_SPLIT *sp, const char *schema, const char *table, int col_count,
+                   const char **col_names, const char **col_values, const int *col_lengths)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    int i, n;
+
+    if (sp->shards <= 1) return 0;
+
+    if (!sp->key_valid ||
+        strcmp(sp->key_table, table ? table : "") != 0 ||
+        strcmp(sp->key_schema, schema ? schema : "") != 0)
+        split_resolve_key(sp, schema, table, col_count, col_names);
+
+    n = sp->key_count ? sp->key_count : col_count;
+    for (i = 0; i < n; i++) {
+        int c = sp->key_count ? sp->key[i] : i;
+        const unsigned char *v;
+        int len, j;
+
+        if (c >= col_count || !col_values[c]) {
+            len = 0;
+            v = NULL;
+        } else {
+            v = (const unsigned char *)col_values[c];
+            len = col_lengths ? col_lengths[c] : (int)strlen(col_values[c]);
+            if (len < 0) len = 0;
+        }
+        for (j = 0; j < len; j++) {
+            h ^= v[j];
+            h *= 0x100000001B3ull;
+        }
+        h ^= 0xFF;                  /* Column separator */
+        h *= 0x100000001B3ull;
+    }
+    /* FNV's low bits mix poorly on short keys: finish with a 64-bit mixer */
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return (int)(h % (uint64_t)sp->shards);
+}
+
+/*---------------------------------------------------------------------------
+    odv_split_due
+
+    1 if the current part of shard k holds rows and has reached a limit.
+ ---------------------------------------------------------------------------*/
+int odv_split_due(const ODV_SPLIT *sp, int k)
+{
+    const ODV_OUTBUF *o = &sp->files[k];
+
+    if (sp->rows[k] == 0) return 0;
+    return (sp->max_rows > 0 && sp->rows[k] >= sp->max_rows) ||
+           (sp->max_bytes > 0 && o->flushed + o->len >= sp->max_bytes);
+}
+
+/*---------------------------------------------------------------------------
+    odv_split_rotate
+
+    Closes the current part of shard k and opens the next one.  When the
+    next part cannot be created, rotation stops: the rest of the rows go
+    to the current part and odv_split_close reports the error.
+ ---------------------------------------------------------------------------*/
+int odv_split_rotate(ODV_SPLIT *sp, int k)
+{
+    ODV_OUTBUF next;
+    int rc;
+
+    sp->part[k]++;
+    rc = split_open_part(sp, k, &next);
+    if (rc != ODV_OK) {
+        sp->part[k]--;
+        sp->max_bytes = 0;
+        sp->max_rows = 0;
+        if (sp->error == ODV_OK) sp->error = rc;
+        return rc;
+    }
+
+    rc = odv_out_close(&sp->files[k]);
+    if (rc != ODV_OK && sp->error == ODV_OK) sp->error = rc;
+    sp->files[k] = next;
+    sp->rows[k] = 0;
+    sp->fresh[k] = 1;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    odv_split_close
+
+    Closes every open part.
+    Returns ODV_OK, or the first write / rotation error.
+ ---------------------------------------------------------------------------*/
+int odv_split_close(ODV_SPLIT *sp)
+{
+    int k, rc;
+
+    if (!sp || !sp->files) return ODV_ERROR_INVALID_ARG;
+    rc = sp->error;
+    for (k = 0; k < sp->shards; k++) {
+        int r = odv_out_close(&sp->files[k]);
+        if (r != ODV_OK && rc == ODV_OK) rc = r;
+    }
+    split_free(sp);
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    odv_csv_special
+
+    Returns the index of the first delimiter, '"', CR or LF in p[0..n),
+    or n if there is none.  16 bytes per step.
+ ---------------------------------------------------------------------------*/
+int odv_csv_special(const char *p, int n, char delimiter)
+{
+    const unsigned char *s = (const unsigned char *)p;
+    int i = 0;
+
+#if defined(ODV_SCAN_SSE2)
+    {
+        const __m128i d  = _mm_set1_epi8(delimiter);
+        const __m128i q  = _mm_set1_epi8('"');
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+            __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, q)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)));
+            int bits = _mm_movemask_epi8(m);
+            if (bits) {
+                while (!(bits & 1)) { bits >>= 1; i++; }
+                return i;
+            }
+        }
+    }
+#elif defined(ODV_SCAN_NEON)
+    {
+        const uint8x16_t d  = vdupq_n_u8((uint8_t)delimiter);
+        const uint8x16_t q  = vdupq_n_u8('"');
+        const uint8x16_t cr = vdupq_n_u8('\r');
+        const uint8x16_t lf = vdupq_n_u8('\n');
+        for (; i + 16 <= n; i += 16) {
+            uint8x16_t v = vld1q_u8(s + i);
+            uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, d), vceqq_u8(v, q)),
+                                    vorrq_u8(vceqq_u8(v, cr), vceqq_u8(v, lf)));
+            if (vmaxvq_u8(m)) break;   /* Located by the loop below */
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        unsigned char c = s[i];
+        if (c == (unsigned char)delimiter || c == '"' || c == '\r' || c == '\n')
+            return i;
+    }
+    return n;
+}
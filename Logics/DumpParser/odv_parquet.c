@@ -0,0 +1,1445 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_parquet.c
+    Apache Parquet file output
+
+    Streams one table into a Parquet file, one row group at a time:
+    - Column values are buffered PLAIN-encoded until the row group is
+      full (row count or byte limit), then written column by column and
+      dropped, so memory stays bounded to one row group.
+    - Each column chunk is dictionary encoded (RLE_DICTIONARY indices)
+      while its distinct values stay small, otherwise PLAIN.  Definition
+      levels use the RLE / bit-packed hybrid.
+    - Pages are optionally Snappy compressed (built-in encoder).
+    - Column chunks carry null counts and min / max statistics.
+    - Page headers and the footer use the Thrift compact protocol.
+
+    Oracle types map to:
+      NUMBER(p<=18, s<=0)  INT64
+      NUMBER(p<=18, s>0)   DECIMAL(p,s) on INT64
+      NUMBER(p<=38, s)     DECIMAL(p,s) on FIXED_LEN_BYTE_ARRAY
+      NUMBER, FLOAT        DOUBLE  (no precision / binary precision)
+      BINARY_FLOAT/DOUBLE  FLOAT / DOUBLE
+      DATE, TIMESTAMP      TIMESTAMP(MICROS), UTC-adjusted for WITH [LOCAL] TIME ZONE
+      RAW, BLOB, LONG RAW  BYTE_ARRAY
+      others (CHAR, CLOB)  BYTE_ARRAY STRING (UTF-8)
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+
+#define PQ_PAGE_SIZE      (1024 * 1024)         /* Target data page size */
+#define PQ_DICT_MAX       (1024 * 1024)         /* Largest dictionary page */
+#define PQ_GROUP_BYTES    (128 * 1024 * 1024)   /* Row group flushed past this */
+#define PQ_STATS_MAX      64                    /* Longest BYTE_ARRAY min / max */
+
+/* Parquet physical types */
+#define PQT_INT64         2
+#define PQT_FLOAT         4
+#define PQT_DOUBLE        5
+#define PQT_BYTE_ARRAY    6
+#define PQT_FLBA          7
+
+/* Encodings */
+#define PQE_PLAIN           0
+#define PQE_RLE             3
+#define PQE_RLE_DICTIONARY  8
+
+/* Page types */
+#define PQP_DATA          0
+#define PQP_DICTIONARY    2
+
+/* Converted types (legacy readers) */
+#define PQC_UTF8              0
+#define PQC_DECIMAL           5
+#define PQC_TIMESTAMP_MICROS  10
+#define PQC_INT_64            18
+
+/* Thrift compact protocol types */
+#define TC_TRUE     1
+#define TC_FALSE    2
+#define TC_BYTE     3
+#define TC_I16      4
+#define TC_I32      5
+#define TC_I64      6
+#define TC_BINARY   8
+#define TC_LIST     9
+#define TC_STRUCT   12
+
+/* How a column's values are produced */
+#define PQK_INT64       0   /* NUMBER -> INT64 (integer or DECIMAL unscaled) */
+#define PQK_DEC128      1   /* NUMBER -> DECIMAL FIXED_LEN_BYTE_ARRAY */
+#define PQK_DOUBLE      2
+#define PQK_FLOAT       3
+#define PQK_TIMESTAMP   4
+#define PQK_STRING      5
+#define PQK_BINARY      6
+
+/*---------------------------------------------------------------------------
+    Growable byte buffer.  A failed allocation is kept in err and later
+    appends are dropped; the caller checks err once per row group.
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    unsigned char *p;
+    size_t         len;
+    size_t         cap;
+    int            err;
+} PQ_BUF;
+
+static int pq_reserve(PQ_BUF *b, size_t extra)
+{
+    unsigned char *np;
+    size_t cap;
+
+    if (b->err) return ODV_ERROR_MALLOC;
+    if (b->len + extra <= b->cap) return ODV_OK;
+    cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra) cap *= 2;
+    np = (unsigned char *)realloc(b->p, cap);
+    if (!np) {
+        b->err = 1;
+        return ODV_ERROR_MALLOC;
+    }
+    b->p = np;
+    b->cap = cap;
+    return ODV_OK;
+}
+
+static void pq_put(PQ_BUF *b, const void *p, size_t n)
+{
+    if (n == 0 || pq_reserve(b, n) != ODV_OK) return;
+    memcpy(b->p + b->len, p, n);
+    b->len += n;
+}
+
+static void pq_put_byte(PQ_BUF *b, int c)
+{
+    if (pq_reserve(b, 1) != ODV_OK) return;
+    b->p[b->len++] = (unsigned char)c;
+}
+
+static void pq_put_le32(PQ_BUF *b, uint32_t v)
+{
+    unsigned char t[4];
+    t[0] = (unsigned char)v;
+    t[1] = (unsigned char)(v >> 8);
+    t[2] = (unsigned char)(v >> 16);
+    t[3] = (unsigned char)(v >> 24);
+    pq_put(b, t, 4);
+}
+
+static void pq_put_le64(PQ_BUF *b, uint64_t v)
+{
+    pq_put_le32(b, (uint32_t)v);
+    pq_put_le32(b, (uint32_t)(v >> 32));
+}
+
+static void pq_put_varint(PQ_BUF *b, uint64_t v)
+{
+    while (v >= 0x80) {
+        pq_put_byte(b, (int)(v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    pq_put_byte(b, (int)v);
+}
+
+static void pq_buf_free(PQ_BUF *b)
+{
+    free(b->p);
+    memset(b, 0, sizeof(*b));
+}
+
+static uint32_t get_le32(const unsigned char *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*---------------------------------------------------------------------------
+    Thrift compact protocol writer
+
+    Fields are written in increasing id order; each struct level keeps
+    the last field id for the delta-encoded field headers.
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    PQ_BUF *b;
+    int     last[8];
+    int     depth;
+} TC_WRITER;
+
+static void tc_init(TC_WRITER *w, PQ_BUF *b)
+{
+    memset(w, 0, sizeof(*w));
+    w->b = b;
+}
+
+static void tc_field(TC_WRITER *w, int id, int type)
+{
+    int delta = id - w->last[w->depth];
+    if (delta > 0 && delta <= 15) {
+        pq_put_byte(w->b, (delta << 4) | type);
+    } else {
+        pq_put_byte(w->b, type);
+        pq_put_varint(w->b, (uint64_t)((id << 1) ^ (id >> 15)));
+    }
+    w->last[w->depth] = id;
+}
+
+static void tc_begin(TC_WRITER *w)
+{
+    w->last[++w->depth] = 0;
+}
+
+static void tc_end(TC_WRITER *w)
+{
+    pq_put_byte(w->b, 0);   /* Field stop */
+    w->depth--;
+}
+
+static void tc_i32(TC_WRITER *w, int id, int32_t v)
+{
+    tc_field(w, id, TC_I32);
+    pq_put_varint(w->b, ((uint64_t)(uint32_t)v << 1) ^ (uint64_t)(int64_t)(v >> 31));
+}
+
+static void tc_i64(TC_WRITER *w, int id, int64_t v)
+{
+    tc_field(w, id, TC_I64);
+    pq_put_varint(w->b, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+static void tc_bool(TC_WRITER *w, int id, int v)
+{
+    tc_field(w, id, v ? TC_TRUE : TC_FALSE);
+}
+
+static void tc_binary(TC_WRITER *w, int id, const void *p, size_t n)
+{
+    tc_field(w, id, TC_BINARY);
+    pq_put_varint(w->b, n);
+    pq_put(w->b, p, n);
+}
+
+static void tc_struct(TC_WRITER *w, int id)
+{
+    tc_field(w, id, TC_STRUCT);
+    tc_begin(w);
+}
+
+static void tc_list(TC_WRITER *w, int id, int elem_type, int count)
+{
+    tc_field(w, id, TC_LIST);
+    if (count < 15) {
+        pq_put_byte(w->b, (count << 4) | elem_type);
+    } else {
+        pq_put_byte(w->b, 0xF0 | elem_type);
+        pq_put_varint(w->b, (uint64_t)count);
+    }
+}
+
+/* Element of a list<i32> / list<binary> */
+static void tc_elem_i32(TC_WRITER *w, int32_t v)
+{
+    pq_put_varint(w->b, ((uint64_t)(uint32_t)v << 1) ^ (uint64_t)(int64_t)(v >> 31));
+}
+
+/*---------------------------------------------------------------------------
+    RLE / bit-packed hybrid encoding
+
+    Runs of 8 or more equal values become RLE runs; everything else goes
+    into bit-packed groups of 8 (zero-padded at the end).
+ ---------------------------------------------------------------------------*/
+static int run_length(const uint32_t *v, int i, int n)
+{
+    int r = 1;
+    while (i + r < n && v[i + r] == v[i]) r++;
+    return r;
+}
+
+static void rle_encode(PQ_BUF *b, const uint32_t *v, int n, int width)
+{
+    int vbytes = (width + 7) / 8;
+    int i = 0;
+
+    while (i < n) {
+        int run = run_length(v, i, n);
+        if (run >= 8 || i + run == n) {
+            int k;
+            pq_put_varint(b, (uint64_t)run << 1);
+            for (k = 0; k < vbytes; k++) pq_put_byte(b, (int)(v[i] >> (8 * k)) & 0xFF);
+            i += run;
+            continue;
+        }
+
+        /* Bit-packed groups until the next long run (at most 63 groups) */
+        {
+            int groups = 0, g, k;
+            size_t hdr;
+
+            if (pq_reserve(b, 1) != ODV_OK) return;
+            hdr = b->len++;
+            do {
+                uint64_t acc = 0;
+                int bits = 0;
+                for (k = 0; k < 8; k++) {
+                    uint32_t x = (i + k < n) ? v[i + k] : 0;
+                    acc |= (uint64_t)x << bits;
+                    bits += width;
+                    while (bits >= 8) {
+                        pq_put_byte(b, (int)(acc & 0xFF));
+                        acc >>= 8;
+                        bits -= 8;
+                    }
+                }
+                i += 8;
+                groups++;
+            } while (i < n && groups < 63 && run_length(v, i, n) < 8);
+            if (i > n) i = n;
+            g = (groups << 1) | 1;
+            if (!b->err) b->p[hdr] = (unsigned char)g;
+        }
+    }
+}
+
+static int bit_width(uint32_t max)
+{
+    int w = 1;
+    while (w < 32 && (max >> w) != 0) w++;
+    return w;
+}
+
+/*---------------------------------------------------------------------------
+    Snappy compression
+
+    Greedy LZ77 over 64 KB blocks with a 4-byte hash, emitting Snappy
+    literals and copies.  dst must hold snappy_max_size(n) bytes.
+ ---------------------------------------------------------------------------*/
+#define SNAPPY_BLOCK      65536
+#define SNAPPY_HASH_BITS  14
+
+static size_t snappy_max_size(size_t n)
+{
+    return 32 + n + n / 6;
+}
+
+static uint32_t load32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static unsigned char *snappy_literal(unsigned char *op, const unsigned char *p, int len)
+{
+    int n = len - 1;
+    if (n < 60) {
+        *op++ = (unsigned char)(n << 2);
+    } else if (n < 256) {
+        *op++ = 60 << 2;
+        *op++ = (unsigned char)n;
+    } else {
+        *op++ = 61 << 2;
+        *op++ = (unsigned char)n;
+        *op++ = (unsigned char)(n >> 8);
+    }
+    memcpy(op, p, len);
+    return op + len;
+}
+
+static unsigned char *snappy_copy(unsigned char *op, int offset, int len)
+{
+    while (len >= 68) {
+        *op++ = (unsigned char)(2 | (63 << 2));
+        *op++ = (unsigned char)offset;
+        *op++ = (unsigned char)(offset >> 8);
+        len -= 64;
+    }
+    if (len > 64) {
+        *op++ = (unsigned char)(2 | (59 << 2));
+        *op++ = (unsigned char)offset;
+        *op++ = (unsigned char)(offset >> 8);
+        len -= 60;
+    }
+    if (len < 12 && offset < 2048) {
+        *op++ = (unsigned char)(1 | ((len - 4) << 2) | ((offset >> 8) << 5));
+        *op++ = (unsigned char)offset;
+    } else {
+        *op++ = (unsigned char)(2 | ((len - 1) << 2));
+        *op++ = (unsigned char)offset;
+        *op++ = (unsigned char)(offset >> 8);
+    }
+    return op;
+}
+
+static size_t snappy_compress(const unsigned char *src, size_t n, unsigned char *dst)
+{
+    uint16_t table[1 << SNAPPY_HASH_BITS];
+    unsigned char *op = dst;
+    size_t v = n, start;
+
+    /* Uncompressed length, varint */
+    while (v >= 0x80) {
+        *op++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *op++ = (unsigned char)v;
+
+    for (start = 0; start < n; start += SNAPPY_BLOCK) {
+        const unsigned char *base = src + start;
+        int blen = (int)((n - start < SNAPPY_BLOCK) ? n - start : SNAPPY_BLOCK);
+        int ip = 0, lit = 0;
+
+        memset(table, 0, sizeof(table));
+        while (ip + 4 <= blen) {
+            uint32_t cur = load32(base + ip);
+            uint32_t h = (cur * 0x1E35A7BDu) >> (32 - SNAPPY_HASH_BITS);
+            int cand = table[h];
+            table[h] = (uint16_t)ip;
+            if (cand < ip && load32(base + cand) == cur) {
+                int len = 4;
+                while (ip + len < blen && base[cand + len] == base[ip + len]) len++;
+                if (ip > lit) op = snappy_literal(op, base + lit, ip - lit);
+                op = snappy_copy(op, ip - cand, len);
+                ip += len;
+                lit = ip;
+            } else {
+                ip += 1 + ((ip - lit) >> 5);    /* Skip faster through incompressible data */
+            }
+        }
+        if (blen > lit) op = snappy_literal(op, base + lit, blen - lit);
+    }
+    return (size_t)(op - dst);
+}
+
+/*---------------------------------------------------------------------------
+    Export context
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    int     kind;             /* PQK_* */
+    int     physical;         /* PQT_* */
+    int     width;            /* Fixed value width, 0 for BYTE_ARRAY */
+    int     precision;        /* DECIMAL */
+    int     scale;
+    int     utc;              /* TIMESTAMP WITH [LOCAL] TIME ZONE */
+    PQ_BUF  plain;            /* Non-null values of the row group, PLAIN-encoded */
+    PQ_BUF  defs;             /* 1 byte per row: 1 = value present */
+    int64_t nulls;
+} PQ_COLUMN;
+
+typedef struct {
+    ODV_OUTBUF   out;
+    int64_t      pos;                 /* Bytes written to the file */
+    ODV_SESSION *session;
+    const char  *target_table;
+    int          started;             /* Columns set up from the first row */
+    char         last_schema[129];
+    char         last_table[129];
+    int          col_count;
+    PQ_COLUMN   *cols;
+    char       **names;
+    int          group_rows;          /* Rows buffered in the current row group */
+    size_t       group_bytes;
+    int          row_group_rows;
+    int          codec;               /* PQ_CODEC_* */
+    int          dictionary;
+    int64_t      total_rows;
+    int          row_groups;
+    PQ_BUF       groups;              /* Serialized RowGroup structs for the footer */
+    PQ_BUF       page;                /* Scratch: page body */
+    PQ_BUF       comp;                /* Scratch: compressed page body */
+    PQ_BUF       hdr;                 /* Scratch: page header */
+    PQ_BUF       idx;                 /* Scratch: uint32 levels / indices */
+    PQ_BUF       dict;                /* Scratch: dictionary hash table + entries */
+    int          rc;
+    int          progress;            /* 1 = report rows to progress_cb */
+} PQ_CONTEXT;
+
+static void pq_emit(PQ_CONTEXT *ctx, const void *p, size_t n)
+{
+    odv_out_write(&ctx->out, p, (int)n);
+    ctx->pos += (int64_t)n;
+}
+
+/*---------------------------------------------------------------------------
+    Column mapping
+ ---------------------------------------------------------------------------*/
+
+/* Smallest FIXED_LEN_BYTE_ARRAY holding precision decimal digits */
+static int decimal_bytes(int precision)
+{
+    int n = 1;
+    while ((8 * n - 1) * 0.30102999566398 < precision) n++;
+    return n;
+}
+
+static void pq_map_column(PQ_CONTEXT *ctx, int i, PQ_COLUMN *c)
+{
+    ODV_SESSION *s = ctx->session;
+    int type = (i < s->table.col_count) ? s->table.desc[i].type : COL_VARCHAR;
+    int raw = (i < s->table.col_count) && s->plan.kernel[i] == KERN_RAW;
+    int prec, scale;
+
+    c->kind = PQK_STRING;
+    c->physical = PQT_BYTE_ARRAY;
+    c->width = 0;
+
+    switch (type) {
+    case COL_NUMBER:
+        if (!raw) break;
+        c->kind = PQK_DOUBLE;
+        if (!odv_number_type(s->table.columns[i].type_str, &prec, &scale)) break;
+        c->precision = prec;
+        c->scale = scale;
+        c->kind = (prec <= 18) ? PQK_INT64 : PQK_DEC128;
+        break;
+    case COL_FLOAT:
+    case COL_BIN_DOUBLE:
+        if (raw) c->kind = PQK_DOUBLE;
+        break;
+    case COL_BIN_FLOAT:
+        if (raw) c->kind = PQK_FLOAT;
+        break;
+    case COL_DATE:
+    case COL_TIMESTAMP:
+    case COL_TIMESTAMP_TZ:
+    case COL_TIMESTAMP_LTZ:
+        if (!raw) break;
+        c->kind = PQK_TIMESTAMP;
+        c->utc = (type != COL_DATE && type != COL_TIMESTAMP);
+        break;
+    case COL_RAW:
+    case COL_BLOB:
+    case COL_LONG_RAW:
+        c->kind = PQK_BINARY;
+        break;
+    default:
+        break;
+    }
+
+    switch (c->kind) {
+    case PQK_INT64:
+    case PQK_TIMESTAMP: c->physical = PQT_INT64;  c->width = 8; break;
+    case PQK_DOUBLE:    c->physical = PQT_DOUBLE; c->width = 8; break;
+    case PQK_FLOAT:     c->physical = PQT_FLOAT;  c->width = 4; break;
+    case PQK_DEC128:
+        c->physical = PQT_FLBA;
+        c->width = decimal_bytes(c->precision);
+        break;
+    default:
+        break;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    Value conversion
+ ---------------------------------------------------------------------------*/
+
+/* Hex text (EXPDP BLOB previews) -> bytes; placeholders are rejected */
+static int hex_to_bytes(PQ_BUF *b, const char *p, int n)
+{
+    int i;
+    if (n <= 0 || (n & 1)) return ODV_ERROR_FORMAT;
+    for (i = 0; i < n; i++) {
+        char c = p[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f')))
+            return ODV_ERROR_FORMAT;
+    }
+    pq_put_le32(b, (uint32_t)(n / 2));
+    if (pq_reserve(b, (size_t)n / 2) != ODV_OK) return ODV_ERROR_MALLOC;
+    for (i = 0; i < n; i += 2) {
+        int hi = (p[i] <= '9') ? p[i] - '0' : (p[i] | 0x20) - 'a' + 10;
+        int lo = (p[i + 1] <= '9') ? p[i + 1] - '0' : (p[i + 1] | 0x20) - 'a' + 10;
+        b->p[b->len++] = (unsigned char)(hi << 4 | lo);
+    }
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    pq_append_value
+
+    PLAIN-encodes one non-null value into the column buffer.
+    Returns ODV_OK, or an error for a value that is stored as NULL.
+ ---------------------------------------------------------------------------*/
+static int pq_append_value(PQ_CONTEXT *ctx, int col, const char *val, int len)
+{
+    PQ_COLUMN *c = &ctx->cols[col];
+    const unsigned char *data = (const unsigned char *)val;
+    const ODV_COLDESC *d = &ctx->session->table.desc[col];
+    char tmp[ODV_NUMBER_STR_LEN];
+    unsigned char dec[16];
+    int n, k;
+
+    switch (c->kind) {
+    case PQK_INT64:
+        /* NUMBER(p,0): up to 18 digits directly; the rest through the 128-bit path */
+        if (c->scale == 0) {
+            int64_t iv;
+            if (odv_number_to_int64(data, len, &iv) == ODV_OK) {
+                pq_put_le64(&c->plain, (uint64_t)iv);
+                return ODV_OK;
+            }
+        }
+        if (odv_number_scaled(data, len, c->scale, dec) != ODV_OK) return ODV_ERROR_FORMAT;
+        for (k = 8; k < 16; k++)
+            if (dec[k] != ((dec[7] & 0x80) ? 0xFF : 0x00)) return ODV_ERROR_FORMAT;
+        pq_put(&c->plain, dec, 8);          /* Little-endian already */
+        return ODV_OK;
+    case PQK_DEC128: {
+        unsigned char be[16];
+        if (odv_number_scaled(data, len, c->scale, dec) != ODV_OK) return ODV_ERROR_FORMAT;
+        for (k = c->width; k < 16; k++)
+            if (dec[k] != ((dec[c->width - 1] & 0x80) ? 0xFF : 0x00)) return ODV_ERROR_FORMAT;
+        for (k = 0; k < c->width; k++) be[k] = dec[c->width - 1 - k];
+        pq_put(&c->plain, be, (size_t)c->width);
+        return ODV_OK;
+    }
+    case PQK_DOUBLE: {
+        uint64_t bits;
+        if (d->type == COL_BIN_DOUBLE) {
+            if (len < 8) return ODV_ERROR_FORMAT;
+            bits = oracle_ieee_bits(data, 8);
+        } else {
+            double dv;
+            if (decode_oracle_number(data, len, tmp, sizeof(tmp)) <= 0) return ODV_ERROR_FORMAT;
+            dv = strtod(tmp, NULL);
+            memcpy(&bits, &dv, 8);
+        }
+        pq_put_le64(&c->plain, bits);
+        return ODV_OK;
+    }
+    case PQK_FLOAT:
+        if (len < 4) return ODV_ERROR_FORMAT;
+        pq_put_le32(&c->plain, (uint32_t)oracle_ieee_bits(data, 4));
+        return ODV_OK;
+    case PQK_TIMESTAMP: {
+        int64_t us;
+        if (odv_datetime_to_unix_us(data, len, d->precision, &us) != ODV_OK)
+            return ODV_ERROR_FORMAT;
+        pq_put_le64(&c->plain, (uint64_t)us);
+        return ODV_OK;
+    }
+    case PQK_BINARY:
+        if (ctx->session->plan.kernel[col] != KERN_RAW)
+            return hex_to_bytes(&c->plain, val, len);
+        break;
+    default:
+        if (ctx->session->plan.kernel[col] == KERN_RAW) {
+            /* INTERVAL: its display text */
+            n = (d->type == COL_INTERVAL_YM) ? decode_interval_ym(data, len, tmp, sizeof(tmp))
+              : (d->type == COL_INTERVAL_DS) ? decode_interval_ds(data, len, tmp, sizeof(tmp))
+              : -1;
+            if (n < 0) return ODV_ERROR_FORMAT;
+            val = tmp;
+            len = n;
+        }
+        break;
+    }
+
+    pq_put_le32(&c->plain, (uint32_t)len);
+    pq_put(&c->plain, val, (size_t)len);
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Statistics (min / max over the chunk's PLAIN values)
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    const unsigned char *min, *max;
+    int min_len, max_len;
+} PQ_STATS;
+
+/* Negative if a sorts before b, in the column's sort order */
+static int pq_compare(const PQ_COLUMN *c, const unsigned char *a, int alen,
+                      const unsigned char *b, int blen)
+{
+    switch (c->kind) {
+    case PQK_INT64:
+    case PQK_TIMESTAMP: {
+        int64_t x = (int64_t)((uint64_t)get_le32(a) | (uint64_t)get_le32(a + 4) << 32);
+        int64_t y = (int64_t)((uint64_t)get_le32(b) | (uint64_t)get_le32(b + 4) << 32);
+        return (x > y) - (x < y);
+    }
+    case PQK_DOUBLE: {
+        double x, y;
+        uint64_t u = (uint64_t)get_le32(a) | (uint64_t)get_le32(a + 4) << 32;
+        uint64_t w = (uint64_t)get_le32(b) | (uint64_t)get_le32(b + 4) << 32;
+        memcpy(&x, &u, 8);
+        memcpy(&y, &w, 8);
+        return (x > y) - (x < y);
+    }
+    case PQK_FLOAT: {
+        float x, y;
+        uint32_t u = get_le32(a), w = get_le32(b);
+        memcpy(&x, &u, 4);
+        memcpy(&y, &w, 4);
+        return (x > y) - (x < y);
+    }
+    case PQK_DEC128:
+        /* Big-endian two's complement */
+        if ((a[0] ^ b[0]) & 0x80) return (a[0] & 0x80) ? -1 : 1;
+        return memcmp(a, b, (size_t)alen);
+    default: {
+        int r = memcmp(a, b, (size_t)(alen < blen ? alen : blen));
+        return r ? r : (alen > blen) - (alen < blen);
+    }
+    }
+}
+
+static int pq_is_nan(const PQ_COLUMN *c, const unsigned char *p)
+{
+    if (c->kind == PQK_DOUBLE) {
+        double x;
+        uint64_t u = (uint64_t)get_le32(p) | (uint64_t)get_le32(p + 4) << 32;
+        memcpy(&x, &u, 8);
+        return x != x;
+    }
+    if (c->kind == PQK_FLOAT) {
+        float x;
+        uint32_t u = get_le32(p);
+        memcpy(&x, &u, 4);
+        return x != x;
+    }
+    return 0;
+}
+
+/* Next value in a PLAIN buffer */
+static const unsigned char *pq_next(const PQ_COLUMN *c, size_t *off, int *len)
+{
+    const unsigned char *p = c->plain.p + *off;
+    if (c->width) {
+        *len = c->width;
+        *off += (size_t)c->width;
+        return p;
+    }
+    *len = (int)get_le32(p);
+    *off += 4 + (size_t)*len;
+    return p + 4;
+}
+
+static void pq_compute_stats(const PQ_COLUMN *c, PQ_STATS *st)
+{
+    size_t off = 0;
+    int len;
+
+    memset(st, 0, sizeof(*st));
+    while (off < c->plain.len) {
+        const unsigned char *p = pq_next(c, &off, &len);
+        if (pq_is_nan(c, p)) continue;
+        if (!st->min || pq_compare(c, p, len, st->min, st->min_len) < 0) {
+            st->min = p;
+            st->min_len = len;
+        }
+        if (!st->max || pq_compare(c, p, len, st->max, st->max_len) > 0) {
+            st->max = p;
+            st->max_len = len;
+        }
+    }
+}
+
+static void pq_write_stats(TC_WRITER *w, const PQ_COLUMN *c, const PQ_STATS *st)
+{
+    static const unsigned char zero[8] = { 0 };
+    unsigned char buf[PQ_STATS_MAX + 8];
+    int n;
+
+    tc_struct(w, 12);
+    tc_i64(w, 3, c->nulls);
+    if (st->max) {
+        if (c->kind == PQK_DOUBLE || c->kind == PQK_FLOAT) {
+            /* A zero max is written as +0 */
+            memcpy(buf, st->max, (size_t)st->max_len);
+            if (pq_compare(c, buf, st->max_len, zero, st->max_len) == 0)
+                buf[st->max_len - 1] &= 0x7F;
+            tc_binary(w, 5, buf, (size_t)st->max_len);
+        } else if (c->width || st->max_len <= PQ_STATS_MAX) {
+            tc_binary(w, 5, st->max, (size_t)st->max_len);
+        } else {
+            /* Truncated upper bound: increment the last byte below 0xFF */
+            n = PQ_STATS_MAX;
+            memcpy(buf, st->max, (size_t)n);
+            while (n > 0 && buf[n - 1] == 0xFF) n--;
+            if (n > 0) {
+                buf[n - 1]++;
+                tc_binary(w, 5, buf, (size_t)n);
+            }
+        }
+    }
+    if (st->min) {
+        if (c->kind == PQK_DOUBLE || c->kind == PQK_FLOAT) {
+            /* A zero min is written as -0 */
+            memcpy(buf, st->min, (size_t)st->min_len);
+            if (pq_compare(c, buf, st->min_len, zero, st->min_len) == 0)
+                buf[st->min_len - 1] |= 0x80;
+            tc_binary(w, 6, buf, (size_t)st->min_len);
+        } else {
+            /* A prefix is a valid lower bound */
+            n = c->width ? st->min_len : ODV_MIN(st->min_len, PQ_STATS_MAX);
+            tc_binary(w, 6, st->min, (size_t)n);
+        }
+    }
+    tc_end(w);
+}
+
+/*---------------------------------------------------------------------------
+    Dictionary
+
+    Distinct values of the chunk in first-seen order, found through an
+    open-addressing hash table.  Entries point into the PLAIN buffer.
+    Returns the entry count, or 0 if the dictionary would exceed
+    PQ_DICT_MAX (the chunk is then written PLAIN).
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    size_t   off;             /* Value offset in the PLAIN buffer */
+    int      len;
+    uint32_t hash;
+} PQ_DICT_ENTRY;
+
+static uint32_t pq_hash(const unsigned char *p, int n)
+{
+    uint32_t h = 2166136261u;
+    int i;
+    for (i = 0; i < n; i++) h = (h ^ p[i]) * 16777619u;
+    return h ^ (h >> 15);
+}
+
+static int pq_build_dictionary(PQ_CONTEXT *ctx, const PQ_COLUMN *c, int nvalues,
+                               PQ_DICT_ENTRY **entries_out, uint32_t **index_out)
+{
+    PQ_DICT_ENTRY *ent;
+    uint32_t *slots, *index;
+    size_t slot_count = 1024, dict_bytes = 0, off = 0, need;
+    int count = 0, i, max_entries;
+
+    /* Table sized for the worst case up front: slots (load <= 1/2),
+       entries and one index per value */
+    max_entries = nvalues;
+    while (slot_count < (size_t)max_entries * 2) slot_count *= 2;
+    need = slot_count * sizeof(uint32_t) + (size_t)max_entries * sizeof(PQ_DICT_ENTRY);
+    ctx->dict.len = 0;
+    ctx->idx.len = 0;
+    if (pq_reserve(&ctx->dict, need) != ODV_OK ||
+        pq_reserve(&ctx->idx, (size_t)nvalues * sizeof(uint32_t)) != ODV_OK)
+        return 0;
+    slots = (uint32_t *)ctx->dict.p;
+    ent = (PQ_DICT_ENTRY *)(ctx->dict.p + slot_count * sizeof(uint32_t));
+    index = (uint32_t *)ctx->idx.p;
+    memset(slots, 0xFF, slot_count * sizeof(uint32_t));
+
+    for (i = 0; i < nvalues; i++) {
+        int len;
+        size_t voff = off + (c->width ? 0 : 4);
+        const unsigned char *p = pq_next(c, &off, &len);
+        uint32_t h = pq_hash(p, len);
+        size_t slot = h & (slot_count - 1);
+
+        while (slots[slot] != 0xFFFFFFFFu) {
+            const PQ_DICT_ENTRY *e = &ent[slots[slot]];
+            if (e->hash == h && e->len == len && memcmp(c->plain.p + e->off, p, (size_t)len) == 0)
+                break;
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        if (slots[slot] == 0xFFFFFFFFu) {
+            dict_bytes += (size_t)len + (c->width ? 0 : 4);
+            if (dict_bytes > PQ_DICT_MAX) return 0;
+            ent[count].off = voff;
+            ent[count].len = len;
+            ent[count].hash = h;
+            slots[slot] = (uint32_t)count++;
+        }
+        index[i] = slots[slot];
+    }
+
+    *entries_out = ent;
+    *index_out = index;
+    return count;
+}
+
+/*---------------------------------------------------------------------------
+    Pages
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    int64_t uncompressed;     /* Headers + uncompressed bodies */
+    int64_t compressed;       /* Headers + stored bodies */
+} PQ_CHUNK_SIZES;
+
+/* Writes the page header and body (compressed per ctx->codec) */
+static void pq_write_page(PQ_CONTEXT *ctx, int page_type, int num_values, int encoding,
+                          PQ_CHUNK_SIZES *sz)
+{
+    const unsigned char *body = ctx->page.p;
+    size_t body_len = ctx->page.len;
+    TC_WRITER w;
+
+    if (ctx->codec == PQ_CODEC_SNAPPY) {
+        ctx->comp.len = 0;
+        if (pq_reserve(&ctx->comp, snappy_max_size(body_len)) != ODV_OK) return;
+        ctx->comp.len = snappy_compress(body, body_len, ctx->comp.p);
+        body = ctx->comp.p;
+        body_len = ctx->comp.len;
+    }
+
+    ctx->hdr.len = 0;
+    tc_init(&w, &ctx->hdr);
+    tc_begin(&w);
+    tc_i32(&w, 1, page_type);
+    tc_i32(&w, 2, (int32_t)ctx->page.len);
+    tc_i32(&w, 3, (int32_t)body_len);
+    if (page_type == PQP_DICTIONARY) {
+        tc_struct(&w, 7);
+        tc_i32(&w, 1, num_values);
+        tc_i32(&w, 2, PQE_PLAIN);
+        tc_end(&w);
+    } else {
+        tc_struct(&w, 5);
+        tc_i32(&w, 1, num_values);
+        tc_i32(&w, 2, encoding);
+        tc_i32(&w, 3, PQE_RLE);     /* Definition levels */
+        tc_i32(&w, 4, PQE_RLE);     /* Repetition levels (none) */
+        tc_end(&w);
+    }
+    tc_end(&w);
+    if (ctx->hdr.err || ctx->page.err || ctx->comp.err) return;
+
+    pq_emit(ctx, ctx->hdr.p, ctx->hdr.len);
+    pq_emit(ctx, body, body_len);
+    sz->uncompressed += (int64_t)(ctx->hdr.len + ctx->page.len);
+    sz->compressed += (int64_t)(ctx->hdr.len + body_len);
+}
+
+/* Definition levels of rows [r0, r1) as a length-prefixed RLE run list */
+static void pq_put_def_levels(PQ_CONTEXT *ctx, const PQ_COLUMN *c, int r0, int r1,
+                              uint32_t *levels)
+{
+    size_t at;
+    int i;
+
+    for (i = r0; i < r1; i++) levels[i - r0] = c->defs.p[i];
+    if (pq_reserve(&ctx->page, 4) != ODV_OK) return;
+    at = ctx->page.len;
+    ctx->page.len += 4;
+    rle_encode(&ctx->page, levels, r1 - r0, 1);
+    if (!ctx->page.err) {
+        uint32_t n = (uint32_t)(ctx->page.len - at - 4);
+        ctx->page.p[at]     = (unsigned char)n;
+        ctx->page.p[at + 1] = (unsigned char)(n >> 8);
+        ctx->page.p[at + 2] = (unsigned char)(n >> 16);
+        ctx->page.p[at + 3] = (unsigned char)(n >> 24);
+    }
+}
+
+/*---------------------------------------------------------------------------
+    pq_write_chunk
+
+    Writes one column chunk of the buffered row group and appends its
+    ColumnChunk metadata to w.
+ ---------------------------------------------------------------------------*/
+static int pq_write_chunk(PQ_CONTEXT *ctx, int col, TC_WRITER *w,
+                          int64_t *group_uncompressed, int64_t *group_compressed)
+{
+    PQ_COLUMN *c = &ctx->cols[col];
+    int rows = ctx->group_rows;
+    int nvalues = rows - (int)c->nulls;
+    int64_t chunk_start = ctx->pos, dict_offset = -1, data_offset;
+    PQ_DICT_ENTRY *ent = NULL;
+    uint32_t *index = NULL, *levels;
+    PQ_CHUNK_SIZES sz = { 0, 0 };
+    PQ_STATS st;
+    int dict_count = 0, width = 0, r0, v0, i;
+    size_t off0 = 0;
+    PQ_BUF lv = { NULL, 0, 0, 0 };
+
+    pq_compute_stats(c, &st);
+
+    /* Dictionary page */
+    if (ctx->dictionary && nvalues > 0)
+        dict_count = pq_build_dictionary(ctx, c, nvalues, &ent, &index);
+    if (dict_count > 0) {
+        ctx->page.len = 0;
+        for (i = 0; i < dict_count; i++) {
+            if (!c->width) pq_put_le32(&ctx->page, (uint32_t)ent[i].len);
+            pq_put(&ctx->page, c->plain.p + ent[i].off, (size_t)ent[i].len);
+        }
+        dict_offset = ctx->pos;
+        pq_write_page(ctx, PQP_DICTIONARY, dict_count, PQE_PLAIN, &sz);
+        width = bit_width((uint32_t)(dict_count - 1));
+    }
+
+    /* Data pages of about PQ_PAGE_SIZE value bytes each */
+    if (pq_reserve(&lv, (size_t)rows * sizeof(uint32_t)) != ODV_OK) return ODV_ERROR_MALLOC;
+    levels = (uint32_t *)lv.p;
+    data_offset = ctx->pos;
+    r0 = 0;
+    v0 = 0;
+    while (r0 < rows) {
+        size_t off = off0;
+        int r1 = r0, v1 = v0;
+
+        while (r1 < rows && off - off0 < PQ_PAGE_SIZE) {
+            if (c->defs.p[r1]) {
+                int len;
+                pq_next(c, &off, &len);
+                v1++;
+            }
+            r1++;
+        }
+
+        ctx->page.len = 0;
+        pq_put_def_levels(ctx, c, r0, r1, levels);
+        if (dict_count > 0) {
+            pq_put_byte(&ctx->page, width);
+            rle_encode(&ctx->page, index + v0, v1 - v0, width);
+        } else {
+            pq_put(&ctx->page, c->plain.p + off0, off - off0);
+        }
+        pq_write_page(ctx, PQP_DATA, r1 - r0,
+                      dict_count > 0 ? PQE_RLE_DICTIONARY : PQE_PLAIN, &sz);
+
+        r0 = r1;
+        v0 = v1;
+        off0 = off;
+    }
+    pq_buf_free(&lv);
+    if (ctx->page.err || ctx->comp.err || ctx->hdr.err || ctx->idx.err)
+        return ODV_ERROR_MALLOC;
+
+    /* ColumnChunk */
+    tc_begin(w);
+    tc_i64(w, 2, chunk_start);
+    tc_struct(w, 3);                        /* ColumnMetaData */
+    tc_i32(w, 1, c->physical);
+    if (dict_count > 0) {
+        tc_list(w, 2, TC_I32, 3);
+        tc_elem_i32(w, PQE_PLAIN);
+        tc_elem_i32(w, PQE_RLE);
+        tc_elem_i32(w, PQE_RLE_DICTIONARY);
+    } else {
+        tc_list(w, 2, TC_I32, 2);
+        tc_elem_i32(w, PQE_PLAIN);
+        tc_elem_i32(w, PQE_RLE);
+    }
+    tc_list(w, 3, TC_BINARY, 1);
+    pq_put_varint(w->b, strlen(ctx->names[col]));
+    pq_put(w->b, ctx->names[col], strlen(ctx->names[col]));
+    tc_i32(w, 4, ctx->codec);
+    tc_i64(w, 5, rows);
+    tc_i64(w, 6, sz.uncompressed);
+    tc_i64(w, 7, sz.compressed);
+    tc_i64(w, 9, data_offset);
+    if (dict_offset >= 0) tc_i64(w, 11, dict_offset);
+    pq_write_stats(w, c, &st);
+    tc_end(w);
+    tc_end(w);
+
+    *group_uncompressed += sz.uncompressed;
+    *group_compressed += sz.compressed;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    pq_flush_group
+
+    Writes the buffered rows as one row group and records its metadata.
+ ---------------------------------------------------------------------------*/
+static int pq_flush_group(PQ_CONTEXT *ctx)
+{
+    TC_WRITER w;
+    int64_t group_start = ctx->pos, uncompressed = 0, compressed = 0;
+    int i, rc;
+
+    if (ctx->group_rows == 0) return ODV_OK;
+
+    tc_init(&w, &ctx->groups);
+    tc_begin(&w);                           /* RowGroup */
+    tc_list(&w, 1, TC_STRUCT, ctx->col_count);
+    for (i = 0; i < ctx->col_count; i++) {
+        rc = pq_write_chunk(ctx, i, &w, &uncompressed, &compressed);
+        if (rc != ODV_OK) return rc;
+    }
+    tc_i64(&w, 2, uncompressed);
+    tc_i64(&w, 3, ctx->group_rows);
+    tc_i64(&w, 5, group_start);
+    tc_i64(&w, 6, compressed);
+    tc_field(&w, 7, TC_I16);                /* ordinal */
+    pq_put_varint(w.b, (uint64_t)((ctx->row_groups << 1) ^ (ctx->row_groups >> 15)));
+    tc_end(&w);
+    if (ctx->groups.err) return ODV_ERROR_MALLOC;
+
+    for (i = 0; i < ctx->col_count; i++) {
+        ctx->cols[i].plain.len = 0;
+        ctx->cols[i].defs.len = 0;
+        ctx->cols[i].nulls = 0;
+    }
+    ctx->total_rows += ctx->group_rows;
+    ctx->group_rows = 0;
+    ctx->group_bytes = 0;
+    ctx->row_groups++;
+    return odv_out_flush(&ctx->out);
+}
+
+/*---------------------------------------------------------------------------
+    Footer (FileMetaData)
+ ---------------------------------------------------------------------------*/
+static void pq_schema_element(TC_WRITER *w, const PQ_COLUMN *c, const char *name)
+{
+    tc_begin(w);
+    tc_i32(w, 1, c->physical);
+    if (c->physical == PQT_FLBA) tc_i32(w, 2, c->width);
+    tc_i32(w, 3, 1);                        /* OPTIONAL */
+    tc_binary(w, 4, name, strlen(name));
+
+    switch (c->kind) {
+    case PQK_INT64:
+    case PQK_DEC128:
+        if (c->kind == PQK_INT64 && c->scale == 0) {
+            tc_i32(w, 6, PQC_INT_64);
+            tc_struct(w, 10);               /* LogicalType */
+            tc_struct(w, 10);               /* INTEGER */
+            tc_field(w, 1, TC_BYTE);
+            pq_put_byte(w->b, 64);
+            tc_bool(w, 2, 1);
+            tc_end(w);
+            tc_end(w);
+            break;
+        }
+        tc_i32(w, 6, PQC_DECIMAL);
+        tc_i32(w, 7, c->scale);
+        tc_i32(w, 8, c->precision);
+        tc_struct(w, 10);
+        tc_struct(w, 5);                    /* DECIMAL */
+        tc_i32(w, 1, c->scale);
+        tc_i32(w, 2, c->precision);
+        tc_end(w);
+        tc_end(w);
+        break;
+    case PQK_TIMESTAMP:
+        if (c->utc) tc_i32(w, 6, PQC_TIMESTAMP_MICROS);
+        tc_struct(w, 10);
+        tc_struct(w, 8);                    /* TIMESTAMP */
+        tc_bool(w, 1, c->utc);
+        tc_struct(w, 2);                    /* unit */
+        tc_struct(w, 2);                    /* MICROS */
+        tc_end(w);
+        tc_end(w);
+        tc_end(w);
+        tc_end(w);
+        break;
+    case PQK_STRING:
+        tc_i32(w, 6, PQC_UTF8);
+        tc_struct(w, 10);
+        tc_struct(w, 1);                    /* STRING */
+        tc_end(w);
+        tc_end(w);
+        break;
+    default:
+        break;
+    }
+    tc_end(w);
+}
+
+static int pq_write_footer(PQ_CONTEXT *ctx)
+{
+    PQ_BUF f = { NULL, 0, 0, 0 };
+    TC_WRITER w;
+    char created_by[128];
+    int i;
+
+    snprintf(created_by, sizeof(created_by), "OraDB DUMP Viewer%s%s",
+             ctx->session->app_version[0] ? " version " : "", ctx->session->app_version);
+
+    tc_init(&w, &f);
+    tc_begin(&w);
+    tc_i32(&w, 1, 1);                       /* version */
+    tc_list(&w, 2, TC_STRUCT, ctx->col_count + 1);
+    tc_begin(&w);                           /* Root */
+    tc_binary(&w, 4, "schema", 6);
+    tc_i32(&w, 5, ctx->col_count);
+    tc_end(&w);
+    for (i = 0; i < ctx->col_count; i++)
+        pq_schema_element(&w, &ctx->cols[i], ctx->names[i]);
+    tc_i64(&w, 3, ctx->total_rows);
+    tc_list(&w, 4, TC_STRUCT, ctx->row_groups);
+    pq_put(&f, ctx->groups.p, ctx->groups.len);
+    tc_binary(&w, 6, created_by, strlen(created_by));
+    if (ctx->col_count > 0) {
+        tc_list(&w, 7, TC_STRUCT, ctx->col_count);  /* column_orders */
+        for (i = 0; i < ctx->col_count; i++) {
+            tc_begin(&w);
+            tc_struct(&w, 1);               /* TYPE_ORDER */
+            tc_end(&w);
+            tc_end(&w);
+        }
+    }
+    tc_end(&w);
+
+    if (f.err || ctx->groups.err) {
+        pq_buf_free(&f);
+        return ODV_ERROR_MALLOC;
+    }
+    pq_emit(ctx, f.p, f.len);
+    {
+        unsigned char tail[8];
+        uint32_t n = (uint32_t)f.len;
+        tail[0] = (unsigned char)n;
+        tail[1] = (unsigned char)(n >> 8);
+        tail[2] = (unsigned char)(n >> 16);
+        tail[3] = (unsigned char)(n >> 24);
+        memcpy(tail + 4, "PAR1", 4);
+        pq_emit(ctx, tail, 8);
+    }
+    pq_buf_free(&f);
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Row callback
+ ---------------------------------------------------------------------------*/
+static int pq_setup_columns(PQ_CONTEXT *ctx, int col_count, const char **col_names)
+{
+    size_t name_bytes = 0;
+    char *p;
+    int i;
+
+    ctx->cols = (PQ_COLUMN *)calloc((size_t)(col_count > 0 ? col_count : 1), sizeof(PQ_COLUMN));
+    for (i = 0; i < col_count; i++) name_bytes += strlen(col_names[i]) + 1;
+    ctx->names = (char **)malloc((size_t)(col_count > 0 ? col_count : 1) * sizeof(char *) + name_bytes);
+    if (!ctx->cols || !ctx->names) return ODV_ERROR_MALLOC;
+
+    p = (char *)(ctx->names + (col_count > 0 ? col_count : 1));
+    for (i = 0; i < col_count; i++) {
+        size_t n = strlen(col_names[i]) + 1;
+        memcpy(p, col_names[i], n);
+        ctx->names[i] = p;
+        p += n;
+        pq_map_column(ctx, i, &ctx->cols[i]);
+    }
+    ctx->col_count = col_count;
+    return ODV_OK;
+}
+
+/* Buffers one row.  Returns ODV_OK, or the error the export has failed
+   with. */
+static int pq_put_row(PQ_CONTEXT *ctx, const char *schema, const char *table,
+                      int col_count, const char **col_names, const char **col_values,
+                      const int *col_lengths)
+{
+    int i;
+
+    if (ctx->rc != ODV_OK) return ctx->rc;
+
+    /* Filter by table name if specified */
+    if (ctx->target_table && ctx->target_table[0] != '\0') {
+        if (strcmp(table, ctx->target_table) != 0) return ODV_OK;
+    }
+
+    /* One table per file: the first one seen */
+    if (!ctx->started) {
+        ctx->rc = pq_setup_columns(ctx, col_count, col_names);
+        ctx->started = 1;
+        odv_strcpy(ctx->last_schema, schema ? schema : "", 128);
+        odv_strcpy(ctx->last_table, table, 128);
+    } else if (strcmp(schema ? schema : "", ctx->last_schema) != 0 ||
+               strcmp(table, ctx->last_table) != 0 || col_count != ctx->col_count) {
+        return ODV_OK;
+    }
+    if (ctx->rc != ODV_OK) return ctx->rc;
+
+    for (i = 0; i < col_count; i++) {
+        PQ_COLUMN *c = &ctx->cols[i];
+        size_t before = c->plain.len;
+        int present = col_lengths[i] >= 0 &&
+                      pq_append_value(ctx, i, col_values[i], col_lengths[i]) == ODV_OK;
+        if (!present) {
+            c->plain.len = before;      /* Drop a partial value */
+            c->nulls++;
+        }
+        pq_put_byte(&c->defs, present);
+        ctx->group_bytes += c->plain.len - before + 1;
+        if (c->plain.err || c->defs.err) ctx->rc = ODV_ERROR_MALLOC;
+    }
+    ctx->group_rows++;
+
+    if (ctx->rc == ODV_OK &&
+        (ctx->group_rows >= ctx->row_group_rows || ctx->group_bytes >= PQ_GROUP_BYTES))
+        ctx->rc = pq_flush_group(ctx);
+    if (ctx->rc != ODV_OK) return ctx->rc;
+
+    /* Report progress periodically (every 100 rows) */
+    if (ctx->progress && ctx->session->progress_cb &&
+        ((ctx->total_rows + ctx->group_rows) % 100) == 0) {
+        ctx->session->progress_cb(ctx->total_rows + ctx->group_rows, table,
+                                  ctx->session->progress_ud);
+    }
+    return ODV_OK;
+}
+
+static void ODV_CALL pq_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    const int *col_lengths, void *user_data)
+{
+    PQ_CONTEXT *ctx = (PQ_CONTEXT *)user_data;
+
+    if (!ctx || ctx->rc != ODV_OK) return;
+    if (pq_put_row(ctx, schema, table, col_count, col_names, col_values,
+                   col_lengths) != ODV_OK)
+        ctx->session->cancelled = 1;
+}
+
+/* Opens the file and writes the leading magic */
+static int pq_init(PQ_CONTEXT *ctx, ODV_SESSION *s, const char *table_name,
+                   const char *output_path)
+{
+    int rc;
+
+    memset(ctx, 0, sizeof(*ctx));
+    rc = odv_out_open(&ctx->out, output_path);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, "Cannot create Parquet output file", ODV_MSG_LEN);
+        return rc;
+    }
+
+    ctx->session = s;
+    ctx->target_table = table_name;
+    ctx->row_group_rows = s->parquet_row_group_rows > 0 ? s->parquet_row_group_rows
+                                                       : ODV_PARQUET_ROW_GROUP;
+    ctx->codec = s->parquet_compression;
+    ctx->dictionary = s->parquet_dictionary;
+    ctx->progress = 1;
+    pq_emit(ctx, "PAR1", 4);
+    return ODV_OK;
+}
+
+/* Writes the last row group and the footer, closes the file and frees
+   the buffers; rc is the parse result.  Returns the export result. */
+static int pq_finish(ODV_SESSION *s, PQ_CONTEXT *ctx, int rc)
+{
+    int i;
+
+    if (ctx->rc == ODV_OK) ctx->rc = pq_flush_group(ctx);
+    if (ctx->rc == ODV_OK) ctx->rc = pq_write_footer(ctx);
+    if (ctx->rc != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        odv_strcpy(s->last_error, "Out of memory while writing Parquet output", ODV_MSG_LEN);
+        rc = ctx->rc;
+    }
+
+    if (odv_out_close(&ctx->out) != ODV_OK && rc == ODV_OK) {
+        odv_strcpy(s->last_error, "Cannot write Parquet output file", ODV_MSG_LEN);
+        rc = ODV_ERROR_FWRITE;
+    }
+
+    for (i = 0; i < ctx->col_count; i++) {
+        pq_buf_free(&ctx->cols[i].plain);
+        pq_buf_free(&ctx->cols[i].defs);
+    }
+    free(ctx->cols);
+    free(ctx->names);
+    pq_buf_free(&ctx->groups);
+    pq_buf_free(&ctx->page);
+    pq_buf_free(&ctx->comp);
+    pq_buf_free(&ctx->hdr);
+    pq_buf_free(&ctx->idx);
+    pq_buf_free(&ctx->dict);
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    write_parquet_file
+
+    Exports a table (the first one seen if table_name is empty) to a
+    Parquet file.  Row group size, compression and dictionary encoding
+    come from odv_set_parquet_options.
+ ---------------------------------------------------------------------------*/
+int write_parquet_file(ODV_SESSION *s, const char *table_name, const char *output_path)
+{
+    PQ_CONTEXT ctx;
+    ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
+    void *saved_ud;
+    int saved_raw;
+    int rc;
+
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+
+    rc = pq_init(&ctx, s, table_name, output_path);
+    if (rc != ODV_OK) return rc;
+
+    /* Save and replace row callback; keep typed columns as wire bytes */
+    saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
+    saved_ud = s->row_ud;
+    saved_raw = s->raw_values;
+    s->row_cb = NULL;
+    s->row_span_cb = pq_row_callback;
+    s->row_ud = &ctx;
+    s->raw_values = 1;
+    s->plan.valid = 0;
+
+    /* Re-parse dump */
+    s->cancelled = 0;
+    s->total_rows = 0;
+
+    /* Auto-detect dump kind if not done */
+    if (s->dump_type == DUMP_UNKNOWN)
+        rc = detect_dump_kind(s);
+
+    if (rc == ODV_OK) rc = odv_run_parse(s, 0);
+
+    /* Last row group and footer */
+    rc = pq_finish(s, &ctx, rc);
+
+    /* Restore original callback and decode mode */
+    s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
+    s->row_ud = saved_ud;
+    s->raw_values = saved_raw;
+    s->plan.valid = 0;
+
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    parquet_tee_open
+
+    Opens a Parquet output of a tee export (odv_tee.c).  Takes typed
+    columns as wire bytes.
+ ---------------------------------------------------------------------------*/
+static int pq_sink_row(void *sink_ctx, const char *schema, const char *table,
+                       int col_count, const char **col_names, const char **col_values,
+                       const int *col_lengths)
+{
+    return pq_put_row((PQ_CONTEXT *)sink_ctx, schema, table, col_count, col_names,
+                      col_values, col_lengths);
+}
+
+static int pq_sink_close(void *sink_ctx, int rc)
+{
+    PQ_CONTEXT *ctx = (PQ_CONTEXT *)sink_ctx;
+
+    rc = pq_finish(ctx->session, ctx, rc);
+    free(ctx);
+    return rc;
+}
+
+int parquet_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                     ODV_TEE_SINK *sink)
+{
+    PQ_CONTEXT *ctx;
+    int rc;
+
+    ctx = (PQ_CONTEXT *)malloc(sizeof(PQ_CONTEXT));
+    if (!ctx) return ODV_ERROR_MALLOC;
+
+    rc = pq_init(ctx, s, table_name, output_path);
+    if (rc != ODV_OK) {
+        free(ctx);
+        return rc;
+    }
+    ctx->progress = 0;          /* Reported by the tee */
+
+    sink->ctx = ctx;
+    sink->raw = 1;
+    sink->row = pq_sink_row;
+    sink->close = pq_sink_close;
+    return ODV_OK;
+}
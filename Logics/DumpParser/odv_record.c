@@ -15,12 +15,29 @@
 
 int init_record(ODV_RECORD *rec, int max_cols)
 {
+    int i;
+
     if (!rec) return ODV_ERROR_INVALID_ARG;
     if (max_cols <= 0) max_cols = 256;
 
     rec->values = (ODV_VALUE *)calloc(max_cols, sizeof(ODV_VALUE));
     if (!rec->values) return ODV_ERROR_MALLOC;
 
+    rec->arena = (unsigned char *)malloc(ODV_ROW_ARENA_LEN);
+    if (!rec->arena) {
+        free(rec->values);
+        rec->values = NULL;
+        return ODV_ERROR_MALLOC;
+    }
+    rec->arena_size = ODV_ROW_ARENA_LEN;
+    rec->arena_used = 0;
+    rec->epoch = 1;
+
+    for (i = 0; i < max_cols; i++) {
+        rec->values[i].is_null = 1;
+        rec->values[i].rec = rec;
+    }
+
     rec->max_columns = max_cols;
     rec->col_count = 0;
     return ODV_OK;
@@ -28,17 +45,14 @@ int init_record(ODV_RECORD *rec, int max_cols)
 
 void free_record(ODV_RECORD *rec)
 {
-    int i;
     if (!rec || !rec->values) return;
 
-    for (i = 0; i < rec->max_columns; i++) {
-        if (rec->values[i].data) {
-            free(rec->values[i].data);
-            rec->values[i].data = NULL;
-        }
-    }
     free(rec->values);
     rec->values = NULL;
+    free(rec->arena);
+    rec->arena = NULL;
+    rec->arena_size = 0;
+    rec->arena_used = 0;
     rec->max_columns = 0;
     rec->col_count = 0;
 }
@@ -51,16 +65,19 @@ void reset_record(ODV_RECORD *rec)
     for (i = 0; i < rec->col_count; i++) {
         rec->values[i].is_null = 1;
         rec->values[i].data_len = 0;
-        /* Keep buffer allocated for reuse */
     }
     rec->col_count = 0;
+
+    /* Release every value span at once; the arena itself is kept for reuse */
+    rec->arena_used = 0;
+    if (++rec->epoch == 0) rec->epoch = 1;
 }
 
 /* Grow record if needed (e.g., table has more than 256 columns) */
-static int grow_record(ODV_RECORD *rec, int needed)
+int grow_record(ODV_RECORD *rec, int needed)
 {
     ODV_VALUE *new_vals;
-    int new_max;
+    int new_max, i;
 
     if (needed <= rec->max_columns) return ODV_OK;
 
@@ -71,6 +88,10 @@ static int grow_record(ODV_RECORD *rec, int needed)
     /* Zero-init new entries */
     memset(new_vals + rec->max_columns, 0,
            (new_max - rec->max_columns) * sizeof(ODV_VALUE));
+    for (i = rec->max_columns; i < new_max; i++) {
+        new_vals[i].is_null = 1;
+        new_vals[i].rec = rec;
+    }
 
     rec->values = new_vals;
     rec->max_columns = new_max;
@@ -78,27 +99,85 @@ static int grow_record(ODV_RECORD *rec, int needed)
 }
 
 /*---------------------------------------------------------------------------
-    Value helpers
+    Row arena
+
+    Value bytes of the current row are carved sequentially out of one slab.
+    When the slab has to move, spans of the current epoch are re-pointed;
+    spans of older epochs are dropped.
  ---------------------------------------------------------------------------*/
 
-int ensure_value_buf(ODV_VALUE *v, int needed)
+static int reserve_arena(ODV_RECORD *rec, int needed)
 {
-    if (!v) return ODV_ERROR_INVALID_ARG;
+    unsigned char *p;
+    int new_size, i;
 
-    if (v->buf_size >= needed) return ODV_OK;
+    if (needed <= rec->arena_size) return ODV_OK;
 
-    /* Round up to next power-of-2-ish size for reuse efficiency */
-    int new_size = (needed < 256) ? 256 : (needed + 255) & ~255;
+    new_size = rec->arena_size ? rec->arena_size : ODV_ROW_ARENA_LEN;
+    while (new_size < needed) {
+        if (new_size > INT_MAX / 2) { new_size = needed; break; }
+        new_size *= 2;
+    }
 
-    if (v->data) {
-        unsigned char *p = (unsigned char *)realloc(v->data, new_size);
-        if (!p) return ODV_ERROR_MALLOC;
-        v->data = p;
-    } else {
-        v->data = (unsigned char *)malloc(new_size);
-        if (!v->data) return ODV_ERROR_MALLOC;
+    p = (unsigned char *)realloc(rec->arena, new_size);
+    if (!p) return ODV_ERROR_MALLOC;
+    rec->arena = p;
+    rec->arena_size = new_size;
+
+    for (i = 0; i < rec->max_columns; i++) {
+        ODV_VALUE *v = &rec->values[i];
+        if (v->epoch == rec->epoch) {
+            v->data = p + v->offset;
+        } else {
+            v->data = NULL;
+            v->buf_size = 0;
+        }
+    }
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Value helpers
+ ---------------------------------------------------------------------------*/
+
+int ensure_value_buf(ODV_VALUE *v, int needed)
+{
+    ODV_RECORD *rec;
+    int cur, size, off, rc;
+
+    if (!v || !v->rec) return ODV_ERROR_INVALID_ARG;
+    rec = v->rec;
+
+    cur = (v->epoch == rec->epoch && v->data) ? v->buf_size : 0;
+    if (cur >= needed) return ODV_OK;
+
+    /* 8-byte granularity keeps spans aligned */
+    if (needed > INT_MAX - 8) return ODV_ERROR_MALLOC;
+    size = (needed + 7) & ~7;
+
+    /* The most recent span can grow in place; others move to the tail */
+    if (cur > 0 && v->offset + cur == rec->arena_used)
+        off = v->offset;
+    else
+        off = rec->arena_used;
+    if (off > INT_MAX - size) return ODV_ERROR_MALLOC;
+
+    rc = reserve_arena(rec, off + size);
+    if (rc != ODV_OK) {
+        if (cur == 0) { v->data = NULL; v->buf_size = 0; }
+        return rc;
     }
-    v->buf_size = new_size;
+
+    if (cur == 0)
+        v->data_len = 0;   /* Fresh span: nothing to carry over */
+    else if (off != v->offset && v->data_len > 0)
+        memcpy(rec->arena + off, v->data, v->data_len < cur ? v->data_len : cur);
+
+    v->offset   = off;
+    v->data     = rec->arena + off;
+    v->buf_size = size;
+    v->epoch    = rec->epoch;
+    rec->arena_used = off + size;
     return ODV_OK;
 }
 
@@ -132,24 +211,105 @@ int set_value_string(ODV_VALUE *v, const char *str, int len)
     return ODV_OK;
 }
 
+/* Destination for a decoder that writes its text straight into the value:
+   room for cap bytes (terminator included), or NULL if out of memory.
+   Finish with commit_value_text. */
+char *value_text_buf(ODV_VALUE *v, int cap)
+{
+    if (!v || cap < 1 || ensure_value_buf(v, cap) != ODV_OK) return NULL;
+    return (char *)v->data;
+}
+
+/* Seals text written through value_text_buf.  n is the decoder result:
+   the text length, or <= 0 (failed or empty) for NULL, as set_value_string
+   treats empty text. */
+int commit_value_text(ODV_VALUE *v, int n)
+{
+    if (!v) return ODV_ERROR_INVALID_ARG;
+    if (n <= 0 || !v->data || n >= v->buf_size) {
+        v->is_null = 1;
+        v->data_len = 0;
+        return n < 0 ? n : ODV_OK;
+    }
+    v->data[n] = '\0';
+    v->data_len = n;
+    v->is_null = 0;
+    return ODV_OK;
+}
+
+/* prefix + hex digits of src as the value.  src may be the value's own
+   data (RAW decoded in place). */
+int set_value_hex(ODV_VALUE *v, const char *prefix, const unsigned char *src, int len)
+{
+    int plen = prefix ? (int)strlen(prefix) : 0;
+    int in_place, rc;
+
+    if (!v || len < 0 || (len > 0 && !src)) return ODV_ERROR_INVALID_ARG;
+    if (len > (INT_MAX - plen - 1) / 2) return ODV_ERROR_MALLOC;
+
+    in_place = (len > 0 && src == v->data);
+    rc = ensure_value_buf(v, plen + len * 2 + 1);
+    if (rc != ODV_OK) return rc;
+    if (in_place) src = v->data;
+
+    /* Digits first: the prefix would overwrite unread source bytes */
+    odv_hex_encode(src, len, (char *)v->data + plen, 0);
+    if (plen) memcpy(v->data, prefix, plen);
+    v->data_len = plen + len * 2;
+    v->data[v->data_len] = '\0';
+    v->is_null = 0;
+    return ODV_OK;
+}
+
+/* ASCII value -> UTF-16LE, in place (UTF-16LE output mode) */
+int widen_value_ascii(ODV_VALUE *v)
+{
+    int n, i, rc;
+
+    if (!v || v->is_null || !v->data || v->data_len <= 0) return ODV_OK;
+
+    n = v->data_len;
+    rc = ensure_value_buf(v, n * 2 + 2);
+    if (rc != ODV_OK) return rc;
+
+    for (i = n - 1; i >= 0; i--) {
+        v->data[i * 2]     = v->data[i];
+        v->data[i * 2 + 1] = 0;
+    }
+    v->data[n * 2] = v->data[n * 2 + 1] = 0;
+    v->data_len = n * 2;
+    return ODV_OK;
+}
+
+/* Drop trailing blanks (CHAR/NCHAR padding); wide = value is UTF-16LE */
+void trim_value_spaces(ODV_VALUE *v, int wide)
+{
+    if (!v || !v->data) return;
+
+    if (wide) {
+        while (v->data_len >= 2 && v->data[v->data_len - 2] == ' ' &&
+               v->data[v->data_len - 1] == 0)
+            v->data_len -= 2;
+        if (v->data_len + 1 < v->buf_size) v->data[v->data_len + 1] = '\0';
+    } else {
+        while (v->data_len > 0 && v->data[v->data_len - 1] == ' ')
+            v->data_len--;
+    }
+    if (v->data_len < v->buf_size) v->data[v->data_len] = '\0';
+}
+
 /*---------------------------------------------------------------------------
-    Charset-converted metadata cache
-    Converted once per table (when table name changes), reused for all rows.
+    Charset-converted metadata cache (per session)
+    Converted once per table generation (see odv_table_changed), reused
+    for all rows.
  ---------------------------------------------------------------------------*/
 
-static struct {
-    char schema[ODV_OBJNAME_LEN * 4 + 1];
-    char name[ODV_OBJNAME_LEN * 4 + 1];
-    char col_names[ODV_MAX_COLUMNS][ODV_OBJNAME_LEN * 4 + 1];
-    char src_schema[ODV_OBJNAME_LEN + 1];   /* detect change */
-    char src_name[ODV_OBJNAME_LEN + 1];     /* detect change */
-    int  col_count;
-    int  valid;
-} meta_cache;
-
 static void convert_meta_string(const char *src, int src_cs, int dst_cs,
                                 char *dst, int dst_size)
 {
+    /* Unknown dump charset: names are taken as UTF-8 */
+    if (src_cs == CHARSET_UNKNOWN && dst_cs == CHARSET_UTF16LE)
+        src_cs = CHARSET_UTF8;
     if (src_cs != dst_cs && src_cs != CHARSET_UNKNOWN) {
         int out_len = 0;
         if (convert_charset(src, (int)strlen(src), src_cs,
@@ -162,40 +322,57 @@ static void convert_meta_string(const char *src, int src_cs, int dst_cs,
     odv_strcpy(dst, src, dst_size - 1);
 }
 
-void update_meta_cache(ODV_SESSION *s)
+int update_meta_cache(ODV_SESSION *s)
 {
+    ODV_META_CACHE *mc = &s->meta_cache;
+    const int name_len = ODV_OBJNAME_LEN * 4 + 1;
     int i;
 
     /* Check if cache is already valid for this table */
-    if (meta_cache.valid &&
-        meta_cache.col_count == s->table.col_count &&
-        strcmp(meta_cache.src_schema, s->table.schema) == 0 &&
-        strcmp(meta_cache.src_name, s->table.name) == 0) {
-        return;  /* Already cached */
+    if (mc->valid && mc->gen == s->table_gen)
+        return ODV_OK;  /* Already cached */
+
+    /* Grow column name storage to the table width */
+    if (s->table.col_count > mc->col_alloc || !mc->col_names) {
+        int new_alloc = mc->col_alloc ? mc->col_alloc : 64;
+        char *buf;
+        const char **names;
+        while (new_alloc < s->table.col_count) new_alloc *= 2;
+        buf = (char *)realloc(mc->col_name_buf, (size_t)new_alloc * name_len);
+        if (!buf) return ODV_ERROR_MALLOC;
+        mc->col_name_buf = buf;
+        names = (const char **)realloc((void *)mc->col_names, new_alloc * sizeof(char *));
+        if (!names) return ODV_ERROR_MALLOC;
+        mc->col_names = names;
+        mc->col_alloc = new_alloc;
     }
 
     /* Convert schema and table name */
     convert_meta_string(s->table.schema, s->dump_charset, s->out_charset,
-                        meta_cache.schema, sizeof(meta_cache.schema));
+                        mc->schema, sizeof(mc->schema));
     convert_meta_string(s->table.name, s->dump_charset, s->out_charset,
-                        meta_cache.name, sizeof(meta_cache.name));
+                        mc->name, sizeof(mc->name));
+    convert_meta_string(s->table.name, s->dump_charset, CHARSET_UTF8,
+                        mc->progress_name, sizeof(mc->progress_name));
 
     /* Convert column names */
-    for (i = 0; i < s->table.col_count && i < ODV_MAX_COLUMNS; i++) {
+    for (i = 0; i < s->table.col_count; i++) {
+        char *dst = mc->col_name_buf + (size_t)i * name_len;
         convert_meta_string(s->table.columns[i].name, s->dump_charset, s->out_charset,
-                            meta_cache.col_names[i], sizeof(meta_cache.col_names[i]));
+                            dst, name_len);
+        mc->col_names[i] = dst;
     }
 
-    /* Remember source for change detection */
-    odv_strcpy(meta_cache.src_schema, s->table.schema, ODV_OBJNAME_LEN);
-    odv_strcpy(meta_cache.src_name, s->table.name, ODV_OBJNAME_LEN);
-    meta_cache.col_count = s->table.col_count;
-    meta_cache.valid = 1;
+    mc->gen = s->table_gen;
+    mc->valid = 1;
+    return ODV_OK;
 }
 
-void invalidate_meta_cache(void)
+void free_meta_cache(ODV_SESSION *s)
 {
-    meta_cache.valid = 0;
+    free(s->meta_cache.col_name_buf);
+    free((void *)s->meta_cache.col_names);
+    memset(&s->meta_cache, 0, sizeof(s->meta_cache));
 }
 
 /*---------------------------------------------------------------------------
@@ -204,37 +381,71 @@ void invalidate_meta_cache(void)
 
 int deliver_row(ODV_SESSION *s)
 {
-    const char *col_names[ODV_MAX_COLUMNS];
-    const char *col_values[ODV_MAX_COLUMNS];
-    int i;
+    const char **col_values;
+    int *col_lengths;
+    int i, n;
     static const char empty_str[] = "";
 
-    if (!s || !s->row_cb) return ODV_OK;
+    if (!s) return ODV_OK;
 
-    /* Ensure metadata is charset-converted for this table */
-    update_meta_cache(s);
+    /* odv_seek_row: rows between the checkpoint and the target row are
+       parsed but not delivered */
+    if (s->skip_rows > 0) {
+        s->skip_rows--;
+        return ODV_OK;
+    }
 
-    for (i = 0; i < s->table.col_count && i < ODV_MAX_COLUMNS && i < s->record.max_columns; i++) {
-        col_names[i] = meta_cache.col_names[i];
+    if (!s->row_cb && !s->row_span_cb) return ODV_OK;
 
+    /* Ensure metadata is charset-converted for this table */
+    if (update_meta_cache(s) != ODV_OK) return ODV_ERROR_MALLOC;
+    if (odv_reserve_col_scratch(s, s->table.col_count) != ODV_OK)
+        return ODV_ERROR_MALLOC;
+    col_values = s->cb_strs;
+    col_lengths = s->cb_ints;
+
+    n = ODV_MIN(s->table.col_count, s->record.max_columns);
+    for (i = 0; i < n; i++) {
         if (s->record.values[i].is_null || !s->record.values[i].data) {
             col_values[i] = empty_str;
+            col_lengths[i] = -1;
         } else {
             col_values[i] = (const char *)s->record.values[i].data;
+            col_lengths[i] = s->record.values[i].data_len;
         }
     }
 
-    s->row_cb(
-        meta_cache.schema,
-        meta_cache.name,
-        s->table.col_count,
-        col_names,
-        col_values,
-        s->row_ud
-    );
+    if (s->row_span_cb) {
+        s->row_span_cb(
+            s->meta_cache.schema,
+            s->meta_cache.name,
+            s->table.col_count,
+            s->meta_cache.col_names,
+            col_values,
+            col_lengths,
+            s->row_ud
+        );
+    } else {
+        s->row_cb(
+            s->meta_cache.schema,
+            s->meta_cache.name,
+            s->table.col_count,
+            s->meta_cache.col_names,
+            col_values,
+            s->row_ud
+        );
+    }
 
     s->total_rows++;
 
+    /* Row limit reached: stop the parse the same way a cancel does.
+       Exports never set limit_active and always write every row. */
+    if (s->limit_active && s->row_limit > 0 &&
+        ++s->rows_delivered >= s->row_limit) {
+        s->limit_reached = 1;
+        s->cancelled = 1;
+    }
+
     return ODV_OK;
 }
 
@@ -257,6 +468,6 @@ void odv_report_progress(ODV_SESSION *s, FILE *fp)
         s->last_progress_pct = pct;
         /* Use charset-converted table name if cache is valid */
         update_meta_cache(s);
-        s->progress_cb(s->total_rows, meta_cache.name, s->progress_ud);
+        s->progress_cb(s->total_rows, s->meta_cache.progress_name, s->progress_ud);
     }
 }
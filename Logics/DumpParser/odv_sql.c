@@ -2,7 +2,7 @@
     OraDB DUMP Viewer
 
     odv_sql.c
-    SQL INSERT statement output
+    SQL INSERT statement and PostgreSQL COPY output
 
     Generates INSERT INTO statements for various DBMS targets:
     - Oracle:     Standard Oracle SQL syntax
@@ -10,6 +10,14 @@
     - MySQL:      Backtick identifiers
     - SQL Server: Bracket identifiers
 
+    Rows can be batched (odv_set_sql_batch): multi-row VALUES lists for
+    PostgreSQL / MySQL / SQL Server, INSERT ALL for Oracle, optionally
+    inside transactions committed every N rows.
+
+    PostgreSQL COPY output (odv_export_pgcopy) is written here as well,
+    sharing the CREATE TABLE DDL: a COPY text script, or a PGCOPY binary
+    file encoded from the Oracle wire bytes.
+
     Copyright (C) 2026 YANAI Taketo
  *****************************************************************************/
 
@@ -21,59 +29,74 @@
     SQL export context
  ---------------------------------------------------------------------------*/
 typedef struct {
-    FILE       *fp;
+    int         batch_pending;
+    int64_t     txn_rows;
+    int         txn_open;
+} SQL_SHARD_STATE;
+
+typedef struct {
+    ODV_OUTBUF *out;                  /* Current part of the current shard */
+    ODV_SPLIT  *split;                /* Output parts / shards (write_sql_file only) */
+    SQL_SHARD_STATE *shard_state;     /* Batch / transaction state of the other shards */
+    int         shard;                /* Shard that out, batch_pending, txn_* belong to */
     int64_t     row_count;
     const char *target_table;
     int         dbms_type;
     int         header_written;
     char        insert_prefix[4096];  /* Cached INSERT INTO ... VALUES ( */
+    int         batch_rows;           /* Rows per INSERT statement (1 = one per row) */
+    int         commit_rows;          /* COMMIT every N rows (0 = no transaction control) */
+    int         batch_pending;        /* Rows in the open multi-row statement */
+    int64_t     txn_rows;             /* Rows in the open transaction */
+    int         txn_open;
     ODV_SESSION *session;             /* For accessing column type info */
     int         create_table;         /* 1=output DROP TABLE + CREATE TABLE DDL */
     int         create_index;         /* 1=output CREATE INDEX DDL */
     int         write_comments;       /* 1=output COMMENT ON DDL */
     char        last_schema[129];     /* Schema name from last row (for post-parse index output) */
     char        last_table[129];      /* Table name from last row */
+    int         progress;             /* 1=report rows to progress_cb */
 } SQL_CONTEXT;
 
 /*---------------------------------------------------------------------------
     Helper: write SQL-escaped string value
     Escapes single quotes by doubling them.
  ---------------------------------------------------------------------------*/
-static void sql_write_string(FILE *fp, const char *val)
+static void sql_write_string(ODV_OUTBUF *out, const char *val)
 {
-    fputc('\'', fp);
+    odv_out_putc(out, '\'');
     while (*val) {
         if (*val == '\'') {
-            fputc('\'', fp);
-            fputc('\'', fp);
+            odv_out_putc(out, '\'');
+            odv_out_putc(out, '\'');
         } else if (*val == '\\' && 0) {
             /* MySQL needs backslash escaping, but we use standard SQL mode */
-            fputc('\\', fp);
-            fputc('\\', fp);
+            odv_out_putc(out, '\\');
+            odv_out_putc(out, '\\');
         } else {
-            fputc(*val, fp);
+            odv_out_putc(out, *val);
         }
         val++;
     }
-    fputc('\'', fp);
+    odv_out_putc(out, '\'');
 }
 
 /*---------------------------------------------------------------------------
     Helper: quote an identifier for the target DBMS
  ---------------------------------------------------------------------------*/
-static void sql_write_identifier(FILE *fp, const char *name, int dbms)
+static void sql_write_identifier(ODV_OUTBUF *out, const char *name, int dbms)
 {
     switch (dbms) {
     case DBMS_MYSQL:
-        fprintf(fp, "`%s`", name);
+        odv_out_printf(out, "`%s`", name);
         break;
     case DBMS_SQLSERVER:
-        fprintf(fp, "[%s]", name);
+        odv_out_printf(out, "[%s]", name);
         break;
     case DBMS_ORACLE:
     case DBMS_POSTGRES:
     default:
-        fprintf(fp, "\"%s\"", name);
+        odv_out_printf(out, "\"%s\"", name);
         break;
     }
 }
@@ -132,10 +155,13 @@ static int parse_number_prec_scale(const char *paren, int *prec, int *scale)
     - NUMBER(p, negative_scale) → adjusted NUMERIC for non-Oracle targets
     - FLOAT(n) → binary precision to IEEE float mapping
     - INTERVAL, LONG RAW, XMLTYPE, ROWID, BFILE, etc.
+    Built names go to result (SQL_TYPE_LEN bytes), so tee writer threads
+    (odv_tee.c) can map types at the same time.
  ---------------------------------------------------------------------------*/
-static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
+#define SQL_TYPE_LEN 256
+
+static const char *map_oracle_to_target_type(const char *oracle_type, int dbms, char *result)
 {
-    static char result[256];
     char base[64];
     const char *paren;
     int i;
@@ -171,11 +197,11 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
             parse_number_prec_scale(paren, &prec, &scale);
             if (prec > 38 && scale == 0) {
                 /* This was originally FLOAT(n) encoded as NUMBER(n) by EXPDP */
-                snprintf(result, sizeof(result), "FLOAT(%d)", prec);
+                snprintf(result, SQL_TYPE_LEN, "FLOAT(%d)", prec);
                 return result;
             }
         }
-        snprintf(result, sizeof(result), "%s", oracle_type);
+        snprintf(result, SQL_TYPE_LEN, "%s", oracle_type);
         return result;
     }
 
@@ -192,17 +218,17 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
     if (dbms == DBMS_POSTGRES) {
         /* VARCHAR2 / NVARCHAR2 → VARCHAR */
         if (strcmp(base, "VARCHAR2") == 0 || strcmp(base, "NVARCHAR2") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "VARCHAR%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "VARCHAR%s", paren); return result; }
             return "VARCHAR(255)";
         }
         /* NUMBER */
         if (strcmp(base, "NUMBER") == 0) {
             if (has_prec && prec > 38 && scale == 0) return "DOUBLE PRECISION"; /* FLOAT */
             if (has_prec && scale < 0) {
-                snprintf(result, sizeof(result), "NUMERIC(%d,0)", prec + (-scale));
+                snprintf(result, SQL_TYPE_LEN, "NUMERIC(%d,0)", prec + (-scale));
                 return result;
             }
-            if (paren) { snprintf(result, sizeof(result), "NUMERIC%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "NUMERIC%s", paren); return result; }
             return "NUMERIC";
         }
         /* FLOAT (from EXP parser) — binary precision */
@@ -221,9 +247,9 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
             if (strstr(oracle_type, "WITH TIME ZONE") ||
                 strstr(oracle_type, "WITH LOCAL TIME ZONE")) {
                 /* PG: WITH LOCAL TIME ZONE → WITH TIME ZONE */
-                snprintf(result, sizeof(result), "TIMESTAMP(%d) WITH TIME ZONE", ts_prec);
+                snprintf(result, SQL_TYPE_LEN, "TIMESTAMP(%d) WITH TIME ZONE", ts_prec);
             } else {
-                snprintf(result, sizeof(result), "TIMESTAMP(%d)", ts_prec);
+                snprintf(result, SQL_TYPE_LEN, "TIMESTAMP(%d)", ts_prec);
             }
             return result;
         }
@@ -236,7 +262,7 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
         if (strcmp(base, "BINARY_DOUBLE") == 0) return "DOUBLE PRECISION";
         /* CHAR / NCHAR */
         if (strcmp(base, "CHAR") == 0 || strcmp(base, "NCHAR") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "CHAR%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "CHAR%s", paren); return result; }
             return "CHAR(1)";
         }
         /* INTERVAL */
@@ -256,16 +282,16 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
        ================================================================= */
     if (dbms == DBMS_MYSQL) {
         if (strcmp(base, "VARCHAR2") == 0 || strcmp(base, "NVARCHAR2") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "VARCHAR%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "VARCHAR%s", paren); return result; }
             return "VARCHAR(255)";
         }
         if (strcmp(base, "NUMBER") == 0) {
             if (has_prec && prec > 38 && scale == 0) return "DOUBLE";
             if (has_prec && scale < 0) {
-                snprintf(result, sizeof(result), "DECIMAL(%d,0)", prec + (-scale));
+                snprintf(result, SQL_TYPE_LEN, "DECIMAL(%d,0)", prec + (-scale));
                 return result;
             }
-            if (paren) { snprintf(result, sizeof(result), "DECIMAL%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "DECIMAL%s", paren); return result; }
             return "DECIMAL(38,10)";
         }
         if (strcmp(base, "FLOAT") == 0) {
@@ -281,9 +307,9 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
             int ts_prec = paren ? atoi(paren + 1) : 0;
             if (ts_prec > 6) ts_prec = 6;
             if (ts_prec > 0) {
-                snprintf(result, sizeof(result), "DATETIME(%d)", ts_prec);
+                snprintf(result, SQL_TYPE_LEN, "DATETIME(%d)", ts_prec);
             } else {
-                snprintf(result, sizeof(result), "DATETIME");
+                snprintf(result, SQL_TYPE_LEN, "DATETIME");
             }
             return result;
         }
@@ -293,7 +319,7 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
         if (strcmp(base, "BINARY_FLOAT") == 0) return "FLOAT";
         if (strcmp(base, "BINARY_DOUBLE") == 0) return "DOUBLE";
         if (strcmp(base, "CHAR") == 0 || strcmp(base, "NCHAR") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "CHAR%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "CHAR%s", paren); return result; }
             return "CHAR(1)";
         }
         if (strcmp(base, "INTERVAL YEAR TO MONTH") == 0 ||
@@ -311,22 +337,22 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
        ================================================================= */
     if (dbms == DBMS_SQLSERVER) {
         if (strcmp(base, "VARCHAR2") == 0 || strcmp(base, "NVARCHAR2") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "NVARCHAR%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "NVARCHAR%s", paren); return result; }
             return "NVARCHAR(255)";
         }
         if (strcmp(base, "NUMBER") == 0) {
             if (has_prec && prec > 38 && scale == 0) return "FLOAT";  /* FLOAT(53) */
             if (has_prec && scale < 0) {
-                snprintf(result, sizeof(result), "DECIMAL(%d,0)", prec + (-scale));
+                snprintf(result, SQL_TYPE_LEN, "DECIMAL(%d,0)", prec + (-scale));
                 return result;
             }
-            if (paren) { snprintf(result, sizeof(result), "DECIMAL%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "DECIMAL%s", paren); return result; }
             return "DECIMAL(38,10)";
         }
         if (strcmp(base, "FLOAT") == 0) {
             if (paren) {
                 int bp = atoi(paren + 1);
-                snprintf(result, sizeof(result), "FLOAT(%d)", bp <= 24 ? 24 : 53);
+                snprintf(result, SQL_TYPE_LEN, "FLOAT(%d)", bp <= 24 ? 24 : 53);
                 return result;
             }
             return "FLOAT";
@@ -336,26 +362,26 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
             int ts_prec = paren ? atoi(paren + 1) : 7;
             if (ts_prec > 7) ts_prec = 7; /* SQL Server max = 7 */
             if (strstr(oracle_type, "WITH TIME ZONE")) {
-                snprintf(result, sizeof(result), "DATETIMEOFFSET(%d)", ts_prec);
+                snprintf(result, SQL_TYPE_LEN, "DATETIMEOFFSET(%d)", ts_prec);
             } else {
-                snprintf(result, sizeof(result), "DATETIME2(%d)", ts_prec);
+                snprintf(result, SQL_TYPE_LEN, "DATETIME2(%d)", ts_prec);
             }
             return result;
         }
         if (strcmp(base, "CLOB") == 0 || strcmp(base, "NCLOB") == 0 || strcmp(base, "LONG") == 0) return "NVARCHAR(MAX)";
         if (strcmp(base, "BLOB") == 0 || strcmp(base, "LONG RAW") == 0) return "VARBINARY(MAX)";
         if (strcmp(base, "RAW") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "VARBINARY%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "VARBINARY%s", paren); return result; }
             return "VARBINARY(MAX)";
         }
         if (strcmp(base, "BINARY_FLOAT") == 0) return "REAL";
         if (strcmp(base, "BINARY_DOUBLE") == 0) return "FLOAT";
         if (strcmp(base, "CHAR") == 0) {
-            if (paren) { snprintf(result, sizeof(result), "NCHAR%s", paren); return result; }
+            if (paren) { snprintf(result, SQL_TYPE_LEN, "NCHAR%s", paren); return result; }
             return "NCHAR(1)";
         }
         if (strcmp(base, "NCHAR") == 0) {
-            snprintf(result, sizeof(result), "%s", oracle_type);
+            snprintf(result, SQL_TYPE_LEN, "%s", oracle_type);
             return result;
         }
         if (strcmp(base, "INTERVAL YEAR TO MONTH") == 0 ||
@@ -369,7 +395,7 @@ static const char *map_oracle_to_target_type(const char *oracle_type, int dbms)
     }
 
     /* Unknown DBMS: return as-is */
-    snprintf(result, sizeof(result), "%s", oracle_type);
+    snprintf(result, SQL_TYPE_LEN, "%s", oracle_type);
     return result;
 }
 
@@ -382,7 +408,8 @@ static void write_create_table(SQL_CONTEXT *ctx, const char *schema,
                                 const char *table, int col_count,
                                 const char **col_names, int dbms)
 {
-    FILE *fp = ctx->fp;
+    ODV_OUTBUF *out = ctx->out;
+    char type_buf[SQL_TYPE_LEN];
     int i;
 
     if (!ctx->session) return;
@@ -391,66 +418,67 @@ static void write_create_table(SQL_CONTEXT *ctx, const char *schema,
     switch (dbms) {
     case DBMS_ORACLE:
         /* Oracle: PL/SQL anonymous block (IF EXISTS not supported before 23c) */
-        fprintf(fp, "BEGIN EXECUTE IMMEDIATE 'DROP TABLE ");
-        if (schema && schema[0] != '\0') fprintf(fp, "\"%s\".", schema);
-        fprintf(fp, "\"%s\" CASCADE CONSTRAINTS PURGE'", table);
-        fprintf(fp, "; EXCEPTION WHEN OTHERS THEN NULL; END;\n/\n\n");
+        odv_out_printf(out, "BEGIN EXECUTE IMMEDIATE 'DROP TABLE ");
+        if (schema && schema[0] != '\0') odv_out_printf(out, "\"%s\".", schema);
+        odv_out_printf(out, "\"%s\" CASCADE CONSTRAINTS PURGE'", table);
+        odv_out_printf(out, "; EXCEPTION WHEN OTHERS THEN NULL; END;\n/\n\n");
         break;
     case DBMS_MYSQL:
-        fprintf(fp, "DROP TABLE IF EXISTS ");
+        odv_out_printf(out, "DROP TABLE IF EXISTS ");
         if (schema && schema[0] != '\0') {
-            sql_write_identifier(fp, schema, dbms);
-            fputc('.', fp);
+            sql_write_identifier(out, schema, dbms);
+            odv_out_putc(out, '.');
         }
-        sql_write_identifier(fp, table, dbms);
-        fprintf(fp, ";\n\n");
+        sql_write_identifier(out, table, dbms);
+        odv_out_printf(out, ";\n\n");
         break;
     case DBMS_SQLSERVER:
-        fprintf(fp, "IF OBJECT_ID('");
-        if (schema && schema[0] != '\0') fprintf(fp, "%s.", schema);
-        fprintf(fp, "%s', 'U') IS NOT NULL DROP TABLE ", table);
+        odv_out_printf(out, "IF OBJECT_ID('");
+        if (schema && schema[0] != '\0') odv_out_printf(out, "%s.", schema);
+        odv_out_printf(out, "%s', 'U') IS NOT NULL DROP TABLE ", table);
         if (schema && schema[0] != '\0') {
-            sql_write_identifier(fp, schema, dbms);
-            fputc('.', fp);
+            sql_write_identifier(out, schema, dbms);
+            odv_out_putc(out, '.');
         }
-        sql_write_identifier(fp, table, dbms);
-        fprintf(fp, ";\n\n");
+        sql_write_identifier(out, table, dbms);
+        odv_out_printf(out, ";\n\n");
         break;
     default: /* PostgreSQL */
-        fprintf(fp, "DROP TABLE IF EXISTS ");
+        odv_out_printf(out, "DROP TABLE IF EXISTS ");
         if (schema && schema[0] != '\0') {
-            sql_write_identifier(fp, schema, dbms);
-            fputc('.', fp);
+            sql_write_identifier(out, schema, dbms);
+            odv_out_putc(out, '.');
         }
-        sql_write_identifier(fp, table, dbms);
-        fprintf(fp, " CASCADE;\n\n");
+        sql_write_identifier(out, table, dbms);
+        odv_out_printf(out, " CASCADE;\n\n");
         break;
     }
 
-    fprintf(fp, "CREATE TABLE ");
+    odv_out_printf(out, "CREATE TABLE ");
 
     if (schema && schema[0] != '\0') {
-        sql_write_identifier(fp, schema, dbms);
-        fputc('.', fp);
+        sql_write_identifier(out, schema, dbms);
+        odv_out_putc(out, '.');
     }
-    sql_write_identifier(fp, table, dbms);
-    fprintf(fp, " (\n");
+    sql_write_identifier(out, table, dbms);
+    odv_out_printf(out, " (\n");
 
     for (i = 0; i < col_count; i++) {
-        if (i > 0) fprintf(fp, ",\n");
-        fprintf(fp, "    ");
-        sql_write_identifier(fp, col_names[i], dbms);
-        fputc(' ', fp);
+        if (i > 0) odv_out_printf(out, ",\n");
+        odv_out_printf(out, "    ");
+        sql_write_identifier(out, col_names[i], dbms);
+        odv_out_putc(out, ' ');
 
         if (i < ctx->session->table.col_count &&
             ctx->session->table.columns[i].type_str[0]) {
-            fputs(map_oracle_to_target_type(ctx->session->table.columns[i].type_str, dbms), fp);
+            odv_out_puts(out, map_oracle_to_target_type(ctx->session->table.columns[i].type_str, dbms,
+                                                   type_buf));
         } else {
-            fputs("VARCHAR(255)", fp);
+            odv_out_puts(out, "VARCHAR(255)");
         }
     }
 
-    fprintf(fp, "\n);\n\n");
+    odv_out_printf(out, "\n);\n\n");
 }
 
 /*---------------------------------------------------------------------------
@@ -462,7 +490,7 @@ static void write_create_table(SQL_CONTEXT *ctx, const char *schema,
 static void write_indexes(SQL_CONTEXT *ctx, const char *schema,
                           const char *table, int dbms)
 {
-    FILE *fp = ctx->fp;
+    ODV_OUTBUF *out = ctx->out;
     int i, j;
 
     if (!ctx->session) return;
@@ -471,36 +499,36 @@ static void write_indexes(SQL_CONTEXT *ctx, const char *schema,
         ODV_CONSTRAINT *c = &ctx->session->table.constraints[i];
         if (c->type != CONSTRAINT_INDEX) continue;
 
-        fprintf(fp, "CREATE INDEX ");
+        odv_out_printf(out, "CREATE INDEX ");
         if (c->name[0]) {
-            sql_write_identifier(fp, c->name, dbms);
-            fputc(' ', fp);
+            sql_write_identifier(out, c->name, dbms);
+            odv_out_putc(out, ' ');
         }
-        fprintf(fp, "ON ");
+        odv_out_printf(out, "ON ");
         if (schema && schema[0] != '\0') {
-            sql_write_identifier(fp, schema, dbms);
-            fputc('.', fp);
+            sql_write_identifier(out, schema, dbms);
+            odv_out_putc(out, '.');
         }
-        sql_write_identifier(fp, table, dbms);
-        fputc(' ', fp);
+        sql_write_identifier(out, table, dbms);
+        odv_out_putc(out, ' ');
 
         /* Use index_expr if available (preserves function-based expressions),
            otherwise build from columns[] */
         if (c->index_expr[0]) {
-            fputs(c->index_expr, fp);
+            odv_out_puts(out, c->index_expr);
         } else if (c->col_count > 0) {
-            fputc('(', fp);
+            odv_out_putc(out, '(');
             for (j = 0; j < c->col_count; j++) {
-                if (j > 0) fputs(", ", fp);
-                sql_write_identifier(fp, c->columns[j], dbms);
+                if (j > 0) odv_out_puts(out, ", ");
+                sql_write_identifier(out, c->columns[j], dbms);
             }
-            fputc(')', fp);
+            odv_out_putc(out, ')');
         } else {
             /* Fallback: empty index (should not happen) */
-            fputs("()", fp);
+            odv_out_puts(out, "()");
         }
 
-        fprintf(fp, ";\n");
+        odv_out_printf(out, ";\n");
     }
 
     /* Add blank line after indexes if any were written */
@@ -512,7 +540,7 @@ static void write_indexes(SQL_CONTEXT *ctx, const char *schema,
                 break;
             }
         }
-        if (has_index) fputc('\n', fp);
+        if (has_index) odv_out_putc(out, '\n');
     }
 }
 
@@ -528,7 +556,7 @@ static void write_indexes(SQL_CONTEXT *ctx, const char *schema,
 static void write_comments(SQL_CONTEXT *ctx, const char *schema,
                            const char *table, int dbms)
 {
-    FILE *fp = ctx->fp;
+    ODV_OUTBUF *out = ctx->out;
     int i;
     int has_any = 0;
 
@@ -547,26 +575,26 @@ static void write_comments(SQL_CONTEXT *ctx, const char *schema,
     if (ctx->session->table.comment[0]) {
         switch (dbms) {
         case DBMS_MYSQL:
-            fprintf(fp, "ALTER TABLE ");
-            if (schema && schema[0]) { sql_write_identifier(fp, schema, dbms); fputc('.', fp); }
-            sql_write_identifier(fp, table, dbms);
-            fprintf(fp, " COMMENT = ");
-            sql_write_string(fp, ctx->session->table.comment);
-            fprintf(fp, ";\n");
+            odv_out_printf(out, "ALTER TABLE ");
+            if (schema && schema[0]) { sql_write_identifier(out, schema, dbms); odv_out_putc(out, '.'); }
+            sql_write_identifier(out, table, dbms);
+            odv_out_printf(out, " COMMENT = ");
+            sql_write_string(out, ctx->session->table.comment);
+            odv_out_printf(out, ";\n");
             break;
         case DBMS_SQLSERVER:
             /* SQL Server uses sp_addextendedproperty — output as comment */
-            fprintf(fp, "-- COMMENT ON TABLE %s: ", table);
-            sql_write_string(fp, ctx->session->table.comment);
-            fputc('\n', fp);
+            odv_out_printf(out, "-- COMMENT ON TABLE %s: ", table);
+            sql_write_string(out, ctx->session->table.comment);
+            odv_out_putc(out, '\n');
             break;
         default: /* Oracle, PostgreSQL */
-            fprintf(fp, "COMMENT ON TABLE ");
-            if (schema && schema[0]) { sql_write_identifier(fp, schema, dbms); fputc('.', fp); }
-            sql_write_identifier(fp, table, dbms);
-            fprintf(fp, " IS ");
-            sql_write_string(fp, ctx->session->table.comment);
-            fprintf(fp, ";\n");
+            odv_out_printf(out, "COMMENT ON TABLE ");
+            if (schema && schema[0]) { sql_write_identifier(out, schema, dbms); odv_out_putc(out, '.'); }
+            sql_write_identifier(out, table, dbms);
+            odv_out_printf(out, " IS ");
+            sql_write_string(out, ctx->session->table.comment);
+            odv_out_printf(out, ";\n");
             break;
         }
     }
@@ -579,31 +607,52 @@ static void write_comments(SQL_CONTEXT *ctx, const char *schema,
         case DBMS_MYSQL:
             /* MySQL: column comments set via ALTER TABLE MODIFY COLUMN ... COMMENT '...'
                This requires full column definition — too complex. Output as SQL comment. */
-            fprintf(fp, "-- COMMENT ON COLUMN %s.", table);
-            fprintf(fp, "%s: ", ctx->session->table.columns[i].name);
-            sql_write_string(fp, ctx->session->table.columns[i].comment);
-            fputc('\n', fp);
+            odv_out_printf(out, "-- COMMENT ON COLUMN %s.", table);
+            odv_out_printf(out, "%s: ", ctx->session->table.columns[i].name);
+            sql_write_string(out, ctx->session->table.columns[i].comment);
+            odv_out_putc(out, '\n');
             break;
         case DBMS_SQLSERVER:
-            fprintf(fp, "-- COMMENT ON COLUMN %s.", table);
-            fprintf(fp, "%s: ", ctx->session->table.columns[i].name);
-            sql_write_string(fp, ctx->session->table.columns[i].comment);
-            fputc('\n', fp);
+            odv_out_printf(out, "-- COMMENT ON COLUMN %s.", table);
+            odv_out_printf(out, "%s: ", ctx->session->table.columns[i].name);
+            sql_write_string(out, ctx->session->table.columns[i].comment);
+            odv_out_putc(out, '\n');
             break;
         default: /* Oracle, PostgreSQL */
-            fprintf(fp, "COMMENT ON COLUMN ");
-            if (schema && schema[0]) { sql_write_identifier(fp, schema, dbms); fputc('.', fp); }
-            sql_write_identifier(fp, table, dbms);
-            fputc('.', fp);
-            sql_write_identifier(fp, ctx->session->table.columns[i].name, dbms);
-            fprintf(fp, " IS ");
-            sql_write_string(fp, ctx->session->table.columns[i].comment);
-            fprintf(fp, ";\n");
+            odv_out_printf(out, "COMMENT ON COLUMN ");
+            if (schema && schema[0]) { sql_write_identifier(out, schema, dbms); odv_out_putc(out, '.'); }
+            sql_write_identifier(out, table, dbms);
+            odv_out_putc(out, '.');
+            sql_write_identifier(out, ctx->session->table.columns[i].name, dbms);
+            odv_out_printf(out, " IS ");
+            sql_write_string(out, ctx->session->table.columns[i].comment);
+            odv_out_printf(out, ";\n");
             break;
         }
     }
 
-    fputc('\n', fp);
+    odv_out_putc(out, '\n');
+}
+
+/*---------------------------------------------------------------------------
+    write_comment_header
+
+    "-- Table:" comment at the top of every output part.
+ ---------------------------------------------------------------------------*/
+static void write_comment_header(SQL_CONTEXT *ctx, const char *schema, const char *table)
+{
+    ODV_OUTBUF *out = ctx->out;
+
+    odv_out_printf(out, "-- Table: ");
+    if (schema && schema[0] != '\0') {
+        odv_out_printf(out, "%s.", schema);
+    }
+    odv_out_printf(out, "%s\n", table);
+    if (ctx->session && ctx->session->app_version[0]) {
+        odv_out_printf(out, "-- Generated by OraDB DUMP Viewer v%s\n\n", ctx->session->app_version);
+    } else {
+        odv_out_printf(out, "-- Generated by OraDB DUMP Viewer\n\n");
+    }
 }
 
 /*---------------------------------------------------------------------------
@@ -616,22 +665,12 @@ static void build_insert_prefix(SQL_CONTEXT *ctx, const char *schema,
                                 const char *table, int col_count,
                                 const char **col_names, int dbms)
 {
-    FILE *fp = ctx->fp;
     int i;
 
     ctx->header_written = 1;
 
     /* Write CREATE TABLE comment at the top */
-    fprintf(fp, "-- Table: ");
-    if (schema && schema[0] != '\0') {
-        fprintf(fp, "%s.", schema);
-    }
-    fprintf(fp, "%s\n", table);
-    if (ctx->session && ctx->session->app_version[0]) {
-        fprintf(fp, "-- Generated by OraDB DUMP Viewer v%s\n\n", ctx->session->app_version);
-    } else {
-        fprintf(fp, "-- Generated by OraDB DUMP Viewer\n\n");
-    }
+    write_comment_header(ctx, schema, table);
 
     /* Output CREATE TABLE DDL if requested.
        Note: write_indexes is called after parse completes (in write_sql_file)
@@ -690,121 +729,313 @@ static void build_insert_prefix(SQL_CONTEXT *ctx, const char *schema,
 }
 
 /*---------------------------------------------------------------------------
-    sql_row_callback
- ---------------------------------------------------------------------------*/
-static void ODV_CALL sql_row_callback(
-    const char *schema, const char *table,
-    int col_count, const char **col_names, const char **col_values,
-    void *user_data)
-{
-    SQL_CONTEXT *ctx = (SQL_CONTEXT *)user_data;
-    int i;
+    Batching helpers
 
-    if (!ctx || !ctx->fp) return;
+    insert_prefix is "INSERT INTO <target> (<cols>) VALUES (":
+      per row    : the prefix as is
+      multi-row  : the prefix without its " (", then one "(...)" per row
+      INSERT ALL : "  INTO" + the prefix after "INSERT INTO", per row
+ ---------------------------------------------------------------------------*/
+#define SQL_INSERT_INTO_LEN 11      /* strlen("INSERT INTO") */
+#define SQL_SERVER_MAX_ROWS 1000    /* Row constructors per VALUES list */
 
-    /* Filter by table name if specified */
-    if (ctx->target_table && ctx->target_table[0] != '\0') {
-        if (strcmp(table, ctx->target_table) != 0) return;
+static void sql_begin_txn(SQL_CONTEXT *ctx)
+{
+    if (ctx->commit_rows <= 0 || ctx->txn_open) return;
+    switch (ctx->dbms_type) {
+    case DBMS_POSTGRES:  odv_out_puts(ctx->out, "BEGIN;\n"); break;
+    case DBMS_MYSQL:     odv_out_puts(ctx->out, "START TRANSACTION;\n"); break;
+    case DBMS_SQLSERVER: odv_out_puts(ctx->out, "BEGIN TRANSACTION;\n"); break;
+    default:             break;   /* Oracle: transactions start implicitly */
     }
+    ctx->txn_open = 1;
+    ctx->txn_rows = 0;
+}
 
-    /* Build INSERT prefix on first row */
-    if (!ctx->header_written) {
-        build_insert_prefix(ctx, schema, table, col_count, col_names, ctx->dbms_type);
-    }
+/* Terminates the open multi-row statement, if any */
+static void sql_end_batch(SQL_CONTEXT *ctx)
+{
+    if (ctx->batch_pending == 0) return;
+    if (ctx->dbms_type == DBMS_ORACLE)
+        odv_out_puts(ctx->out, "SELECT 1 FROM DUAL;\n");
+    else
+        odv_out_puts(ctx->out, ";\n");
+    ctx->batch_pending = 0;
+}
 
-    /* Remember schema/table for post-parse index output */
-    if (schema) odv_strcpy(ctx->last_schema, schema, 128);
-    if (table) odv_strcpy(ctx->last_table, table, 128);
+static void sql_commit(SQL_CONTEXT *ctx)
+{
+    if (!ctx->txn_open) return;
+    sql_end_batch(ctx);
+    odv_out_puts(ctx->out, "COMMIT;\n");
+    ctx->txn_open = 0;
+    ctx->txn_rows = 0;
+}
 
-    /* Write INSERT statement */
-    fputs(ctx->insert_prefix, ctx->fp);
+/* Makes shard k current: out and the batch / transaction state */
+static void sql_use_shard(SQL_CONTEXT *ctx, int k)
+{
+    SQL_SHARD_STATE *st;
+
+    if (k == ctx->shard) return;
+    st = &ctx->shard_state[ctx->shard];
+    st->batch_pending = ctx->batch_pending;
+    st->txn_rows = ctx->txn_rows;
+    st->txn_open = ctx->txn_open;
+
+    st = &ctx->shard_state[k];
+    ctx->batch_pending = st->batch_pending;
+    ctx->txn_rows = st->txn_rows;
+    ctx->txn_open = st->txn_open;
+    ctx->shard = k;
+    ctx->out = &ctx->split->files[k];
+}
+
+/* Values of one row, comma-separated, without the parentheses */
+static void sql_write_values(SQL_CONTEXT *ctx, int col_count, const char **col_values)
+{
+    int i;
 
     for (i = 0; i < col_count; i++) {
-        if (i > 0) fputs(", ", ctx->fp);
+        if (i > 0) odv_out_puts(ctx->out, ", ");
 
         if (!col_values[i] || col_values[i][0] == '\0') {
-            fputs("NULL", ctx->fp);
+            odv_out_puts(ctx->out, "NULL");
         } else if (ctx->session && i < ctx->session->table.col_count &&
-                   (ctx->session->table.columns[i].type == COL_BIN_FLOAT ||
-                    ctx->session->table.columns[i].type == COL_BIN_DOUBLE) &&
+                   (ctx->session->table.desc[i].type == COL_BIN_FLOAT ||
+                    ctx->session->table.desc[i].type == COL_BIN_DOUBLE) &&
                    (strcmp(col_values[i], "NaN") == 0 ||
                     strcmp(col_values[i], "Inf") == 0 ||
                     strcmp(col_values[i], "-Inf") == 0)) {
             /* Special IEEE 754 values: NaN, Inf, -Inf */
-            int is_float = (ctx->session->table.columns[i].type == COL_BIN_FLOAT);
+            int is_float = (ctx->session->table.desc[i].type == COL_BIN_FLOAT);
             const char *val = col_values[i];
             switch (ctx->dbms_type) {
             case DBMS_ORACLE:
                 if (strcmp(val, "NaN") == 0)
-                    fputs(is_float ? "BINARY_FLOAT_NAN" : "BINARY_DOUBLE_NAN", ctx->fp);
+                    odv_out_puts(ctx->out, is_float ? "BINARY_FLOAT_NAN" : "BINARY_DOUBLE_NAN");
                 else if (strcmp(val, "Inf") == 0)
-                    fputs(is_float ? "BINARY_FLOAT_INFINITY" : "BINARY_DOUBLE_INFINITY", ctx->fp);
+                    odv_out_puts(ctx->out, is_float ? "BINARY_FLOAT_INFINITY" : "BINARY_DOUBLE_INFINITY");
                 else
-                    fprintf(ctx->fp, "-%s", is_float ? "BINARY_FLOAT_INFINITY" : "BINARY_DOUBLE_INFINITY");
+                    odv_out_printf(ctx->out, "-%s", is_float ? "BINARY_FLOAT_INFINITY" : "BINARY_DOUBLE_INFINITY");
                 break;
             case DBMS_POSTGRES:
-                fprintf(ctx->fp, "'%s'::%s",
+                odv_out_printf(ctx->out, "'%s'::%s",
                     strcmp(val, "Inf") == 0 ? "Infinity" :
                     strcmp(val, "-Inf") == 0 ? "-Infinity" : val,
                     is_float ? "REAL" : "DOUBLE PRECISION");
                 break;
             default:
                 /* MySQL / SQL Server: no NaN/Inf support → NULL */
-                fputs("NULL", ctx->fp);
+                odv_out_puts(ctx->out, "NULL");
                 break;
             }
         } else if (is_numeric_value(col_values[i])) {
-            fputs(col_values[i], ctx->fp);
+            odv_out_puts(ctx->out, col_values[i]);
+        } else {
+            sql_write_string(ctx->out, col_values[i]);
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------
+    sql_put_row
+
+    Writes one row as INSERT statement(s).
+    Returns ODV_OK, or the error the output has failed with (disk full,
+    closed pipe).
+ ---------------------------------------------------------------------------*/
+static int sql_put_row(SQL_CONTEXT *ctx, const char *schema, const char *table,
+                       int col_count, const char **col_names, const char **col_values)
+{
+    ODV_SPLIT *split = ctx->split;
+    int k;
+
+    /* Filter by table name if specified */
+    if (ctx->target_table && ctx->target_table[0] != '\0') {
+        if (strcmp(table, ctx->target_table) != 0) return ODV_OK;
+    }
+    if (ctx->out->error != ODV_OK) return ctx->out->error;
+
+    /* Build INSERT prefix on first row; the DDL goes to the first file */
+    if (!ctx->header_written) {
+        sql_use_shard(ctx, 0);
+        build_insert_prefix(ctx, schema, table, col_count, col_names, ctx->dbms_type);
+        split->fresh[0] = 0;
+    }
+
+    /* Route the row; a full part gets its statements closed first */
+    k = odv_split_pick(split, schema, table, col_count, col_names, col_values, NULL);
+    sql_use_shard(ctx, k);
+    if (odv_split_due(split, k)) {
+        sql_end_batch(ctx);
+        sql_commit(ctx);
+        odv_split_rotate(split, k);
+    }
+    if (split->fresh[k]) {
+        split->fresh[k] = 0;
+        write_comment_header(ctx, schema, table);
+    }
+
+    /* Remember schema/table for post-parse index output */
+    if (schema) odv_strcpy(ctx->last_schema, schema, 128);
+    if (table) odv_strcpy(ctx->last_table, table, 128);
+
+    sql_begin_txn(ctx);
+
+    if (ctx->batch_rows <= 1) {
+        /* One INSERT statement per row */
+        odv_out_puts(ctx->out, ctx->insert_prefix);
+        sql_write_values(ctx, col_count, col_values);
+        odv_out_puts(ctx->out, ");\n");
+    } else if (ctx->dbms_type == DBMS_ORACLE) {
+        /* INSERT ALL INTO ... INTO ... SELECT 1 FROM DUAL */
+        if (ctx->batch_pending == 0) odv_out_puts(ctx->out, "INSERT ALL\n");
+        odv_out_puts(ctx->out, "  INTO");
+        odv_out_puts(ctx->out, ctx->insert_prefix + SQL_INSERT_INTO_LEN);
+        sql_write_values(ctx, col_count, col_values);
+        odv_out_puts(ctx->out, ")\n");
+    } else {
+        /* INSERT INTO ... VALUES (...), (...), ... */
+        if (ctx->batch_pending == 0) {
+            odv_out_write(ctx->out, ctx->insert_prefix, (int)strlen(ctx->insert_prefix) - 2);
+            odv_out_putc(ctx->out, '\n');
         } else {
-            sql_write_string(ctx->fp, col_values[i]);
+            odv_out_puts(ctx->out, ",\n");
         }
+        odv_out_putc(ctx->out, '(');
+        sql_write_values(ctx, col_count, col_values);
+        odv_out_putc(ctx->out, ')');
     }
 
-    fputs(");\n", ctx->fp);
+    if (ctx->batch_rows > 1 && ++ctx->batch_pending >= ctx->batch_rows)
+        sql_end_batch(ctx);
+    if (ctx->txn_open && ++ctx->txn_rows >= ctx->commit_rows)
+        sql_commit(ctx);
+
+    split->rows[k]++;
     ctx->row_count++;
 
     /* Report progress periodically (every 100 rows) */
-    if (ctx->session && ctx->session->progress_cb && (ctx->row_count % 100) == 0) {
+    if (ctx->progress && ctx->session->progress_cb && (ctx->row_count % 100) == 0) {
         ctx->session->progress_cb(ctx->row_count, table, ctx->session->progress_ud);
     }
+    return ODV_OK;
 }
 
 /*---------------------------------------------------------------------------
-    write_sql_file
+    sql_row_callback
+ ---------------------------------------------------------------------------*/
+static void ODV_CALL sql_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    void *user_data)
+{
+    SQL_CONTEXT *ctx = (SQL_CONTEXT *)user_data;
 
-    Exports a table to SQL INSERT statements.
+    if (!ctx || !ctx->out || !ctx->split) return;
+
+    /* Stop parsing once the output cannot take more */
+    if (sql_put_row(ctx, schema, table, col_count, col_names, col_values) != ODV_OK)
+        ctx->session->cancelled = 1;
+}
+
+/* Sets up ctx for an export into the open split.  On failure the split
+   is closed. */
+static int sql_init_context(SQL_CONTEXT *ctx, ODV_SESSION *s, const char *table_name,
+                            ODV_SPLIT *split, int dbms_type)
+{
+    ctx->shard_state = (SQL_SHARD_STATE *)calloc((size_t)split->shards, sizeof(SQL_SHARD_STATE));
+    if (!ctx->shard_state) {
+        odv_split_close(split);
+        return ODV_ERROR_MALLOC;
+    }
+
+    ctx->split = split;
+    ctx->shard = 0;
+    ctx->out = &split->files[0];
+
+    ctx->row_count = 0;
+    ctx->target_table = table_name;
+    ctx->dbms_type = dbms_type;
+    ctx->header_written = 0;
+    ctx->insert_prefix[0] = '\0';
+    ctx->batch_rows = s->sql_batch_rows > 1 ? s->sql_batch_rows : 1;
+    if (dbms_type == DBMS_SQLSERVER && ctx->batch_rows > SQL_SERVER_MAX_ROWS)
+        ctx->batch_rows = SQL_SERVER_MAX_ROWS;
+    ctx->commit_rows = s->sql_commit_rows > 0 ? s->sql_commit_rows : 0;
+    ctx->batch_pending = 0;
+    ctx->txn_rows = 0;
+    ctx->txn_open = 0;
+    ctx->session = s;
+    ctx->create_table = s->sql_create_table;
+    ctx->create_index = s->sql_create_index;
+    ctx->write_comments = s->sql_write_comments;
+    ctx->last_schema[0] = '\0';
+    ctx->last_table[0] = '\0';
+    ctx->progress = 1;
+    return ODV_OK;
+}
+
+/* Ends the open statements, adds the post-data DDL and closes the
+   output; rc is the parse result.  Returns the export result. */
+static int sql_finish(ODV_SESSION *s, SQL_CONTEXT *ctx, int rc)
+{
+    int close_rc, k;
+
+    /* Close the last batch and transaction of every shard */
+    for (k = ctx->split->shards - 1; k >= 0; k--) {
+        sql_use_shard(ctx, k);
+        sql_end_batch(ctx);
+        sql_commit(ctx);
+    }
+
+    /* Write CREATE INDEX and COMMENT ON after parse completes
+       (EXP has INDEX/COMMENT DDL after data records), to the last
+       part of the first file */
+    if (ctx->header_written && ctx->last_table[0]) {
+        if (ctx->create_index)
+            write_indexes(ctx, ctx->last_schema, ctx->last_table, ctx->dbms_type);
+        if (ctx->write_comments)
+            write_comments(ctx, ctx->last_schema, ctx->last_table, ctx->dbms_type);
+    }
+
+    close_rc = odv_split_close(ctx->split);
+    if (close_rc != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        if (close_rc == ODV_ERROR_EPIPE) {
+            odv_strcpy(s->last_error, "SQL output closed by the reader", ODV_MSG_LEN);
+            rc = ODV_ERROR_EPIPE;
+        } else {
+            odv_strcpy(s->last_error, "Cannot write SQL output file", ODV_MSG_LEN);
+            rc = ODV_ERROR_FWRITE;
+        }
+    }
+    free(ctx->shard_state);
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    export_sql
+
+    Exports a table to SQL INSERT statements in the open split, then
+    closes it.
  ---------------------------------------------------------------------------*/
-int write_sql_file(ODV_SESSION *s, const char *table_name,
-                   const char *output_path, int dbms_type)
+static int export_sql(ODV_SESSION *s, const char *table_name, ODV_SPLIT *split, int dbms_type)
 {
     SQL_CONTEXT ctx;
     ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
     void *saved_ud;
     int rc;
 
-    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
-
-    ctx.fp = fopen(output_path, "wb");
-    if (!ctx.fp) {
-        odv_strcpy(s->last_error, "Cannot create SQL output file", ODV_MSG_LEN);
-        return ODV_ERROR_FOPEN;
-    }
-
-    ctx.row_count = 0;
-    ctx.target_table = table_name;
-    ctx.dbms_type = dbms_type;
-    ctx.header_written = 0;
-    ctx.insert_prefix[0] = '\0';
-    ctx.session = s;
-    ctx.create_table = s->sql_create_table;
-    ctx.create_index = s->sql_create_index;
-    ctx.write_comments = s->sql_write_comments;
-    ctx.last_schema[0] = '\0';
-    ctx.last_table[0] = '\0';
+    rc = sql_init_context(&ctx, s, table_name, split, dbms_type);
+    if (rc != ODV_OK) return rc;
 
     /* Save and replace row callback */
     saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
     saved_ud = s->row_ud;
+    s->row_span_cb = NULL;
     s->row_cb = sql_row_callback;
     s->row_ud = &ctx;
 
@@ -816,44 +1047,781 @@ int write_sql_file(ODV_SESSION *s, const char *table_name,
     if (s->dump_type == DUMP_UNKNOWN) {
         rc = detect_dump_kind(s);
         if (rc != ODV_OK) {
-            fclose(ctx.fp);
+            odv_split_close(split);
+            free(ctx.shard_state);
             s->row_cb = saved_cb;
+            s->row_span_cb = saved_span_cb;
             s->row_ud = saved_ud;
             return rc;
         }
     }
 
-    switch (s->dump_type) {
-    case DUMP_EXPDP:
-        rc = parse_expdp_dump(s, 0);
-        break;
-    case DUMP_EXPDP_COMPRESS:
-        odv_strcpy(s->last_error, "Compressed EXPDP dumps are not supported", ODV_MSG_LEN);
-        rc = ODV_ERROR_UNSUPPORTED;
+    rc = odv_run_parse(s, 0);
+
+    /* A failed write cancels the parse (see sql_row_callback) */
+    rc = sql_finish(s, &ctx, rc);
+
+    /* Restore original callback */
+    s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
+    s->row_ud = saved_ud;
+
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    write_sql_file
+
+    Exports a table to SQL INSERT statements in a file, or in its parts /
+    shards (odv_set_output_split, odv_set_output_shards).
+ ---------------------------------------------------------------------------*/
+int write_sql_file(ODV_SESSION *s, const char *table_name,
+                   const char *output_path, int dbms_type)
+{
+    ODV_SPLIT split;
+    int rc;
+
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+
+    rc = odv_split_open(&split, s, output_path);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, (rc == ODV_ERROR_FOPEN) ? "Cannot create SQL output file"
+                                                          : "Cannot start output compression",
+                   ODV_MSG_LEN);
+        return rc;
+    }
+    return export_sql(s, table_name, &split, dbms_type);
+}
+
+/*---------------------------------------------------------------------------
+    write_sql_sink
+
+    Exports to an opened descriptor / callback sink, which it closes.
+ ---------------------------------------------------------------------------*/
+int write_sql_sink(ODV_SESSION *s, const char *table_name, ODV_OUTBUF *out, int dbms_type)
+{
+    ODV_SPLIT split;
+    int rc;
+
+    if (!s || !out) return ODV_ERROR_INVALID_ARG;
+
+    rc = odv_split_attach(&split, s, out);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, "Cannot start output compression", ODV_MSG_LEN);
+        return rc;
+    }
+    return export_sql(s, table_name, &split, dbms_type);
+}
+
+/*---------------------------------------------------------------------------
+    sql_tee_open
+
+    Opens a SQL output of a tee export (odv_tee.c).
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    SQL_CONTEXT ctx;
+    ODV_SPLIT   split;
+} SQL_TEE_SINK;
+
+static int sql_sink_row(void *sink_ctx, const char *schema, const char *table,
+                        int col_count, const char **col_names, const char **col_values,
+                        const int *col_lengths)
+{
+    (void)col_lengths;      /* Values are NUL-terminated */
+    return sql_put_row(&((SQL_TEE_SINK *)sink_ctx)->ctx, schema, table, col_count,
+                       col_names, col_values);
+}
+
+static int sql_sink_close(void *sink_ctx, int rc)
+{
+    SQL_TEE_SINK *t = (SQL_TEE_SINK *)sink_ctx;
+
+    rc = sql_finish(t->ctx.session, &t->ctx, rc);
+    free(t);
+    return rc;
+}
+
+int sql_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                 int dbms_type, ODV_TEE_SINK *sink)
+{
+    SQL_TEE_SINK *t;
+    int rc;
+
+    t = (SQL_TEE_SINK *)malloc(sizeof(SQL_TEE_SINK));
+    if (!t) return ODV_ERROR_MALLOC;
+
+    rc = odv_split_open(&t->split, s, output_path);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, (rc == ODV_ERROR_FOPEN) ? "Cannot create SQL output file"
+                                                          : "Cannot start output compression",
+                   ODV_MSG_LEN);
+        free(t);
+        return rc;
+    }
+    rc = sql_init_context(&t->ctx, s, table_name, &t->split, dbms_type);
+    if (rc != ODV_OK) {
+        free(t);
+        return rc;
+    }
+    t->ctx.progress = 0;        /* Reported by the tee */
+
+    sink->ctx = t;
+    sink->raw = 0;
+    sink->row = sql_sink_row;
+    sink->close = sql_sink_close;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    PostgreSQL COPY output
+
+    Text format : a psql script.  Per table the optional DDL, then
+                  COPY ... FROM stdin; with tab-separated rows, \N for NULL
+                  and backslash escapes, ended by "\.".
+    Binary      : a PGCOPY file for the first table (header, int16 field
+                  count + int32-length-prefixed fields per row, -1 trailer)
+                  plus a "<output>.sql" script with the DDL and \copy.
+
+    The dump is parsed with s->raw_values set, so NUMBER, DATE/TIMESTAMP,
+    BINARY_FLOAT/DOUBLE, INTERVAL and RAW columns arrive as Oracle wire
+    bytes.  Binary fields are encoded straight from those; text fields are
+    decoded into a stack buffer.
+ ---------------------------------------------------------------------------*/
+
+/* PostgreSQL column classes (from the mapped column type) */
+#define PG_TEXT         0
+#define PG_NUMERIC      1
+#define PG_FLOAT4       2
+#define PG_FLOAT8       3
+#define PG_TIMESTAMP    4   /* TIMESTAMP [WITH TIME ZONE] */
+#define PG_INTERVAL     5
+#define PG_BYTEA        6
+
+#define PG_EPOCH_UNIX_US  INT64_C(946684800000000)  /* 2000-01-01 in Unix microseconds */
+
+static const char pgcopy_signature[11] = { 'P', 'G', 'C', 'O', 'P', 'Y', '\n', '\377', '\r', '\n', '\0' };
+
+typedef struct {
+    ODV_OUTBUF   out;
+    ODV_SESSION *session;
+    const char  *target_table;
+    const char  *output_path;
+    int          binary;
+    int          header_written;
+    int          in_copy;             /* Text: a COPY block is open */
+    int64_t      row_count;
+    unsigned char *pg_class;          /* PG_* per column */
+    int          class_alloc;
+    ODV_DATE_PROG date_prog;          /* Text form of DATE/TIMESTAMP */
+    char         last_schema[129];
+    char         last_table[129];
+} PGCOPY_CONTEXT;
+
+static int pg_column_class(const char *pg_type)
+{
+    if (strncmp(pg_type, "NUMERIC", 7) == 0)          return PG_NUMERIC;
+    if (strcmp(pg_type, "REAL") == 0)                 return PG_FLOAT4;
+    if (strcmp(pg_type, "DOUBLE PRECISION") == 0)     return PG_FLOAT8;
+    if (strncmp(pg_type, "TIMESTAMP", 9) == 0)        return PG_TIMESTAMP;
+    if (strcmp(pg_type, "INTERVAL") == 0)             return PG_INTERVAL;
+    if (strcmp(pg_type, "BYTEA") == 0)                return PG_BYTEA;
+    return PG_TEXT;
+}
+
+/* Classes of the current table's columns, from the CREATE TABLE mapping */
+static int pg_build_classes(PGCOPY_CONTEXT *ctx, int col_count)
+{
+    ODV_SESSION *s = ctx->session;
+    char type_buf[SQL_TYPE_LEN];
+    int i;
+
+    if (col_count > ctx->class_alloc) {
+        unsigned char *p = (unsigned char *)realloc(ctx->pg_class, (size_t)col_count);
+        if (!p) return ODV_ERROR_MALLOC;
+        ctx->pg_class = p;
+        ctx->class_alloc = col_count;
+    }
+    for (i = 0; i < col_count; i++) {
+        ctx->pg_class[i] = PG_TEXT;
+        if (i < s->table.col_count && s->table.columns[i].type_str[0])
+            ctx->pg_class[i] = (unsigned char)pg_column_class(
+                map_oracle_to_target_type(s->table.columns[i].type_str, DBMS_POSTGRES,
+                                          type_buf));
+    }
+    return ODV_OK;
+}
+
+static int pg_is_raw(const ODV_SESSION *s, int col)
+{
+    return col < s->table.col_count && s->plan.kernel[col] == KERN_RAW;
+}
+
+/*---------------------------------------------------------------------------
+    pg_raw_text
+
+    Text form of a KERN_RAW value other than RAW, as PostgreSQL reads it.
+    out must hold ODV_NUMBER_STR_LEN bytes.  Returns the length, or -1
+    for a value that cannot be decoded (written as NULL).
+ ---------------------------------------------------------------------------*/
+static int pg_raw_text(PGCOPY_CONTEXT *ctx, int col, const unsigned char *data, int len,
+                       char *out)
+{
+    const ODV_COLDESC *d = &ctx->session->table.desc[col];
+    int n;
+
+    switch (d->type) {
+    case COL_NUMBER:
+    case COL_FLOAT:
+        return decode_oracle_number(data, len, out, ODV_NUMBER_STR_LEN);
+    case COL_BIN_FLOAT:
+    case COL_BIN_DOUBLE:
+        if (len < (d->type == COL_BIN_FLOAT ? 4 : 8)) return -1;
+        n = (d->type == COL_BIN_FLOAT) ? decode_binary_float(data, out, ODV_NUMBER_STR_LEN)
+                                       : decode_binary_double(data, out, ODV_NUMBER_STR_LEN);
+        if (n > 0 && strcmp(out + (out[0] == '-'), "Inf") == 0) {
+            memcpy(out + n, "inity", 6);    /* "Infinity" / "-Infinity" */
+            n += 5;
+        }
+        return n;
+    case COL_INTERVAL_YM:
+        return decode_interval_ym(data, len, out, ODV_NUMBER_STR_LEN);
+    case COL_INTERVAL_DS:
+        return decode_interval_ds(data, len, out, ODV_NUMBER_STR_LEN);
+    case COL_DATE:
+        n = decode_oracle_date(data, len, out, ODV_NUMBER_STR_LEN, &ctx->date_prog);
         break;
-    case DUMP_EXP:
-    case DUMP_EXP_DIRECT:
-        rc = parse_exp_dump(s, 0);
+    case COL_TIMESTAMP:
+    case COL_TIMESTAMP_TZ:
+    case COL_TIMESTAMP_LTZ:
+        n = decode_oracle_timestamp(data, len, out, ODV_NUMBER_STR_LEN, &ctx->date_prog,
+                                    d->precision);
         break;
     default:
-        rc = ODV_ERROR_FORMAT;
+        return -1;      /* RAW is hex-encoded by the callers */
+    }
+
+    /* DATE / TIMESTAMP: BC years as "yyyy-... BC", time zones stored as UTC */
+    if (n > 0 && out[0] == '-') {
+        memmove(out, out + 1, n);
+        memcpy(out + n - 1, " BC", 4);
+        n += 2;
+    }
+    if (n > 0 && (d->type == COL_TIMESTAMP_TZ || d->type == COL_TIMESTAMP_LTZ)) {
+        memcpy(out + n, "+00", 4);
+        n += 3;
+    }
+    return n;
+}
+
+/* Decoded length of an upper/lower-case hex string, or -1 */
+static int pg_hex_len(const char *p, int n)
+{
+    int i;
+    if (n <= 0 || (n & 1)) return -1;
+    for (i = 0; i < n; i++) {
+        char c = p[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f')))
+            return -1;
+    }
+    return n / 2;
+}
+
+static int hex_nibble(char c)
+{
+    return (c <= '9') ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+
+/* RAW bytes as hex text, 64 bytes per step */
+static void pg_write_hex(ODV_OUTBUF *out, const unsigned char *data, int len)
+{
+    char tmp[128];
+    int i;
+
+    for (i = 0; i < len; i += 64) {
+        int k = (len - i < 64) ? len - i : 64;
+        odv_out_write(out, tmp, odv_hex_encode(data + i, k, tmp, 0));
+    }
+}
+
+/*---------------------------------------------------------------------------
+    Text format
+ ---------------------------------------------------------------------------*/
+
+/* Writes len bytes with COPY text escapes for \, TAB, LF and CR */
+static void pg_write_text_escaped(ODV_OUTBUF *out, const char *val, int len)
+{
+    int i, run = 0;
+
+    for (i = 0; i < len; i++) {
+        char c = val[i];
+        if (c != '\\' && c != '\t' && c != '\n' && c != '\r') continue;
+        odv_out_write(out, val + run, i - run);
+        odv_out_putc(out, '\\');
+        odv_out_putc(out, c == '\t' ? 't' : c == '\n' ? 'n' : c == '\r' ? 'r' : '\\');
+        run = i + 1;
+    }
+    odv_out_write(out, val + run, len - run);
+}
+
+static void pg_write_text_field(PGCOPY_CONTEXT *ctx, int col, const char *val, int len)
+{
+    ODV_OUTBUF *out = &ctx->out;
+    char tmp[ODV_NUMBER_STR_LEN];
+
+    if (len < 0) {
+        odv_out_write(out, "\\N", 2);
+        return;
+    }
+
+    if (pg_is_raw(ctx->session, col)) {
+        if (ctx->session->table.desc[col].type == COL_RAW) {
+            /* bytea hex input "\x..." with the backslash escaped */
+            if (ctx->pg_class[col] == PG_BYTEA) odv_out_write(out, "\\\\x", 3);
+            pg_write_hex(out, (const unsigned char *)val, len);
+            return;
+        }
+        len = pg_raw_text(ctx, col, (const unsigned char *)val, len, tmp);
+        if (len < 0) {
+            odv_out_write(out, "\\N", 2);
+            return;
+        }
+        val = tmp;
+    } else if (ctx->pg_class[col] == PG_BYTEA) {
+        /* BLOB / LONG RAW arrive hex-encoded; placeholders become NULL */
+        if (pg_hex_len(val, len) < 0) {
+            odv_out_write(out, "\\N", 2);
+            return;
+        }
+        odv_out_write(out, "\\\\x", 3);
+        odv_out_write(out, val, len);
+        return;
+    }
+
+    pg_write_text_escaped(out, val, len);
+}
+
+/*---------------------------------------------------------------------------
+    Binary format (all integers big-endian)
+ ---------------------------------------------------------------------------*/
+static void pg_put16(ODV_OUTBUF *out, int v)
+{
+    unsigned char b[2];
+    b[0] = (unsigned char)(v >> 8);
+    b[1] = (unsigned char)v;
+    odv_out_write(out, b, 2);
+}
+
+static void pg_put32(ODV_OUTBUF *out, uint32_t v)
+{
+    unsigned char b[4];
+    b[0] = (unsigned char)(v >> 24);
+    b[1] = (unsigned char)(v >> 16);
+    b[2] = (unsigned char)(v >> 8);
+    b[3] = (unsigned char)v;
+    odv_out_write(out, b, 4);
+}
+
+static void pg_put64(ODV_OUTBUF *out, uint64_t v)
+{
+    pg_put32(out, (uint32_t)(v >> 32));
+    pg_put32(out, (uint32_t)v);
+}
+
+static void pg_put_float8(ODV_OUTBUF *out, double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, 8);
+    pg_put32(out, 8);
+    pg_put64(out, bits);
+}
+
+static void pg_put_float4(ODV_OUTBUF *out, float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, 4);
+    pg_put32(out, 4);
+    pg_put32(out, bits);
+}
+
+/*---------------------------------------------------------------------------
+    pg_put_numeric
+
+    Oracle NUMBER -> numeric: base-100 mantissa digits regrouped into
+    base-10000 digits.  Digit i has weight 100^(int_pairs - 1 - i); an odd
+    base-100 power is the high half of its base-10000 group.
+ ---------------------------------------------------------------------------*/
+static void pg_put_numeric(ODV_OUTBUF *out, const unsigned char *data, int len)
+{
+    unsigned char d[24];
+    int16_t groups[16];
+    int neg, int_pairs, n, i, p0, pmin, weight, gmin, ndigits, dscale;
+
+    n = odv_number_digits(data, len, &neg, &int_pairs, d);
+    if (n == 0) {
+        pg_put32(out, 8);
+        pg_put64(out, 0);
+        return;
+    }
+
+    p0 = int_pairs - 1;
+    pmin = p0 - (n - 1);
+    weight = (p0 - (p0 & 1)) / 2;
+    gmin = (pmin - (pmin & 1)) / 2;
+    ndigits = weight - gmin + 1;
+
+    memset(groups, 0, sizeof(groups));
+    for (i = 0; i < n; i++) {
+        int p = p0 - i;
+        int g = (p - (p & 1)) / 2;
+        groups[weight - g] += (int16_t)((p & 1) ? d[i] * 100 : d[i]);
+    }
+    dscale = (pmin < 0) ? -2 * pmin - (d[n - 1] % 10 == 0) : 0;
+
+    pg_put32(out, (uint32_t)(8 + ndigits * 2));
+    pg_put16(out, ndigits);
+    pg_put16(out, weight);
+    pg_put16(out, neg ? 0x4000 : 0x0000);
+    pg_put16(out, dscale);
+    for (i = 0; i < ndigits; i++) pg_put16(out, groups[i]);
+}
+
+static void pg_write_binary_field(PGCOPY_CONTEXT *ctx, int col, const char *val, int len)
+{
+    ODV_OUTBUF *out = &ctx->out;
+    const unsigned char *data = (const unsigned char *)val;
+    int type = ctx->session->table.desc[col].type;
+    int cls = ctx->pg_class[col];
+    char tmp[ODV_NUMBER_STR_LEN];
+    int32_t months, days;
+    int64_t us;
+
+    if (len < 0) {
+        pg_put32(out, 0xFFFFFFFFu);
+        return;
+    }
+
+    if (!pg_is_raw(ctx->session, col)) {
+        if (cls == PG_BYTEA) {
+            /* BLOB / LONG RAW arrive hex-encoded; placeholders become NULL */
+            int i, n = pg_hex_len(val, len);
+            if (n < 0) {
+                pg_put32(out, 0xFFFFFFFFu);
+                return;
+            }
+            pg_put32(out, (uint32_t)n);
+            for (i = 0; i < len; i += 2)
+                odv_out_putc(out, (char)(hex_nibble(val[i]) << 4 | hex_nibble(val[i + 1])));
+            return;
+        }
+        pg_put32(out, (uint32_t)len);
+        odv_out_write(out, val, len);
+        return;
+    }
+
+    switch (cls) {
+    case PG_NUMERIC:
+        if (type == COL_NUMBER || type == COL_FLOAT) {
+            pg_put_numeric(out, data, len);
+            return;
+        }
         break;
+    case PG_FLOAT4:
+    case PG_FLOAT8:
+        if (type == COL_BIN_FLOAT || type == COL_BIN_DOUBLE) {
+            uint64_t bits;
+            double dv;
+            float fv;
+            if (len < (type == COL_BIN_FLOAT ? 4 : 8)) break;
+            bits = oracle_ieee_bits(data, type == COL_BIN_FLOAT ? 4 : 8);
+            if (type == COL_BIN_FLOAT) {
+                uint32_t b32 = (uint32_t)bits;
+                memcpy(&fv, &b32, 4);
+                dv = fv;
+            } else {
+                memcpy(&dv, &bits, 8);
+                fv = (float)dv;
+            }
+            if (cls == PG_FLOAT4) pg_put_float4(out, fv);
+            else pg_put_float8(out, dv);
+            return;
+        }
+        if (type == COL_NUMBER || type == COL_FLOAT) {
+            if (decode_oracle_number(data, len, tmp, sizeof(tmp)) <= 0) break;
+            if (cls == PG_FLOAT4) pg_put_float4(out, strtof(tmp, NULL));
+            else pg_put_float8(out, strtod(tmp, NULL));
+            return;
+        }
+        break;
+    case PG_TIMESTAMP:
+        if (type == COL_DATE || type == COL_TIMESTAMP ||
+            type == COL_TIMESTAMP_TZ || type == COL_TIMESTAMP_LTZ) {
+            if (odv_datetime_to_unix_us(data, len, ctx->session->table.desc[col].precision,
+                                        &us) != ODV_OK) break;
+            pg_put32(out, 8);
+            pg_put64(out, (uint64_t)(us - PG_EPOCH_UNIX_US));
+            return;
+        }
+        break;
+    case PG_INTERVAL:
+        if (type == COL_INTERVAL_YM || type == COL_INTERVAL_DS) {
+            if (odv_interval_parts(data, len, type == COL_INTERVAL_YM,
+                                   &months, &days, &us) != ODV_OK) break;
+            pg_put32(out, 16);
+            pg_put64(out, (uint64_t)us);
+            pg_put32(out, (uint32_t)days);
+            pg_put32(out, (uint32_t)months);
+            return;
+        }
+        break;
+    case PG_BYTEA:
+        if (type == COL_RAW) {
+            pg_put32(out, (uint32_t)len);
+            odv_out_write(out, val, len);
+            return;
+        }
+        break;
+    default:
+        /* Text column fed by a raw value (e.g. RAW without a type) */
+        if (type == COL_RAW) {
+            pg_put32(out, (uint32_t)len * 2);
+            pg_write_hex(out, data, len);
+            return;
+        }
+        len = pg_raw_text(ctx, col, data, len, tmp);
+        if (len < 0) break;
+        pg_put32(out, (uint32_t)len);
+        odv_out_write(out, tmp, len);
+        return;
     }
 
-    /* Write CREATE INDEX and COMMENT ON after parse completes
-       (EXP has INDEX/COMMENT DDL after data records) */
-    if (ctx.header_written && ctx.last_table[0]) {
-        if (ctx.create_index)
-            write_indexes(&ctx, ctx.last_schema, ctx.last_table, ctx.dbms_type);
-        if (ctx.write_comments)
-            write_comments(&ctx, ctx.last_schema, ctx.last_table, ctx.dbms_type);
+    /* Undecodable value */
+    pg_put32(out, 0xFFFFFFFFu);
+}
+
+/*---------------------------------------------------------------------------
+    Table headers
+ ---------------------------------------------------------------------------*/
+static void pg_write_comment_header(ODV_SESSION *s, ODV_OUTBUF *out,
+                                    const char *schema, const char *table)
+{
+    odv_out_printf(out, "-- Table: ");
+    if (schema && schema[0] != '\0') odv_out_printf(out, "%s.", schema);
+    odv_out_printf(out, "%s\n", table);
+    if (s->app_version[0])
+        odv_out_printf(out, "-- Generated by OraDB DUMP Viewer v%s\n\n", s->app_version);
+    else
+        odv_out_printf(out, "-- Generated by OraDB DUMP Viewer\n\n");
+}
+
+static void pg_write_target(ODV_OUTBUF *out, const char *schema, const char *table,
+                            int col_count, const char **col_names)
+{
+    int i;
+
+    if (schema && schema[0] != '\0') odv_out_printf(out, "\"%s\".", schema);
+    odv_out_printf(out, "\"%s\" (", table);
+    for (i = 0; i < col_count; i++)
+        odv_out_printf(out, i > 0 ? ", \"%s\"" : "\"%s\"", col_names[i]);
+    odv_out_putc(out, ')');
+}
+
+static void pg_write_create_table(PGCOPY_CONTEXT *ctx, ODV_OUTBUF *out, const char *schema,
+                                  const char *table, int col_count, const char **col_names)
+{
+    SQL_CONTEXT sql;
+
+    memset(&sql, 0, sizeof(sql));
+    sql.out = out;
+    sql.session = ctx->session;
+    write_create_table(&sql, schema, table, col_count, col_names, DBMS_POSTGRES);
+}
+
+/* Text: comments, DDL and COPY ... FROM stdin; */
+static void pg_begin_text_table(PGCOPY_CONTEXT *ctx, const char *schema, const char *table,
+                                int col_count, const char **col_names)
+{
+    ODV_OUTBUF *out = &ctx->out;
+
+    if (ctx->in_copy) odv_out_write(out, "\\.\n\n", 4);
+
+    pg_write_comment_header(ctx->session, out, schema, table);
+    if (ctx->session->sql_create_table)
+        pg_write_create_table(ctx, out, schema, table, col_count, col_names);
+    odv_out_printf(out, "COPY ");
+    pg_write_target(out, schema, table, col_count, col_names);
+    odv_out_printf(out, " FROM stdin;\n");
+    ctx->in_copy = 1;
+}
+
+/* Binary: "<output>.sql" with the DDL and a psql \copy of the data file
+   (read through the decompressor when the data file is compressed) */
+static void pg_write_binary_script(PGCOPY_CONTEXT *ctx, const char *schema, const char *table,
+                                   int col_count, const char **col_names)
+{
+    char path[ODV_PATH_LEN + 8];
+    ODV_OUTBUF script;
+    ODV_OUTBUF *out = &script;
+    const char *p;
+    int codec = ctx->session->out_compression;
+
+    snprintf(path, sizeof(path), "%s.sql", ctx->output_path);
+    if (odv_out_open(out, path) != ODV_OK) return;
+
+    pg_write_comment_header(ctx->session, out, schema, table);
+    if (ctx->session->sql_create_table)
+        pg_write_create_table(ctx, out, schema, table, col_count, col_names);
+    odv_out_printf(out, "\\copy ");
+    pg_write_target(out, schema, table, col_count, col_names);
+    if (codec == ODV_COMPRESS_GZIP) odv_out_puts(out, " FROM PROGRAM 'gzip -dc \"");
+    else if (codec == ODV_COMPRESS_ZSTD) odv_out_puts(out, " FROM PROGRAM 'zstd -dc \"");
+    else odv_out_puts(out, " FROM '");
+    for (p = ctx->output_path; *p; p++) {
+        if (*p == '\'') odv_out_putc(out, '\'');
+        odv_out_putc(out, *p);
     }
+    if (codec != ODV_COMPRESS_NONE) odv_out_putc(out, '"');
+    odv_out_printf(out, "' WITH (FORMAT binary)\n");
+    odv_out_close(out);
+}
 
-    fclose(ctx.fp);
+/*---------------------------------------------------------------------------
+    pgcopy_row_callback
+ ---------------------------------------------------------------------------*/
+static void ODV_CALL pgcopy_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    const int *col_lengths, void *user_data)
+{
+    PGCOPY_CONTEXT *ctx = (PGCOPY_CONTEXT *)user_data;
+    int i;
 
-    /* Restore original callback */
+    if (!ctx || !ctx->out.buf) return;
+
+    /* Filter by table name if specified */
+    if (ctx->target_table && ctx->target_table[0] != '\0') {
+        if (strcmp(table, ctx->target_table) != 0) return;
+    }
+
+    /* New table: column classes and the table header */
+    if (!ctx->header_written ||
+        strcmp(schema ? schema : "", ctx->last_schema) != 0 ||
+        strcmp(table, ctx->last_table) != 0) {
+        if (ctx->binary && ctx->header_written) return;   /* One table per PGCOPY file */
+        if (pg_build_classes(ctx, col_count) != ODV_OK) {
+            ctx->session->cancelled = 1;
+            return;
+        }
+        if (ctx->binary)
+            pg_write_binary_script(ctx, schema, table, col_count, col_names);
+        else
+            pg_begin_text_table(ctx, schema, table, col_count, col_names);
+        ctx->header_written = 1;
+        odv_strcpy(ctx->last_schema, schema ? schema : "", 128);
+        odv_strcpy(ctx->last_table, table, 128);
+    }
+
+    if (ctx->binary) {
+        pg_put16(&ctx->out, col_count);
+        for (i = 0; i < col_count; i++)
+            pg_write_binary_field(ctx, i, col_values[i], col_lengths[i]);
+    } else {
+        for (i = 0; i < col_count; i++) {
+            if (i > 0) odv_out_putc(&ctx->out, '\t');
+            pg_write_text_field(ctx, i, col_values[i], col_lengths[i]);
+        }
+        odv_out_putc(&ctx->out, '\n');
+    }
+
+    ctx->row_count++;
+
+    /* Report progress periodically (every 100 rows) */
+    if (ctx->session->progress_cb && (ctx->row_count % 100) == 0) {
+        ctx->session->progress_cb(ctx->row_count, table, ctx->session->progress_ud);
+    }
+}
+
+/*---------------------------------------------------------------------------
+    write_pgcopy_file
+
+    Exports a table (or, in text format, all tables) for PostgreSQL COPY.
+    binary: 0 = COPY text script, 1 = PGCOPY binary file + "<output>.sql"
+ ---------------------------------------------------------------------------*/
+int write_pgcopy_file(ODV_SESSION *s, const char *table_name,
+                      const char *output_path, int binary)
+{
+    PGCOPY_CONTEXT ctx;
+    ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
+    void *saved_ud;
+    int saved_raw;
+    int rc;
+
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+
+    memset(&ctx, 0, sizeof(ctx));
+    rc = odv_out_open(&ctx.out, output_path);
+    if (rc != ODV_OK) {
+        odv_strcpy(s->last_error, "Cannot create COPY output file", ODV_MSG_LEN);
+        return rc;
+    }
+    rc = odv_out_compress(&ctx.out, s->out_compression, s->out_compression_level,
+                          s->out_compression_threads);
+    if (rc != ODV_OK) {
+        odv_out_close(&ctx.out);
+        odv_strcpy(s->last_error, "Cannot start output compression", ODV_MSG_LEN);
+        return rc;
+    }
+
+    ctx.session = s;
+    ctx.target_table = table_name;
+    ctx.output_path = output_path;
+    ctx.binary = binary ? 1 : 0;
+    odv_compile_date_format(&ctx.date_prog, DATE_FMT_SLASH, NULL);
+
+    if (ctx.binary) {
+        odv_out_write(&ctx.out, pgcopy_signature, sizeof(pgcopy_signature));
+        pg_put32(&ctx.out, 0);      /* Flags */
+        pg_put32(&ctx.out, 0);      /* Header extension length */
+    }
+
+    /* Save and replace row callback; keep typed columns as wire bytes */
+    saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
+    saved_ud = s->row_ud;
+    saved_raw = s->raw_values;
+    s->row_cb = NULL;
+    s->row_span_cb = pgcopy_row_callback;
+    s->row_ud = &ctx;
+    s->raw_values = 1;
+    s->plan.valid = 0;
+
+    /* Re-parse dump */
+    s->cancelled = 0;
+    s->total_rows = 0;
+
+    /* Auto-detect dump kind if not done */
+    if (s->dump_type == DUMP_UNKNOWN)
+        rc = detect_dump_kind(s);
+
+    if (rc == ODV_OK) rc = odv_run_parse(s, 0);
+
+    if (ctx.binary)
+        pg_put16(&ctx.out, -1);     /* File trailer */
+    else if (ctx.in_copy)
+        odv_out_write(&ctx.out, "\\.\n", 3);
+
+    if (odv_out_close(&ctx.out) != ODV_OK && rc == ODV_OK) {
+        odv_strcpy(s->last_error, "Cannot write COPY output file", ODV_MSG_LEN);
+        rc = ODV_ERROR_FWRITE;
+    }
+    free(ctx.pg_class);
+
+    /* Restore original callback and decode mode */
     s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
     s->row_ud = saved_ud;
+    s->raw_values = saved_raw;
+    s->plan.valid = 0;
 
     return rc;
 }
@@ -0,0 +1,710 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_tee.c
+    One parse, several export outputs
+
+    Exports a table to every output registered with odv_add_tee_output
+    (CSV, SQL INSERTs in a chosen dialect, Parquet, Excel) from a single pass
+    over the dump.  Each output is the exporter's own writer (its
+    *_tee_open), so files are the same as exporting them one at a time.
+
+    Parquet and Excel take typed columns as Oracle wire bytes (s->raw_values);
+    when text outputs run next to them, those columns are decoded to text
+    once per row here, the way the parser's text kernels would.
+
+    Threaded mode gives every output its own thread.  Rows are copied
+    into a ring of batches; each writer works through the ring at its
+    own pace and the parser waits only when the slowest writer is a full
+    ring behind.  The ring is drained (odv_tee_sync) before the parser
+    replaces s->table, since writers read the table's columns and
+    constraints and the row metadata lives in s->meta_cache.
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+#include "odv_thread.h"
+
+#define TEE_BATCHES     8                 /* Batches in the ring */
+#define TEE_BATCH_ROWS  1024              /* A batch is handed over at ... */
+#define TEE_BATCH_BYTES (1024 * 1024)     /* ... either limit */
+#define TEE_RAW_MAX     32                /* Wire bytes of NUMBER / DATE / ... (see take_raw) */
+
+/*---------------------------------------------------------------------------
+    Tee state
+ ---------------------------------------------------------------------------*/
+
+/* Rows of one table, values copied.  Value j of row r has its wire form
+   at slot (r * col_count + j) * 2 and its text form at the next slot;
+   the two are the same bytes unless the column was decoded to text. */
+typedef struct {
+    int           rows;
+    int           col_count;
+    const char   *schema;          /* s->meta_cache, stable until the ring drains */
+    const char   *table;
+    const char  **col_names;
+    size_t       *off;             /* Offset of each value in data */
+    int          *len;             /* -1 = NULL */
+    size_t        slots;           /* Allocated off / len entries */
+    char         *data;            /* Values, each NUL-terminated */
+    size_t        data_len;
+    size_t        data_cap;
+} TEE_BATCH;
+
+typedef struct {
+    ODV_TEE      *tee;
+    int           index;
+    const char  **values;          /* Row being handed to the sink */
+    int          *lengths;
+    int           alloc;
+} TEE_WRITER;
+
+struct ODV_TEE {
+    ODV_SESSION  *session;
+    const char   *target_table;
+    ODV_TEE_SINK  sinks[ODV_MAX_TEE];
+    int           rc[ODV_MAX_TEE]; /* First error of each sink */
+    int           nsinks;
+    int           decode;          /* 1 = decode wire bytes for the text sinks */
+    int           error;           /* ODV_ERROR_* of the tee itself */
+    int64_t       rows;
+    ODV_PROGRESS_CALLBACK progress_cb;
+    void         *progress_ud;
+
+    /* Text form of the current row (decode) */
+    const char  **text_values;
+    int          *text_lengths;
+    int           text_alloc;
+    char         *text_buf;
+    size_t        text_cap;
+
+    /* Threaded mode */
+    int           threaded;
+    TEE_BATCH     batches[TEE_BATCHES];
+    int64_t       head;            /* Batches handed over */
+    int           filling;         /* batches[head % TEE_BATCHES] holds rows */
+    int64_t       tail[ODV_MAX_TEE]; /* Batches each writer is done with */
+    int           stop;
+    ODV_MUTEX     lock;
+    ODV_COND      work_cv;         /* Writers: a batch was handed over / stop */
+    ODV_COND      done_cv;         /* Parser: a writer finished a batch */
+    ODV_THREAD    threads[ODV_MAX_TEE];
+    TEE_WRITER    writers[ODV_MAX_TEE];
+    int           started;
+};
+
+/*---------------------------------------------------------------------------
+    Wire bytes -> text
+
+    Mirrors the parser's text kernels (odv_expdp.c kern_*, odv_exp.c xk_*)
+    for the columns s->raw_values leaves as wire bytes.
+ ---------------------------------------------------------------------------*/
+static int tee_is_raw(const ODV_SESSION *s, int col)
+{
+    return col < s->table.col_count && s->plan.kernel[col] == KERN_RAW;
+}
+
+/* Room the text of a wire value needs, NUL included */
+static size_t tee_text_cap(const ODV_SESSION *s, int col, int len)
+{
+    switch (s->table.desc[col].type) {
+    case COL_NUMBER:
+    case COL_FLOAT:         return ODV_NUMBER_STR_LEN;
+    case COL_DATE:
+    case COL_TIMESTAMP:
+    case COL_TIMESTAMP_TZ:
+    case COL_TIMESTAMP_LTZ: return (size_t)s->date_prog.max_len + 32;
+    case COL_BIN_FLOAT:
+    case COL_BIN_DOUBLE:    return 32;
+    case COL_INTERVAL_YM:
+    case COL_INTERVAL_DS:   return 40;
+    default:                return (size_t)len * 2 + 3;   /* "0x" + hex */
+    }
+}
+
+/* Decodes one wire value into out (tee_text_cap bytes).  Returns the
+   text length, or -1 for a value the kernel would leave NULL. */
+static int tee_raw_text(ODV_SESSION *s, int col, const char *val, int len, char *out)
+{
+    const ODV_COLDESC *d = &s->table.desc[col];
+    int expdp = (s->dump_type == DUMP_EXPDP);
+    int cap = (int)tee_text_cap(s, col, len);
+    unsigned char raw[TEE_RAW_MAX];
+    const unsigned char *p = (const unsigned char *)val;
+    const char *text;
+    int n;
+
+    if (d->type == COL_RAW) {
+        /* EXPDP writes bare hex, EXP "0x" + hex */
+        if (expdp && len <= 0) {
+            out[0] = '\0';
+            return 0;
+        }
+        n = 0;
+        if (!expdp) {
+            memcpy(out, "0x", 2);
+            n = 2;
+        }
+        n += odv_hex_encode(p, len, out + n, 0);
+        out[n] = '\0';
+        return n;
+    }
+
+    /* EXPDP decodes a zero-padded copy of at most TEE_RAW_MAX bytes */
+    if (expdp || len < TEE_RAW_MAX) {
+        if (len > TEE_RAW_MAX) len = TEE_RAW_MAX;
+        memset(raw, 0, sizeof(raw));
+        memcpy(raw, val, (size_t)len);
+        p = raw;
+    }
+
+    switch (d->type) {
+    case COL_NUMBER:
+    case COL_FLOAT:
+        n = decode_oracle_number(p, len, out, cap);
+        break;
+    case COL_DATE:
+        n = decode_oracle_date_memo(s, col, p, len, &text);
+        if (n >= 0) {
+            memcpy(out, text, (size_t)n);
+            break;
+        }
+        n = decode_oracle_date(p, len, out, cap, &s->date_prog);
+        break;
+    case COL_TIMESTAMP:
+    case COL_TIMESTAMP_TZ:
+    case COL_TIMESTAMP_LTZ:
+        n = decode_oracle_timestamp(p, len, out, cap, &s->date_prog, d->precision);
+        break;
+    case COL_BIN_FLOAT:
+        n = decode_binary_float(p, out, cap);
+        break;
+    case COL_BIN_DOUBLE:
+        n = decode_binary_double(p, out, cap);
+        break;
+    case COL_INTERVAL_YM:
+        n = decode_interval_ym(p, len, out, cap);
+        break;
+    case COL_INTERVAL_DS:
+        n = decode_interval_ds(p, len, out, cap);
+        break;
+    default:
+        n = -1;
+        break;
+    }
+    if (n >= 0) out[n] = '\0';
+    return n;
+}
+
+/* Fills tee->text_values / text_lengths with the text form of the row */
+static int tee_decode_row(ODV_TEE *tee, int col_count, const char **col_values,
+                          const int *col_lengths)
+{
+    ODV_SESSION *s = tee->session;
+    size_t need = 0, pos = 0;
+    int i;
+
+    if (col_count > tee->text_alloc) {
+        int alloc = tee->text_alloc ? tee->text_alloc : 64;
+        const char **v;
+        int *l;
+        while (alloc < col_count) alloc *= 2;
+        v = (const char **)realloc((void *)tee->text_values, (size_t)alloc * sizeof(char *));
+        if (v) tee->text_values = v;
+        l = (int *)realloc(tee->text_lengths, (size_t)alloc * sizeof(int));
+        if (l) tee->text_lengths = l;
+        if (!v || !l) return ODV_ERROR_MALLOC;
+        tee->text_alloc = alloc;
+    }
+
+    for (i = 0; i < col_count; i++) {
+        if (col_lengths[i] >= 0 && tee_is_raw(s, i))
+            need += tee_text_cap(s, i, col_lengths[i]);
+    }
+    if (need > tee->text_cap) {
+        char *p = (char *)realloc(tee->text_buf, need);
+        if (!p) return ODV_ERROR_MALLOC;
+        tee->text_buf = p;
+        tee->text_cap = need;
+    }
+
+    /* Offsets first: text_buf is final only after the sizing pass */
+    for (i = 0; i < col_count; i++) {
+        tee->text_values[i] = col_values[i];
+        tee->text_lengths[i] = col_lengths[i];
+        if (col_lengths[i] >= 0 && tee_is_raw(s, i)) {
+            char *out = tee->text_buf + pos;
+            int n = tee_raw_text(s, i, col_values[i], col_lengths[i], out);
+            pos += tee_text_cap(s, i, col_lengths[i]);
+            tee->text_values[i] = (n >= 0) ? out : "";
+            tee->text_lengths[i] = n;
+        }
+    }
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Writer threads
+ ---------------------------------------------------------------------------*/
+
+/* Hands row r of a batch to writer w's sink */
+static int tee_batch_row(TEE_WRITER *w, const TEE_BATCH *b, int r)
+{
+    ODV_TEE_SINK *sink = &w->tee->sinks[w->index];
+    size_t base = (size_t)r * (size_t)b->col_count * 2 + (sink->raw ? 0 : 1);
+    int j;
+
+    if (b->col_count > w->alloc) {
+        const char **v = (const char **)realloc((void *)w->values,
+                                                (size_t)b->col_count * sizeof(char *));
+        int *l;
+        if (v) w->values = v;
+        l = (int *)realloc(w->lengths, (size_t)b->col_count * sizeof(int));
+        if (l) w->lengths = l;
+        if (!v || !l) return ODV_ERROR_MALLOC;
+        w->alloc = b->col_count;
+    }
+    for (j = 0; j < b->col_count; j++) {
+        w->values[j] = b->data + b->off[base + (size_t)j * 2];
+        w->lengths[j] = b->len[base + (size_t)j * 2];
+    }
+    return sink->row(sink->ctx, b->schema, b->table, b->col_count, b->col_names,
+                     w->values, w->lengths);
+}
+
+static ODV_THREAD_FUNC(tee_worker)
+{
+    TEE_WRITER *w = (TEE_WRITER *)arg;
+    ODV_TEE *tee = w->tee;
+    int i = w->index;
+
+    odv_lock(&tee->lock);
+    for (;;) {
+        const TEE_BATCH *b;
+        int r, rc;
+
+        while (!tee->stop && tee->tail[i] == tee->head)
+            odv_wait(&tee->work_cv, &tee->lock);
+        if (tee->tail[i] == tee->head) break;
+        b = &tee->batches[tee->tail[i] % TEE_BATCHES];
+        rc = tee->rc[i];
+        odv_unlock(&tee->lock);
+
+        /* A failed sink keeps pace without writing */
+        for (r = 0; r < b->rows && rc == ODV_OK; r++)
+            rc = tee_batch_row(w, b, r);
+
+        odv_lock(&tee->lock);
+        tee->rc[i] = rc;
+        tee->tail[i]++;
+        odv_signal(&tee->done_cv);
+    }
+    odv_unlock(&tee->lock);
+    return 0;
+}
+
+/* Oldest batch some writer still needs; called with the lock held */
+static int64_t tee_min_tail(const ODV_TEE *tee)
+{
+    int64_t t = tee->head;
+    int i;
+
+    for (i = 0; i < tee->nsinks; i++)
+        if (tee->tail[i] < t) t = tee->tail[i];
+    return t;
+}
+
+/* Hands the batch being filled to the writers */
+static void tee_submit(ODV_TEE *tee)
+{
+    int i, live = 0;
+
+    if (!tee->filling) return;
+    tee->filling = 0;
+    odv_lock(&tee->lock);
+    tee->head++;
+    odv_broadcast(&tee->work_cv);
+    for (i = 0; i < tee->nsinks; i++)
+        if (tee->rc[i] == ODV_OK) live++;
+    odv_unlock(&tee->lock);
+
+    /* Nothing left to write to */
+    if (live == 0) tee->session->cancelled = 1;
+}
+
+/* Waits until every writer has finished every handed-over batch */
+static void tee_drain(ODV_TEE *tee)
+{
+    tee_submit(tee);
+    odv_lock(&tee->lock);
+    while (tee_min_tail(tee) < tee->head)
+        odv_wait(&tee->done_cv, &tee->lock);
+    odv_unlock(&tee->lock);
+}
+
+static int tee_batch_reserve(TEE_BATCH *b, size_t slots, size_t bytes)
+{
+    if (slots > b->slots) {
+        size_t n = b->slots ? b->slots : 4096;
+        size_t *o;
+        int *l;
+        while (n < slots) n *= 2;
+        o = (size_t *)realloc(b->off, n * sizeof(size_t));
+        if (o) b->off = o;
+        l = (int *)realloc(b->len, n * sizeof(int));
+        if (l) b->len = l;
+        if (!o || !l) return ODV_ERROR_MALLOC;
+        b->slots = n;
+    }
+    if (bytes > b->data_cap) {
+        size_t n = b->data_cap ? b->data_cap : TEE_BATCH_BYTES + 65536;
+        char *p;
+        while (n < bytes) n *= 2;
+        p = (char *)realloc(b->data, n);
+        if (!p) return ODV_ERROR_MALLOC;
+        b->data = p;
+        b->data_cap = n;
+    }
+    return ODV_OK;
+}
+
+static void tee_batch_put(TEE_BATCH *b, size_t slot, const char *val, int len)
+{
+    b->off[slot] = b->data_len;
+    b->len[slot] = len;
+    if (len > 0) memcpy(b->data + b->data_len, val, (size_t)len);
+    b->data_len += (len > 0 ? (size_t)len : 0);
+    b->data[b->data_len++] = '\0';
+}
+
+/* Copies one row (wire and text forms) into the batch being filled */
+static int tee_queue_row(ODV_TEE *tee, const char *schema, const char *table,
+                         int col_count, const char **col_names,
+                         const char **raw_values, const int *raw_lengths,
+                         const char **text_values, const int *text_lengths)
+{
+    TEE_BATCH *b = &tee->batches[tee->head % TEE_BATCHES];
+    size_t bytes = 0, slot;
+    int j;
+
+    /* One table per batch */
+    if (tee->filling && (b->schema != schema || b->table != table ||
+                        b->col_count != col_count || b->col_names != col_names)) {
+        tee_submit(tee);
+        b = &tee->batches[tee->head % TEE_BATCHES];
+    }
+
+    /* Starting a batch: wait for its slot to be free */
+    if (!tee->filling) {
+        odv_lock(&tee->lock);
+        while (tee->head - tee_min_tail(tee) >= TEE_BATCHES)
+            odv_wait(&tee->done_cv, &tee->lock);
+        odv_unlock(&tee->lock);
+        tee->filling = 1;
+        b->rows = 0;
+        b->data_len = 0;
+        b->schema = schema;
+        b->table = table;
+        b->col_count = col_count;
+        b->col_names = col_names;
+    }
+
+    for (j = 0; j < col_count; j++) {
+        bytes += (raw_lengths[j] > 0 ? (size_t)raw_lengths[j] : 0) + 1;
+        if (text_values[j] != raw_values[j])
+            bytes += (text_lengths[j] > 0 ? (size_t)text_lengths[j] : 0) + 1;
+    }
+    slot = (size_t)b->rows * (size_t)col_count * 2;
+    if (tee_batch_reserve(b, slot + (size_t)col_count * 2, b->data_len + bytes) != ODV_OK)
+        return ODV_ERROR_MALLOC;
+
+    for (j = 0; j < col_count; j++, slot += 2) {
+        tee_batch_put(b, slot, raw_values[j], raw_lengths[j]);
+        if (text_values[j] != raw_values[j]) {
+            tee_batch_put(b, slot + 1, text_values[j], text_lengths[j]);
+        } else {
+            b->off[slot + 1] = b->off[slot];
+            b->len[slot + 1] = b->len[slot];
+        }
+    }
+    b->rows++;
+
+    if (b->rows >= TEE_BATCH_ROWS || b->data_len >= TEE_BATCH_BYTES)
+        tee_submit(tee);
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    Row callback
+ ---------------------------------------------------------------------------*/
+static void ODV_CALL tee_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    const int *col_lengths, void *user_data)
+{
+    ODV_TEE *tee = (ODV_TEE *)user_data;
+    const char **text_values = col_values;
+    const int *text_lengths = col_lengths;
+    int i, live = 0;
+
+    if (!tee || tee->error != ODV_OK) return;
+
+    /* Filter by table name if specified */
+    if (tee->target_table && tee->target_table[0] != '\0') {
+        if (strcmp(table, tee->target_table) != 0) return;
+    }
+
+    if (tee->decode) {
+        tee->error = tee_decode_row(tee, col_count, col_values, col_lengths);
+        if (tee->error != ODV_OK) {
+            tee->session->cancelled = 1;
+            return;
+        }
+        text_values = tee->text_values;
+        text_lengths = tee->text_lengths;
+    }
+
+    if (tee->threaded) {
+        tee->error = tee_queue_row(tee, schema, table, col_count, col_names,
+                                   col_values, col_lengths, text_values, text_lengths);
+        if (tee->error != ODV_OK) {
+            tee->session->cancelled = 1;
+            return;
+        }
+    } else {
+        for (i = 0; i < tee->nsinks; i++) {
+            ODV_TEE_SINK *sink = &tee->sinks[i];
+            if (tee->rc[i] != ODV_OK) continue;
+            tee->rc[i] = sink->raw ? sink->row(sink->ctx, schema, table, col_count, col_names,
+                                               col_values, col_lengths)
+                                   : sink->row(sink->ctx, schema, table, col_count, col_names,
+                                               text_values, text_lengths);
+            if (tee->rc[i] == ODV_OK) live++;
+        }
+        /* Nothing left to write to */
+        if (live == 0) {
+            tee->session->cancelled = 1;
+            return;
+        }
+    }
+
+    /* Report progress periodically (every 100 rows) */
+    tee->rows++;
+    if (tee->progress_cb && (tee->rows % 100) == 0)
+        tee->progress_cb(tee->rows, table, tee->progress_ud);
+}
+
+/*---------------------------------------------------------------------------
+    odv_tee_sync
+
+    Called by the parsers before s->table is replaced or grown: waits
+    until the writer threads have taken every queued row.
+ ---------------------------------------------------------------------------*/
+void odv_tee_sync(ODV_SESSION *s)
+{
+    if (s && s->tee && s->tee->threaded)
+        tee_drain(s->tee);
+}
+
+/*---------------------------------------------------------------------------
+    Setup / teardown
+ ---------------------------------------------------------------------------*/
+static int tee_start_threads(ODV_TEE *tee)
+{
+    int i;
+
+    odv_mutex_init(&tee->lock);
+    odv_cond_init(&tee->work_cv);
+    odv_cond_init(&tee->done_cv);
+    for (i = 0; i < tee->nsinks; i++) {
+        tee->writers[i].tee = tee;
+        tee->writers[i].index = i;
+        if (!odv_thread_start(&tee->threads[i], tee_worker, &tee->writers[i])) break;
+        tee->started++;
+    }
+    return (tee->started == tee->nsinks) ? ODV_OK : ODV_ERROR;
+}
+
+static void tee_stop_threads(ODV_TEE *tee)
+{
+    int i;
+
+    odv_lock(&tee->lock);
+    tee->stop = 1;
+    odv_broadcast(&tee->work_cv);
+    odv_unlock(&tee->lock);
+    for (i = 0; i < tee->started; i++) {
+        odv_thread_join(tee->threads[i]);
+    }
+    odv_cond_free(&tee->work_cv);
+    odv_cond_free(&tee->done_cv);
+    odv_mutex_free(&tee->lock);
+}
+
+static void tee_free(ODV_TEE *tee)
+{
+    int i;
+
+    for (i = 0; i < TEE_BATCHES; i++) {
+        free(tee->batches[i].off);
+        free(tee->batches[i].len);
+        free(tee->batches[i].data);
+    }
+    for (i = 0; i < ODV_MAX_TEE; i++) {
+        free((void *)tee->writers[i].values);
+        free(tee->writers[i].lengths);
+    }
+    free((void *)tee->text_values);
+    free(tee->text_lengths);
+    free(tee->text_buf);
+    free(tee);
+}
+
+/* Opens the sinks of s->tee_outputs, closing the opened ones on failure */
+static int tee_open_sinks(ODV_TEE *tee, const char *table_name)
+{
+    ODV_SESSION *s = tee->session;
+    int i, rc = ODV_OK;
+
+    for (i = 0; i < s->tee_count && rc == ODV_OK; i++) {
+        const ODV_TEE_OUTPUT *o = &s->tee_outputs[i];
+        ODV_TEE_SINK *sink = &tee->sinks[tee->nsinks];
+
+        switch (o->format) {
+        case ODV_TEE_CSV:
+            rc = csv_tee_open(s, table_name, o->path, sink);
+            break;
+        case ODV_TEE_SQL:
+            rc = sql_tee_open(s, table_name, o->path, o->option, sink);
+            break;
+        case ODV_TEE_PARQUET:
+            rc = parquet_tee_open(s, table_name, o->path, sink);
+            break;
+        case ODV_TEE_XLSX:
+            rc = xlsx_tee_open(s, table_name, o->path, sink);
+            break;
+        default:
+            rc = ODV_ERROR_INVALID_ARG;
+            break;
+        }
+        if (rc == ODV_OK) tee->nsinks++;
+    }
+    if (rc != ODV_OK) {
+        char msg[ODV_MSG_LEN + 1];
+        memcpy(msg, s->last_error, sizeof(msg));
+        for (i = 0; i < tee->nsinks; i++)
+            tee->sinks[i].close(tee->sinks[i].ctx, rc);
+        memcpy(s->last_error, msg, sizeof(msg));
+        tee->nsinks = 0;
+    }
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    write_tee
+
+    Exports a table to every output of s->tee_outputs in one parse.
+    threaded: 1 = one writer thread per output
+    Returns the parse result, else the first output's error.
+ ---------------------------------------------------------------------------*/
+int write_tee(ODV_SESSION *s, const char *table_name, int threaded)
+{
+    ODV_TEE *tee;
+    ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
+    void *saved_ud;
+    int saved_raw;
+    char msg[ODV_MSG_LEN + 1];
+    int rc, i, any_raw = 0, any_text = 0, result;
+
+    if (!s) return ODV_ERROR_INVALID_ARG;
+    if (s->tee_count <= 0) {
+        odv_strcpy(s->last_error, "No tee outputs added", ODV_MSG_LEN);
+        return ODV_ERROR_INVALID_ARG;
+    }
+
+    tee = (ODV_TEE *)calloc(1, sizeof(ODV_TEE));
+    if (!tee) return ODV_ERROR_MALLOC;
+    tee->session = s;
+    tee->target_table = table_name;
+
+    rc = tee_open_sinks(tee, table_name);
+    if (rc != ODV_OK) {
+        tee_free(tee);
+        return rc;
+    }
+    for (i = 0; i < tee->nsinks; i++) {
+        if (tee->sinks[i].raw) any_raw = 1;
+        else any_text = 1;
+    }
+    tee->decode = any_raw && any_text;
+
+    if (threaded && tee->nsinks > 0) {
+        tee->threaded = 1;
+        if (tee_start_threads(tee) != ODV_OK) {
+            tee_stop_threads(tee);
+            for (i = 0; i < tee->nsinks; i++)
+                tee->sinks[i].close(tee->sinks[i].ctx, ODV_ERROR);
+            tee_free(tee);
+            odv_strcpy(s->last_error, "Cannot start tee writer threads", ODV_MSG_LEN);
+            return ODV_ERROR;
+        }
+    }
+
+    /* Save and replace row callback; the sinks stay quiet and the tee
+       reports progress once per row */
+    saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
+    saved_ud = s->row_ud;
+    saved_raw = s->raw_values;
+    tee->progress_cb = s->progress_cb;
+    tee->progress_ud = s->progress_ud;
+    s->row_cb = NULL;
+    s->row_span_cb = tee_row_callback;
+    s->row_ud = tee;
+    s->raw_values = any_raw;
+    s->plan.valid = 0;
+    s->tee = tee;
+
+    /* Re-parse dump */
+    s->cancelled = 0;
+    s->total_rows = 0;
+
+    /* Auto-detect dump kind if not done */
+    if (s->dump_type == DUMP_UNKNOWN)
+        rc = detect_dump_kind(s);
+
+    if (rc == ODV_OK) rc = odv_run_parse(s, 0);
+
+    /* Let the writers finish, then close every output */
+    if (tee->threaded) {
+        tee_drain(tee);
+        tee_stop_threads(tee);
+    }
+    if (tee->error != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        odv_strcpy(s->last_error, "Out of memory in tee export", ODV_MSG_LEN);
+        rc = tee->error;
+    }
+    result = rc;
+    msg[0] = '\0';
+    for (i = 0; i < tee->nsinks; i++) {
+        int close_rc = tee->sinks[i].close(tee->sinks[i].ctx, rc);
+        if (close_rc != rc && !msg[0]) {      /* The output's own error */
+            result = close_rc;
+            memcpy(msg, s->last_error, sizeof(msg));
+        }
+    }
+    if (msg[0]) memcpy(s->last_error, msg, sizeof(msg));
+
+    /* Restore original callback and decode mode */
+    s->tee = NULL;
+    s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
+    s->row_ud = saved_ud;
+    s->raw_values = saved_raw;
+    s->plan.valid = 0;
+
+    tee_free(tee);
+    return result;
+}
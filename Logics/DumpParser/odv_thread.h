@@ -0,0 +1,60 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_thread.h
+    Threads, mutexes and condition variables (Win32 / POSIX)
+
+    Used by the compression pool (odv_compress.c) and the threaded tee
+    export (odv_tee.c).  Include after odv_types.h.
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#ifndef ODV_THREAD_H
+#define ODV_THREAD_H
+
+#ifdef WINDOWS
+  #include <process.h>
+#else
+  #include <pthread.h>
+#endif
+
+#ifdef WINDOWS
+typedef HANDLE             ODV_THREAD;
+typedef CRITICAL_SECTION   ODV_MUTEX;
+typedef CONDITION_VARIABLE ODV_COND;
+#define ODV_THREAD_FUNC(fn)  unsigned __stdcall fn(void *arg)
+/* Start fn(arg) in *t; nonzero on success */
+#define odv_thread_start(t, fn, arg) \
+    ((*(t) = (HANDLE)_beginthreadex(NULL, 0, (fn), (arg), 0, NULL)) != NULL)
+#define odv_thread_join(t) \
+    do { WaitForSingleObject((t), INFINITE); CloseHandle(t); } while (0)
+#define odv_mutex_init(m)  InitializeCriticalSection(m)
+#define odv_mutex_free(m)  DeleteCriticalSection(m)
+#define odv_lock(m)        EnterCriticalSection(m)
+#define odv_unlock(m)      LeaveCriticalSection(m)
+#define odv_cond_init(c)   InitializeConditionVariable(c)
+#define odv_cond_free(c)   ((void)0)
+#define odv_wait(c, m)     SleepConditionVariableCS((c), (m), INFINITE)
+#define odv_signal(c)      WakeConditionVariable(c)
+#define odv_broadcast(c)   WakeAllConditionVariable(c)
+#else
+typedef pthread_t          ODV_THREAD;
+typedef pthread_mutex_t    ODV_MUTEX;
+typedef pthread_cond_t     ODV_COND;
+#define ODV_THREAD_FUNC(fn)  void *fn(void *arg)
+#define odv_thread_start(t, fn, arg) \
+    (pthread_create((t), NULL, (fn), (arg)) == 0)
+#define odv_thread_join(t) pthread_join((t), NULL)
+#define odv_mutex_init(m)  pthread_mutex_init((m), NULL)
+#define odv_mutex_free(m)  pthread_mutex_destroy(m)
+#define odv_lock(m)        pthread_mutex_lock(m)
+#define odv_unlock(m)      pthread_mutex_unlock(m)
+#define odv_cond_init(c)   pthread_cond_init((c), NULL)
+#define odv_cond_free(c)   pthread_cond_destroy(c)
+#define odv_wait(c, m)     pthread_cond_wait((c), (m))
+#define odv_signal(c)      pthread_cond_signal(c)
+#define odv_broadcast(c)   pthread_cond_broadcast(c)
+#endif
+
+#endif /* ODV_THREAD_H */
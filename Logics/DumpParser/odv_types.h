@@ -45,6 +45,7 @@
 #define ODV_ERROR_FREAD       -102
 #define ODV_ERROR_FWRITE      -103
 #define ODV_ERROR_FSEEK       -104
+#define ODV_ERROR_EPIPE       -105   /* Reader of the output pipe went away */
 #define ODV_ERROR_CANCELLED   -200
 #define ODV_ERROR_UNSUPPORTED -300
 
@@ -99,6 +100,33 @@
 #define COL_ROWID             80
 #define COL_USER_DEFINE       90
 
+/* Decode kernels (ODV_DECODE_PLAN.kernel, one per column) */
+#define KERN_TEXT              0   /* CHAR/VARCHAR2 and unknown: already in output charset */
+#define KERN_TEXT_CONV         1   /* CHAR/VARCHAR2 and unknown: dump -> output charset */
+#define KERN_NTEXT             2   /* NCHAR/NVARCHAR2 (AL16UTF16) */
+#define KERN_NUMBER            3   /* NUMBER/FLOAT */
+#define KERN_DATE              4
+#define KERN_TIMESTAMP         5   /* TIMESTAMP [WITH [LOCAL] TIME ZONE] */
+#define KERN_BIN_FLOAT         6
+#define KERN_BIN_DOUBLE        7
+#define KERN_INTERVAL_YM       8
+#define KERN_INTERVAL_DS       9
+#define KERN_HEX              10   /* RAW/ROWID */
+#define KERN_BLOB             11
+#define KERN_CLOB             12
+#define KERN_NCLOB            13
+#define KERN_BFILE            14
+#define KERN_LONG             15
+#define KERN_LONG_RAW         16
+#define KERN_RAW              17   /* Wire bytes kept as-is (s->raw_values) */
+#define KERN_COUNT            18
+
+/* Kernels whose output is plain ASCII (widened for UTF-16LE output) */
+#define KERN_ASCII_MASK      ((1u << KERN_NUMBER) | (1u << KERN_DATE) | \
+                              (1u << KERN_TIMESTAMP) | (1u << KERN_BIN_FLOAT) | \
+                              (1u << KERN_BIN_DOUBLE) | (1u << KERN_INTERVAL_YM) | \
+                              (1u << KERN_INTERVAL_DS) | (1u << KERN_HEX))
+
 /* EXP export modes */
 #define EXP_MODE_TABLE         0
 #define EXP_MODE_USER          1
@@ -120,16 +148,21 @@
 #define ODV_MSG_LEN           1024
 #define ODV_WORD_LEN          6000
 #define ODV_VARCHAR_LEN      98301   /* UTF-8 max VARCHAR2 */
+#define ODV_NUMBER_STR_LEN     320   /* Longest NUMBER text + NUL */
 #define ODV_FILE_BUF_LEN     32768
+#define ODV_OUTBUF_SIZE    1048576   /* Export output block (odv_output.c) */
+#define ODV_MAX_SHARDS         256   /* Hash-sharded export files */
+#define ODV_SHARD_KEY_LEN     1024   /* Comma-separated shard key column names */
+#define ODV_PARQUET_ROW_GROUP 131072  /* Default rows per Parquet row group */
 #define ODV_DUMP_BLOCK_LEN    4096   /* EXPDP read block size */
 #define ODV_EXP_READ_BUF_LEN 65536
 #define ODV_EXP_RECORD_LEN  6144000
 #define ODV_DDL_BUF_LEN    1048576   /* 1MB for DDL */
 #define ODV_LOB_CHUNK_LEN   131072   /* 128KB LOB chunk */
-#define ODV_MAX_TABLES        1000
-#define ODV_MAX_COLUMNS       1000
-#define ODV_MAX_CONSTRAINTS     50
+#define ODV_ROW_ARENA_LEN    65536   /* Initial row arena size */
+#define ODV_MAX_COLUMNS       4096   /* Sanity limit (Oracle extended MAX_COLUMNS) */
 #define ODV_MAX_CONSTRAINT_COLS 16
+#define ODV_CHECKPOINT_INTERVAL 10000   /* Default rows between row checkpoints */
 
 /* Table/Partition types (for ODV_TABLE_ENTRY.type) */
 #define TABLE_TYPE_TABLE              0
@@ -150,6 +183,18 @@
 #define DATE_FMT_FULL          2     /* YYYYMMDDHH24MISS */
 #define DATE_FMT_CUSTOM        3     /* Custom format string */
 
+/* Compiled date format ops (odv_compile_date_format) */
+#define DOP_LIT                0     /* Literal run */
+#define DOP_YYYY               1
+#define DOP_MM                 2
+#define DOP_DD                 3
+#define DOP_HH24               4
+#define DOP_MI                 5
+#define DOP_SS                 6
+
+#define ODV_DATE_MEMO_LEN     40     /* Longest DATE text kept in the memo */
+#define ODV_DATE_PROG_TEXT_LEN (256 * 6 + 1) /* Longest compiled format text + NUL */
+
 /* Output CSV escaping */
 #define CSV_ESCAPE_COMMA     0x04
 #define CSV_ESCAPE_NEWLINE   0x08
@@ -161,18 +206,41 @@
 #define DBMS_MYSQL             5
 #define DBMS_SQLSERVER         6
 
+/* Parquet page compression (values are the format's codec ids) */
+#define PQ_CODEC_NONE          0
+#define PQ_CODEC_SNAPPY        1
+
+/* Export output compression (odv_compress.c) */
+#define ODV_COMPRESS_NONE      0
+#define ODV_COMPRESS_GZIP      1     /* Concatenated gzip members */
+#define ODV_COMPRESS_ZSTD      2     /* Concatenated Zstandard frames */
+#define ODV_COMPRESS_MAX_THREADS 32
+
+/* Tee export outputs (odv_tee.c) */
+#define ODV_TEE_CSV            0
+#define ODV_TEE_SQL            1     /* option = DBMS_* */
+#define ODV_TEE_PARQUET        2
+#define ODV_TEE_XLSX           3
+#define ODV_MAX_TEE            8
+
 /*---------------------------------------------------------------------------
     Data Structures
  ---------------------------------------------------------------------------*/
 
-/* Column definition */
+/* Column decode descriptor.
+   Kept apart from ODV_COLUMN so that the per-row decode loop walks a
+   dense array (20 bytes per column) instead of ~1 KB of DDL metadata. */
 typedef struct {
-    char   name[ODV_OBJNAME_LEN + 1];
     int    type;                 /* COL_* constant */
     int    length;
     int    precision;
     int    scale;
     int    charset;              /* For NCHAR/NVARCHAR */
+} ODV_COLDESC;
+
+/* Column metadata (DDL, callbacks and export only) */
+typedef struct {
+    char   name[ODV_OBJNAME_LEN + 1];
     int    flags;
     int    property;
     char   type_str[64];         /* "VARCHAR2(100)" etc. */
@@ -198,12 +266,17 @@ typedef struct {
     char   index_expr[1024];                                            /* Function-based index expression (full column list text) */
 } ODV_CONSTRAINT;
 
-/* Table definition */
+/* Table definition.
+   desc/columns/constraints are grown on demand (odv_catalog.c) and keep
+   their capacity across odv_table_reset().  desc[i] and columns[i]
+   describe the same column. */
 typedef struct {
     char        schema[ODV_OBJNAME_LEN + 1];
     char        name[ODV_OBJNAME_LEN + 1];
     char        partition[ODV_OBJNAME_LEN + 1];
-    ODV_COLUMN  columns[ODV_MAX_COLUMNS];
+    ODV_COLDESC *desc;           /* Hot: read per value while decoding */
+    ODV_COLUMN *columns;         /* Cold: names, type strings, defaults, comments */
+    int         col_alloc;
     int         col_count;
     int         lob_col_count;
     int         dump_charset;
@@ -213,28 +286,28 @@ typedef struct {
     int64_t     record_count;
     int64_t     ddl_offset;      /* File position of CREATE TABLE DDL (for fast seek) */
     int         is_partition;
-    ODV_CONSTRAINT constraints[ODV_MAX_CONSTRAINTS];
+    ODV_CONSTRAINT *constraints;
+    int         constraint_alloc;
     int         constraint_count;
     char        comment[512];    /* Table comment (COMMENT ON TABLE) */
 } ODV_TABLE;
 
-/* Partition list entry (built from EXPDP dictionary table) */
-typedef struct {
-    char    schema[ODV_OBJNAME_LEN + 1];
-    char    table[ODV_OBJNAME_LEN + 1];
-    char    partition[ODV_OBJNAME_LEN + 1];
-    char    subpartition[ODV_OBJNAME_LEN + 1];
-    int     partition_no;        /* PROCESS_ORDER from dictionary */
-    int64_t row_count;           /* COMPLETED_ROWS from dictionary */
-} ODV_PARTITION_ENTRY;
-
 /* Lightweight constraint entry for EXPDP metadata (name-only, no column info) */
 typedef struct {
     char    name[ODV_OBJNAME_LEN + 1];
     int     type;                /* CONSTRAINT_PK/UNIQUE/FK/INDEX etc. */
 } ODV_CONSTRAINT_NAME;
 
-#define ODV_MAX_META_CONSTRAINTS 20  /* Max constraints per table in table_list */
+/* Row checkpoint: resume point recorded every checkpoint_interval rows
+   while a table is first scanned (list_tables).  Taken at a record
+   boundary, so only the state carried across records is kept. */
+typedef struct {
+    int64_t row_no;              /* Rows preceding this position (0-based) */
+    int64_t offset;              /* File position of the next record */
+    int     seg_remaining;       /* EXPDP: bytes left in current 3c segment */
+    int     is_between_record;   /* EXPDP: 1=at least one record header seen */
+    int     filler_length;       /* EXPDP: filler bytes at 255 boundary */
+} ODV_ROW_CHECKPOINT;
 
 /* Table list entry (for list_tables) */
 typedef struct {
@@ -245,25 +318,48 @@ typedef struct {
     int     type;                /* TABLE_TYPE_* constant */
     int     col_count;
     int64_t row_count;
+    int64_t ddl_offset;          /* File position of table DDL (for fast seek) */
+    /* Row checkpoints (for odv_seek_row) */
+    ODV_ROW_CHECKPOINT *checkpoints;
+    int     checkpoint_count;
     /* EXPDP metadata (populated by master table scan) */
-    ODV_CONSTRAINT_NAME meta_constraints[ODV_MAX_META_CONSTRAINTS];
+    ODV_CONSTRAINT_NAME *meta_constraints;
     int     meta_constraint_count;
+    int     meta_constraint_alloc;
+    /* Catalog hash index links (odv_catalog.c) */
+    uint32_t hash;               /* Hash of schema + name */
+    int     hash_next;           /* Next key (first occurrence) in the same bucket */
+    int     occ_next;            /* Next entry with the same schema.name (-1=none) */
+    int     occ_last;            /* First occurrence only: last entry of the key */
+    int     occ_index;           /* 0-based occurrence number of this schema.name */
+    int     scan_cursor;         /* First occurrence only: master table scan cursor */
 } ODV_TABLE_ENTRY;
 
-/* Column value (decoded, ready for output) */
+/* Column value (decoded, ready for output).
+   data points into the owning record's row arena; it is only valid while
+   epoch matches the record's epoch (i.e. until the next reset_record). */
 typedef struct {
     int             type;
     int             is_null;
     unsigned char  *data;        /* Decoded string/binary data */
     int             data_len;
-    int             buf_size;    /* Allocated buffer size */
+    int             buf_size;    /* Size of this value's arena span */
+    int             offset;      /* Span offset within the row arena */
+    unsigned int    epoch;       /* Arena epoch the span belongs to */
+    struct _odv_record *rec;     /* Owning record */
 } ODV_VALUE;
 
-/* Record (one row of data) */
-typedef struct {
-    ODV_VALUE  *values;
-    int         col_count;
-    int         max_columns;
+/* Record (one row of data).
+   All value bytes of the current row live in one contiguous arena;
+   reset_record() releases them in O(1) by rewinding arena_used. */
+typedef struct _odv_record {
+    ODV_VALUE      *values;
+    int             col_count;
+    int             max_columns;
+    unsigned char  *arena;
+    int             arena_size;
+    int             arena_used;
+    unsigned int    epoch;
 } ODV_RECORD;
 
 /*---------------------------------------------------------------------------
@@ -318,7 +414,7 @@ typedef struct {
      * In EXPDP LOB records, column data is packed without LOB columns.
      * non_lob_map[i] gives the absolute column index for the i-th
      * non-LOB column in the binary stream. */
-    int     non_lob_map[ODV_MAX_COLUMNS];
+    const int *non_lob_map;      /* = s->plan.non_lob_cols */
     int     non_lob_count;       /* Number of entries in non_lob_map */
 
     /* Record header */
@@ -357,6 +453,155 @@ typedef struct {
     char    export_user[ODV_OBJNAME_LEN + 1]; /* Header record 1: export user/schema */
 } ODV_EXP_STATE;
 
+/* Charset-converted metadata cache.
+   Converted once per table generation, reused for all rows. */
+typedef struct {
+    char    schema[ODV_OBJNAME_LEN * 4 + 1];
+    char    name[ODV_OBJNAME_LEN * 4 + 1];
+    char    progress_name[ODV_OBJNAME_LEN * 4 + 1]; /* Always UTF-8 */
+    char   *col_name_buf;        /* col_alloc * (ODV_OBJNAME_LEN * 4 + 1) */
+    const char **col_names;
+    int     col_alloc;
+    unsigned int gen;            /* s->table_gen this cache was built for */
+    int     valid;
+} ODV_META_CACHE;
+
+/* Date format compiled once by odv_set_date_format */
+typedef struct {
+    unsigned char  op;             /* DOP_* */
+    unsigned char  len;            /* DOP_LIT: literal length */
+    unsigned short off;            /* DOP_LIT: offset into ODV_DATE_PROG.lit */
+} ODV_DATE_OP;
+
+typedef struct {
+    int            count;
+    int            custom;         /* DATE_FMT_CUSTOM: truncate to out_size */
+    int            frac;           /* TIMESTAMP appends ".fffffffff" */
+    int            min_out;        /* Smallest out_size for a built-in format */
+    int            max_len;        /* Longest text the ops can produce */
+    ODV_DATE_OP    ops[256];
+    char           lit[256];
+} ODV_DATE_PROG;
+
+/* Last DATE seen in a column and its text (decode plan) */
+typedef struct {
+    unsigned char  raw[7];
+    unsigned char  len;            /* Text length, 0 = empty */
+    char           text[ODV_DATE_MEMO_LEN];
+} ODV_DATE_MEMO;
+
+/* Per-table decode plan (odv_catalog.c).
+   Built once per table generation before the first row is decoded;
+   the row loops index it by column instead of re-deriving type,
+   charset and LOB layout per value. */
+typedef struct {
+    unsigned int   gen;            /* s->table_gen this plan was built for */
+    int            valid;
+    int            col_count;
+    int            alloc;
+    unsigned char *kernel;         /* KERN_* per column */
+    int           *lob_cols;       /* LOB stream order -> column (BLOB/CLOB/NCLOB/LONG/LONG RAW) */
+    int            lob_count;
+    int           *non_lob_cols;   /* Inline stream order -> column (all others) */
+    int            non_lob_count;
+    int           *lob_rank;       /* Column -> number of BLOB/CLOB/NCLOB columns before it */
+    int            text_src_cs;    /* Charset conversion for KERN_TEXT_CONV */
+    int            text_dst_cs;
+    int            wide;           /* text_dst_cs is UTF-16LE */
+    ODV_DATE_MEMO *date_memo;      /* Per column, used by KERN_DATE */
+} ODV_DECODE_PLAN;
+
+/* One LZ77 sequence: literals followed by a match (odv_compress.c) */
+typedef struct {
+    uint32_t       lit_len;
+    uint32_t       match_len;      /* 0 for the trailing literals */
+    uint32_t       offset;
+} ODV_LZ_SEQ;
+
+/* Match finder state and codec scratch, one per compressing thread */
+typedef struct {
+    int32_t       *head;           /* Hash -> latest position, -1 = none */
+    int32_t       *prev;           /* Position -> previous one with the same hash */
+    int            prev_cap;
+    ODV_LZ_SEQ    *seqs;
+    int            seq_cap;
+    unsigned char *scratch;        /* Codec working memory (odv_lz_scratch) */
+    size_t         scratch_cap;
+} ODV_LZ;
+
+typedef struct ODV_ZSTREAM ODV_ZSTREAM;
+
+/* Export output sink callback: takes up to len bytes and returns how many
+   it took (1..len), or 0 / negative to fail the export */
+typedef int (ODV_CALL *ODV_WRITE_CALLBACK)(const void *data, int len, void *user_data);
+
+/* Buffered export output (odv_output.c).  The sink is a file (fp), a
+   caller's descriptor (fd >= 0, left open) or a write callback. */
+typedef struct {
+    FILE          *fp;             /* Unbuffered: each flush is one write */
+    int            fd;
+    ODV_WRITE_CALLBACK write_cb;
+    void          *write_ud;
+    char          *buf;
+    int            len;
+    int            cap;
+    int            error;          /* ODV_ERROR_* once a write or block compression failed */
+    int64_t        flushed;        /* Bytes passed on so far (before compression) */
+    ODV_ZSTREAM   *z;              /* Block compressor, NULL = plain output */
+} ODV_OUTBUF;
+
+/* Append one byte (delimiters, line ends) */
+#define odv_out_putc(o, c) do { \
+    if ((o)->len >= (o)->cap) odv_out_flush(o); \
+    (o)->buf[(o)->len++] = (char)(c); \
+} while(0)
+
+/* Split / sharded export output (odv_output.c).
+   files[k] is the open part of shard k.  The exporter counts rows[k] and
+   rotates a part (odv_split_due / odv_split_rotate) once it reaches
+   max_rows rows or max_bytes bytes before compression. */
+typedef struct {
+    ODV_OUTBUF    *files;
+    int           *part;           /* Current part number per shard, from 1 */
+    int64_t       *rows;           /* Rows in the current part */
+    unsigned char *fresh;          /* 1 = part has no header yet */
+    int            shards;         /* 1 = no sharding */
+    int            numbered;       /* 1 = part names carry a part number */
+    int64_t        max_bytes;      /* 0 = no limit */
+    int64_t        max_rows;       /* 0 = no limit */
+    int            codec;          /* Compression of every part (ODV_COMPRESS_*) */
+    int            level;
+    int            threads;        /* Compressing threads per part */
+    int            error;          /* First failed rotation */
+    char           path[ODV_PATH_LEN];
+    struct _odv_session *session;  /* Shard key options, primary key */
+    int            key_valid;      /* key[] resolved for key_schema.key_table */
+    char           key_schema[ODV_OBJNAME_LEN + 1];
+    char           key_table[ODV_OBJNAME_LEN + 1];
+    int           *key;            /* Key column indexes */
+    int            key_count;      /* 0 = hash the whole row */
+    int            key_alloc;
+} ODV_SPLIT;
+
+/* One output of a tee export (odv_tee.c), opened by the exporter's
+   *_tee_open.  row returns ODV_OK or the error the output failed with;
+   close finishes the output (rc = parse result) and returns the result. */
+typedef struct {
+    void *ctx;
+    int   raw;                     /* 1 = typed columns as wire bytes (s->raw_values) */
+    int (*row)(void *ctx, const char *schema, const char *table, int col_count,
+               const char **col_names, const char **col_values, const int *col_lengths);
+    int (*close)(void *ctx, int rc);
+} ODV_TEE_SINK;
+
+typedef struct {
+    int   format;                  /* ODV_TEE_* */
+    int   option;
+    char  path[ODV_PATH_LEN];
+} ODV_TEE_OUTPUT;
+
+typedef struct ODV_TEE ODV_TEE;
+
 /* Forward declaration */
 typedef struct _odv_session ODV_SESSION;
 
@@ -370,6 +615,16 @@ typedef void (ODV_CALL *ODV_ROW_CALLBACK)(
     void *user_data
 );
 
+typedef void (ODV_CALL *ODV_ROW_SPAN_CALLBACK)(
+    const char *schema,
+    const char *table,
+    int col_count,
+    const char **col_names,
+    const char **col_values,
+    const int *col_lengths,      /* Byte length per value, -1 = NULL */
+    void *user_data
+);
+
 typedef void (ODV_CALL *ODV_PROGRESS_CALLBACK)(
     int64_t rows_processed,
     const char *current_table,
@@ -391,6 +646,18 @@ typedef void (ODV_CALL *ODV_TABLE_CALLBACK)(
     void *user_data
 );
 
+/* Arrow C Data Interface structs are defined in odv_api.h */
+struct ArrowSchema;
+struct ArrowArray;
+
+typedef void (ODV_CALL *ODV_ARROW_CALLBACK)(
+    const char *schema,
+    const char *table,
+    struct ArrowSchema *arrow_schema,
+    struct ArrowArray *batch,    /* Both owned by the callback, see odv_api.h */
+    void *user_data
+);
+
 /* Main session structure */
 struct _odv_session {
     /* Dump file info */
@@ -398,29 +665,58 @@ struct _odv_session {
     int64_t         dump_size;
     int             dump_type;       /* DUMP_EXPDP, DUMP_EXP etc. */
     int             dump_charset;
-    int             out_charset;
+    int             out_charset;     /* Row values and row callback names:
+                                        CHARSET_UTF8 or CHARSET_UTF16LE.
+                                        Catalog and exports are always UTF-8. */
 
     /* Current table being parsed */
     ODV_TABLE       table;
 
-    /* Table list */
-    ODV_TABLE_ENTRY table_list[ODV_MAX_TABLES];
+    /* Table list (grown by odv_table_list_add) */
+    ODV_TABLE_ENTRY *table_list;
     int             table_count;
+    int             table_alloc;
+
+    /* Hash index over table_list on (schema, name) */
+    int            *tbl_buckets;     /* First-occurrence entry per bucket (-1=empty) */
+    int             tbl_bucket_count; /* Power of 2 */
+    int             tbl_indexed;     /* Entries [0, tbl_indexed) are indexed */
 
-    /* Partition list (built from EXPDP dictionary) */
-    ODV_PARTITION_ENTRY partition_list[ODV_MAX_TABLES];
     int             partition_count;
 
+    /* odv_get_table_constraints_json result (grown to the entry's list) */
+    char           *constraints_json;
+    size_t          constraints_json_alloc;
+
     /* Parse state */
     ODV_PARSE_STATE state;
     ODV_EXP_STATE   exp_state;
 
     /* Record buffer (reused per row) */
     ODV_RECORD      record;
-    unsigned char   read_buf[ODV_EXP_READ_BUF_LEN];
+
+    /* Bumped whenever s->table is replaced (odv_table_changed) */
+    unsigned int    table_gen;
+
+    /* Charset-converted names of the current table (odv_record.c) */
+    ODV_META_CACHE  meta_cache;
+
+    /* Decode plan for the current table (odv_catalog.c) */
+    ODV_DECODE_PLAN plan;
+    int             raw_values;      /* 1=numeric/datetime/RAW columns keep their
+                                        Oracle bytes (KERN_RAW), for typed exports */
+
+    /* Per-column scratch arrays for table/row callbacks */
+    const char    **cb_names;
+    const char    **cb_strs;         /* col_types / col_values */
+    const char    **cb_defaults;
+    int            *cb_ints;         /* col_not_nulls / col_lengths */
+    char           *cb_name_buf;     /* Converted column names */
+    int             cb_alloc;
 
     /* Callbacks */
     ODV_ROW_CALLBACK        row_cb;
+    ODV_ROW_SPAN_CALLBACK   row_span_cb;    /* Replaces row_cb when set */
     void                   *row_ud;
     ODV_PROGRESS_CALLBACK   progress_cb;
     void                   *progress_ud;
@@ -432,6 +728,9 @@ struct _odv_session {
     char            filter_table[ODV_OBJNAME_LEN + 1];
     char            filter_partition[ODV_OBJNAME_LEN + 1]; /* Partition name filter (empty=all) */
     int             filter_active;   /* 0=no filter, 1=filter active */
+    char            filter_schema_cs[ODV_OBJNAME_LEN + 1]; /* filter_schema in dump charset */
+    char            filter_table_cs[ODV_OBJNAME_LEN + 1];  /* filter_table in dump charset */
+    int             filter_cs_valid; /* 1=filter_*_cs are current */
     int             pass_flg;        /* 1=skip current table's records */
     int64_t         seek_offset;     /* If >0, seek here after header to skip DDL scan */
 
@@ -442,6 +741,24 @@ struct _odv_session {
     /* Statistics */
     int64_t         total_rows;
 
+    /* Row checkpoints (collected for the table being scanned, moved to
+       its table_list entry by the table notification) */
+    int             checkpoint_interval;   /* Rows between checkpoints (0=off) */
+    ODV_ROW_CHECKPOINT *ckpt_buf;
+    int             ckpt_count;
+    int             ckpt_alloc;
+
+    /* Row seek (odv_seek_row) */
+    int             seek_active;     /* 1=next record parse resumes at seek_ckpt */
+    ODV_ROW_CHECKPOINT seek_ckpt;    /* Nearest checkpoint at or before seek_row */
+    int64_t         seek_row;        /* First row to deliver */
+    int64_t         skip_rows;       /* Rows still to be parsed without delivery */
+    int             keep_table_list; /* 1=do not rebuild table_list while parsing */
+    int64_t         row_limit;       /* Stop after this many delivered rows (0=all) */
+    int             limit_active;    /* 1=row_limit applies (odv_parse_dump / odv_seek_row) */
+    int64_t         rows_delivered;
+    int             limit_reached;   /* 1=parse stopped by row_limit */
+
     /* Progress tracking (file-position-based percentage with hysteresis) */
     int             last_progress_pct;  /* Last reported percentage (0-100) */
 
@@ -451,12 +768,28 @@ struct _odv_session {
     /* Export options */
     int             date_format;           /* 0=SLASH, 1=COMPACT, 2=FULL, 3=CUSTOM */
     char            custom_date_format[256]; /* Format string for DATE_FMT_CUSTOM */
+    ODV_DATE_PROG   date_prog;             /* date_format compiled */
     int             csv_write_header;      /* 1=write column header row (default:1) */
     int             csv_write_types;       /* 1=write column type row (default:0) */
     char            csv_delimiter;         /* CSV field delimiter (default ',') */
     int             sql_create_table;      /* 1=output DROP+CREATE TABLE DDL (default:1) */
     int             sql_create_index;      /* 1=output CREATE INDEX DDL (default:1) */
     int             sql_write_comments;    /* 1=output COMMENT ON DDL (default:1) */
+    int             sql_batch_rows;        /* Rows per INSERT statement (default:1) */
+    int             sql_commit_rows;       /* COMMIT every N rows, 0=none (default:0) */
+    int             parquet_row_group_rows; /* Rows per Parquet row group */
+    int             parquet_compression;   /* PQ_CODEC_* (default:SNAPPY) */
+    int             parquet_dictionary;    /* 1=dictionary-encode columns (default:1) */
+    int             out_compression;       /* ODV_COMPRESS_* for CSV / SQL / COPY (default:NONE) */
+    int             out_compression_level; /* 1-9, 0=codec default */
+    int             out_compression_threads; /* 0=one per CPU, 1=exporting thread only */
+    int64_t         split_max_bytes;       /* Rotate CSV / SQL parts at N bytes (0=off) */
+    int64_t         split_max_rows;        /* Rotate CSV / SQL parts at N rows (0=off) */
+    int             shard_count;           /* Hash-sharded CSV / SQL files (0/1=off) */
+    char            shard_keys[ODV_SHARD_KEY_LEN]; /* Shard key columns, ""=primary key */
+    ODV_TEE_OUTPUT  tee_outputs[ODV_MAX_TEE]; /* Outputs of odv_export_tee */
+    int             tee_count;
+    ODV_TEE        *tee;                   /* Running tee export, NULL = none */
 
     /* LOB extraction options */
     int             lob_extract_mode;      /* 1=extracting LOB files */
@@ -505,6 +838,9 @@ struct _odv_session {
     Internal function prototypes (cross-module)
  ---------------------------------------------------------------------------*/
 
+/* odv_api.c */
+int odv_run_parse(ODV_SESSION *s, int list_only);
+
 /* odv_detect.c */
 int detect_dump_kind(ODV_SESSION *s);
 
@@ -518,38 +854,131 @@ int parse_exp_dump(ODV_SESSION *s, int list_only);
 int  init_record(ODV_RECORD *rec, int max_cols);
 void free_record(ODV_RECORD *rec);
 void reset_record(ODV_RECORD *rec);
+int  grow_record(ODV_RECORD *rec, int needed);
 int  set_value_null(ODV_VALUE *v);
 int  set_value_string(ODV_VALUE *v, const char *str, int len);
+int  set_value_hex(ODV_VALUE *v, const char *prefix, const unsigned char *src, int len);
 int  ensure_value_buf(ODV_VALUE *v, int needed);
+char *value_text_buf(ODV_VALUE *v, int cap);
+int  commit_value_text(ODV_VALUE *v, int n);
+int  widen_value_ascii(ODV_VALUE *v);
+void trim_value_spaces(ODV_VALUE *v, int wide);
 int  deliver_row(ODV_SESSION *s);
 void odv_report_progress(ODV_SESSION *s, FILE *fp);
-void invalidate_meta_cache(void);
-void update_meta_cache(ODV_SESSION *s);
+int  update_meta_cache(ODV_SESSION *s);
+void free_meta_cache(ODV_SESSION *s);
 
 /* odv_number.c */
 int decode_oracle_number(const unsigned char *buf, int len, char *out, int out_size);
+int decode_oracle_number_batch(const unsigned char *const *bufs, const int *lens,
+                               int count, char *out, int stride, int *out_lens);
+int odv_number_to_int64(const unsigned char *buf, int len, int64_t *val);
+int odv_number_digits(const unsigned char *buf, int len, int *neg, int *int_pairs,
+                      unsigned char *digits);
+int odv_number_scaled(const unsigned char *buf, int len, int scale, unsigned char *out);
+int odv_number_type(const char *type_str, int *precision, int *scale);
 
 /* odv_datetime.c */
-int decode_oracle_date(const unsigned char *buf, int len, char *out, int out_size, int fmt, const char *custom_fmt);
-int decode_oracle_timestamp(const unsigned char *buf, int len, char *out, int out_size, int fmt, const char *custom_fmt, int ts_precision);
+void odv_compile_date_format(ODV_DATE_PROG *prog, int fmt, const char *custom_fmt);
+int decode_oracle_date(const unsigned char *buf, int len, char *out, int out_size, const ODV_DATE_PROG *prog);
+int decode_oracle_date_memo(ODV_SESSION *s, int col, const unsigned char *buf, int len, const char **text);
+int decode_oracle_timestamp(const unsigned char *buf, int len, char *out, int out_size, const ODV_DATE_PROG *prog, int ts_precision);
 int decode_binary_float(const unsigned char *buf, char *out, int out_size);
 int decode_binary_double(const unsigned char *buf, char *out, int out_size);
 int decode_interval_ym(const unsigned char *buf, int len, char *out, int out_size);
 int decode_interval_ds(const unsigned char *buf, int len, char *out, int out_size);
+uint64_t oracle_ieee_bits(const unsigned char *buf, int nbytes);
+int odv_datetime_to_unix_us(const unsigned char *buf, int len, int ts_precision, int64_t *us);
+int odv_interval_parts(const unsigned char *buf, int len, int ym,
+                       int32_t *months, int32_t *days, int64_t *us);
 
 /* odv_charset.c */
 int convert_charset(const char *src, int src_len, int src_cs,
                     char *dst, int dst_size, int dst_cs, int *out_len);
+int odv_utf16be_to_utf8(const unsigned char *src, int src_len,
+                        unsigned char *dst, int dst_cap, int *consumed);
+int odv_utf16be_to_utf16le(const unsigned char *src, int src_len,
+                           unsigned char *dst, int dst_cap, int *consumed);
+int odv_hex_encode(const unsigned char *src, int n, char *dst, int wide);
 
 /* odv_xml.c */
 typedef void (*xml_tag_callback)(const char *tag, const char *value, int depth, void *ctx);
 int parse_xml_ddl(const char *xml, int xml_len, xml_tag_callback cb, void *ctx);
 
+/* odv_output.c */
+int  odv_out_open(ODV_OUTBUF *o, const char *path);
+int  odv_out_flush(ODV_OUTBUF *o);
+void odv_out_write(ODV_OUTBUF *o, const void *p, int n);
+void odv_out_puts(ODV_OUTBUF *o, const char *str);
+void odv_out_printf(ODV_OUTBUF *o, const char *fmt, ...);
+int  odv_out_close(ODV_OUTBUF *o);
+int  odv_csv_special(const char *p, int n, char delimiter);
+int  odv_out_open_fd(ODV_OUTBUF *o, int fd);
+int  odv_out_open_callback(ODV_OUTBUF *o, ODV_WRITE_CALLBACK cb, void *user_data);
+int  odv_out_send(ODV_OUTBUF *o, const void *p, int n);
+int  odv_split_open(ODV_SPLIT *sp, ODV_SESSION *s, const char *path);
+int  odv_split_attach(ODV_SPLIT *sp, ODV_SESSION *s, ODV_OUTBUF *o);
+int  odv_split_pick(ODV_SPLIT *sp, const char *schema, const char *table, int col_count,
+                    const char **col_names, const char **col_values, const int *col_lengths);
+int  odv_split_due(const ODV_SPLIT *sp, int k);
+int  odv_split_rotate(ODV_SPLIT *sp, int k);
+int  odv_split_close(ODV_SPLIT *sp);
+
+/* odv_compress.c */
+int   odv_cpu_count(void);
+int   odv_out_compress(ODV_OUTBUF *o, int codec, int level, int threads);
+int   odv_z_flush(ODV_OUTBUF *o);
+int   odv_z_close(ODV_OUTBUF *o);
+int   odv_lz_parse(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                   int max_dist, int max_len);
+void *odv_lz_scratch(ODV_LZ *lz, size_t size);
+void  odv_lz_free(ODV_LZ *lz);
+void  odv_huffman_lengths(const uint32_t *freq, int n, int max_bits, unsigned char *len);
+int   odv_highbit32(uint32_t v);
+
+/* odv_deflate.c */
+uint32_t odv_crc32(uint32_t crc, const void *p, size_t n);
+int odv_deflate_chunk(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                      int final, unsigned char *dst, int cap);
+int odv_deflate(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                unsigned char *dst, int cap);
+int odv_gzip_member(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                    unsigned char *dst, int cap);
+
+/* odv_zstd.c */
+int odv_zstd_frame(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                   unsigned char *dst, int cap);
+
 /* odv_csv.c */
 int write_csv_file(ODV_SESSION *s, const char *table_name, const char *output_path);
+int write_csv_sink(ODV_SESSION *s, const char *table_name, ODV_OUTBUF *out);
+int csv_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                 ODV_TEE_SINK *sink);
 
 /* odv_sql.c */
 int write_sql_file(ODV_SESSION *s, const char *table_name, const char *output_path, int dbms_type);
+int write_sql_sink(ODV_SESSION *s, const char *table_name, ODV_OUTBUF *out, int dbms_type);
+int write_pgcopy_file(ODV_SESSION *s, const char *table_name, const char *output_path, int binary);
+int sql_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                 int dbms_type, ODV_TEE_SINK *sink);
+
+/* odv_parquet.c */
+int write_parquet_file(ODV_SESSION *s, const char *table_name, const char *output_path);
+int parquet_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                     ODV_TEE_SINK *sink);
+
+/* odv_tee.c */
+int  write_tee(ODV_SESSION *s, const char *table_name, int threaded);
+void odv_tee_sync(ODV_SESSION *s);
+
+/* odv_xlsx.c */
+int write_xlsx_file(ODV_SESSION *s, const char *table_name, const char *output_path);
+int xlsx_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                  ODV_TEE_SINK *sink);
+
+/* odv_arrow.c */
+int write_arrow_batches(ODV_SESSION *s, const char *table_name, int batch_rows,
+                        ODV_ARROW_CALLBACK cb, void *user_data);
 
 /* LOB helpers (odv_api.c) */
 int  odv_lob_check_column(ODV_SESSION *s);
@@ -557,4 +986,29 @@ int  odv_lob_accumulate(ODV_SESSION *s, int lob_col_idx, const unsigned char *da
 int  odv_lob_write_file(ODV_SESSION *s);
 void odv_lob_reset_buffer(ODV_SESSION *s);
 
+/* Row checkpoint helpers (odv_api.c) */
+int  odv_ckpt_add(ODV_SESSION *s, FILE *fp, const ODV_PARSE_STATE *st);
+void odv_ckpt_attach(ODV_SESSION *s, ODV_TABLE_ENTRY *e);
+int  odv_ckpt_resume(ODV_SESSION *s, FILE *fp, ODV_PARSE_STATE *st);
+
+/* odv_catalog.c */
+void             odv_table_reset(ODV_TABLE *t);
+void             odv_table_free(ODV_TABLE *t);
+ODV_COLUMN      *odv_table_column(ODV_TABLE *t, int idx);
+ODV_CONSTRAINT  *odv_table_add_constraint(ODV_TABLE *t);
+ODV_TABLE_ENTRY *odv_table_list_add(ODV_SESSION *s);
+void             odv_table_list_free(ODV_SESSION *s);
+ODV_CONSTRAINT_NAME *odv_entry_add_constraint_name(ODV_TABLE_ENTRY *e);
+int              odv_reserve_col_scratch(ODV_SESSION *s, int cols);
+void             odv_free_col_scratch(ODV_SESSION *s);
+void             odv_table_changed(ODV_SESSION *s);
+const ODV_DECODE_PLAN *odv_decode_plan(ODV_SESSION *s);
+void             odv_free_decode_plan(ODV_SESSION *s);
+int              odv_table_index_add(ODV_SESSION *s, int idx);
+int              odv_table_index_sync(ODV_SESSION *s);
+int              odv_table_index_find(ODV_SESSION *s, const char *schema, const char *name);
+void             odv_table_index_free(ODV_SESSION *s);
+void             odv_filter_prepare(ODV_SESSION *s);
+int              odv_filter_match(ODV_SESSION *s);
+
 #endif /* ODV_TYPES_H */
@@ -0,0 +1,1317 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_xlsx.c
+    Excel workbook (.xlsx) output
+
+    Streams tables into an Office Open XML workbook without holding the
+    rows in memory:
+    - Every zip entry is deflated 1MB at a time as its XML is produced
+      and closed with a data descriptor, so a worksheet is never built
+      in memory.  Zip64 records are added only when the file passes 4GB.
+    - Each table gets its own worksheet (bold header row, frozen pane).
+      A worksheet rolls over to "NAME (2)", "NAME (3)", ... at Excel's
+      1,048,576-row limit, or before its XML reaches 4GB.
+    - Short strings go to the shared string table, deduplicated through
+      a hash table; once the table reaches its size limit the remaining
+      strings are written inline, so memory stays bounded.
+
+    Oracle types map to:
+      NUMBER, FLOAT        number (text when over 15 significant digits)
+      BINARY_FLOAT/DOUBLE  number (text for NaN / Inf)
+      DATE, TIMESTAMP      date serial, yyyy-mm-dd hh:mm:ss[.000]
+                           (text before 1900-03-01 or after 9999)
+      others               text, as in the CSV output
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+#include <ctype.h>
+
+#define XL_MAX_ROWS       1048576               /* Worksheet rows, header included */
+#define XL_MAX_COLS       16384                 /* Worksheet columns (A..XFD) */
+#define XL_MAX_CHARS      32767                 /* UTF-16 units in a cell */
+#define XL_NAME_CHARS     31                    /* UTF-16 units in a sheet name */
+#define XL_NAME_LEN       128                   /* Sheet name buffer (UTF-8) */
+#define XL_CHUNK          (1024 * 1024)         /* Entry data deflated per call */
+#define XL_LEVEL          6                     /* Deflate level */
+#define XL_SHEET_BYTES    0xF0000000u           /* Worksheet XML rolls over past this */
+#define XL_SST_LEN        255                   /* Longest shared string */
+#define XL_SST_COUNT      (1024 * 1024)         /* Shared strings at most */
+#define XL_SST_BYTES      (64 * 1024 * 1024)    /* Shared string text at most */
+#define XL_DAY_US         INT64_C(86400000000)
+
+/* Cell styles (cellXfs in styles.xml) */
+#define XL_STYLE_HEADER   1
+#define XL_STYLE_DATE     2
+#define XL_STYLE_TS       3
+
+/* Cell kinds */
+#define XLK_STRING        0     /* Text as delivered */
+#define XLK_NUMBER        1     /* NUMBER / FLOAT wire bytes */
+#define XLK_DOUBLE        2     /* BINARY_FLOAT / BINARY_DOUBLE wire bytes */
+#define XLK_DATE          3     /* DATE / TIMESTAMP wire bytes */
+#define XLK_TEXT          4     /* Other wire bytes, written as their text */
+
+/* Zip record signatures */
+#define ZIP_LOCAL         0x04034b50u
+#define ZIP_DESCRIPTOR    0x08074b50u
+#define ZIP_CENTRAL       0x02014b50u
+#define ZIP_END           0x06054b50u
+#define ZIP64_END         0x06064b50u
+#define ZIP64_LOCATOR     0x07064b50u
+#define ZIP_FLAGS         0x0008        /* Sizes in the data descriptor */
+#define ZIP_DEFLATED      8
+#define ZIP_DOS_DATE      0x0021        /* 1980-01-01: output does not depend on the clock */
+
+typedef struct {
+    char     name[32];
+    int64_t  offset;            /* Local header */
+    uint32_t crc;
+    uint32_t csize;
+    uint32_t usize;
+} XL_ENTRY;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t len;
+    size_t   off;               /* In the string pool */
+} XL_STRING;
+
+typedef struct {
+    ODV_SESSION   *session;
+    const char    *target_table;
+    ODV_OUTBUF     out;
+    int64_t        pos;                 /* Bytes written to the file */
+    ODV_LZ         lz;
+    unsigned char *xml;                 /* Entry data not deflated yet */
+    int            xml_len;
+    unsigned char *comp;
+    int            comp_cap;
+    uint32_t       crc;                 /* Open entry so far */
+    int64_t        usize;
+    int64_t        csize;
+    XL_ENTRY      *entries;
+    int            entry_count;
+    int            entry_cap;
+    char         (*sheets)[XL_NAME_LEN];
+    int            sheet_count;
+    int            sheet_cap;
+    int            sheet_open;
+    int            sheet_rows;          /* Rows in the open sheet, header included */
+    int            started;
+    char           last_schema[128];
+    char           last_table[128];
+    int            col_count;           /* Columns written (at most XL_MAX_COLS) */
+    int            row_cols;            /* Columns of the table's rows */
+    unsigned char *kinds;               /* XLK_* per column */
+    char         (*refs)[4];            /* Column letters */
+    char         **names;
+    char          *text;                /* Decoded wire values */
+    int            text_cap;
+    char          *pool;                /* Shared string text */
+    size_t         pool_len;
+    size_t         pool_cap;
+    XL_STRING     *strs;
+    int            str_count;
+    int            str_cap;
+    int           *slots;               /* Hash table of strs indexes, -1 = empty */
+    int            slot_mask;
+    int64_t        sst_refs;            /* Cells referring to a shared string */
+    int64_t        total_rows;
+    int            rc;
+    int            progress;            /* 1 = report rows to progress_cb */
+} XL_CONTEXT;
+
+/*---------------------------------------------------------------------------
+    Zip container
+ ---------------------------------------------------------------------------*/
+static unsigned char *put_le16(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    return p + 2;
+}
+
+static unsigned char *put_le32(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+    return p + 4;
+}
+
+static unsigned char *put_le64(unsigned char *p, uint64_t v)
+{
+    p = put_le32(p, (uint32_t)v);
+    return put_le32(p, (uint32_t)(v >> 32));
+}
+
+static void xl_emit(XL_CONTEXT *ctx, const void *p, size_t n)
+{
+    odv_out_write(&ctx->out, p, (int)n);
+    ctx->pos += (int64_t)n;
+}
+
+/* Deflates the buffered entry data; final ends the DEFLATE stream */
+static void xl_deflate(XL_CONTEXT *ctx, int final)
+{
+    int n;
+
+    if (ctx->rc != ODV_OK) return;
+    n = odv_deflate_chunk(&ctx->lz, ctx->xml, ctx->xml_len, XL_LEVEL, final,
+                          ctx->comp, ctx->comp_cap);
+    if (n < 0) {
+        ctx->rc = n;
+        return;
+    }
+    ctx->crc = odv_crc32(ctx->crc, ctx->xml, (size_t)ctx->xml_len);
+    ctx->usize += ctx->xml_len;
+    ctx->csize += n;
+    xl_emit(ctx, ctx->comp, (size_t)n);
+    ctx->xml_len = 0;
+}
+
+static void xl_put(XL_CONTEXT *ctx, const void *p, size_t n)
+{
+    const unsigned char *src = (const unsigned char *)p;
+
+    while (n > 0 && ctx->rc == ODV_OK) {
+        size_t k = (size_t)(XL_CHUNK - ctx->xml_len);
+        if (k > n) k = n;
+        memcpy(ctx->xml + ctx->xml_len, src, k);
+        ctx->xml_len += (int)k;
+        src += k;
+        n -= k;
+        if (ctx->xml_len == XL_CHUNK) xl_deflate(ctx, 0);
+    }
+}
+
+static void xl_puts(XL_CONTEXT *ctx, const char *str)
+{
+    xl_put(ctx, str, strlen(str));
+}
+
+/* Writes the local header of a new entry; its data follows via xl_put */
+static void xl_begin_entry(XL_CONTEXT *ctx, const char *name)
+{
+    unsigned char hdr[30], *p = hdr;
+    XL_ENTRY *e;
+
+    if (ctx->rc != ODV_OK) return;
+    if (ctx->entry_count == ctx->entry_cap) {
+        int cap = ctx->entry_cap ? ctx->entry_cap * 2 : 16;
+        e = (XL_ENTRY *)realloc(ctx->entries, (size_t)cap * sizeof(XL_ENTRY));
+        if (!e) {
+            ctx->rc = ODV_ERROR_MALLOC;
+            return;
+        }
+        ctx->entries = e;
+        ctx->entry_cap = cap;
+    }
+    e = &ctx->entries[ctx->entry_count++];
+    memset(e, 0, sizeof(*e));
+    odv_strcpy(e->name, name, (int)sizeof(e->name) - 1);
+    e->offset = ctx->pos;
+
+    p = put_le32(p, ZIP_LOCAL);
+    p = put_le16(p, 20);                    /* Version needed: 2.0 */
+    p = put_le16(p, ZIP_FLAGS);
+    p = put_le16(p, ZIP_DEFLATED);
+    p = put_le16(p, 0);                     /* Time */
+    p = put_le16(p, ZIP_DOS_DATE);
+    p = put_le32(p, 0);                     /* CRC and sizes: data descriptor */
+    p = put_le32(p, 0);
+    p = put_le32(p, 0);
+    p = put_le16(p, (uint32_t)strlen(e->name));
+    put_le16(p, 0);
+    xl_emit(ctx, hdr, sizeof(hdr));
+    xl_emit(ctx, e->name, strlen(e->name));
+
+    ctx->crc = 0;
+    ctx->usize = 0;
+    ctx->csize = 0;
+    ctx->xml_len = 0;
+}
+
+/* Ends the entry's DEFLATE stream and writes its data descriptor */
+static void xl_end_entry(XL_CONTEXT *ctx)
+{
+    unsigned char dd[16], *p = dd;
+    XL_ENTRY *e;
+
+    xl_deflate(ctx, 1);
+    if (ctx->rc != ODV_OK) return;
+    e = &ctx->entries[ctx->entry_count - 1];
+    e->crc = ctx->crc;
+    e->csize = (uint32_t)ctx->csize;
+    e->usize = (uint32_t)ctx->usize;
+
+    p = put_le32(p, ZIP_DESCRIPTOR);
+    p = put_le32(p, e->crc);
+    p = put_le32(p, e->csize);
+    put_le32(p, e->usize);
+    xl_emit(ctx, dd, sizeof(dd));
+}
+
+/* Central directory and end records; zip64 only past the 32-bit limits */
+static void xl_write_directory(XL_CONTEXT *ctx)
+{
+    unsigned char rec[64], *p;
+    int64_t cd_offset = ctx->pos, cd_size;
+    int i, zip64;
+
+    for (i = 0; i < ctx->entry_count && ctx->rc == ODV_OK; i++) {
+        const XL_ENTRY *e = &ctx->entries[i];
+        int far = (e->offset >= 0xFFFFFFFF);
+        size_t name_len = strlen(e->name);
+
+        p = rec;
+        p = put_le32(p, ZIP_CENTRAL);
+        p = put_le16(p, far ? 45 : 20);     /* Version made by */
+        p = put_le16(p, far ? 45 : 20);     /* Version needed */
+        p = put_le16(p, ZIP_FLAGS);
+        p = put_le16(p, ZIP_DEFLATED);
+        p = put_le16(p, 0);
+        p = put_le16(p, ZIP_DOS_DATE);
+        p = put_le32(p, e->crc);
+        p = put_le32(p, e->csize);
+        p = put_le32(p, e->usize);
+        p = put_le16(p, (uint32_t)name_len);
+        p = put_le16(p, far ? 12 : 0);      /* Extra field */
+        p = put_le16(p, 0);                 /* Comment */
+        p = put_le16(p, 0);                 /* Disk */
+        p = put_le16(p, 0);                 /* Internal attributes */
+        p = put_le32(p, 0);                 /* External attributes */
+        p = put_le32(p, far ? 0xFFFFFFFFu : (uint32_t)e->offset);
+        xl_emit(ctx, rec, (size_t)(p - rec));
+        xl_emit(ctx, e->name, name_len);
+        if (far) {
+            p = rec;
+            p = put_le16(p, 0x0001);        /* Zip64 extended information */
+            p = put_le16(p, 8);
+            p = put_le64(p, (uint64_t)e->offset);
+            xl_emit(ctx, rec, (size_t)(p - rec));
+        }
+    }
+    cd_size = ctx->pos - cd_offset;
+
+    zip64 = (ctx->entry_count > 0xFFFF || cd_offset >= 0xFFFFFFFF || cd_size >= 0xFFFFFFFF);
+    if (zip64) {
+        int64_t end64 = ctx->pos;
+
+        p = rec;
+        p = put_le32(p, ZIP64_END);
+        p = put_le64(p, 44);                /* Size of the rest of the record */
+        p = put_le16(p, 45);
+        p = put_le16(p, 45);
+        p = put_le32(p, 0);
+        p = put_le32(p, 0);
+        p = put_le64(p, (uint64_t)ctx->entry_count);
+        p = put_le64(p, (uint64_t)ctx->entry_count);
+        p = put_le64(p, (uint64_t)cd_size);
+        p = put_le64(p, (uint64_t)cd_offset);
+        xl_emit(ctx, rec, (size_t)(p - rec));
+
+        p = rec;
+        p = put_le32(p, ZIP64_LOCATOR);
+        p = put_le32(p, 0);
+        p = put_le64(p, (uint64_t)end64);
+        p = put_le32(p, 1);                 /* Total disks */
+        xl_emit(ctx, rec, (size_t)(p - rec));
+    }
+
+    p = rec;
+    p = put_le32(p, ZIP_END);
+    p = put_le16(p, 0);
+    p = put_le16(p, 0);
+    p = put_le16(p, zip64 ? 0xFFFF : (uint32_t)ctx->entry_count);
+    p = put_le16(p, zip64 ? 0xFFFF : (uint32_t)ctx->entry_count);
+    p = put_le32(p, zip64 ? 0xFFFFFFFFu : (uint32_t)cd_size);
+    p = put_le32(p, zip64 ? 0xFFFFFFFFu : (uint32_t)cd_offset);
+    p = put_le16(p, 0);
+    xl_emit(ctx, rec, (size_t)(p - rec));
+}
+
+/*---------------------------------------------------------------------------
+    XML text
+ ---------------------------------------------------------------------------*/
+
+/* Length of the valid UTF-8 sequence at p that XML allows, else 0 */
+static int xl_utf8_len(const unsigned char *p, const unsigned char *end)
+{
+    unsigned c = p[0];
+    int n, k;
+
+    if (c >= 0xC2 && c <= 0xDF) n = 2;
+    else if (c >= 0xE0 && c <= 0xEF) n = 3;
+    else if (c >= 0xF0 && c <= 0xF4) n = 4;
+    else return 0;
+    if (end - p < n) return 0;
+    for (k = 1; k < n; k++)
+        if ((p[k] & 0xC0) != 0x80) return 0;
+    if (c == 0xE0 && p[1] < 0xA0) return 0;                     /* Overlong */
+    if (c == 0xED && p[1] >= 0xA0) return 0;                    /* Surrogate */
+    if (c == 0xEF && p[1] == 0xBF && p[2] >= 0xBE) return 0;    /* U+FFFE, U+FFFF */
+    if (c == 0xF0 && p[1] < 0x90) return 0;                     /* Overlong */
+    if (c == 0xF4 && p[1] >= 0x90) return 0;                    /* Past U+10FFFF */
+    return n;
+}
+
+/* "_xHHHH_" is how Excel escapes a character, so a literal one must
+   have its '_' escaped */
+static int xl_is_escape(const unsigned char *p, const unsigned char *end)
+{
+    int k;
+
+    if (end - p < 7 || p[1] != 'x' || p[6] != '_') return 0;
+    for (k = 2; k < 6; k++)
+        if (!isxdigit(p[k])) return 0;
+    return 1;
+}
+
+/*---------------------------------------------------------------------------
+    xl_put_text
+
+    Writes text as XML character data: markup characters as entities,
+    control characters as "_xHHHH_", invalid UTF-8 as U+FFFD, cut to
+    XL_MAX_CHARS characters.  quote: escape '"' too (attribute values).
+ ---------------------------------------------------------------------------*/
+static void xl_put_text(XL_CONTEXT *ctx, const char *text, int len, int quote)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    const unsigned char *p = (const unsigned char *)text, *end = p + len, *run = p;
+    char esc[8];
+    int units = 0;
+
+    while (p < end) {
+        unsigned c = *p;
+        const char *rep = NULL;
+        int rep_len = 0, n = 1;
+
+        if (c < 0x80) {
+            units++;
+            if (c == '&') {
+                rep = "&amp;";
+                rep_len = 5;
+            } else if (c == '<') {
+                rep = "&lt;";
+                rep_len = 4;
+            } else if (c == '>') {
+                rep = "&gt;";
+                rep_len = 4;
+            } else if (c == '"' && quote) {
+                rep = "&quot;";
+                rep_len = 6;
+            } else if ((c < 0x20 && c != '\t' && c != '\n') ||
+                       (c == '_' && xl_is_escape(p, end))) {
+                memcpy(esc, "_x00", 4);
+                esc[4] = hex[c >> 4];
+                esc[5] = hex[c & 15];
+                esc[6] = '_';
+                rep = esc;
+                rep_len = 7;
+            }
+        } else {
+            n = xl_utf8_len(p, end);
+            if (n == 0) {
+                rep = "\xEF\xBF\xBD";
+                rep_len = 3;
+                n = 1;
+            }
+            units += (n == 4) ? 2 : 1;
+        }
+        if (units > XL_MAX_CHARS) break;
+        if (rep) {
+            xl_put(ctx, run, (size_t)(p - run));
+            xl_put(ctx, rep, (size_t)rep_len);
+            run = p + n;
+        }
+        p += n;
+    }
+    xl_put(ctx, run, (size_t)(p - run));
+}
+
+/* Leading or trailing white space is dropped unless marked preserved */
+static int xl_needs_preserve(const char *p, int len)
+{
+    return len > 0 && (p[0] == ' ' || p[0] == '\t' || p[0] == '\n' || p[0] == '\r' ||
+                       p[len - 1] == ' ' || p[len - 1] == '\t' || p[len - 1] == '\n' ||
+                       p[len - 1] == '\r');
+}
+
+static void xl_put_t(XL_CONTEXT *ctx, const char *p, int len)
+{
+    xl_puts(ctx, xl_needs_preserve(p, len) ? "<t xml:space=\"preserve\">" : "<t>");
+    xl_put_text(ctx, p, len, 0);
+    xl_puts(ctx, "</t>");
+}
+
+static int xl_utoa(uint32_t v, char *out)
+{
+    char tmp[10];
+    int n = 0, k = 0;
+
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (n) out[k++] = tmp[--n];
+    out[k] = '\0';
+    return k;
+}
+
+/*---------------------------------------------------------------------------
+    Cell values
+ ---------------------------------------------------------------------------*/
+
+/* Whether text is an xsd:double Excel keeps exactly: at most max_digits
+   significant digits (0 = any) */
+static int xl_is_number(const char *p, int len, int max_digits)
+{
+    int i = 0, digits = 0, first = -1, last = -1;
+
+    if (i < len && (p[i] == '-' || p[i] == '+')) i++;
+    for (; i < len && p[i] >= '0' && p[i] <= '9'; i++, digits++)
+        if (p[i] != '0') {
+            if (first < 0) first = digits;
+            last = digits;
+        }
+    if (i < len && p[i] == '.') {
+        for (i++; i < len && p[i] >= '0' && p[i] <= '9'; i++, digits++)
+            if (p[i] != '0') {
+                if (first < 0) first = digits;
+                last = digits;
+            }
+    }
+    if (digits == 0) return 0;
+    if (i < len && (p[i] == 'e' || p[i] == 'E')) {
+        int exp_digits = 0;
+        i++;
+        if (i < len && (p[i] == '-' || p[i] == '+')) i++;
+        for (; i < len && p[i] >= '0' && p[i] <= '9'; i++) exp_digits++;
+        if (exp_digits == 0) return 0;
+    }
+    if (i != len) return 0;
+    return max_digits == 0 || first < 0 || last - first + 1 <= max_digits;
+}
+
+/* Excel date serial of a Unix time (1900 date system, 1e-10 day steps).
+   Returns the length, or -1 outside 1900-03-01 .. 9999-12-31. */
+static int xl_date_serial(int64_t us, char *out)
+{
+    int64_t day = (us >= 0) ? us / XL_DAY_US : -((-us + XL_DAY_US - 1) / XL_DAY_US);
+    int64_t frac = ((us - day * XL_DAY_US) * 25 + 108) / 216;
+    int64_t serial = day + 25569;
+    int n, k;
+
+    if (frac >= INT64_C(10000000000)) {
+        serial++;
+        frac -= INT64_C(10000000000);
+    }
+    if (serial < 61 || serial > 2958465) return -1;
+    n = xl_utoa((uint32_t)serial, out);
+    if (frac) {
+        out[n++] = '.';
+        for (k = 9; k >= 0; k--) {
+            out[n + k] = (char)('0' + frac % 10);
+            frac /= 10;
+        }
+        n += 10;
+        while (out[n - 1] == '0') n--;
+    }
+    out[n] = '\0';
+    return n;
+}
+
+static int xl_reserve_text(XL_CONTEXT *ctx, int need)
+{
+    char *p;
+
+    if (need <= ctx->text_cap) return ODV_OK;
+    p = (char *)realloc(ctx->text, (size_t)need);
+    if (!p) return ODV_ERROR_MALLOC;
+    ctx->text = p;
+    ctx->text_cap = need;
+    return ODV_OK;
+}
+
+/*---------------------------------------------------------------------------
+    xl_raw_text
+
+    Text form of a wire value (KERN_RAW), as the CSV output shows it.
+    Returns the length in ctx->text, or -1 for a value left empty.
+ ---------------------------------------------------------------------------*/
+static int xl_raw_text(XL_CONTEXT *ctx, int col, const char *val, int len)
+{
+    ODV_SESSION *s = ctx->session;
+    const ODV_COLDESC *d = &s->table.desc[col];
+    unsigned char raw[32];
+    int cap = ODV_NUMBER_STR_LEN + s->date_prog.max_len + 32;
+    int n;
+
+    if (d->type == COL_RAW) {
+        /* EXPDP writes bare hex, EXP "0x" + hex */
+        int expdp = (s->dump_type == DUMP_EXPDP);
+        if (len <= 0 || xl_reserve_text(ctx, len * 2 + 3) != ODV_OK) return -1;
+        n = 0;
+        if (!expdp) {
+            memcpy(ctx->text, "0x", 2);
+            n = 2;
+        }
+        return n + odv_hex_encode((const unsigned char *)val, len, ctx->text + n, 0);
+    }
+
+    if (xl_reserve_text(ctx, cap) != ODV_OK) return -1;
+    /* Decoders read fixed-size fields: decode a zero-padded copy */
+    if (len > (int)sizeof(raw)) len = (int)sizeof(raw);
+    memset(raw, 0, sizeof(raw));
+    memcpy(raw, val, (size_t)len);
+
+    switch (d->type) {
+    case COL_NUMBER:
+    case COL_FLOAT:
+        return decode_oracle_number(raw, len, ctx->text, cap);
+    case COL_DATE:
+        /* Not the session's memo: tee writers run on their own threads */
+        return decode_oracle_date(raw, len, ctx->text, cap, &s->date_prog);
+    case COL_TIMESTAMP:
+    case COL_TIMESTAMP_TZ:
+    case COL_TIMESTAMP_LTZ:
+        return decode_oracle_timestamp(raw, len, ctx->text, cap, &s->date_prog, d->precision);
+    case COL_BIN_FLOAT:
+        return decode_binary_float(raw, ctx->text, cap);
+    case COL_BIN_DOUBLE:
+        return decode_binary_double(raw, ctx->text, cap);
+    case COL_INTERVAL_YM:
+        return decode_interval_ym(raw, len, ctx->text, cap);
+    case COL_INTERVAL_DS:
+        return decode_interval_ds(raw, len, ctx->text, cap);
+    default:
+        return -1;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    Shared strings
+ ---------------------------------------------------------------------------*/
+static uint32_t xl_hash(const char *p, int n)
+{
+    uint32_t h = 2166136261u;
+    int i;
+    for (i = 0; i < n; i++) h = (h ^ (unsigned char)p[i]) * 16777619u;
+    return h;
+}
+
+static int xl_rehash(XL_CONTEXT *ctx, int slots)
+{
+    int *t = (int *)malloc((size_t)slots * sizeof(int));
+    int i;
+
+    if (!t) return ODV_ERROR_MALLOC;
+    memset(t, 0xFF, (size_t)slots * sizeof(int));
+    for (i = 0; i < ctx->str_count; i++) {
+        uint32_t k = ctx->strs[i].hash & (uint32_t)(slots - 1);
+        while (t[k] >= 0) k = (k + 1) & (uint32_t)(slots - 1);
+        t[k] = i;
+    }
+    free(ctx->slots);
+    ctx->slots = t;
+    ctx->slot_mask = slots - 1;
+    return ODV_OK;
+}
+
+/* Index of the string in the shared string table, adding it if there
+   is room; -1 if it has to be written inline */
+static int xl_sst_index(XL_CONTEXT *ctx, const char *p, int len)
+{
+    uint32_t h = xl_hash(p, len), k;
+    XL_STRING *e;
+    int i;
+
+    if (!ctx->slots && xl_rehash(ctx, 4096) != ODV_OK) return -1;
+    for (k = h & (uint32_t)ctx->slot_mask; (i = ctx->slots[k]) >= 0;
+         k = (k + 1) & (uint32_t)ctx->slot_mask) {
+        e = &ctx->strs[i];
+        if (e->hash == h && e->len == (uint32_t)len && memcmp(ctx->pool + e->off, p, (size_t)len) == 0)
+            return i;
+    }
+
+    if (ctx->str_count >= XL_SST_COUNT || ctx->pool_len + (size_t)len > XL_SST_BYTES) return -1;
+    if (ctx->pool_len + (size_t)len > ctx->pool_cap) {
+        size_t cap = ctx->pool_cap ? ctx->pool_cap * 2 : 65536;
+        char *np = (char *)realloc(ctx->pool, cap);
+        if (!np) return -1;
+        ctx->pool = np;
+        ctx->pool_cap = cap;
+    }
+    if (ctx->str_count == ctx->str_cap) {
+        int cap = ctx->str_cap ? ctx->str_cap * 2 : 4096;
+        XL_STRING *ns = (XL_STRING *)realloc(ctx->strs, (size_t)cap * sizeof(XL_STRING));
+        if (!ns) return -1;
+        ctx->strs = ns;
+        ctx->str_cap = cap;
+    }
+
+    i = ctx->str_count++;
+    e = &ctx->strs[i];
+    e->hash = h;
+    e->len = (uint32_t)len;
+    e->off = ctx->pool_len;
+    memcpy(ctx->pool + ctx->pool_len, p, (size_t)len);
+    ctx->pool_len += (size_t)len;
+    ctx->slots[k] = i;
+
+    /* Keep the load factor at most 1/2 */
+    if (ctx->str_count * 2 > ctx->slot_mask + 1 && xl_rehash(ctx, (ctx->slot_mask + 1) * 2) != ODV_OK) {
+        ctx->str_count--;               /* Unindexed: drop it again */
+        ctx->pool_len -= (size_t)len;
+        ctx->slots[k] = -1;
+        return -1;
+    }
+    return i;
+}
+
+static void xl_write_shared_strings(XL_CONTEXT *ctx)
+{
+    char num[48];
+    int i;
+
+    xl_begin_entry(ctx, "xl/sharedStrings.xml");
+    xl_puts(ctx, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                 "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" count=\"");
+    snprintf(num, sizeof(num), "%lld\" uniqueCount=\"%d\">", (long long)ctx->sst_refs,
+             ctx->str_count);
+    xl_puts(ctx, num);
+    for (i = 0; i < ctx->str_count && ctx->rc == ODV_OK; i++) {
+        xl_puts(ctx, "<si>");
+        xl_put_t(ctx, ctx->pool + ctx->strs[i].off, (int)ctx->strs[i].len);
+        xl_puts(ctx, "</si>");
+    }
+    xl_puts(ctx, "</sst>");
+    xl_end_entry(ctx);
+}
+
+/*---------------------------------------------------------------------------
+    Worksheets
+ ---------------------------------------------------------------------------*/
+
+/* Case-insensitive (ASCII) comparison, as Excel compares sheet names */
+static int xl_name_equal(const char *a, const char *b)
+{
+    for (; *a && *b; a++, b++) {
+        int ca = (*a >= 'a' && *a <= 'z') ? *a - 32 : *a;
+        int cb = (*b >= 'a' && *b <= 'z') ? *b - 32 : *b;
+        if (ca != cb) return 0;
+    }
+    return *a == *b;
+}
+
+/* Copies at most max_units UTF-16 units of a sanitized sheet name */
+static int xl_name_copy(const char *src, int max_units, char *out)
+{
+    const unsigned char *p = (const unsigned char *)src, *end = p + strlen(src);
+    int units = 0, n = 0;
+
+    while (p < end) {
+        int k = (*p < 0x80) ? 1 : xl_utf8_len(p, end);
+        int u = (k == 4) ? 2 : 1;
+        if (units + u > max_units) break;
+        if (k == 0 || (k == 1 && (*p < 0x20 || strchr("[]:*?/\\", *p)))) {
+            out[n++] = '_';
+            k = 1;
+        } else {
+            memcpy(out + n, p, (size_t)k);
+            n += k;
+        }
+        units += u;
+        p += k;
+    }
+    out[n] = '\0';
+    /* A name cannot start or end with an apostrophe */
+    if (n > 0 && out[0] == '\'') out[0] = '_';
+    if (n > 0 && out[n - 1] == '\'') out[n - 1] = '_';
+    return n;
+}
+
+/* Unique sheet name for table: "NAME", then "NAME (2)", "NAME (3)", ... */
+static void xl_sheet_name(XL_CONTEXT *ctx, const char *table, char *out)
+{
+    char suffix[16];
+    int k, i, taken;
+
+    for (k = 1;; k++) {
+        suffix[0] = '\0';
+        if (k > 1) snprintf(suffix, sizeof(suffix), " (%d)", k);
+        xl_name_copy(table && table[0] ? table : "Sheet", XL_NAME_CHARS - (int)strlen(suffix), out);
+        strcat(out, suffix);
+        for (taken = 0, i = 0; i < ctx->sheet_count && !taken; i++)
+            taken = xl_name_equal(ctx->sheets[i], out);
+        if (!taken) return;
+    }
+}
+
+static int xl_setup_columns(XL_CONTEXT *ctx, int col_count, const char **col_names)
+{
+    ODV_SESSION *s = ctx->session;
+    size_t name_bytes = 0;
+    char *p;
+    int i, n = ODV_MIN(col_count, XL_MAX_COLS);
+
+    free(ctx->kinds);
+    free(ctx->refs);
+    free(ctx->names);
+    ctx->kinds = (unsigned char *)malloc((size_t)(n > 0 ? n : 1));
+    ctx->refs = (char (*)[4])malloc((size_t)(n > 0 ? n : 1) * 4);
+    for (i = 0; i < n; i++) name_bytes += strlen(col_names[i]) + 1;
+    ctx->names = (char **)malloc((size_t)(n > 0 ? n : 1) * sizeof(char *) + name_bytes);
+    ctx->col_count = 0;
+    ctx->row_cols = col_count;
+    if (!ctx->kinds || !ctx->refs || !ctx->names) return ODV_ERROR_MALLOC;
+
+    p = (char *)(ctx->names + (n > 0 ? n : 1));
+    for (i = 0; i < n; i++) {
+        int type = (i < s->table.col_count) ? s->table.desc[i].type : COL_VARCHAR;
+        int raw = (i < s->table.col_count) && s->plan.kernel[i] == KERN_RAW;
+        size_t len = strlen(col_names[i]) + 1;
+        int c = i, k = 0;
+        char rev[3];
+
+        memcpy(p, col_names[i], len);
+        ctx->names[i] = p;
+        p += len;
+
+        /* Column letters: A..Z, AA..ZZ, AAA..XFD */
+        do {
+            rev[k++] = (char)('A' + c % 26);
+            c = c / 26 - 1;
+        } while (c >= 0);
+        for (c = 0; c < k; c++) ctx->refs[i][c] = rev[k - 1 - c];
+        ctx->refs[i][k] = '\0';
+
+        ctx->kinds[i] = XLK_STRING;
+        if (!raw) continue;
+        switch (type) {
+        case COL_NUMBER:
+        case COL_FLOAT:         ctx->kinds[i] = XLK_NUMBER; break;
+        case COL_BIN_FLOAT:
+        case COL_BIN_DOUBLE:    ctx->kinds[i] = XLK_DOUBLE; break;
+        case COL_DATE:
+        case COL_TIMESTAMP:     ctx->kinds[i] = XLK_DATE;   break;
+        default:                ctx->kinds[i] = XLK_TEXT;   break;
+        }
+    }
+    ctx->col_count = n;
+    return ODV_OK;
+}
+
+/* Column width from the header text, wider for dates */
+static int xl_col_width(const XL_CONTEXT *ctx, int i)
+{
+    const unsigned char *p = (const unsigned char *)ctx->names[i];
+    int w = 2;
+
+    for (; *p; p++)
+        if ((*p & 0xC0) != 0x80) w += (*p < 0x80) ? 1 : 2;
+    if (ctx->kinds[i] == XLK_DATE && w < 20) w = 20;
+    return ODV_MAX(8, ODV_MIN(w, 60));
+}
+
+/* Starts a worksheet for table with its header row */
+static void xl_open_sheet(XL_CONTEXT *ctx, const char *table)
+{
+    char name[40], buf[96];
+    char (*sheets)[XL_NAME_LEN];
+    int i;
+
+    if (ctx->rc != ODV_OK) return;
+    if (ctx->sheet_count == ctx->sheet_cap) {
+        int cap = ctx->sheet_cap ? ctx->sheet_cap * 2 : 8;
+        sheets = (char (*)[XL_NAME_LEN])realloc(ctx->sheets, (size_t)cap * XL_NAME_LEN);
+        if (!sheets) {
+            ctx->rc = ODV_ERROR_MALLOC;
+            return;
+        }
+        ctx->sheets = sheets;
+        ctx->sheet_cap = cap;
+    }
+    xl_sheet_name(ctx, table, ctx->sheets[ctx->sheet_count]);
+    ctx->sheet_count++;
+    ctx->sheet_open = 1;
+
+    snprintf(name, sizeof(name), "xl/worksheets/sheet%d.xml", ctx->sheet_count);
+    xl_begin_entry(ctx, name);
+    xl_puts(ctx, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                 "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">");
+    xl_puts(ctx, ctx->sheet_count == 1 ? "<sheetViews><sheetView tabSelected=\"1\" workbookViewId=\"0\">"
+                                       : "<sheetViews><sheetView workbookViewId=\"0\">");
+    xl_puts(ctx, "<pane ySplit=\"1\" topLeftCell=\"A2\" activePane=\"bottomLeft\" state=\"frozen\"/>"
+                 "<selection pane=\"bottomLeft\"/></sheetView></sheetViews>"
+                 "<sheetFormatPr defaultRowHeight=\"15\"/>");
+    if (ctx->col_count > 0) {
+        xl_puts(ctx, "<cols>");
+        for (i = 0; i < ctx->col_count; i++) {
+            snprintf(buf, sizeof(buf), "<col min=\"%d\" max=\"%d\" width=\"%d\" customWidth=\"1\"/>",
+                     i + 1, i + 1, xl_col_width(ctx, i));
+            xl_puts(ctx, buf);
+        }
+        xl_puts(ctx, "</cols>");
+    }
+    xl_puts(ctx, "<sheetData>");
+
+    /* Header row */
+    if (ctx->col_count > 0) {
+        xl_puts(ctx, "<row r=\"1\">");
+        for (i = 0; i < ctx->col_count; i++) {
+            snprintf(buf, sizeof(buf), "<c r=\"%s1\" s=\"%d\" t=\"inlineStr\"><is>",
+                     ctx->refs[i], XL_STYLE_HEADER);
+            xl_puts(ctx, buf);
+            xl_put_t(ctx, ctx->names[i], (int)strlen(ctx->names[i]));
+            xl_puts(ctx, "</is></c>");
+        }
+        xl_puts(ctx, "</row>");
+    }
+    ctx->sheet_rows = 1;
+}
+
+static void xl_close_sheet(XL_CONTEXT *ctx)
+{
+    if (!ctx->sheet_open) return;
+    xl_puts(ctx, "</sheetData></worksheet>");
+    xl_end_entry(ctx);
+    ctx->sheet_open = 0;
+}
+
+/* Opens a cell: <c r="B7"[ s=".."][ t=".."]> */
+static void xl_cell_start(XL_CONTEXT *ctx, int col, const char *rownum, int style,
+                          const char *type)
+{
+    char buf[64];
+    int n = 0;
+
+    memcpy(buf, "<c r=\"", 6);
+    n = 6;
+    n += (int)strlen(strcpy(buf + n, ctx->refs[col]));
+    n += (int)strlen(strcpy(buf + n, rownum));
+    buf[n++] = '"';
+    if (style) n += snprintf(buf + n, sizeof(buf) - (size_t)n, " s=\"%d\"", style);
+    if (type) n += snprintf(buf + n, sizeof(buf) - (size_t)n, " t=\"%s\"", type);
+    buf[n++] = '>';
+    xl_put(ctx, buf, (size_t)n);
+}
+
+static void xl_string_cell(XL_CONTEXT *ctx, int col, const char *rownum, const char *p, int len)
+{
+    char num[12];
+    int k;
+
+    if (len <= 0) return;
+    k = (len <= XL_SST_LEN) ? xl_sst_index(ctx, p, len) : -1;
+    if (k >= 0) {
+        ctx->sst_refs++;
+        xl_cell_start(ctx, col, rownum, 0, "s");
+        xl_puts(ctx, "<v>");
+        xl_put(ctx, num, (size_t)xl_utoa((uint32_t)k, num));
+        xl_puts(ctx, "</v></c>");
+        return;
+    }
+    xl_cell_start(ctx, col, rownum, 0, "inlineStr");
+    xl_puts(ctx, "<is>");
+    xl_put_t(ctx, p, len);
+    xl_puts(ctx, "</is></c>");
+}
+
+static void xl_number_cell(XL_CONTEXT *ctx, int col, const char *rownum, int style,
+                           const char *p, int len)
+{
+    xl_cell_start(ctx, col, rownum, style, NULL);
+    xl_puts(ctx, "<v>");
+    xl_put(ctx, p, (size_t)len);
+    xl_puts(ctx, "</v></c>");
+}
+
+static void xl_put_cell(XL_CONTEXT *ctx, int col, const char *rownum, const char *val, int len)
+{
+    const ODV_COLDESC *d = &ctx->session->table.desc[col];
+    char serial[32];
+    int64_t us;
+    int n;
+
+    switch (ctx->kinds[col]) {
+    case XLK_NUMBER:
+    case XLK_DOUBLE:
+        n = xl_raw_text(ctx, col, val, len);
+        if (n <= 0) return;
+        if (xl_is_number(ctx->text, n, ctx->kinds[col] == XLK_NUMBER ? 15 : 0))
+            xl_number_cell(ctx, col, rownum, 0, ctx->text, n);
+        else
+            xl_string_cell(ctx, col, rownum, ctx->text, n);
+        return;
+    case XLK_DATE:
+        if (odv_datetime_to_unix_us((const unsigned char *)val, len, d->precision, &us) == ODV_OK &&
+            (n = xl_date_serial(us, serial)) > 0) {
+            int style = (d->type == COL_TIMESTAMP && d->precision != 0) ? XL_STYLE_TS
+                                                                        : XL_STYLE_DATE;
+            xl_number_cell(ctx, col, rownum, style, serial, n);
+            return;
+        }
+        /* Outside Excel's dates: the text */
+        /* fall through */
+    case XLK_TEXT:
+        n = xl_raw_text(ctx, col, val, len);
+        if (n > 0) xl_string_cell(ctx, col, rownum, ctx->text, n);
+        return;
+    default:
+        xl_string_cell(ctx, col, rownum, val, len);
+        return;
+    }
+}
+
+/*---------------------------------------------------------------------------
+    Workbook parts
+ ---------------------------------------------------------------------------*/
+static void xl_write_styles(XL_CONTEXT *ctx)
+{
+    xl_begin_entry(ctx, "xl/styles.xml");
+    xl_puts(ctx,
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<numFmts count=\"2\">"
+        "<numFmt numFmtId=\"164\" formatCode=\"yyyy\\-mm\\-dd\\ hh:mm:ss\"/>"
+        "<numFmt numFmtId=\"165\" formatCode=\"yyyy\\-mm\\-dd\\ hh:mm:ss.000\"/>"
+        "</numFmts>"
+        "<fonts count=\"2\">"
+        "<font><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+        "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+        "</fonts>"
+        "<fills count=\"3\">"
+        "<fill><patternFill patternType=\"none\"/></fill>"
+        "<fill><patternFill patternType=\"gray125\"/></fill>"
+        "<fill><patternFill patternType=\"solid\"><fgColor rgb=\"FFB0C4DE\"/>"
+        "<bgColor indexed=\"64\"/></patternFill></fill>"
+        "</fills>"
+        "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+        "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+        "<cellXfs count=\"4\">"
+        "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/>"
+        "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"2\" borderId=\"0\" xfId=\"0\" applyFont=\"1\" applyFill=\"1\"/>"
+        "<xf numFmtId=\"164\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyNumberFormat=\"1\"/>"
+        "<xf numFmtId=\"165\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyNumberFormat=\"1\"/>"
+        "</cellXfs>"
+        "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+        "</styleSheet>");
+    xl_end_entry(ctx);
+}
+
+static void xl_write_package(XL_CONTEXT *ctx)
+{
+    char buf[256];
+    int i;
+
+    xl_begin_entry(ctx, "xl/workbook.xml");
+    xl_puts(ctx, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                 "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+                 "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+                 "<sheets>");
+    for (i = 0; i < ctx->sheet_count; i++) {
+        xl_puts(ctx, "<sheet name=\"");
+        xl_put_text(ctx, ctx->sheets[i], (int)strlen(ctx->sheets[i]), 1);
+        snprintf(buf, sizeof(buf), "\" sheetId=\"%d\" r:id=\"rId%d\"/>", i + 1, i + 1);
+        xl_puts(ctx, buf);
+    }
+    xl_puts(ctx, "</sheets></workbook>");
+    xl_end_entry(ctx);
+
+    xl_begin_entry(ctx, "xl/_rels/workbook.xml.rels");
+    xl_puts(ctx, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                 "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">");
+    for (i = 0; i < ctx->sheet_count; i++) {
+        snprintf(buf, sizeof(buf),
+                 "<Relationship Id=\"rId%d\" Type=\"http://schemas.openxmlformats.org/officeDocument/"
+                 "2006/relationships/worksheet\" Target=\"worksheets/sheet%d.xml\"/>", i + 1, i + 1);
+        xl_puts(ctx, buf);
+    }
+    snprintf(buf, sizeof(buf),
+             "<Relationship Id=\"rId%d\" Type=\"http://schemas.openxmlformats.org/officeDocument/"
+             "2006/relationships/styles\" Target=\"styles.xml\"/>", i + 1);
+    xl_puts(ctx, buf);
+    snprintf(buf, sizeof(buf),
+             "<Relationship Id=\"rId%d\" Type=\"http://schemas.openxmlformats.org/officeDocument/"
+             "2006/relationships/sharedStrings\" Target=\"sharedStrings.xml\"/>", i + 2);
+    xl_puts(ctx, buf);
+    xl_puts(ctx, "</Relationships>");
+    xl_end_entry(ctx);
+
+    xl_begin_entry(ctx, "_rels/.rels");
+    xl_puts(ctx, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                 "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                 "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/"
+                 "2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+                 "</Relationships>");
+    xl_end_entry(ctx);
+
+    xl_begin_entry(ctx, "[Content_Types].xml");
+    xl_puts(ctx, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                 "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+                 "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+                 "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+                 "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-"
+                 "officedocument.spreadsheetml.sheet.main+xml\"/>");
+    for (i = 0; i < ctx->sheet_count; i++) {
+        snprintf(buf, sizeof(buf),
+                 "<Override PartName=\"/xl/worksheets/sheet%d.xml\" ContentType=\"application/"
+                 "vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>", i + 1);
+        xl_puts(ctx, buf);
+    }
+    xl_puts(ctx, "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-"
+                 "officedocument.spreadsheetml.styles+xml\"/>"
+                 "<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"application/"
+                 "vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml\"/>"
+                 "</Types>");
+    xl_end_entry(ctx);
+}
+
+/*---------------------------------------------------------------------------
+    Row callback
+ ---------------------------------------------------------------------------*/
+
+/* Writes one row.  Returns ODV_OK, or the error the export has failed
+   with. */
+static int xl_put_row(XL_CONTEXT *ctx, const char *schema, const char *table,
+                      int col_count, const char **col_names, const char **col_values,
+                      const int *col_lengths)
+{
+    char rownum[12], buf[24];
+    int i;
+
+    if (ctx->rc != ODV_OK) return ctx->rc;
+    if (ctx->out.error != ODV_OK) return ctx->out.error;
+
+    /* Filter by table name if specified */
+    if (ctx->target_table && ctx->target_table[0] != '\0') {
+        if (strcmp(table, ctx->target_table) != 0) return ODV_OK;
+    }
+
+    /* A sheet per table; a full sheet continues on the next one */
+    if (!ctx->started || col_count != ctx->row_cols ||
+        strcmp(schema ? schema : "", ctx->last_schema) != 0 ||
+        strcmp(table, ctx->last_table) != 0) {
+        xl_close_sheet(ctx);
+        if (ctx->rc == ODV_OK) ctx->rc = xl_setup_columns(ctx, col_count, col_names);
+        ctx->started = 1;
+        odv_strcpy(ctx->last_schema, schema ? schema : "", 127);
+        odv_strcpy(ctx->last_table, table, 127);
+        xl_open_sheet(ctx, table);
+    } else if (ctx->sheet_rows >= XL_MAX_ROWS ||
+               ctx->usize + ctx->xml_len >= (int64_t)XL_SHEET_BYTES) {
+        xl_close_sheet(ctx);
+        xl_open_sheet(ctx, table);
+    }
+    if (ctx->rc != ODV_OK) return ctx->rc;
+
+    xl_utoa((uint32_t)ctx->sheet_rows + 1, rownum);
+    snprintf(buf, sizeof(buf), "<row r=\"%s\">", rownum);
+    xl_puts(ctx, buf);
+    for (i = 0; i < ctx->col_count; i++) {
+        if (col_lengths[i] >= 0)
+            xl_put_cell(ctx, i, rownum, col_values[i], col_lengths[i]);
+    }
+    xl_puts(ctx, "</row>");
+    if (ctx->rc != ODV_OK) return ctx->rc;
+
+    ctx->sheet_rows++;
+    ctx->total_rows++;
+
+    /* Report progress periodically (every 100 rows) */
+    if (ctx->progress && ctx->session->progress_cb && (ctx->total_rows % 100) == 0) {
+        ctx->session->progress_cb(ctx->total_rows, table, ctx->session->progress_ud);
+    }
+    return ODV_OK;
+}
+
+static void ODV_CALL xl_row_callback(
+    const char *schema, const char *table,
+    int col_count, const char **col_names, const char **col_values,
+    const int *col_lengths, void *user_data)
+{
+    XL_CONTEXT *ctx = (XL_CONTEXT *)user_data;
+
+    if (!ctx || ctx->rc != ODV_OK) return;
+    if (xl_put_row(ctx, schema, table, col_count, col_names, col_values,
+                   col_lengths) != ODV_OK)
+        ctx->session->cancelled = 1;
+}
+
+/* Opens the file and writes the styles part */
+static int xl_init(XL_CONTEXT *ctx, ODV_SESSION *s, const char *table_name,
+                   const char *output_path)
+{
+    int rc;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->session = s;
+    ctx->target_table = table_name;
+    ctx->progress = 1;
+    ctx->comp_cap = XL_CHUNK + XL_CHUNK / 16 + 1024;
+    ctx->xml = (unsigned char *)malloc(XL_CHUNK);
+    ctx->comp = (unsigned char *)malloc((size_t)ctx->comp_cap);
+    if (!ctx->xml || !ctx->comp) {
+        free(ctx->xml);
+        free(ctx->comp);
+        odv_strcpy(s->last_error, "Out of memory while writing Excel output", ODV_MSG_LEN);
+        return ODV_ERROR_MALLOC;
+    }
+
+    rc = odv_out_open(&ctx->out, output_path);
+    if (rc != ODV_OK) {
+        free(ctx->xml);
+        free(ctx->comp);
+        odv_strcpy(s->last_error, "Cannot create Excel output file", ODV_MSG_LEN);
+        return rc;
+    }
+    xl_write_styles(ctx);
+    return ODV_OK;
+}
+
+/* Closes the last sheet, writes the shared strings, workbook parts and
+   zip directory, closes the file and frees the buffers; rc is the parse
+   result.  Returns the export result. */
+static int xl_finish(ODV_SESSION *s, XL_CONTEXT *ctx, int rc)
+{
+    xl_close_sheet(ctx);
+    if (ctx->sheet_count == 0) {
+        /* A workbook needs a sheet */
+        ctx->col_count = 0;
+        xl_open_sheet(ctx, ctx->target_table && ctx->target_table[0] ? ctx->target_table
+                                                                     : "Sheet1");
+        xl_close_sheet(ctx);
+    }
+    xl_write_shared_strings(ctx);
+    xl_write_package(ctx);
+    if (ctx->rc == ODV_OK) xl_write_directory(ctx);
+
+    if (ctx->rc != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        odv_strcpy(s->last_error, "Out of memory while writing Excel output", ODV_MSG_LEN);
+        rc = ctx->rc;
+    }
+    if (odv_out_close(&ctx->out) != ODV_OK && (rc == ODV_OK || rc == ODV_ERROR_CANCELLED)) {
+        odv_strcpy(s->last_error, "Cannot write Excel output file", ODV_MSG_LEN);
+        rc = ODV_ERROR_FWRITE;
+    }
+
+    odv_lz_free(&ctx->lz);
+    free(ctx->xml);
+    free(ctx->comp);
+    free(ctx->entries);
+    free(ctx->sheets);
+    free(ctx->kinds);
+    free(ctx->refs);
+    free(ctx->names);
+    free(ctx->text);
+    free(ctx->pool);
+    free(ctx->strs);
+    free(ctx->slots);
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    write_xlsx_file
+
+    Exports a table (every table, one sheet each, if table_name is empty)
+    to an Excel workbook.
+ ---------------------------------------------------------------------------*/
+int write_xlsx_file(ODV_SESSION *s, const char *table_name, const char *output_path)
+{
+    XL_CONTEXT ctx;
+    ODV_ROW_CALLBACK saved_cb;
+    ODV_ROW_SPAN_CALLBACK saved_span_cb;
+    void *saved_ud;
+    int saved_raw;
+    int rc;
+
+    if (!s || !output_path) return ODV_ERROR_INVALID_ARG;
+
+    rc = xl_init(&ctx, s, table_name, output_path);
+    if (rc != ODV_OK) return rc;
+
+    /* Save and replace row callback; keep typed columns as wire bytes */
+    saved_cb = s->row_cb;
+    saved_span_cb = s->row_span_cb;
+    saved_ud = s->row_ud;
+    saved_raw = s->raw_values;
+    s->row_cb = NULL;
+    s->row_span_cb = xl_row_callback;
+    s->row_ud = &ctx;
+    s->raw_values = 1;
+    s->plan.valid = 0;
+
+    /* Re-parse dump */
+    s->cancelled = 0;
+    s->total_rows = 0;
+
+    /* Auto-detect dump kind if not done */
+    if (s->dump_type == DUMP_UNKNOWN)
+        rc = detect_dump_kind(s);
+
+    if (rc == ODV_OK) rc = odv_run_parse(s, 0);
+
+    /* Remaining parts and the zip directory */
+    rc = xl_finish(s, &ctx, rc);
+
+    /* Restore original callback and decode mode */
+    s->row_cb = saved_cb;
+    s->row_span_cb = saved_span_cb;
+    s->row_ud = saved_ud;
+    s->raw_values = saved_raw;
+    s->plan.valid = 0;
+
+    return rc;
+}
+
+/*---------------------------------------------------------------------------
+    xlsx_tee_open
+
+    Opens an Excel output of a tee export (odv_tee.c).  Takes typed
+    columns as wire bytes.
+ ---------------------------------------------------------------------------*/
+static int xl_sink_row(void *sink_ctx, const char *schema, const char *table,
+                       int col_count, const char **col_names, const char **col_values,
+                       const int *col_lengths)
+{
+    return xl_put_row((XL_CONTEXT *)sink_ctx, schema, table, col_count, col_names,
+                      col_values, col_lengths);
+}
+
+static int xl_sink_close(void *sink_ctx, int rc)
+{
+    XL_CONTEXT *ctx = (XL_CONTEXT *)sink_ctx;
+
+    rc = xl_finish(ctx->session, ctx, rc);
+    free(ctx);
+    return rc;
+}
+
+int xlsx_tee_open(ODV_SESSION *s, const char *table_name, const char *output_path,
+                  ODV_TEE_SINK *sink)
+{
+    XL_CONTEXT *ctx;
+    int rc;
+
+    ctx = (XL_CONTEXT *)malloc(sizeof(XL_CONTEXT));
+    if (!ctx) return ODV_ERROR_MALLOC;
+
+    rc = xl_init(ctx, s, table_name, output_path);
+    if (rc != ODV_OK) {
+        free(ctx);
+        return rc;
+    }
+    ctx->progress = 0;          /* Reported by the tee */
+
+    sink->ctx = ctx;
+    sink->raw = 1;
+    sink->row = xl_sink_row;
+    sink->close = xl_sink_close;
+    return ODV_OK;
+}
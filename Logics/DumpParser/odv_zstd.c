@@ -0,0 +1,833 @@
+/*****************************************************************************
+    OraDB DUMP Viewer
+
+    odv_zstd.c
+    Zstandard (RFC 8878) frame encoder
+
+    One call writes one single-segment frame with the content size and
+    the XXH64 content checksum.  The LZ77 parse from odv_lz_parse covers
+    the whole input (offsets up to the frame start) and is cut into
+    blocks of at most 128 KB; each block carries Huffman (or raw / RLE)
+    literals and FSE-coded sequences, and falls back to a raw block when
+    that is not smaller.  Repeat offsets are not used.
+
+    Copyright (C) 2026 YANAI Taketo
+ *****************************************************************************/
+
+#include "odv_types.h"
+
+#define ZS_MAGIC          0xFD2FB528u
+#define ZS_BLOCK_MAX      (128 * 1024)
+#define ZS_SEQ_MAX        (ZS_BLOCK_MAX / 4 + 1)
+#define ZS_MAX_MATCH      65536
+#define ZS_HUF_MAX_BITS   11
+#define ZS_HUF_WEIGHT_LOG 6
+#define ZS_FSE_MAX_SYMS   53
+
+#define ZS_LL_CODES       36
+#define ZS_ML_CODES       53
+#define ZS_OF_CODES       32
+#define ZS_LL_MAX_LOG     9
+#define ZS_ML_MAX_LOG     9
+#define ZS_OF_MAX_LOG     8
+
+#define ZS_MODE_PREDEFINED 0
+#define ZS_MODE_RLE        1
+#define ZS_MODE_FSE        2
+
+/* Literal length / match length codes: baseline and extra bits */
+static const uint32_t ll_base[ZS_LL_CODES] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048, 4096,
+    8192, 16384, 32768, 65536
+};
+static const unsigned char ll_bits[ZS_LL_CODES] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12,
+    13, 14, 15, 16
+};
+static const uint32_t ml_base[ZS_ML_CODES] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+    19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+    35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051,
+    4099, 8195, 16387, 32771, 65539
+};
+static const unsigned char ml_bits[ZS_ML_CODES] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16
+};
+
+/* Predefined distributions (RFC 8878 3.1.1.3.2.2) */
+static const short ll_default[ZS_LL_CODES] = {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1
+};
+static const short ml_default[ZS_ML_CODES] = {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1
+};
+static const short of_default[29] = {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+};
+
+typedef struct {
+    uint32_t      ll;               /* Literal length */
+    uint32_t      ml;               /* Match length */
+    uint32_t      off;              /* Match distance */
+    unsigned char llc;
+    unsigned char mlc;
+    unsigned char ofc;
+} ZS_SEQ;
+
+/*---------------------------------------------------------------------------
+    Bit output
+
+    LSB first, closed with a single 1 bit; decoders read it backwards
+    from that marker.
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    unsigned char *start;
+    unsigned char *p;
+    unsigned char *end;
+    uint64_t       acc;
+    int            bits;
+    int            overflow;
+} ZS_BITS;
+
+static void zs_bits_init(ZS_BITS *b, unsigned char *p, unsigned char *end)
+{
+    memset(b, 0, sizeof(*b));
+    b->start = b->p = p;
+    b->end = end;
+}
+
+static void zs_put(ZS_BITS *b, uint32_t v, int n)
+{
+    b->acc |= (uint64_t)(v & (uint32_t)(((uint64_t)1 << n) - 1)) << b->bits;
+    b->bits += n;
+    if (b->bits >= 32) {
+        if (b->end - b->p >= 4) {
+            b->p[0] = (unsigned char)b->acc;
+            b->p[1] = (unsigned char)(b->acc >> 8);
+            b->p[2] = (unsigned char)(b->acc >> 16);
+            b->p[3] = (unsigned char)(b->acc >> 24);
+            b->p += 4;
+        } else {
+            b->overflow = 1;
+        }
+        b->acc >>= 32;
+        b->bits -= 32;
+    }
+}
+
+/* Returns the stream size, or -1 if it did not fit */
+static int zs_close(ZS_BITS *b)
+{
+    zs_put(b, 1, 1);
+    for (; b->bits > 0; b->bits -= 8) {
+        if (b->p < b->end) *b->p++ = (unsigned char)b->acc;
+        else b->overflow = 1;
+        b->acc >>= 8;
+    }
+    return b->overflow ? -1 : (int)(b->p - b->start);
+}
+
+static void zs_le(unsigned char *p, uint64_t v, int n)
+{
+    int i;
+    for (i = 0; i < n; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+/*---------------------------------------------------------------------------
+    XXH64 (seed 0) for the content checksum
+ ---------------------------------------------------------------------------*/
+#define XXH_P1 0x9E3779B185EBCA87ull
+#define XXH_P2 0xC2B2AE3D27D4EB4Full
+#define XXH_P3 0x165667B19E3779F9ull
+#define XXH_P4 0x85EBCA77C2B2AE63ull
+#define XXH_P5 0x27D4EB2F165667C5ull
+
+static uint64_t xxh_rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static uint64_t xxh_read64(const unsigned char *p)
+{
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+           ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+static uint64_t xxh_round(uint64_t acc, uint64_t in)
+{
+    acc += in * XXH_P2;
+    acc = xxh_rotl(acc, 31);
+    return acc * XXH_P1;
+}
+
+static uint64_t xxh_merge(uint64_t h, uint64_t v)
+{
+    h ^= xxh_round(0, v);
+    return h * XXH_P1 + XXH_P4;
+}
+
+static uint64_t xxh64(const unsigned char *p, size_t len)
+{
+    const unsigned char *end = p + len;
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = XXH_P1 + XXH_P2, v2 = XXH_P2, v3 = 0, v4 = 0 - XXH_P1;
+        do {
+            v1 = xxh_round(v1, xxh_read64(p));
+            v2 = xxh_round(v2, xxh_read64(p + 8));
+            v3 = xxh_round(v3, xxh_read64(p + 16));
+            v4 = xxh_round(v4, xxh_read64(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+        h = xxh_rotl(v1, 1) + xxh_rotl(v2, 7) + xxh_rotl(v3, 12) + xxh_rotl(v4, 18);
+        h = xxh_merge(h, v1);
+        h = xxh_merge(h, v2);
+        h = xxh_merge(h, v3);
+        h = xxh_merge(h, v4);
+    } else {
+        h = XXH_P5;
+    }
+    h += (uint64_t)len;
+
+    for (; end - p >= 8; p += 8) {
+        h ^= xxh_round(0, xxh_read64(p));
+        h = xxh_rotl(h, 27) * XXH_P1 + XXH_P4;
+    }
+    if (end - p >= 4) {
+        uint32_t k = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        h ^= (uint64_t)k * XXH_P1;
+        h = xxh_rotl(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= (uint64_t)*p * XXH_P5;
+        h = xxh_rotl(h, 11) * XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+/*---------------------------------------------------------------------------
+    FSE (tANS) tables
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    int      log;                           /* 0 = RLE, no state bits */
+    uint16_t state[1 << ZS_LL_MAX_LOG];
+    uint32_t delta[ZS_FSE_MAX_SYMS];        /* deltaNbBits */
+    int32_t  find[ZS_FSE_MAX_SYMS];         /* deltaFindState */
+    uint16_t init[ZS_FSE_MAX_SYMS];         /* Initial state per symbol */
+} ZS_FSE;
+
+/* Encoding table for norm[0..max_sym] (sum 1 << log, -1 = "less than 1") */
+static void zs_fse_build(ZS_FSE *t, const short *norm, int max_sym, int log)
+{
+    unsigned char spread[1 << ZS_LL_MAX_LOG];
+    int next[ZS_FSE_MAX_SYMS + 1];
+    int first[ZS_FSE_MAX_SYMS];
+    int ts = 1 << log, mask = ts - 1, step = (ts >> 1) + (ts >> 3) + 3;
+    int high = ts - 1, pos = 0, total = 0, s, i;
+
+    t->log = log;
+    for (s = 0; s <= max_sym; s++) {
+        if (norm[s] == -1) spread[high--] = (unsigned char)s;
+    }
+    for (s = 0; s <= max_sym; s++) {
+        for (i = 0; i < norm[s]; i++) {
+            spread[pos] = (unsigned char)s;
+            do {
+                pos = (pos + step) & mask;
+            } while (pos > high);
+        }
+    }
+
+    for (s = 0; s <= max_sym; s++) {
+        int c = norm[s];
+        first[s] = total;
+        next[s] = total;
+        if (c == 0) {
+            t->delta[s] = (uint32_t)(((log + 1) << 16) - ts);
+            t->find[s] = 0;
+        } else if (c == -1 || c == 1) {
+            t->delta[s] = (uint32_t)((log << 16) - ts);
+            t->find[s] = total - 1;
+            total++;
+        } else {
+            int max_out = log - odv_highbit32((uint32_t)(c - 1));
+            t->delta[s] = (uint32_t)(max_out << 16) - (uint32_t)(c << max_out);
+            t->find[s] = total - c;
+            total += c;
+        }
+    }
+    for (i = 0; i < ts; i++) t->state[next[spread[i]]++] = (uint16_t)(ts + i);
+
+    /* First occurrence of each symbol: decoding it always reads >= 1 bit */
+    for (s = 0; s <= max_sym; s++)
+        t->init[s] = norm[s] ? t->state[first[s]] : (uint16_t)ts;
+}
+
+static void zs_fse_encode(ZS_BITS *b, const ZS_FSE *t, uint32_t *state, int s)
+{
+    uint32_t nb;
+
+    if (!t->log) return;
+    nb = (*state + t->delta[s]) >> 16;
+    zs_put(b, *state, (int)nb);
+    *state = t->state[(int)(*state >> nb) + t->find[s]];
+}
+
+/* log2(x) in 1/256 bit units (linear between powers of two) */
+static uint32_t zs_log2_fp(uint32_t x)
+{
+    int h = odv_highbit32(x);
+    return ((uint32_t)h << 8) + (uint32_t)(((uint64_t)x << 8 >> h) - 256);
+}
+
+/* Scales freq[0..max_sym] (sum total) to 1 << log, every present symbol >= 1 */
+static void zs_normalize(const uint32_t *freq, int max_sym, uint32_t total, int log, short *norm)
+{
+    uint64_t rem[ZS_FSE_MAX_SYMS];
+    int s, left = 1 << log;
+
+    for (s = 0; s <= max_sym; s++) {
+        norm[s] = freq[s] ? 1 : 0;
+        left -= norm[s];
+    }
+    {
+        int share_left = left;
+        for (s = 0; s <= max_sym; s++) {
+            uint64_t share = (uint64_t)freq[s] * (uint64_t)share_left;
+            norm[s] = (short)(norm[s] + (short)(share / total));
+            rem[s] = share % total;
+            left -= (int)(share / total);
+        }
+    }
+    while (left-- > 0) {
+        int best = -1;
+        for (s = 0; s <= max_sym; s++)
+            if (freq[s] && (best < 0 || rem[s] > rem[best])) best = s;
+        norm[best]++;
+        rem[best] = 0;
+    }
+}
+
+/* Estimated coded size in 1/256 bits, or UINT64 max if a symbol has no slot */
+static uint64_t zs_fse_cost(const uint32_t *freq, int max_code, const short *norm,
+                            int norm_max, int log)
+{
+    uint64_t cost = 0;
+    int s;
+
+    for (s = 0; s <= max_code; s++) {
+        if (!freq[s]) continue;
+        if (s > norm_max || !norm[s]) return ~(uint64_t)0;
+        cost += (uint64_t)freq[s] *
+                (uint64_t)(((uint32_t)log << 8) - zs_log2_fp(norm[s] < 0 ? 1u : (uint32_t)norm[s]));
+    }
+    return cost;
+}
+
+/* FSE table description (RFC 8878 4.1.1); returns its size or -1 */
+static int zs_write_ncount(const short *norm, int max_sym, int log, unsigned char *dst, int cap)
+{
+    unsigned char *p = dst, *end = dst + cap;
+    int ts = 1 << log, remaining = ts + 1, threshold = ts, nb = log + 1;
+    int sym = 0, prev0 = 0, nbits = 4;
+    uint32_t bits = (uint32_t)(log - 5);
+
+#define ZS_NC_FLUSH() do {                                  \
+        if (end - p < 2) return -1;                         \
+        p[0] = (unsigned char)bits;                         \
+        p[1] = (unsigned char)(bits >> 8);                  \
+        p += 2;                                             \
+        bits >>= 16;                                        \
+    } while (0)
+
+    while (sym <= max_sym && remaining > 1) {
+        if (prev0) {
+            int start = sym;
+            while (sym <= max_sym && !norm[sym]) sym++;
+            if (sym > max_sym) break;
+            while (sym >= start + 24) {
+                start += 24;
+                bits += 0xFFFFu << nbits;
+                ZS_NC_FLUSH();
+            }
+            while (sym >= start + 3) {
+                start += 3;
+                bits += 3u << nbits;
+                nbits += 2;
+            }
+            bits += (uint32_t)(sym - start) << nbits;
+            nbits += 2;
+            if (nbits > 16) {
+                ZS_NC_FLUSH();
+                nbits -= 16;
+            }
+        }
+        {
+            int count = norm[sym++];
+            int max = (2 * threshold - 1) - remaining;
+            remaining -= (count < 0) ? -count : count;
+            count++;
+            if (count >= threshold) count += max;
+            bits += (uint32_t)count << nbits;
+            nbits += nb;
+            nbits -= (count < max);
+            prev0 = (count == 1);
+            if (remaining < 1) return -1;
+            while (remaining < threshold) {
+                nb--;
+                threshold >>= 1;
+            }
+        }
+        if (nbits > 16) {
+            ZS_NC_FLUSH();
+            nbits -= 16;
+        }
+    }
+#undef ZS_NC_FLUSH
+
+    if (remaining != 1 || end - p < 2) return -1;
+    p[0] = (unsigned char)bits;
+    p[1] = (unsigned char)(bits >> 8);
+    p += (nbits + 7) / 8;
+    return (int)(p - dst);
+}
+
+/* Accuracy log for count symbols up to max_code (after FSE_optimalTableLog) */
+static int zs_table_log(int count, int max_code, int max_log)
+{
+    int log = odv_highbit32((uint32_t)(count > 1 ? count - 1 : 1)) - 2;
+    int min_bits = ODV_MIN(odv_highbit32((uint32_t)count) + 1, odv_highbit32((uint32_t)ODV_MAX(max_code, 1)) + 2);
+
+    log = ODV_MIN(log, max_log);
+    log = ODV_MAX(log, min_bits);
+    return ODV_MIN(ODV_MAX(log, 5), max_log);
+}
+
+/*---------------------------------------------------------------------------
+    Literals section (RFC 8878 3.1.1.3.1)
+ ---------------------------------------------------------------------------*/
+
+/* Raw (type 0) / RLE (type 1) literals header */
+static int zs_lit_header(unsigned char *dst, int type, int n)
+{
+    if (n < 32) {
+        dst[0] = (unsigned char)(type | (n << 3));
+        return 1;
+    }
+    if (n < 4096) {
+        zs_le(dst, (uint64_t)(type | (1 << 2) | (n << 4)), 2);
+        return 2;
+    }
+    zs_le(dst, (uint64_t)(type | (3 << 2) | (n << 4)), 3);
+    return 3;
+}
+
+/* FSE-compressed Huffman weights (two interleaved states); size or -1 */
+static int zs_huf_weights_fse(const unsigned char *w, int nw, unsigned char *dst, int cap)
+{
+    uint32_t freq[16];
+    short norm[16];
+    ZS_FSE t;
+    ZS_BITS b;
+    uint32_t s1, s2;
+    int max_sym = 0, distinct = 0, hlen, len, i;
+
+    memset(freq, 0, sizeof(freq));
+    for (i = 0; i < nw; i++) freq[w[i]]++;
+    for (i = 0; i < 16; i++) {
+        if (freq[i]) {
+            max_sym = i;
+            distinct++;
+        }
+    }
+    if (distinct < 2) return -1;
+
+    zs_normalize(freq, max_sym, (uint32_t)nw, ZS_HUF_WEIGHT_LOG, norm);
+    hlen = zs_write_ncount(norm, max_sym, ZS_HUF_WEIGHT_LOG, dst, cap);
+    if (hlen < 0) return -1;
+    zs_fse_build(&t, norm, max_sym, ZS_HUF_WEIGHT_LOG);
+
+    zs_bits_init(&b, dst + hlen, dst + cap);
+    i = nw;
+    if (nw & 1) {
+        s1 = t.init[w[--i]];
+        s2 = t.init[w[--i]];
+        zs_fse_encode(&b, &t, &s1, w[--i]);
+    } else {
+        s2 = t.init[w[--i]];
+        s1 = t.init[w[--i]];
+    }
+    while (i > 0) {
+        zs_fse_encode(&b, &t, &s2, w[--i]);
+        zs_fse_encode(&b, &t, &s1, w[--i]);
+    }
+    zs_put(&b, s2, ZS_HUF_WEIGHT_LOG);
+    zs_put(&b, s1, ZS_HUF_WEIGHT_LOG);
+    len = zs_close(&b);
+    return (len < 0) ? -1 : hlen + len;
+}
+
+/* One Huffman stream; the decoder reads it from the end, so the last
+   literal goes in first */
+static int zs_huf_stream(const unsigned char *lit, int n, const uint16_t *code,
+                         const unsigned char *len, unsigned char *dst, unsigned char *end)
+{
+    ZS_BITS b;
+    int i;
+
+    zs_bits_init(&b, dst, end);
+    for (i = n - 1; i >= 0; i--) zs_put(&b, code[lit[i]], len[lit[i]]);
+    return zs_close(&b);
+}
+
+static int zs_literals_raw(const unsigned char *lit, int n, unsigned char *dst, int cap)
+{
+    int h;
+
+    if (cap < n + 3) return -1;
+    h = zs_lit_header(dst, 0, n);
+    memcpy(dst + h, lit, (size_t)n);
+    return h + n;
+}
+
+static int zs_literals(const unsigned char *lit, int n, unsigned char *dst, int cap)
+{
+    uint32_t freq[256];
+    unsigned char len[256], w[256], tree[128];
+    uint16_t code[256];
+    int count[ZS_HUF_MAX_BITS + 2], start[ZS_HUF_MAX_BITS + 2];
+    int distinct = 0, max_len = 0, last = 0, tree_len, hsize, streams, csize, i;
+    uint64_t bits = 0;
+    unsigned char *p, *end = dst + cap;
+
+    memset(freq, 0, sizeof(freq));
+    for (i = 0; i < n; i++) freq[lit[i]]++;
+    for (i = 0; i < 256; i++) distinct += (freq[i] != 0);
+
+    if (distinct == 1) {
+        if (cap < 4) return -1;
+        i = zs_lit_header(dst, 1, n);
+        dst[i] = lit[0];
+        return i + 1;
+    }
+    if (n < 64) return zs_literals_raw(lit, n, dst, cap);
+
+    odv_huffman_lengths(freq, 256, ZS_HUF_MAX_BITS, len);
+    for (i = 0; i < 256; i++) {
+        if (!len[i]) continue;
+        max_len = ODV_MAX(max_len, len[i]);
+        last = i;
+        bits += (uint64_t)freq[i] * len[i];
+    }
+
+    /* Weights of symbols 0..last-1; the last one is implied */
+    for (i = 0; i < last; i++) w[i] = (unsigned char)(len[i] ? max_len + 1 - len[i] : 0);
+    tree_len = zs_huf_weights_fse(w, last, tree + 1, (int)sizeof(tree) - 1);
+    if (tree_len > 0 && tree_len < 128 && (last > 128 || tree_len < (last + 1) / 2)) {
+        tree[0] = (unsigned char)tree_len;
+        tree_len++;
+    } else if (last <= 128) {
+        tree[0] = (unsigned char)(127 + last);
+        memset(tree + 1, 0, (size_t)(last + 1) / 2);
+        for (i = 0; i < last; i++) tree[1 + i / 2] |= (unsigned char)(w[i] << ((i & 1) ? 0 : 4));
+        tree_len = 1 + (last + 1) / 2;
+    } else {
+        return zs_literals_raw(lit, n, dst, cap);
+    }
+
+    streams = (n < 1024) ? 1 : 4;
+    hsize = (n < 1024) ? 3 : (n < 16384) ? 4 : 5;
+    if ((int)(bits / 8) + tree_len + hsize + (streams == 4 ? 10 : 1) >= n)
+        return zs_literals_raw(lit, n, dst, cap);
+
+    /* Canonical codes: longest codes first, from 0 */
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < 256; i++) count[len[i]]++;
+    start[max_len] = 0;
+    for (i = max_len; i > 1; i--) start[i - 1] = (start[i] + count[i]) >> 1;
+    for (i = 0; i < 256; i++)
+        if (len[i]) code[i] = (uint16_t)start[len[i]]++;
+
+    if (cap < hsize + tree_len + 6) return zs_literals_raw(lit, n, dst, cap);
+    p = dst + hsize;
+    memcpy(p, tree, (size_t)tree_len);
+    p += tree_len;
+    if (streams == 1) {
+        int s = zs_huf_stream(lit, n, code, len, p, end);
+        if (s < 0) return zs_literals_raw(lit, n, dst, cap);
+        p += s;
+    } else {
+        unsigned char *jump = p;
+        int seg = (n + 3) / 4, k;
+        p += 6;
+        for (k = 0; k < 4; k++) {
+            int off = seg * k, cnt = (k < 3) ? seg : n - 3 * seg;
+            int s = zs_huf_stream(lit + off, cnt, code, len, p, end);
+            if (s < 0) return zs_literals_raw(lit, n, dst, cap);
+            if (k < 3) zs_le(jump + 2 * k, (uint64_t)s, 2);
+            p += s;
+        }
+    }
+
+    csize = (int)(p - dst) - hsize;
+    if (csize + hsize >= n + 3) return zs_literals_raw(lit, n, dst, cap);
+    if (hsize == 3)
+        zs_le(dst, 2 | ((uint64_t)n << 4) | ((uint64_t)csize << 14), 3);
+    else if (hsize == 4)
+        zs_le(dst, 2 | (2 << 2) | ((uint64_t)n << 4) | ((uint64_t)csize << 18), 4);
+    else
+        zs_le(dst, 2 | (3 << 2) | ((uint64_t)n << 4) | ((uint64_t)csize << 22), 5);
+    return (int)(p - dst);
+}
+
+/*---------------------------------------------------------------------------
+    Sequences section (RFC 8878 3.1.1.3.2)
+ ---------------------------------------------------------------------------*/
+typedef struct {
+    ZS_FSE   fse;
+    uint32_t state;
+} ZS_STREAM;
+
+/* Picks RLE, predefined or a transmitted table for one code stream.
+   Writes the table description (if any) at desc; returns the mode. */
+static int zs_choose(ZS_STREAM *st, const uint32_t *freq, int ncodes, int nseq,
+                     const short *def, int def_max, int def_log, int max_log,
+                     unsigned char *desc, int *desc_len)
+{
+    short norm[ZS_FSE_MAX_SYMS];
+    uint64_t cost_def, cost_fse;
+    int max_code = 0, distinct = 0, log, hlen, s;
+
+    for (s = 0; s < ncodes; s++) {
+        if (freq[s]) {
+            max_code = s;
+            distinct++;
+        }
+    }
+    *desc_len = 0;
+    if (distinct == 1) {
+        st->fse.log = 0;
+        desc[0] = (unsigned char)max_code;
+        *desc_len = 1;
+        return ZS_MODE_RLE;
+    }
+
+    log = zs_table_log(nseq, max_code, max_log);
+    zs_normalize(freq, max_code, (uint32_t)nseq, log, norm);
+    hlen = zs_write_ncount(norm, max_code, log, desc, 256);
+    cost_def = zs_fse_cost(freq, max_code, def, def_max, def_log);
+    cost_fse = (hlen < 0) ? ~(uint64_t)0
+                          : zs_fse_cost(freq, max_code, norm, max_code, log) + (uint64_t)hlen * 8 * 256;
+
+    if (cost_def <= cost_fse) {
+        zs_fse_build(&st->fse, def, def_max, def_log);
+        return ZS_MODE_PREDEFINED;
+    }
+    zs_fse_build(&st->fse, norm, max_code, log);
+    *desc_len = hlen;
+    return ZS_MODE_FSE;
+}
+
+static int zs_sequences(const ZS_SEQ *seq, int nseq, unsigned char *dst, int cap)
+{
+    uint32_t ll_freq[ZS_LL_CODES], ml_freq[ZS_ML_CODES], of_freq[ZS_OF_CODES];
+    unsigned char ll_desc[256], ml_desc[256], of_desc[256];
+    int ll_len, ml_len, of_len, ll_mode, ml_mode, of_mode, len, k;
+    ZS_STREAM ll, ml, of;
+    unsigned char *p = dst, *end = dst + cap;
+    const ZS_SEQ *s;
+    ZS_BITS b;
+
+    if (cap < 4) return -1;
+    if (nseq < 128) {
+        *p++ = (unsigned char)nseq;
+    } else if (nseq < 0x7F00) {
+        *p++ = (unsigned char)((nseq >> 8) + 0x80);
+        *p++ = (unsigned char)nseq;
+    } else {
+        *p++ = 0xFF;
+        zs_le(p, (uint64_t)(nseq - 0x7F00), 2);
+        p += 2;
+    }
+    if (nseq == 0) return (int)(p - dst);
+
+    memset(ll_freq, 0, sizeof(ll_freq));
+    memset(ml_freq, 0, sizeof(ml_freq));
+    memset(of_freq, 0, sizeof(of_freq));
+    for (k = 0; k < nseq; k++) {
+        ll_freq[seq[k].llc]++;
+        ml_freq[seq[k].mlc]++;
+        of_freq[seq[k].ofc]++;
+    }
+    ll_mode = zs_choose(&ll, ll_freq, ZS_LL_CODES, nseq, ll_default, ZS_LL_CODES - 1, 6,
+                        ZS_LL_MAX_LOG, ll_desc, &ll_len);
+    of_mode = zs_choose(&of, of_freq, ZS_OF_CODES, nseq, of_default, 28, 5,
+                        ZS_OF_MAX_LOG, of_desc, &of_len);
+    ml_mode = zs_choose(&ml, ml_freq, ZS_ML_CODES, nseq, ml_default, ZS_ML_CODES - 1, 6,
+                        ZS_ML_MAX_LOG, ml_desc, &ml_len);
+
+    if (end - p < 1 + ll_len + of_len + ml_len) return -1;
+    *p++ = (unsigned char)((ll_mode << 6) | (of_mode << 4) | (ml_mode << 2));
+    memcpy(p, ll_desc, (size_t)ll_len);
+    p += ll_len;
+    memcpy(p, of_desc, (size_t)of_len);
+    p += of_len;
+    memcpy(p, ml_desc, (size_t)ml_len);
+    p += ml_len;
+
+    /* Encoded last to first; the decoder starts from the final states */
+    zs_bits_init(&b, p, end);
+    s = &seq[nseq - 1];
+    ml.state = ml.fse.log ? ml.fse.init[s->mlc] : 0;
+    of.state = of.fse.log ? of.fse.init[s->ofc] : 0;
+    ll.state = ll.fse.log ? ll.fse.init[s->llc] : 0;
+    zs_put(&b, s->ll - ll_base[s->llc], ll_bits[s->llc]);
+    zs_put(&b, s->ml - ml_base[s->mlc], ml_bits[s->mlc]);
+    zs_put(&b, s->off + 3 - (1u << s->ofc), s->ofc);
+    for (k = nseq - 2; k >= 0; k--) {
+        s = &seq[k];
+        zs_fse_encode(&b, &of.fse, &of.state, s->ofc);
+        zs_fse_encode(&b, &ml.fse, &ml.state, s->mlc);
+        zs_fse_encode(&b, &ll.fse, &ll.state, s->llc);
+        zs_put(&b, s->ll - ll_base[s->llc], ll_bits[s->llc]);
+        zs_put(&b, s->ml - ml_base[s->mlc], ml_bits[s->mlc]);
+        zs_put(&b, s->off + 3 - (1u << s->ofc), s->ofc);
+    }
+    zs_put(&b, ml.state, ml.fse.log);
+    zs_put(&b, of.state, of.fse.log);
+    zs_put(&b, ll.state, ll.fse.log);
+    len = zs_close(&b);
+    if (len < 0) return -1;
+    return (int)(p - dst) + len;
+}
+
+/*---------------------------------------------------------------------------
+    odv_zstd_frame
+
+    Compresses src[0..n) into one Zstandard frame.
+    level: 1 (fastest) .. 9 (smallest), selects the match search effort.
+    Returns the frame size, or ODV_ERROR_MALLOC / ODV_ERROR_BUFFER_OVER.
+ ---------------------------------------------------------------------------*/
+int odv_zstd_frame(ODV_LZ *lz, const unsigned char *src, int n, int level,
+                   unsigned char *dst, int cap)
+{
+    unsigned char *scratch, *lits, *p = dst, *end = dst + cap;
+    ZS_SEQ *seqs;
+    uint32_t lit_done = 0;
+    int nseq_all, i = 0, pos = 0, last;
+
+    nseq_all = odv_lz_parse(lz, src, n, level, n, ZS_MAX_MATCH);
+    if (nseq_all < 0) return nseq_all;
+    scratch = (unsigned char *)odv_lz_scratch(lz, ZS_BLOCK_MAX + sizeof(ZS_SEQ) * ZS_SEQ_MAX);
+    if (!scratch) return ODV_ERROR_MALLOC;
+    lits = scratch;
+    seqs = (ZS_SEQ *)(scratch + ZS_BLOCK_MAX);
+
+    /* Frame header: single segment, content size, content checksum */
+    if (cap < 13) return ODV_ERROR_BUFFER_OVER;
+    zs_le(p, ZS_MAGIC, 4);
+    p += 4;
+    if (n < 256) {
+        *p++ = 0x24;
+        *p++ = (unsigned char)n;
+    } else if (n < 65536 + 256) {
+        *p++ = 0x64;
+        zs_le(p, (uint64_t)(n - 256), 2);
+        p += 2;
+    } else {
+        *p++ = 0xA4;
+        zs_le(p, (uint64_t)n, 4);
+        p += 4;
+    }
+
+    do {
+        int start = pos, budget = ZS_BLOCK_MAX, nseq = 0, nlit = 0, size, room, clen = -1;
+
+        while (i < nseq_all) {
+            const ODV_LZ_SEQ *q = &lz->seqs[i];
+            int litrem = (int)(q->lit_len - lit_done);
+
+            if (q->match_len && litrem + (int)q->match_len <= budget) {
+                ZS_SEQ *s = &seqs[nseq++];
+                memcpy(lits + nlit, src + pos, (size_t)litrem);
+                nlit += litrem;
+                s->ll = (uint32_t)litrem;
+                s->ml = q->match_len;
+                s->off = q->offset;
+                if (s->ll < 16) s->llc = (unsigned char)s->ll;
+                else if (s->ll >= 64) s->llc = (unsigned char)(odv_highbit32(s->ll) + 19);
+                else {
+                    int c = 24;
+                    while (ll_base[c] > s->ll) c--;
+                    s->llc = (unsigned char)c;
+                }
+                if (s->ml - 3 < 32) s->mlc = (unsigned char)(s->ml - 3);
+                else if (s->ml - 3 >= 128) s->mlc = (unsigned char)(odv_highbit32(s->ml - 3) + 36);
+                else {
+                    int c = 42;
+                    while (ml_base[c] > s->ml) c--;
+                    s->mlc = (unsigned char)c;
+                }
+                s->ofc = (unsigned char)odv_highbit32(s->off + 3);
+                pos += litrem + (int)q->match_len;
+                budget -= litrem + (int)q->match_len;
+                i++;
+                lit_done = 0;
+            } else {
+                /* Literals that fit; the match (if any) opens the next block */
+                int t = ODV_MIN(litrem, budget);
+                memcpy(lits + nlit, src + pos, (size_t)t);
+                nlit += t;
+                pos += t;
+                lit_done += (uint32_t)t;
+                if (!q->match_len && lit_done == q->lit_len) {
+                    i++;
+                    lit_done = 0;
+                }
+                break;
+            }
+        }
+
+        last = (i >= nseq_all);
+        size = pos - start;
+        room = (int)(end - p) - 3;
+        if (size > 0 && room > 0) {
+            int l = zs_literals(lits, nlit, p + 3, ODV_MIN(room, size));
+            if (l >= 0) {
+                int s = zs_sequences(seqs, nseq, p + 3 + l, ODV_MIN(room, size) - l);
+                if (s >= 0 && l + s < size) clen = l + s;
+            }
+        }
+        if (clen >= 0) {
+            zs_le(p, (uint64_t)(last | (2 << 1) | (clen << 3)), 3);
+            p += 3 + clen;
+        } else {
+            if (room < size) return ODV_ERROR_BUFFER_OVER;
+            zs_le(p, (uint64_t)(last | (size << 3)), 3);
+            memcpy(p + 3, src + start, (size_t)size);
+            p += 3 + size;
+        }
+    } while (i < nseq_all);
+
+    if (end - p < 4) return ODV_ERROR_BUFFER_OVER;
+    zs_le(p, xxh64(src, (size_t)n) & 0xFFFFFFFFu, 4);
+    p += 4;
+    return (int)(p - dst);
+}
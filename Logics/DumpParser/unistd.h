@@ -27,5 +27,7 @@
 
 typedef int ssize_t;
 
+#else
+#include_next <unistd.h>         /* -I. puts this stub ahead of the system header */
 #endif /* WINDOWS */
 #endif /* ODV_UNISTD_H */